@@ -21,7 +21,11 @@ win32 {
 }
 
 SOURCES += \
+    src/batchscheduler.cpp \
     src/channeldata.cpp \
+    src/ch10packetindex.cpp \
+    src/ch10packetsource.cpp \
+    src/ch10recordingindex.cpp \
     src/chapter10reader.cpp \
     src/framesetup.cpp \
     src/main.cpp \
@@ -32,6 +36,14 @@ SOURCES += \
     src/settingsdialog.cpp \
     src/timeextractionwidget.cpp \
     src/frameprocessor.cpp \
+    src/csvrowwriter.cpp \
+    src/extractionplan.cpp \
+    src/pcmframedecoder.cpp \
+    src/pcmframesync.cpp \
+    src/pcmpackettable.cpp \
+    src/rnrzldecoder.cpp \
+    src/synccorrelator.cpp \
+    src/timebinaccumulator.cpp \
     src/plotviewmodel.cpp \
     src/plotwidget.cpp \
     src/settingsmanager.cpp \
@@ -51,7 +63,11 @@ SOURCES += \
     lib/qcustomplot/qcustomplot.cpp
 
 HEADERS += \
+    include/batchscheduler.h \
     include/channeldata.h \
+    include/ch10packetindex.h \
+    include/ch10packetsource.h \
+    include/ch10recordingindex.h \
     include/chapter10reader.h \
     include/constants.h \
     include/framesetup.h \
@@ -60,6 +76,17 @@ HEADERS += \
     include/mainview.h \
     include/receivergridwidget.h \
     include/frameprocessor.h \
+    include/csvrowwriter.h \
+    include/extractionplan.h \
+    include/irigtime.h \
+    include/pcmframedecoder.h \
+    include/pcmframesync.h \
+    include/pcmpackettable.h \
+    include/rnrzldecoder.h \
+    include/spscring.h \
+    include/synccorrelator.h \
+    include/timebinaccumulator.h \
+    include/tmatsdecode.h \
     include/processingparams.h \
     include/batchfileinfo.h \
     include/settingsdata.h \
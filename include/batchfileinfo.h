@@ -13,9 +13,12 @@
 /**
  * @brief Stores metadata and validation state for one file in a batch.
  *
- * Populated during batch file loading (channel discovery) and updated
- * during validation and pre-scan phases. Plain value type following the
- * same pattern as SettingsData.
+ * Populated off the GUI thread during batch file loading (channel
+ * discovery and a first pre-scan) and updated during validation and
+ * pre-scan phases. The channel discovery results are the file's catalog:
+ * set once by intake and all that processing needs, so a file is not read
+ * again before its run. Plain value type following the same pattern as
+ * SettingsData.
  */
 struct BatchFileInfo
 {
@@ -23,11 +26,15 @@ struct BatchFileInfo
     QString filename;               ///< Base filename (QFileInfo::fileName()).
     qint64  fileSize = 0;           ///< File size in bytes.
 
-    /// @name Channel discovery results
+    /// @name Channel discovery results (set by intake, read-only afterwards)
     /// @{
     QStringList pcmChannelStrings;  ///< PCM channel display strings from this file.
     QStringList timeChannelStrings; ///< Time channel display strings from this file.
     QVector<int> pcmChannelIds;     ///< PCM channel IDs corresponding to pcmChannelStrings.
+    QVector<int> timeChannelIds;    ///< Time channel IDs corresponding to timeChannelStrings.
+    quint64 startSeconds = 0;       ///< File start time (IRIG seconds, as Chapter10Reader::dhmsToUInt64()).
+    quint64 stopSeconds  = 0;       ///< File stop time (IRIG seconds).
+    bool loaded = false;            ///< True once intake has read this file (successfully or not).
     /// @}
 
     /// @name Validation state (updated on channel change)
@@ -38,6 +45,10 @@ struct BatchFileInfo
     int resolvedTimeIndex = -1;    ///< Index into this file's timeChannelStrings (0-based), or -1.
     bool preScanOk      = false;    ///< True if sync pattern was found during pre-scan.
     bool isRandomized   = false;    ///< True if RNRZ-L encoding detected.
+    int preScanPcmChannelId = -1;   ///< PCM channel ID preScanOk was found for (-1 = not pre-scanned).
+    quint64 preScanFrameSync = 0;   ///< Frame sync pattern preScanOk was found with.
+    int preScanSyncBits     = 0;    ///< Frame sync length (bits) preScanOk was found with.
+    int preScanFrameWords   = 0;    ///< Minor frame length (words) preScanOk was found with.
     bool skip           = false;    ///< True if file should be skipped during processing.
     QString skipReason;             ///< Human-readable reason if skip is true.
     /// @}
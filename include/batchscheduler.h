@@ -0,0 +1,83 @@
+/**
+ * @file batchscheduler.h
+ * @brief Order and concurrency limits for running batch files on a worker pool.
+ */
+
+#ifndef BATCHSCHEDULER_H
+#define BATCHSCHEDULER_H
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief Decides which batch file starts next on a bounded set of workers.
+ *
+ * Files are handed out largest first, so the longest runs start early
+ * instead of becoming the tail of the batch. A file only starts while fewer
+ * than the worker limit are running and fewer than the per-device limit are
+ * running from its storage device, so several runs do not thrash one
+ * spinning disk while files on other devices keep the remaining workers busy.
+ * Devices are told apart by their mounted volume (storageDevice()), so two
+ * partitions of one disk count as two devices.
+ *
+ * Holds file indices only; the caller owns the files and the workers.
+ */
+class BatchScheduler
+{
+public:
+    /**
+     * @param[in] max_workers    Files running at once (at least 1).
+     * @param[in] max_per_device Files running at once from one device (0 = no limit).
+     */
+    explicit BatchScheduler(int max_workers = 1, int max_per_device = 0);
+
+    /// Queues file @p index of @p size bytes stored on @p device.
+    void addFile(int index, qint64 size, const QString& device);
+
+    /**
+     * @brief Starts the largest queued file that the limits allow.
+     * @return Its index, or -1 if none may start now.
+     */
+    int takeNext();
+
+    /// Marks the running file @p index as done, freeing its worker and device slot.
+    void finish(int index);
+
+    /// Drops the queued files (running ones are unaffected).
+    void clearQueue();
+
+    int maxWorkers() const { return m_max_workers; }      ///< @return Worker limit.
+    int running() const { return static_cast<int>(m_running.size()); } ///< @return Files started and not finished.
+    int queued() const { return static_cast<int>(m_queue.size()); }    ///< @return Files not started yet.
+
+    /**
+     * @brief Files that can run at once given the queue, the worker limit and the device limits.
+     *
+     * Used to share the cores between the files of a batch: each run gets
+     * its share of decode threads rather than one per core.
+     */
+    int concurrency() const;
+
+    /// @return Number of physical CPU cores, or QThread::idealThreadCount() if it cannot be read.
+    static int physicalCoreCount();
+
+    /// @return Identifier of the volume holding @p path (empty if unknown).
+    static QString storageDevice(const QString& path);
+
+private:
+    /// @brief One queued file.
+    struct File {
+        int index = -1;   ///< Index in the caller's file list.
+        qint64 size = 0;  ///< File size in bytes.
+        QString device;   ///< Storage device (see storageDevice()).
+    };
+
+    int m_max_workers = 1;           ///< Files running at once.
+    int m_max_per_device = 0;        ///< Files running at once per device (0 = no limit).
+    QVector<File> m_queue;           ///< Queued files, largest first.
+    QMap<int, QString> m_running;    ///< Device of each running file, by index.
+    QMap<QString, int> m_device_use; ///< Running files per device.
+};
+
+#endif // BATCHSCHEDULER_H
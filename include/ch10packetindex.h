@@ -0,0 +1,105 @@
+/**
+ * @file ch10packetindex.h
+ * @brief Persistent per-file packet index (structure of arrays, ".ch10.idx" sidecar).
+ */
+
+#ifndef CH10PACKETINDEX_H
+#define CH10PACKETINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <QString>
+
+#include "ch10packetsource.h"
+
+/**
+ * @brief Header fields of every packet of a Chapter 10 file, in file order.
+ *
+ * Built from the headers returned by Ch10PacketSource::next() during the
+ * first full pass over a file (Chapter10Reader::loadChannels()) and saved
+ * next to it as "<file>.idx". Later opens load the sidecar with one read per
+ * column instead of walking the file, and use it to visit only the packets
+ * they need (see selectPackets()).
+ *
+ * Each field is a separate contiguous array (structure of arrays), so a
+ * filter over channel IDs and data types touches 3 bytes per packet. The
+ * sidecar records the size and modification time of the file it describes;
+ * load() rejects it when either differs, or when it is damaged.
+ */
+class Ch10PacketIndex
+{
+public:
+    /// @brief Decides whether a packet is visited, from its channel ID and data type.
+    using PacketFilter = Ch10PacketSource::PacketFilter;
+
+    /// @return Sidecar path of @p filename ("<filename>.idx").
+    static QString sidecarPath(const QString& filename);
+
+    /// Removes all packets.
+    void clear();
+
+    /// Appends the header of @p packet, which must follow the last packet appended.
+    void append(const Ch10Packet& packet);
+
+    /**
+     * @brief Appends a packet known only by its offset, time, channel and type (e.g. a recording index entry).
+     *
+     * Its lengths are recorded as 0, so such an index serves cataloging
+     * only; it is never saved or used to select packets.
+     */
+    void append(int64_t offset, int64_t rel_time, uint16_t channel_id, uint8_t data_type);
+
+    size_t size() const { return m_offsets.size(); }      ///< @return Number of packets.
+    bool isEmpty() const { return m_offsets.empty(); }    ///< @return true if no packets.
+
+    /// @name Columns (one element per packet)
+    /// @{
+    const std::vector<int64_t>& offsets() const { return m_offsets; }             ///< @return Header file offsets.
+    const std::vector<int64_t>& relativeTimes() const { return m_rel_times; }     ///< @return Header relative times (100 ns).
+    const std::vector<uint32_t>& packetLengths() const { return m_packet_lengths; } ///< @return ulPacketLen.
+    const std::vector<uint32_t>& dataLengths() const { return m_data_lengths; }   ///< @return ulDataLen.
+    const std::vector<uint16_t>& channelIds() const { return m_channel_ids; }     ///< @return uChID.
+    const std::vector<uint8_t>& dataTypes() const { return m_data_types; }        ///< @return ubyDataType.
+    /// @}
+
+    /**
+     * @brief Writes the index to the sidecar of @p filename, stamped with the file's size and time.
+     * @return false if the sidecar cannot be written (e.g. read-only directory).
+     */
+    bool save(const QString& filename) const;
+
+    /**
+     * @brief Replaces the index with the sidecar of @p filename.
+     * @return false (and an empty index) if there is no sidecar, it is damaged,
+     *         or @p filename changed size or modification time since it was written.
+     */
+    bool load(const QString& filename);
+
+    /**
+     * @brief Restricts @p source to the indexed packets that pass @p filter.
+     *
+     * The returned source jumps from one selected packet to the next with
+     * setPosition(), starting at the first selected packet at or after the
+     * current position of @p source. next() returns I106_READ_ERROR if a
+     * selected offset no longer holds the indexed packet.
+     *
+     * @param[in] source Open source of the indexed file (ownership is taken).
+     * @param[in] filter Packets to visit.
+     * @return Source that returns the selected packets only.
+     */
+    std::unique_ptr<Ch10PacketSource> selectPackets(std::unique_ptr<Ch10PacketSource> source,
+                                                    const PacketFilter& filter) const;
+
+private:
+    std::vector<int64_t> m_offsets;         ///< Header file offsets, ascending.
+    std::vector<int64_t> m_rel_times;       ///< Header relative times.
+    std::vector<uint32_t> m_packet_lengths; ///< Packet lengths including headers.
+    std::vector<uint32_t> m_data_lengths;   ///< Data lengths.
+    std::vector<uint16_t> m_channel_ids;    ///< Channel IDs.
+    std::vector<uint8_t> m_data_types;      ///< Data types.
+};
+
+#endif // CH10PACKETINDEX_H
@@ -0,0 +1,161 @@
+/**
+ * @file ch10packetsource.h
+ * @brief Sequential Chapter 10 packet reader with memory-mapped, prefetching and irig106 backends.
+ */
+
+#ifndef CH10PACKETSOURCE_H
+#define CH10PACKETSOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <QString>
+
+#include "constants.h"
+#include "irig106ch10.h"
+
+/// @brief One packet handed out by Ch10PacketSource.
+struct Ch10Packet {
+    Irig106::SuI106Ch10Header header = {};  ///< Primary header, plus the secondary header if flagged.
+    const uint8_t* data = nullptr;          ///< Packet body (channel-specific word, data, filler); see readData().
+    uint32_t data_size = 0;                 ///< Body bytes: packet length minus header lengths.
+    int64_t offset = 0;                     ///< File offset of the primary header.
+    uint32_t header_size = 0;               ///< Primary + secondary header bytes.
+
+    int64_t dataOffset() const { return offset + header_size; }  ///< @return File offset of the body.
+};
+
+/// @brief I/O counters of a Ch10PacketSource, for throughput reports.
+struct Ch10ReadStats {
+    int64_t bytes = 0;     ///< Bytes brought in from the file (furthest offset parsed when mapped).
+    int64_t read_ns = 0;   ///< Time spent inside file reads (prefetching backend only, else 0).
+    uint64_t waits = 0;    ///< Times the parser waited for a block still being read.
+};
+
+/**
+ * @brief Reads the packets of a Chapter 10 file in file order.
+ *
+ * Mirrors the irig106 enI106Ch10ReadNextHeader() / enI106Ch10ReadData() pair:
+ * next() returns the next valid header (sync and checksums verified, scanning
+ * forward byte by byte after a corrupt one), readData() makes its body
+ * available. Callers that only need headers skip readData().
+ *
+ * The Mapped backend maps the whole file copy-on-write and parses headers in
+ * place: next() and readData() are pointer arithmetic, bodies are views into
+ * the mapping that stay valid until the source is destroyed, and fileBytes()
+ * lets other threads read any packet without a file handle. The kernel is
+ * told the access is sequential (and may use huge pages) where supported.
+ * The Prefetched backend suits storage where page-fault driven reads are
+ * slow (NFS/SMB mounts): a background thread reads large blocks at
+ * block-aligned offsets into a small ring of buffers (kPrefetchBlocks, so the
+ * next blocks are read while the current one is parsed) and headers are
+ * parsed out of the blocks in user space, one read() per block instead of
+ * per header. Bodies inside one block are views into it; bodies spanning
+ * blocks are copied. Either way they stay valid until the next call.
+ *
+ * The Library backend uses the irig106 calls (one read() per header and per
+ * body, copied into an internal buffer that the next readData() reuses); it
+ * is the fallback when a file cannot be mapped.
+ */
+class Ch10PacketSource
+{
+public:
+    /// @brief Packet reading implementation.
+    enum class Backend {
+        Library,     ///< irig106 read() calls into a reused buffer.
+        Mapped,      ///< Memory-mapped file, zero-copy views.
+        Prefetched   ///< Large blocks read ahead on a background thread.
+    };
+
+    /// @brief Decides whether a packet is wanted, from its channel ID and data type.
+    using PacketFilter = std::function<bool(uint16_t channel_id, uint8_t data_type)>;
+
+    virtual ~Ch10PacketSource() = default;
+
+    Ch10PacketSource(const Ch10PacketSource&) = delete;
+    Ch10PacketSource& operator=(const Ch10PacketSource&) = delete;
+    Ch10PacketSource(Ch10PacketSource&&) = delete;
+    Ch10PacketSource& operator=(Ch10PacketSource&&) = delete;
+
+    /**
+     * @brief Opens @p filename for reading.
+     * @param[in] filename Chapter 10 file.
+     * @param[in] backend  Preferred backend; Mapped falls back to Library if mapping fails.
+     * @param[in] block_bytes Prefetched backend block size (at least kMinPrefetchBlockBytes).
+     * @return The open source, or nullptr if the file cannot be opened or does not start with a sync word.
+     */
+    static std::unique_ptr<Ch10PacketSource> open(const QString& filename, Backend backend = Backend::Mapped,
+                                                  size_t block_bytes = PCMConstants::kPrefetchBlockBytes);
+
+    /// @return Backend actually in use.
+    virtual Backend backend() const = 0;
+
+    /**
+     * @brief Advances to the next valid packet header.
+     * @param[out] packet Header, offsets and sizes; @c data is set only if the body is already available.
+     * @return I106_OK, I106_EOF, I106_HEADER_CHKSUM_BAD (first corrupt header after a good one)
+     *         or a read error.
+     */
+    virtual Irig106::EnI106Status next(Ch10Packet& packet) = 0;
+
+    /**
+     * @brief Makes the body of the packet last returned by next() available in @c packet.data.
+     * @return I106_OK, I106_EOF if the body is truncated, or a read error.
+     */
+    virtual Irig106::EnI106Status readData(Ch10Packet& packet) = 0;
+
+    /// Moves to file offset @p offset; the next header is searched from there.
+    virtual bool setPosition(int64_t offset) = 0;
+
+    /**
+     * @brief Reads the header and body of the packet starting at @p offset (e.g. from a Ch10PacketIndex).
+     * @return I106_OK, I106_READ_ERROR if no valid packet starts at @p offset, or the error of next() / readData().
+     */
+    Irig106::EnI106Status readAt(int64_t offset, Ch10Packet& packet);
+
+    /**
+     * @brief Finds the header of the last complete packet that ends at or before @p end.
+     *
+     * The app-side counterpart of enI106Ch10LastMsg() / enI106Ch10ReadPrevHeader()
+     * for every backend: headers are walked forward from kBackwardSearchBytes
+     * before @p end, doubling the distance until a packet is found, so only the
+     * tail of the file is touched. previous(size()) is the last whole packet.
+     * The body is not read; use readAt(packet.offset) for it.
+     * @param[in]  end    File offset the packet must end by.
+     * @param[out] packet Header, offsets and sizes of the packet found.
+     * @param[in]  filter Packets to consider (all if empty), e.g. the last time packet.
+     * @return I106_OK, I106_BOF if no packet ends at or before @p end, or a read error.
+     */
+    Irig106::EnI106Status previous(int64_t end, Ch10Packet& packet, const PacketFilter& filter = nullptr);
+
+    /**
+     * @brief Tells the source that most bodies will be skipped (header-only scans).
+     *
+     * The Mapped backend swaps its sequential read-ahead hint for a random
+     * access one, so storage reads are bounded by the pages holding headers
+     * rather than the file size. Other backends ignore it.
+     */
+    virtual void adviseSparseReads() {}
+
+    /// @return Current file offset (after the last header or body read).
+    virtual int64_t position() const = 0;
+
+    /// @return File size in bytes.
+    virtual int64_t size() const = 0;
+
+    /// @return The whole file, valid while the source exists, or nullptr if not mapped.
+    virtual const uint8_t* fileBytes() const { return nullptr; }
+
+    /// @return I/O counters since the source was opened.
+    virtual Ch10ReadStats readStats() const = 0;
+
+    /// @return Display name of @p backend for log messages.
+    static QString backendName(Backend backend);
+
+protected:
+    Ch10PacketSource() = default;
+};
+
+#endif // CH10PACKETSOURCE_H
@@ -0,0 +1,77 @@
+/**
+ * @file ch10recordingindex.h
+ * @brief Decoder for Chapter 10 recording index packets (data type 0x03, root and node).
+ */
+
+#ifndef CH10RECORDINGINDEX_H
+#define CH10RECORDINGINDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "ch10packetindex.h"
+#include "ch10packetsource.h"
+
+/**
+ * @brief Reads the packet list a recorder wrote into its recording index packets.
+ *
+ * Recorders close a file with a root index packet. Its entries point at node
+ * index packets, which list packet offsets with their channel ID, data type
+ * and time; its last entry points at the previous root (the first root points
+ * at itself). Following the chain from the last packet of the file lists the
+ * recording without walking its packets.
+ *
+ * Only RTC intra-packet time stamps without intra-packet data headers are
+ * decoded; other layouts are reported as missing so callers fall back to a
+ * scan. The irig106 library has no index decoder, so the layout is parsed here.
+ */
+class Ch10RecordingIndex
+{
+public:
+    /// @brief Contents of a root index packet.
+    struct Root {
+        std::vector<int64_t> node_offsets;  ///< Offsets of the node index packets, in entry order.
+        int64_t previous_root = -1;         ///< Offset of the previous root (its own offset for the first root).
+        int64_t file_size = -1;             ///< File size recorded in the packet, or -1 if absent.
+    };
+
+    /// @brief One packet listed by a node index packet.
+    struct Entry {
+        int64_t offset = 0;      ///< File offset of the packet header.
+        int64_t rel_time = 0;    ///< Relative time of the packet (100 ns).
+        uint16_t channel_id = 0; ///< Channel ID of the packet.
+        uint8_t data_type = 0;   ///< Data type of the packet.
+    };
+
+    /**
+     * @brief Decodes a root index packet.
+     * @param[in]  packet Packet with its body read.
+     * @param[out] root   Node offsets, previous root and file size.
+     * @return false if @p packet is not a root index packet of a supported layout.
+     */
+    static bool decodeRoot(const Ch10Packet& packet, Root& root);
+
+    /**
+     * @brief Decodes a node index packet, appending its entries to @p entries.
+     * @return false if @p packet is not a node index packet of a supported layout.
+     */
+    static bool decodeNode(const Ch10Packet& packet, std::vector<Entry>& entries);
+
+    /**
+     * @brief Fills @p index from the recording index of the file open in @p source.
+     *
+     * The last packet must be a root index packet. Every root of the chain and
+     * every node is read and checked: sizes must match the entry counts, a
+     * recorded file size may not exceed the file, roots must run backwards,
+     * listed packets must be in order inside the file, and the first and last
+     * listed packets must be where and what the index says. The first packet
+     * of the file (TMATS) is included if the index leaves it out.
+     *
+     * @param[in]  source Open source; its position is changed.
+     * @param[out] index  Listed packets with zero lengths (see Ch10PacketIndex::append()).
+     * @return false (and an empty @p index) if there is no usable recording index.
+     */
+    static bool read(Ch10PacketSource& source, Ch10PacketIndex& index);
+};
+
+#endif // CH10RECORDINGINDEX_H
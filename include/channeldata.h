@@ -38,6 +38,8 @@ public:
     void setChannelName(const QString& channel_name);
     /// Increments the packet count by one.
     void incrementChannelCount();
+    /// @param[in] channel_count Number of packets counted for this channel.
+    void setChannelCount(int channel_count);
 
 private:
     int m_channel_id;        ///< Numeric channel identifier.
@@ -9,9 +9,8 @@
 #ifndef CHAPTER10READER_H
 #define CHAPTER10READER_H
 
-#include <array>
+#include <cstdint>
 
-#include <QByteArray>
 #include <QDateTime>
 #include <QMap>
 #include <QObject>
@@ -22,6 +21,10 @@
 #include "i106_decode_tmats.h"
 
 #include "channeldata.h"
+#include "timefields.h"
+
+class Ch10PacketIndex;
+class Ch10PacketSource;
 
 
 /**
@@ -34,6 +37,7 @@
 class Chapter10Reader : public QObject
 {
     Q_OBJECT
+    friend class TestChapter10Reader;
 
 public:
     explicit Chapter10Reader(QObject* parent = nullptr);
@@ -45,26 +49,52 @@ public:
     Chapter10Reader(Chapter10Reader&&) = delete;
     Chapter10Reader& operator=(Chapter10Reader&&) = delete;
 
-    /**
-     * @brief Opens a Chapter 10 file and synchronizes the time reference.
-     * @param[in] filename Path to the .ch10 file.
-     * @return true on success.
-     */
-    bool tryLoadingFile(const QString& filename);
-
-    /// Closes the currently open Chapter 10 file and frees the read buffer.
-    void closeFile() const;
-
     /// Resets channel lists and selection state.
     void clearSettings();
 
     /**
      * @brief Scans the file for TMATS metadata and catalogs all channels.
+     *
+     * Catalogs the packets listed by the file's Ch10PacketIndex sidecar,
+     * reading back only the first IRIG time packet and the TMATS packets.
+     * Without a valid sidecar the recording index packets written by the
+     * recorder are used if the file ends with a root index packet (see
+     * Ch10RecordingIndex); counts are then those of the indexed packets.
+     * Otherwise, or if that index is inconsistent or leaves out a time or PCM
+     * channel declared in TMATS, the packet headers are read once through a
+     * Ch10PacketSource, skipping every body, to build the index, which is
+     * saved for the next open. Packet counts are tallied in flat arrays
+     * indexed by channel ID; ChannelData entries are made once at the end.
+     * The first IRIG time packet sets the time reference used to convert the
+     * start and stop times, so no irig106 handle state is involved.
+     *
      * @param[in] filename Path to the .ch10 file.
      * @return true if channels were loaded successfully.
      */
     bool loadChannels(const QString& filename);
 
+    /**
+     * @brief Finds the start and stop times without cataloging the channels.
+     *
+     * Reads headers from the head of the file up to the first IRIG time
+     * packet, which sets the time reference and the start time, and searches
+     * backwards from the tail for the last time packet, which sets the stop
+     * time (Ch10PacketSource::previous()). The time accessors then return the
+     * same values loadChannels() would, after reading two ends of the file.
+     *
+     * @param[in] filename Path to the .ch10 file.
+     * @return true if both times were found.
+     */
+    bool loadTimeRange(const QString& filename);
+
+    /**
+     * @brief Takes over the channel catalog of @p other, typically loaded on a worker thread.
+     *
+     * Channels, TMATS metadata and the channel selection move here; the file
+     * times are kept, so a range shown from loadTimeRange() does not change.
+     */
+    void takeChannels(Chapter10Reader& other);
+
     /// Ensures a ChannelData entry exists for @p channel_id.
     void addChannelInfoEntry(int channel_id);
 
@@ -113,23 +143,25 @@ private:
     static QStringList buildChannelComboBoxList(const QList<ChannelData*>& channels);
     /// Returns the list index of @p channel_id, or -1 if not found.
     static int findChannelIndex(const QList<ChannelData*>& channels, int channel_id);
-    void processPacketTime(Irig106::SuI106Ch10Header& header, bool& found_start_time);
-    bool processTmatsPacket(Irig106::SuI106Ch10Header& header);
+    bool indexPackets(Ch10PacketSource& source, Ch10PacketIndex& index);
+    /// Rebuilds the channel map and time range from @p index. @return false if no time packet was found.
+    bool catalogPackets(Ch10PacketSource& source, const Ch10PacketIndex& index);
+    /// @return true if every time and PCM channel TMATS declares was cataloged.
+    bool tmatsChannelsCataloged() const;
+    void processPacketTime(uint8_t data_type, int64_t relative_time, bool& found_start_time);
+    bool processTmatsPacket(Irig106::SuI106Ch10Header& header, const uint8_t* data);
     void finalizeTimeCalc();
     void applyTmatsNames();
-    void inferChannelTypeFromHeader(int channel_id);
+    void inferChannelTypeFromHeader(int channel_id, uint8_t data_type);
     void categorizeChannels();
 
     Irig106::EnI106Status m_status;                             ///< Last irig106 API return status.
     QString m_filename;                                         ///< Path to the currently loaded file.
-    int m_file_handle;                                          ///< irig106 file handle.
-
-    Irig106::SuI106Ch10Header m_header;                         ///< Reusable packet header buffer.
-    QByteArray m_buffer;                                        ///< Packet data read buffer.
-    std::array<unsigned char, 6> m_relative_start_time;         ///< Relative time of first data packet.
-    std::array<unsigned char, 6> m_relative_stop_time;          ///< Relative time of last data packet.
-    tm m_file_start_time;                                       ///< Decoded calendar start time.
-    tm m_file_stop_time;                                        ///< Decoded calendar stop time.
+    Irig106::SuTimeRef m_time_ref;                              ///< Relative-to-IRIG time reference of the file.
+    int64_t m_relative_start_time;                              ///< Relative time of first data packet.
+    int64_t m_relative_stop_time;                               ///< Relative time of last data packet.
+    TimeFields m_file_start_time;                               ///< Decoded DOY/HH:MM:SS start time.
+    TimeFields m_file_stop_time;                                ///< Decoded DOY/HH:MM:SS stop time.
     bool m_times_loaded = false;                                ///< True if start/stop times have been decoded.
     uint64_t m_time_difference;                                 ///< Offset between DOY-based and IRIG absolute seconds.
     Irig106::SuIrig106Time m_irig_time;                         ///< Reusable IRIG time struct.
@@ -31,8 +31,19 @@ namespace PCMConstants {
     inline constexpr int kMaxChannelCount      = 0x10000; ///< Maximum channel ID range.
     inline constexpr const char* kDefaultFrameSync = "FE6B2840"; ///< Default frame sync hex pattern.
 
-    /// Time rounding offset (0.5 ms) used in writeTimeSample.
-    inline constexpr double kTimeRoundingOffset = 0.0005;
+    /// @name Time base
+    /// @{
+    /// 100 ns ticks per second (unit of IRIG 106 relative time and time fractions).
+    inline constexpr int64_t kTicksPerSecond = 10000000;
+    /// 100 ns ticks per millisecond.
+    inline constexpr int64_t kTicksPerMillisecond = 10000;
+    /// Time rounding offset (0.5 ms in ticks) used in writeTimeSample.
+    inline constexpr int64_t kTimeRoundingTicks = kTicksPerMillisecond / 2;
+    /// Sample rates are resolved to 1 / kSampleRateSteps Hz (1 mHz).
+    inline constexpr int64_t kSampleRateSteps = 1000;
+    /// Highest output sample rate; keeps the integer bin arithmetic within 64 bits.
+    inline constexpr double kMaxSampleRate = 100000.0;
+    /// @}
 
     /// Maximum raw 16-bit sample value for calibration math.
     inline constexpr uint16_t kMaxRawSampleValue = 0xFFFF;
@@ -49,6 +60,52 @@ namespace PCMConstants {
     /// Default number of PCM packets to scan during pre-scan encoding detection.
     inline constexpr int kPreScanMaxPackets = 5;
 
+    /// @name Parallel decoding
+    /// @{
+    /// Default minimum PCM payload per parallel decode chunk (32 MB); smaller files decode serially.
+    inline constexpr uint64_t kParallelChunkBytes = 32ULL * 1024 * 1024;
+    /// Chunks planned per worker thread so uneven chunks still balance.
+    inline constexpr int kParallelChunksPerThread = 4;
+    /// Minor frames decoded before each chunk to prime sync, lock and descrambler.
+    inline constexpr uint32_t kParallelLeadInFrames = 16;
+    /// @}
+
+    /// @name Read / decode / write pipeline
+    /// @{
+    /// Packet buffers circulating between the read and decode stages.
+    inline constexpr size_t kPipelinePacketSlots = 64;
+    /// Row batches circulating between the decode and write stages.
+    inline constexpr size_t kPipelineRowBatches = 8;
+    /// Formatted CSV bytes buffered before each write to the output file (4 MB).
+    inline constexpr size_t kCsvFlushBytes = 4ULL * 1024 * 1024;
+    /// @}
+
+    /// @name Prefetching packet source
+    /// @{
+    /// Default file block read per prefetch request (8 MB); blocks start at multiples of this size.
+    inline constexpr size_t kPrefetchBlockBytes = 8ULL * 1024 * 1024;
+    /// Smallest accepted block; one block must hold any packet header.
+    inline constexpr size_t kMinPrefetchBlockBytes = 64;
+    /// Blocks in flight between the prefetch thread and the parser (triple buffering).
+    inline constexpr size_t kPrefetchBlocks = 3;
+    /// @}
+
+    /// Suffix appended to a recording's file name for its packet index sidecar.
+    inline constexpr const char* kPacketIndexSuffix = ".idx";
+
+    /// Bytes searched before a file offset when looking for the packet that precedes it (64 KB); doubled until found.
+    inline constexpr int64_t kBackwardSearchBytes = 64 * 1024;
+
+    /// @name Time window seeking
+    /// @{
+    /// Seconds read before the window start (to form frame lock) and after its stop (for late packets).
+    inline constexpr uint64_t kWindowMarginSeconds = 2;
+    /// Byte range below which the search for a window edge in an unindexed file stops bisecting (1 MB).
+    inline constexpr int64_t kWindowSearchBytes = 1024 * 1024;
+    /// Windows closer than this are read in one pass rather than seeking between them (their margins meet).
+    inline constexpr uint64_t kWindowMergeGapSeconds = 2 * kWindowMarginSeconds;
+    /// @}
+
     /// @name Channel type identifiers from TMATS records
     /// @{
     inline constexpr const char* kChannelTypeTime = "TIMEIN"; ///< TMATS type for time channels.
@@ -101,7 +158,7 @@ namespace UIConstants {
     inline constexpr int kDefaultChannelsPerReceiver  = 3;     ///< Default channels per receiver (L, R, C).
     inline constexpr int kMinChannelsPerReceiver      = 1;     ///< Minimum valid channels per receiver.
     inline constexpr int kMaxChannelsPerReceiver      = 48;    ///< Maximum valid channels per receiver.
-    inline constexpr int kMaxTotalParameters          = 48;    ///< Maximum total parameter words (receivers x channels).
+    inline constexpr int kMaxTotalParameters          = 512;   ///< Maximum total parameter words (receivers x channels).
     inline constexpr std::array<const char*, 3> kChannelPrefixes = {"L", "R", "C"}; ///< Channel prefix labels.
     inline constexpr int kNumKnownPrefixes            = 3;     ///< Number of known channel prefixes.
 
@@ -152,6 +209,7 @@ namespace UIConstants {
     /// @{
     inline constexpr const char* kBatchOutputPrefix      = "AGC_";                       ///< Output filename prefix for batch mode.
     inline constexpr const char* kSettingsKeyLastBatchDir = "LastBatchOutputDirectory";   ///< QSettings key for last batch output directory.
+    inline constexpr int kBatchFilesPerDevice            = 2;                            ///< Default batch files read at once from one storage device.
     inline constexpr int kBatchFileListHeight            = 180;                          ///< Fixed height for file list tree (px).
     inline constexpr int kProgressBarMax                 = 100;                          ///< Maximum value for the progress bar.
     inline constexpr int kTreeIndentation                = 12;                           ///< Indentation width for tree widgets (px).
@@ -0,0 +1,78 @@
+/**
+ * @file csvrowwriter.h
+ * @brief Allocation-free CSV row formatting with large buffered writes.
+ */
+
+#ifndef CSVROWWRITER_H
+#define CSVROWWRITER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "constants.h"
+#include "irigtime.h"
+
+class QIODevice;
+
+/**
+ * @brief Formats averaged time-bin rows straight into a reusable byte buffer.
+ *
+ * Produces exactly the bytes of the original QString-based row builder:
+ * "DOY,HH:MM:SS.mmm" followed by one ",value" per column, where the time is
+ * rounded to the nearest millisecond and each value is sum / samples printed
+ * like QString::number(double) ('g', 6 significant digits). Numbers are
+ * written with std::to_chars, the "DOY,HH:MM:SS." prefix is rebuilt only when
+ * the second changes, and the buffer goes to the device in blocks of
+ * @c flush_bytes, so a row costs no heap allocation and no device call.
+ *
+ * The writer does not own the device. flush() (also run by the destructor)
+ * writes out the remaining bytes; call it before closing the device.
+ */
+class CsvRowWriter
+{
+public:
+    /**
+     * @param[in] output      Open device receiving the rows.
+     * @param[in] flush_bytes Buffered bytes that trigger a write to @p output.
+     */
+    explicit CsvRowWriter(QIODevice& output, size_t flush_bytes = PCMConstants::kCsvFlushBytes);
+    ~CsvRowWriter();
+
+    CsvRowWriter(const CsvRowWriter&) = delete;
+    CsvRowWriter& operator=(const CsvRowWriter&) = delete;
+    CsvRowWriter(CsvRowWriter&&) = delete;
+    CsvRowWriter& operator=(CsvRowWriter&&) = delete;
+
+    /**
+     * @brief Appends one row.
+     * @param[in] time_ticks Row time in 100 ns ticks since the Unix epoch.
+     * @param[in] sums       @p num_columns column sums.
+     * @param[in] num_columns Number of value columns.
+     * @param[in] n_samples  Frames summed into the row; each value is sum / n_samples.
+     */
+    void writeRow(int64_t time_ticks, const double* sums, size_t num_columns, int n_samples);
+
+    /// Writes the buffered bytes to the device. @return false if the device write failed.
+    bool flush();
+
+    uint64_t rowsWritten() const { return m_rows; }  ///< @return Rows appended so far.
+
+private:
+    /// Rebuilds m_prefix ("DOY,HH:MM:SS.") for @p whole_seconds since the epoch.
+    void cachePrefix(int64_t whole_seconds);
+
+    QIODevice& m_output;                 ///< Destination device.
+    size_t m_flush_bytes = 0;            ///< Flush threshold.
+    std::vector<char> m_buffer;          ///< Pending output (capacity kept between flushes).
+    size_t m_used = 0;                   ///< Bytes of m_buffer in use.
+    IrigTime::DayCache m_day;            ///< Calendar day of recent rows.
+    int64_t m_prefix_second = std::numeric_limits<int64_t>::min(); ///< Second m_prefix was built for.
+    std::array<char, 32> m_prefix = {};  ///< Cached "DOY,HH:MM:SS." of m_prefix_second.
+    size_t m_prefix_len = 0;             ///< Length of m_prefix.
+    uint64_t m_rows = 0;                 ///< Rows appended.
+};
+
+#endif // CSVROWWRITER_H
@@ -0,0 +1,71 @@
+/**
+ * @file extractionplan.h
+ * @brief Compiled list of the frame words an extraction run actually reads.
+ */
+
+#ifndef EXTRACTIONPLAN_H
+#define EXTRACTIONPLAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// @brief One output value read from every minor frame.
+struct ExtractionField {
+    uint32_t end_bit = 0;  ///< Offset of the word's last bit from the preceding sync bit.
+    uint32_t word = 0;     ///< Zero-based word index within the minor frame.
+    uint32_t column = 0;   ///< Destination column (index of the enabled parameter).
+    uint64_t mask = 0;     ///< Applied to the 64-bit window ending at end_bit; 0 reads as zero.
+};
+
+/**
+ * @brief Flat, offset-sorted array of the words to pull from each minor frame.
+ *
+ * Compiled once per run from the word index of every enabled parameter. The
+ * synchronizer reads only these words, directly from its packed bitstream, so
+ * the per-frame cost depends on the number of enabled parameters and not on
+ * the frame length. Values keep the original semantics: a word is the 64-bit
+ * window ending at its last bit ANDed with the common word mask, and the sync
+ * slot at index @c words_in_frame - 1 (never filled by the frame state
+ * machine) reads as zero.
+ */
+class ExtractionPlan
+{
+public:
+    ExtractionPlan() = default;
+
+    /**
+     * @brief Compiles a plan for a set of output columns.
+     * @param[in] column_words   Word index of each output column; columns outside
+     *                           [0, words_in_frame) are left out of the plan.
+     * @param[in] words_in_frame Words per minor frame (data words + 1).
+     * @param[in] word_len       Common data word length in bits.
+     * @param[in] word_mask      Mask applied to extracted data words.
+     */
+    static ExtractionPlan compile(const std::vector<int>& column_words, uint32_t words_in_frame,
+                                  uint32_t word_len, uint64_t word_mask);
+
+    /// @brief Plan reading every word slot of the frame in order (column i = word i).
+    static ExtractionPlan allWords(uint32_t words_in_frame, uint32_t word_len, uint64_t word_mask);
+
+    /**
+     * @brief Number of data words the frame state machine stores per frame.
+     *
+     * A zero word length still stores one word per bit, and a one-word frame
+     * stores its single slot only when the word is one bit long.
+     */
+    static uint32_t dataWordCount(uint32_t words_in_frame, uint32_t word_len);
+
+    size_t size() const { return m_fields.size(); }             ///< @return Number of fields.
+    bool isEmpty() const { return m_fields.empty(); }            ///< @return true if nothing is read.
+    const ExtractionField& field(size_t i) const { return m_fields[i]; } ///< @return Field @p i.
+    const ExtractionField* fields() const { return m_fields.data(); }   ///< @return Flat field array.
+
+    /// @return Largest end_bit in the plan (0 if empty).
+    uint32_t lastEndBit() const { return m_fields.empty() ? 0 : m_fields.back().end_bit; }
+
+private:
+    std::vector<ExtractionField> m_fields;  ///< Sorted by end_bit, then column.
+};
+
+#endif // EXTRACTIONPLAN_H
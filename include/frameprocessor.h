@@ -7,8 +7,10 @@
 #define FRAMEPROCESSOR_H
 
 #include <atomic>
+#include <memory>
+#include <vector>
 
-#include <QByteArray>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QObject>
 #include <QString>
@@ -18,10 +20,15 @@
 #include "i106_time.h"
 #include "i106_decode_tmats.h"
 
+#include "ch10packetindex.h"
+#include "ch10packetsource.h"
 #include "constants.h"
 #include "processingparams.h"
 
+class CsvRowWriter;
 class FrameSetup;
+class PcmPacketTable;
+class TimeBinAccumulator;
 struct ParameterInfo;
 
 /**
@@ -41,7 +48,8 @@ typedef struct SuChanInfo
  * @brief Extracts PCM minor frames from a Chapter 10 file and writes CSV output.
  *
  * Created fresh per processing run, moved to a worker thread, and auto-deleted
- * when the thread finishes. Owns its own irig106 file handle and buffers.
+ * when the thread finishes. Owns its own packet source (see Ch10PacketSource)
+ * and buffers.
  */
 class FrameProcessor : public QObject
 {
@@ -62,9 +70,34 @@ public:
     /**
      * @brief Extracts AGC samples from a Chapter 10 file and writes CSV output.
      *
-     * Iterates through all packets, decoding PCM minor frames on the selected
-     * channel and averaging samples at the requested rate. Emits
-     * progressUpdated() periodically and processingFinished() on completion.
+     * Iterates through the packets of the time window, decoding PCM minor
+     * frames on the selected channel and averaging samples at the requested
+     * rate. Reading starts from the time packet found by a bisection a
+     * margin before start_seconds and stops at the first time packet a
+     * margin past stop_seconds, so a short window of a long recording costs
+     * about the window's bytes. Emits progressUpdated() periodically (over
+     * the window) and processingFinished() on completion.
+     *
+     * With more than one decode thread (ProcessingParams::decode_threads) and
+     * a large enough file, the PCM packets are indexed by a header-only scan
+     * and decoded as packet-aligned chunks on a thread pool; the chunk results
+     * are merged in file order into output identical to the serial run.
+     *
+     * PCM channels listed in ProcessingParams::extra_pcm_channels are decoded
+     * in the same read of the file, each with its own frame layout, frame
+     * setup and CSV output; their packets are fanned out to one decoder per
+     * channel, so the file is read once regardless of the channel count.
+     *
+     * Each channel's extra_rates add CSV outputs at other sample rates. The
+     * frames are decoded and calibrated once and fed to one time-bin
+     * accumulator per rate, so a 1 Hz overview and a 100 Hz export of the
+     * same file cost a single decode.
+     *
+     * ProcessingParams::windows lists several windows, each written to its
+     * own CSV, in place of start_seconds, stop_seconds and outfile. Windows
+     * whose margins meet are read in one pass with one accumulator per
+     * window; the processor seeks from one pass to the next, so the bytes
+     * read are about those of the windows' union rather than one run each.
      *
      * @param[in] params      Validated processing parameters (file, channels, timing, etc.).
      * @param[in] frame_setup Frame parameter definitions (word map, calibration).
@@ -104,21 +137,157 @@ signals:
     void errorOccurred(const QString& message);
 
 private:
-    /// @brief Per-packet timing information for timestamp computation.
-    struct PacketTimeRef {
-        int64_t base_time;    ///< Packet header reference time (100ns units).
-        uint64_t start_bit;   ///< Starting bit position in combined buffer.
-        uint64_t num_bits;    ///< Number of data bits from this packet.
+    struct ChannelRun;
+    using ChannelRuns = std::vector<std::unique_ptr<ChannelRun>>;
+
+    /// @brief Span of file time read in one pass: one or more windows whose margins meet.
+    struct WindowPass {
+        uint64_t start_seconds = 0;  ///< Start of the first window (IRIG seconds).
+        uint64_t stop_seconds = 0;   ///< Latest end of its windows (IRIG seconds).
+        int windows = 0;             ///< Number of windows read in the pass.
     };
 
     /// @name File I/O helpers
     /// @{
-    bool openFile(const QString& filename);
-    void closeFile() const;
+    /**
+     * @brief Opens @p filename through a packet source and sets the time reference.
+     *
+     * Also loads the file's sidecar index, if a valid one exists.
+     * @param[in] backend     Packet source backend (see Ch10PacketSource::open()).
+     * @param[in] block_bytes Block size of the Prefetched backend.
+     */
+    bool openFile(const QString& filename, Ch10PacketSource::Backend backend = Ch10PacketSource::Backend::Mapped,
+                  size_t block_bytes = PCMConstants::kPrefetchBlockBytes);
+    void closeFile();
+
+    /**
+     * @brief Restricts m_source to the packets passing @p filter, if the file has a sidecar index.
+     *
+     * Without an index m_source is left as is and the caller's own header
+     * checks skip the other packets.
+     */
+    void selectIndexedPackets(const Ch10PacketIndex::PacketFilter& filter);
+
+    /// Logs the bytes m_source has read since openFile() and the MB/s achieved.
+    void logReadThroughput();
+
+    /**
+     * @brief Sets m_time_ref from the first IRIG time packet, then rewinds.
+     *
+     * Equivalent to enI106_SyncTime(), but keeps the reference in this object
+     * so decoders can convert times without the handle's shared state.
+     */
+    bool syncTimeReference();
+
+    /**
+     * @brief Reads the current time packet and makes it the time reference.
+     * @param[in,out] prev_time_ticks    Previous time packet in 100 ns ticks (gap detection; < 0 if none).
+     * @param[in,out] time_gaps_detected Incremented when a gap is reported.
+     * @return false on a read error (already reported).
+     */
+    bool readTimePacket(int64_t& prev_time_ticks, int& time_gaps_detected);
+
+    /// Emits progressUpdated() / percentage log lines for file @p position within the pass's byte range.
+    void reportProgress(int64_t position, int& last_reported_percent);
+    /// @}
+
+    /// @name Time window seeking
+    /// @{
+    /**
+     * @brief Moves m_source to the time window of @p params and sets the progress byte range.
+     *
+     * Positions the source on the last time packet stamped at least
+     * kWindowMarginSeconds before start_seconds, so the packets before it are
+     * never read, and estimates where the window ends for progress. The
+     * search runs on a second, sparsely read source, so a prefetching
+     * m_source only restarts once, at the window. Assumes time runs forward
+     * through the file; a run starting at the file start reads from where it is.
+     */
+    void seekToWindow(const ProcessingParams& params);
+
+    /**
+     * @brief Finds the last time packet of @p time_channel_id stamped at or before @p seconds.
+     *
+     * Bisects the time packets listed by @p index when it is not empty,
+     * reading one packet per step; otherwise bisects the bytes from @p from
+     * to the end of the file, probing the first time packet after each
+     * midpoint, down to kWindowSearchBytes, and walks the rest. This replaces
+     * enI106Ch10SetPosToIrigTime(), which needs the library's in-memory index
+     * and a handle.
+     *
+     * @param[in] source Source of the file; its position is changed.
+     * @param[in] index  Sidecar index of the file, or an empty index.
+     * @return Offset of the packet, or -1 if none after @p from is that early.
+     */
+    static int64_t findTimePacket(Ch10PacketSource& source, const Ch10PacketIndex& index,
+                                  int time_channel_id, uint64_t seconds, int64_t from);
+
+    /**
+     * @brief Finds the first time packet of @p time_channel_id in [@p from, @p to) and decodes its time.
+     * @param[out] offset  Offset of the packet.
+     * @param[out] seconds IRIG seconds of the packet.
+     * @return false if there is none or it cannot be read.
+     */
+    static bool probeTimePacket(Ch10PacketSource& source, int time_channel_id, int64_t from, int64_t to,
+                                int64_t& offset, uint64_t& seconds);
+
+    /// @return true if the time packet just read is past stop_seconds plus kWindowMarginSeconds.
+    bool pastWindow(const ProcessingParams& params) const;
+
+    /**
+     * @brief Groups @p windows (in start order) into passes over the file.
+     *
+     * A window starting within kWindowMergeGapSeconds of the latest stop of
+     * the current pass joins it: the file between them is read anyway for
+     * the margins, so streaming through costs less than seeking.
+     */
+    static std::vector<WindowPass> planWindowPasses(const QVector<TimeWindow>& windows);
     /// @}
 
-    /// Grows m_buffer to at least @p required bytes. Returns false on allocation failure.
-    bool ensureBufferCapacity(qsizetype required);
+    /// @name Decode paths
+    /// @{
+    /**
+     * @brief Reads, decodes and writes the remaining packets as overlapped stages.
+     *
+     * This thread reads packets into recycled buffers and hands each one to
+     * the channels it belongs to; per channel, one pool thread decodes them
+     * into the run's bins and another formats and writes the closed rows. The
+     * stages are linked by bounded SpscRing queues, so a slow stage holds back
+     * the ones before it instead of growing memory. Queue occupancy and wait
+     * counts are logged at the end of the run.
+     *
+     * @return false if the run was aborted.
+     */
+    bool decodePipelined(const ProcessingParams& params, ChannelRuns& runs,
+                         int& time_gaps_detected);
+
+    /**
+     * @brief Indexes the remaining time packets and every run's PCM packets from their headers.
+     * @param[out] tables One packet table per entry of @p runs.
+     * @return false if the run was aborted.
+     */
+    bool scanPcmPackets(const ProcessingParams& params, const ChannelRuns& runs,
+                        std::vector<PcmPacketTable>& tables, int& time_gaps_detected);
+
+    /**
+     * @brief Indexes all channels in one header scan, then decodes each in parallel chunks.
+     * @return false if the run was aborted.
+     */
+    bool decodeParallel(const ProcessingParams& params, ChannelRuns& runs,
+                        int threads, int& time_gaps_detected);
+
+    /**
+     * @brief Decodes one channel's packet chunks on @p threads workers and merges them in order.
+     * @param[in]     progress_base  Payload bytes of the channels already decoded.
+     * @param[in]     progress_total Payload bytes of all channels.
+     * @param[in,out] last_reported_percent Progress state for reportProgress().
+     * @return false if the run was aborted.
+     */
+    bool decodeChannelChunks(const ProcessingParams& params, ChannelRun& run,
+                             const PcmPacketTable& table, int threads,
+                             uint64_t progress_base, uint64_t progress_total,
+                             int& last_reported_percent);
+    /// @}
 
     /// @name irig106 C helper wrappers
     /// @{
@@ -142,7 +311,7 @@ private:
     /// @name PCM bit-level helpers
     /// @{
     /**
-     * @brief Applies IRIG 106 Appendix D self-synchronizing descrambler.
+     * @brief Applies IRIG 106 Appendix D self-synchronizing descrambler (see RnrzlDecoder).
      * @param[in,out] data       Raw byte buffer to derandomize in-place.
      * @param[in]     total_bits Number of valid bits in the buffer.
      * @param[in,out] lfsr       15-bit LFSR state carried across packets.
@@ -165,24 +334,42 @@ private:
 
     /**
      * @brief Writes one averaged time sample row to the CSV output.
+     *
+     * Formats through a temporary CsvRowWriter; processing runs keep one
+     * writer per output instead so rows are written in large blocks.
+     *
      * @param[in,out] output              Output file stream.
-     * @param[in]     current_time_sample Time value for this sample row.
+     * @param[in]     current_time_ticks  Row time in 100 ns ticks since the epoch.
      * @param[in]     n_samples           Number of raw samples to average.
      * @param[in]     enabled_params      Parameter definitions for column output.
      */
     static void writeTimeSample(QFile& output,
-                                double current_time_sample,
+                                int64_t current_time_ticks,
                                 int n_samples,
                                 const QVector<ParameterInfo*>& enabled_params);
 
+    /**
+     * @brief Writes and clears the closed bins of @p bins.
+     * @param[in,out] writer Row writer of the output.
+     * @param[in,out] bins   Accumulator whose closed bins are written.
+     */
+    static void writeClosedBins(CsvRowWriter& writer, TimeBinAccumulator& bins);
+
     Irig106::EnI106Status m_status;                             ///< Last irig106 API return status.
-    int m_file_handle;                                          ///< irig106 file handle.
-    Irig106::SuI106Ch10Header m_header;                         ///< Reusable packet header buffer.
-    QByteArray m_buffer;                                        ///< Packet data read buffer.
+    std::unique_ptr<Ch10PacketSource> m_source;                 ///< Input file packets (while open).
+    Ch10Packet m_packet;                                        ///< Current packet of m_source.
+    QElapsedTimer m_source_timer;                               ///< Started when m_source is opened.
+    uint64_t m_worker_read_bytes = 0;                           ///< Payload bytes read by parallel decode workers.
+    Ch10PacketIndex m_packet_index;                             ///< Sidecar index of the open file (empty if none).
     Irig106::SuTmatsInfo m_tmats_info;                          ///< Parsed TMATS metadata.
     QVector<SuChanInfo*> m_channel_info;                        ///< Per-channel attribute table.
     Irig106::SuIrig106Time m_irig_time;                         ///< Reusable IRIG time struct.
+    Irig106::SuTimeRef m_time_ref;                              ///< Current relative-to-IRIG time reference.
     int64_t m_total_file_size;                                  ///< Input file size in bytes (for progress).
+    int64_t m_progress_begin = 0;                               ///< File offset where the window's packets start (for progress).
+    int64_t m_progress_end = 0;                                 ///< Estimated file offset where they end (for progress).
+    int m_pass = 0;                                             ///< Index of the window pass being read (for progress).
+    int m_pass_count = 1;                                       ///< Number of window passes of the run (for progress).
     std::atomic<bool> m_abort_requested;                         ///< Thread-safe abort flag.
 };
 
@@ -0,0 +1,133 @@
+/**
+ * @file irigtime.h
+ * @brief Thread-safe, allocation-free conversion of IRIG/epoch seconds to DOY/HH:MM:SS.
+ */
+
+#ifndef IRIGTIME_H
+#define IRIGTIME_H
+
+#include <cstdint>
+#include <limits>
+
+#include "timefields.h"
+
+/**
+ * @brief UTC calendar arithmetic for IRIG times, without gmtime() or the TZ environment.
+ *
+ * IRIG time packets decode to seconds since 1970-01-01 UTC (the year defaults
+ * to 1970/1971 when the packet carries none). The functions below convert
+ * such a count with integer civil-from-days arithmetic (proleptic Gregorian
+ * calendar, valid for negative counts too), so they are constexpr, reentrant
+ * and independent of the process time zone.
+ */
+namespace IrigTime
+{
+    inline constexpr int64_t kSecondsPerMinute = 60;
+    inline constexpr int64_t kSecondsPerHour = 3600;
+    inline constexpr int64_t kSecondsPerDay = 86400;
+    inline constexpr int64_t kDaysPerEra = 146097;      ///< Days per 400-year Gregorian cycle.
+    inline constexpr int64_t kYearsPerEra = 400;
+    inline constexpr int64_t kEpochShiftDays = 719468;  ///< Days from 0000-03-01 to 1970-01-01.
+
+    /// @brief Gregorian calendar date.
+    struct CivilDate {
+        int64_t year = 1970;  ///< Year.
+        int month = 1;        ///< Month (1-12).
+        int day = 1;          ///< Day of month (1-31).
+    };
+
+    /// @return @p a / @p b rounded towards negative infinity (@p b > 0).
+    constexpr int64_t floorDiv(int64_t a, int64_t b)
+    {
+        return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+    }
+
+    /// @return Days from 1970-01-01 to @p year-@p month-@p day.
+    constexpr int64_t daysFromCivil(int64_t year, int month, int day)
+    {
+        // Years start in March so the leap day is the last day of the year
+        const int64_t y = year - ((month <= 2) ? 1 : 0);
+        const int64_t era = floorDiv(y, kYearsPerEra);
+        const int64_t year_of_era = y - (era * kYearsPerEra);                       // [0, 399]
+        const int64_t shifted_month = (month > 2) ? (month - 3) : (month + 9);      // [0, 11]
+        const int64_t day_of_year = (((153 * shifted_month) + 2) / 5) + day - 1;    // [0, 365]
+        const int64_t day_of_era = (year_of_era * 365) + (year_of_era / 4) - (year_of_era / 100) + day_of_year;
+        return (era * kDaysPerEra) + day_of_era - kEpochShiftDays;
+    }
+
+    /// @return Calendar date @p days after 1970-01-01.
+    constexpr CivilDate civilFromDays(int64_t days)
+    {
+        const int64_t z = days + kEpochShiftDays;
+        const int64_t era = floorDiv(z, kDaysPerEra);
+        const int64_t day_of_era = z - (era * kDaysPerEra);                                        // [0, 146096]
+        const int64_t year_of_era = (day_of_era - (day_of_era / 1460) + (day_of_era / 36524) -
+                                     (day_of_era / 146096)) / 365;                                 // [0, 399]
+        const int64_t day_of_year = day_of_era - ((365 * year_of_era) + (year_of_era / 4) - (year_of_era / 100));
+        const int64_t shifted_month = ((5 * day_of_year) + 2) / 153;                               // [0, 11]
+        CivilDate date;
+        date.day = static_cast<int>(day_of_year - (((153 * shifted_month) + 2) / 5) + 1);
+        date.month = static_cast<int>((shifted_month < 10) ? (shifted_month + 3) : (shifted_month - 9));
+        date.year = year_of_era + (era * kYearsPerEra) + ((date.month <= 2) ? 1 : 0);
+        return date;
+    }
+
+    /// @return Day of year (1-366) of the day @p days after 1970-01-01.
+    constexpr int dayOfYear(int64_t days)
+    {
+        return static_cast<int>(days - daysFromCivil(civilFromDays(days).year, 1, 1)) + 1;
+    }
+
+    /// @return DOY/HH:MM:SS of @p seconds since 1970-01-01 UTC.
+    constexpr TimeFields toTimeFields(int64_t seconds)
+    {
+        const int64_t days = floorDiv(seconds, kSecondsPerDay);
+        const int64_t second_of_day = seconds - (days * kSecondsPerDay);
+        TimeFields fields;
+        fields.ddd = dayOfYear(days);
+        fields.hh = static_cast<int>(second_of_day / kSecondsPerHour);
+        fields.mm = static_cast<int>((second_of_day % kSecondsPerHour) / kSecondsPerMinute);
+        fields.ss = static_cast<int>(second_of_day % kSecondsPerMinute);
+        return fields;
+    }
+
+    /**
+     * @brief toTimeFields() with the current day cached.
+     *
+     * Output rows advance through a recording in time order, so consecutive
+     * conversions nearly always fall on the same day; those cost one
+     * subtraction and two divisions. The calendar is only consulted when a
+     * time leaves the cached day. One instance per thread.
+     */
+    class DayCache
+    {
+    public:
+        /// @return DOY/HH:MM:SS of @p seconds since 1970-01-01 UTC.
+        TimeFields fields(int64_t seconds)
+        {
+            int64_t second_of_day = (m_day_start == kNoDay) ? -1 : (seconds - m_day_start);
+            if (second_of_day < 0 || second_of_day >= kSecondsPerDay)
+            {
+                const int64_t days = floorDiv(seconds, kSecondsPerDay);
+                m_day_start = days * kSecondsPerDay;
+                m_day_of_year = dayOfYear(days);
+                second_of_day = seconds - m_day_start;
+            }
+
+            TimeFields fields;
+            fields.ddd = m_day_of_year;
+            fields.hh = static_cast<int>(second_of_day / kSecondsPerHour);
+            fields.mm = static_cast<int>((second_of_day % kSecondsPerHour) / kSecondsPerMinute);
+            fields.ss = static_cast<int>(second_of_day % kSecondsPerMinute);
+            return fields;
+        }
+
+    private:
+        static constexpr int64_t kNoDay = std::numeric_limits<int64_t>::min();
+
+        int64_t m_day_start = kNoDay;  ///< First second of the cached day.
+        int m_day_of_year = 0;         ///< Day of year of the cached day.
+    };
+}
+
+#endif // IRIGTIME_H
@@ -81,6 +81,8 @@ private slots:
     void onProcessingFinished(bool success, const QString& output_file);
     /// Appends a message to the log window.
     void onLogMessage(const QString& message);
+    /// Fills in the status and channel rows of a batch file read by intake.
+    void onBatchFileLoaded(int file_index);
     /// @}
 
 protected:
@@ -111,6 +113,7 @@ private:
     void populateBatchFileList();                         ///< Populates the file list tree in batch mode.
     void populateSingleFileList();                        ///< Populates the file list tree in single-file mode.
     static void applyBatchFileStatus(QTreeWidgetItem* item, const BatchFileInfo& info); ///< Sets status text/color on a batch file tree item.
+    QTreeWidgetItem* batchFileItem(int file_index) const;  ///< @return Tree item of batch file @p file_index, or nullptr if not listed.
     void saveLastBatchOutputDir();                        ///< Persists m_last_batch_output_dir to QSettings.
     void onShowPlot(const QString& csv_filepath);         ///< Loads CSV into plot and shows the plot dock.
     /// @}
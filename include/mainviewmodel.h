@@ -6,6 +6,9 @@
 #ifndef MAINVIEWMODEL_H
 #define MAINVIEWMODEL_H
 
+#include <memory>
+
+#include <QFutureWatcher>
 #include <QObject>
 #include <QSettings>
 #include <QString>
@@ -22,6 +25,31 @@ class FrameSetup;
 class ProcessingCoordinator;
 class SettingsManager;
 
+/**
+ * @brief Channel catalog of one file, built off the GUI thread.
+ *
+ * Returned by MainViewModel::loadChannelCatalog() and carried across the
+ * thread boundary by QFutureWatcher.
+ */
+struct ChannelCatalogResult
+{
+    QString filename;                         ///< File that was cataloged.
+    std::shared_ptr<Chapter10Reader> reader;  ///< Reader holding the catalog, or nullptr on failure.
+    QString error;                            ///< Error reported by the reader, if any.
+};
+
+/**
+ * @brief Intake result of one batch file, built off the GUI thread.
+ *
+ * Returned by MainViewModel::loadBatchFile() and streamed into the batch
+ * list by QFutureWatcher as each file completes.
+ */
+struct BatchIntakeResult
+{
+    BatchFileInfo info;  ///< File entry with channels, resolved channels and pre-scan result.
+    QStringList   log;   ///< Log lines of the load and pre-scan, emitted on the GUI thread.
+};
+
 /**
  * @brief Mediates between the View (MainView) and Model layer.
  *
@@ -39,6 +67,7 @@ class MainViewModel : public QObject
     Q_PROPERTY(int timeChannelIndex READ timeChannelIndex WRITE setTimeChannelIndex NOTIFY timeChannelIndexChanged)
     Q_PROPERTY(int pcmChannelIndex READ pcmChannelIndex WRITE setPcmChannelIndex NOTIFY pcmChannelIndexChanged)
     Q_PROPERTY(bool fileLoaded READ fileLoaded NOTIFY fileLoadedChanged)
+    Q_PROPERTY(bool channelsLoading READ channelsLoading NOTIFY channelsLoadingChanged)
     Q_PROPERTY(int progressPercent READ progressPercent NOTIFY progressPercentChanged)
     Q_PROPERTY(bool processing READ processing NOTIFY processingChanged)
     Q_PROPERTY(bool controlsEnabled READ controlsEnabled NOTIFY controlsEnabledChanged)
@@ -63,6 +92,7 @@ class MainViewModel : public QObject
 
     Q_PROPERTY(bool batchMode READ batchMode NOTIFY batchModeChanged)
     Q_PROPERTY(int batchFileCount READ batchFileCount NOTIFY batchFilesChanged)
+    Q_PROPERTY(bool batchLoading READ batchLoading NOTIFY batchLoadingChanged)
 
 public:
     explicit MainViewModel(QObject* parent = nullptr);
@@ -81,6 +111,8 @@ public:
     int timeChannelIndex() const;                ///< @return Currently selected time channel index.
     int pcmChannelIndex() const;                 ///< @return Currently selected PCM channel index.
     bool fileLoaded() const;                     ///< @return True if a .ch10 file is loaded.
+    /// @return True while the channels of a file whose times are known are being cataloged.
+    bool channelsLoading() const;
     int progressPercent() const;                 ///< @return Current processing progress (0--100).
     bool processing() const;                     ///< @return True while background processing is active.
     bool controlsEnabled() const;                ///< @return True when UI controls should be interactive.
@@ -123,6 +155,7 @@ public:
     /// @{
     bool batchMode() const;                              ///< @return True when multiple files are loaded.
     int batchFileCount() const;                          ///< @return Total number of files in the batch.
+    bool batchLoading() const;                           ///< @return True while openFiles() intake is running.
     int batchValidCount() const;                         ///< @return Number of valid (non-skipped) files.
     int batchSkippedCount() const;                       ///< @return Number of skipped files.
     const QVector<BatchFileInfo>& batchFiles() const;    ///< @return Read-only access to the batch file list.
@@ -197,9 +230,23 @@ public:
 
     /// Logs startup configuration to the log window.
     void logStartupInfo();
-    /// Opens a .ch10 file and populates channel lists.
+    /**
+     * @brief Opens a .ch10 file and populates channel lists.
+     *
+     * The time range is read from the head and tail of the file and published
+     * at once (fileTimesChanged() while channelsLoading()); the channels are
+     * cataloged on a worker thread, after which the file counts as loaded.
+     */
     void openFile(const QString& filename);
-    /// Opens multiple .ch10 files for batch processing.
+    /**
+     * @brief Opens multiple .ch10 files for batch processing.
+     *
+     * The files are listed at once; each is cataloged and pre-scanned on the
+     * thread pool (both back to back, while its pages are cached) and its
+     * entry is filled in as it completes (batchFileLoaded(),
+     * batchLoadProgress()). The batch counts as loaded when every file has
+     * been read or the intake was cancelled with cancelProcessing().
+     */
     void openFiles(const QStringList& filenames);
 
     /// Sets the resolved PCM channel index for a batch file.
@@ -238,7 +285,7 @@ public:
 
     /// Resets all state to defaults and closes the loaded file.
     void clearState();
-    /// Requests cancellation of the current processing run.
+    /// Requests cancellation of the current processing run, or of the batch intake while it runs.
     void cancelProcessing();
 
 #ifdef QT_TESTLIB_LIB
@@ -252,6 +299,7 @@ signals:
     void timeChannelIndexChanged();   ///< Emitted when the selected time channel changes.
     void pcmChannelIndexChanged();    ///< Emitted when the selected PCM channel changes.
     void fileLoadedChanged();         ///< Emitted when the file-loaded state changes.
+    void channelsLoadingChanged();    ///< Emitted when channel cataloging starts or ends.
     void progressPercentChanged();    ///< Emitted when the processing progress updates.
     void processingChanged();         ///< Emitted when processing starts or stops.
     void controlsEnabledChanged();    ///< Emitted when the controls-enabled state changes.
@@ -271,6 +319,14 @@ signals:
     void batchFileUpdated(int fileIndex);
     /// Emitted when processing moves to the next file in a batch.
     void batchFileProcessing(int file_index, int total);
+    /// Emitted when batch intake starts or ends.
+    void batchLoadingChanged();
+    /// Emitted when intake has read batch file @p fileIndex and filled in its channels.
+    void batchFileLoaded(int fileIndex);
+    /// Emitted as batch intake completes files: @p loaded of @p total files read.
+    void batchLoadProgress(int loaded, int total);
+    /// Emitted as a batch start pre-scans files again: @p scanned of @p total files.
+    void batchPreScanProgress(int scanned, int total);
 
     /// Emitted when the recent files list changes.
     void recentFilesChanged();
@@ -288,8 +344,25 @@ private:
                                    const QString& stop_time,
                                    int sample_rate_index);
 
-    /// Validates all batch files against current channel/settings selection.
-    void validateBatchFiles();
+    /// Resolves a loaded batch file to its first PCM/time channel and sets its skip state.
+    static void resolveBatchFileChannels(BatchFileInfo& info);
+
+    /// Catalogs and pre-scans one batch file with a reader of its own — safe to run on any thread.
+    static BatchIntakeResult loadBatchFile(const QString& filepath, const ProcessingParams& scan_params,
+                                           bool pre_scan);
+    /// Moves the intake result at @p index into the batch list.
+    void onBatchFileLoaded(int index);
+    /// Completes openFiles() once every file is read or the intake is cancelled.
+    void onBatchIntakeFinished();
+    /// Sets the batch-loading flag and emits batchLoadingChanged() if it changed.
+    void setBatchLoading(bool loading);
+
+    /// Catalogs the channels of @p filename with a reader of its own — safe to run on any thread.
+    static ChannelCatalogResult loadChannelCatalog(const QString& filename);
+    /// Takes the finished catalog into m_reader and completes openFile().
+    void onChannelCatalogFinished();
+    /// Sets the channels-loading flag and emits channelsLoadingChanged() if it changed.
+    void setChannelsLoading(bool loading);
 
     Chapter10Reader*        m_reader;       ///< Chapter 10 file reader instance.
     FrameSetup*             m_frame_setup;  ///< Frame parameter definitions.
@@ -301,6 +374,11 @@ private:
     QString m_last_output_file;              ///< Path to the last generated CSV file.
     QString m_last_ini_dir;                  ///< Last directory used in INI file dialogs.
     bool m_file_loaded;                      ///< True when a .ch10 file is loaded.
+    bool m_channels_loading = false;         ///< True while openFile() catalogs channels in the background.
+    QFutureWatcher<ChannelCatalogResult>* m_catalog_watcher = nullptr; ///< Watcher for the catalog future.
+    QFutureWatcher<BatchIntakeResult>* m_intake_watcher = nullptr;      ///< Watcher for the batch intake.
+    bool m_batch_loading = false;            ///< True while openFiles() intake runs in the background.
+    int m_batch_loaded_count = 0;            ///< Files of the current intake read so far.
 
     int m_time_channel_index;                ///< Selected time channel combo box index.
     int m_pcm_channel_index;                 ///< Selected PCM channel combo box index.
@@ -0,0 +1,141 @@
+/**
+ * @file pcmframedecoder.h
+ * @brief Turns raw PCM packets into timestamped, calibrated frame samples.
+ */
+
+#ifndef PCMFRAMEDECODER_H
+#define PCMFRAMEDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "irig106ch10.h"
+#include "i106_time.h"
+
+#include "extractionplan.h"
+#include "pcmframesync.h"
+#include "timebinaccumulator.h"
+
+/// @brief Everything needed to build identical decoders and accumulators for one run.
+struct PcmDecodeSetup {
+    PcmFrameSyncConfig sync;                       ///< Frame layout and sync parameters.
+    SyncEngine engine = SyncEngine::WordParallel;  ///< Synchronizer implementation.
+    ExtractionPlan plan;                           ///< Words to extract (one field per value).
+    std::vector<double> slopes;                    ///< Calibration slope of each plan field.
+    std::vector<double> scales;                    ///< Calibration offset of each plan field.
+    double delta_100ns = 0;                        ///< PCM bit period in 100 ns units.
+    uint64_t start_seconds = 0;                    ///< Start of the extraction window (IRIG seconds).
+    uint64_t stop_seconds = 0;                     ///< End of the extraction window (IRIG seconds).
+    std::vector<double> sample_rates{1.0};         ///< Output rows per second, one accumulator each.
+    /// Window of each accumulator (IRIG seconds); empty for start/stop_seconds throughout.
+    std::vector<std::pair<uint64_t, uint64_t>> windows;
+    size_t num_columns = 0;                        ///< Output columns (enabled parameters).
+
+    /// @return Empty accumulator for the plan columns, rate and window of entry @p rate_index.
+    TimeBinAccumulator makeAccumulator(size_t rate_index = 0) const;
+
+    /// @return One empty accumulator per entry of @c sample_rates.
+    std::vector<TimeBinAccumulator> makeAccumulators() const;
+};
+
+/// @brief Decode counters, summed over chunks for the end-of-run summary.
+struct PcmDecodeCounters {
+    uint64_t bytes = 0;         ///< Payload bytes decoded.
+    uint64_t frames = 0;        ///< Frames inside the extraction window.
+    uint64_t syncs = 0;         ///< Sync patterns found.
+    uint64_t locks = 0;         ///< Transitions into frame lock.
+    uint64_t unlocks = 0;       ///< Losses of frame lock.
+    uint64_t missed_syncs = 0;  ///< Predicted syncs not found in lock.
+
+    PcmDecodeCounters& operator+=(const PcmDecodeCounters& other);       ///< Adds @p other.
+    PcmDecodeCounters operator-(const PcmDecodeCounters& other) const;   ///< @return Difference.
+};
+
+/**
+ * @brief Frame sync, timestamping and calibration for one PCM channel.
+ *
+ * Each packet goes through the PcmFrameSynchronizer; every frame it completes
+ * is timestamped by interpolating from the packet header time (bit offset
+ * times the PCM bit period, falling back to the previous packet's reference
+ * for frames that started there), converted to IRIG time in 100 ns ticks by
+ * adding the current time reference's offset (computed once per time packet,
+ * exactly as enI106_RelInt2IrigTime2() would per frame) and, inside the
+ * extraction window, calibrated and added to
+ * the caller's TimeBinAccumulator. Several accumulators (one per output rate
+ * or window) can share one decode: each frame is synchronized and calibrated
+ * once, and skipped when it lies outside every accumulator's window.
+ *
+ * The decoder owns no file state, so the serial reader, parallel chunk
+ * workers and the merge step all share the same per-frame arithmetic.
+ */
+class PcmFrameDecoder
+{
+public:
+    explicit PcmFrameDecoder(const PcmDecodeSetup& setup);
+
+    /**
+     * @brief Starts a new stream.
+     * @param[in] stream_bit Global bit index of the first packet's first bit.
+     */
+    void reset(uint64_t stream_bit = 0);
+
+    /// Sets the relative-to-IRIG time reference used for the following packets.
+    void setTimeReference(const Irig106::SuTimeRef& time_ref);
+
+    /**
+     * @brief Decodes one packet and accumulates its frames.
+     * @param[in]     payload     Raw PCM payload (after the channel-specific data word).
+     * @param[in]     num_bytes   Payload length in bytes.
+     * @param[in]     packet_time Packet header relative time (100 ns units).
+     * @param[in,out] bins        Accumulator receiving frames inside its window.
+     */
+    void processPacket(const uint8_t* payload, size_t num_bytes, int64_t packet_time,
+                       TimeBinAccumulator& bins);
+
+    /**
+     * @brief Decodes one packet and adds each frame to every accumulator.
+     * @param[in]     payload     Raw PCM payload (after the channel-specific data word).
+     * @param[in]     num_bytes   Payload length in bytes.
+     * @param[in]     packet_time Packet header relative time (100 ns units).
+     * @param[in,out] bins        Accumulators, each taking the frames inside its own window.
+     */
+    void processPacket(const uint8_t* payload, size_t num_bytes, int64_t packet_time,
+                       std::vector<TimeBinAccumulator>& bins);
+
+    PcmFrameSynchronizer& synchronizer() { return m_sync; }                    ///< @return Synchronizer.
+    const PcmFrameSynchronizer& synchronizer() const { return m_sync; }        ///< @return Synchronizer.
+    uint64_t framesExtracted() const { return m_frames_extracted; }            ///< @return Frames inside the window.
+    uint64_t bytesProcessed() const { return m_bytes_processed; }              ///< @return Payload bytes decoded.
+
+    /// @return Counters since the last reset().
+    PcmDecodeCounters counters() const;
+
+private:
+    /// @brief Per-packet timing information for timestamp computation.
+    struct PacketTimeRef {
+        int64_t base_time = 0;   ///< Packet header reference time (100ns units).
+        uint64_t start_bit = 0;  ///< Starting bit position in combined stream.
+        uint64_t num_bits = 0;   ///< Number of data bits from this packet.
+    };
+
+    void decodePacket(const uint8_t* payload, size_t num_bytes, int64_t packet_time,
+                      TimeBinAccumulator* bins, size_t num_bins);
+
+    PcmFrameSynchronizer m_sync;             ///< Frame sync and word extraction.
+    std::vector<double> m_slopes;            ///< Calibration slope per plan field.
+    std::vector<double> m_scales;            ///< Calibration offset per plan field.
+    double m_delta_100ns = 0;                ///< PCM bit period (100 ns units).
+    int64_t m_irig_offset = 0;               ///< IRIG ticks minus relative ticks of the time reference.
+
+    PacketTimeRef m_current_ref;             ///< Packet being decoded.
+    PacketTimeRef m_previous_ref;            ///< Packet before it (frames spanning both).
+    bool m_has_time_ref = false;             ///< True once a packet has been decoded.
+    uint64_t m_bit_offset = 0;               ///< Global bit index of the next packet.
+    uint64_t m_frames_extracted = 0;         ///< Frames added to an accumulator.
+    uint64_t m_bytes_processed = 0;          ///< Payload bytes decoded.
+    std::vector<double> m_values;            ///< Scaled values of the current frame.
+};
+
+#endif // PCMFRAMEDECODER_H
@@ -0,0 +1,267 @@
+/**
+ * @file pcmframesync.h
+ * @brief PCM minor-frame synchronizer and word extractor for raw PCM packet payloads.
+ */
+
+#ifndef PCMFRAMESYNC_H
+#define PCMFRAMESYNC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "extractionplan.h"
+#include "synccorrelator.h"
+
+/// @brief Selects the frame synchronizer implementation used by FrameProcessor.
+enum class SyncEngine {
+    BitSerial,    ///< Original per-bit state machine (reference implementation).
+    WordParallel  ///< 64-bit word-at-a-time sync search and shift-based word extraction.
+};
+
+/// @brief Frame synchronizer state (search / check / lock).
+enum class FrameLockState {
+    Search,  ///< No candidate sync; every bit is tested.
+    Check,   ///< Candidate sync seen; every bit is tested until syncs repeat at frame spacing.
+    Lock     ///< Flywheel: only the predicted sync position of each frame is tested.
+};
+
+/// @brief Minor-frame layout and sync parameters (taken from SuPcmF1_Attributes).
+struct PcmFrameSyncConfig {
+    uint64_t sync_pat = 0;        ///< Sync pattern, right-aligned.
+    uint64_t sync_mask = 0;       ///< Mask applied to the 64-bit test word before comparing.
+    uint32_t sync_pat_len = 0;    ///< Sync pattern length in bits.
+    uint32_t bits_in_frame = 0;   ///< Bits per minor frame (sync to sync).
+    uint32_t words_in_frame = 0;  ///< Words per minor frame (data words + 1).
+    uint32_t word_len = 0;        ///< Common data word length in bits.
+    uint64_t word_mask = 0;       ///< Mask applied to extracted data words.
+    uint64_t min_syncs = 0;       ///< Consecutive syncs required before frames are emitted.
+    bool swap_bytes = false;      ///< Swap byte pairs first (bDontSwapRawData == 0).
+    bool randomized = false;      ///< Descramble RNRZ-L after swapping.
+    uint32_t lock_misses = 0;     ///< Consecutive missed syncs that drop lock (0 = never lock).
+};
+
+/**
+ * @brief Synchronizer state that decides all further output.
+ *
+ * Two synchronizers with equal states at the same stream bit emit identical
+ * frames for identical input from there on, so a synchronizer started part
+ * way into a stream can be checked against one that ran from the beginning.
+ * Counters that only gate a decision are saturated at the point where the
+ * decision no longer changes; fields of the other engine stay zero.
+ */
+struct PcmFrameStreamState {
+    uint64_t bit_offset = 0;                          ///< Global index of the next stream bit.
+    FrameLockState lock_state = FrameLockState::Search; ///< Search / check / lock.
+    uint64_t spaced_syncs = 0;                        ///< Spaced syncs seen, saturated at min_syncs + 1.
+    uint64_t consecutive_syncs = 0;                   ///< Saturated at the lock threshold (0 in lock).
+    uint32_t misses = 0;                              ///< Consecutive misses (lock only).
+    uint64_t lfsr_history = 0;                        ///< Descrambler history (randomized data only).
+    uint64_t last_bits = 0;                           ///< Last 64 conditioned stream bits.
+    uint64_t last_sync = UINT64_MAX;                  ///< Word-parallel: last sync bit (-1 before any).
+    uint32_t frame_bit_count = 0;                     ///< Bit-serial: bits since the last sync.
+    uint32_t frame_word_count = 0;                    ///< Bit-serial: next data word index.
+    uint32_t word_bit_count = 0;                      ///< Bit-serial: bits of the current word.
+    int32_t save_data = 0;                            ///< Bit-serial: collection state.
+    std::vector<uint64_t> words;                      ///< Words held for the frame in progress.
+
+    bool operator==(const PcmFrameStreamState& other) const;                       ///< @return true if equal.
+    bool operator!=(const PcmFrameStreamState& other) const { return !(*this == other); } ///< @return true if different.
+};
+
+/**
+ * @brief Finds minor frames in a continuous PCM bitstream delivered packet by packet.
+ *
+ * Payloads are passed exactly as read from the packet. Byte-pair swapping
+ * (skipped for odd-length payloads, like SwapBytes_PcmF1) and RNRZ-L
+ * descrambling are applied by the synchronizer; the word-parallel engine
+ * fuses both into the pass that packs the payload into 64-bit blocks, one
+ * cache-sized chunk at a time, followed directly by the sync search and
+ * word extraction on that chunk.
+ *
+ * Both engines implement the same state machine: a sync is accepted when the
+ * masked 64-bit window ending at a bit equals the pattern, a frame is emitted
+ * when the sync lands exactly @c bits_in_frame bits after the previous one and
+ * all data words were collected in between.
+ *
+ * With @c lock_misses > 0 the synchronizer enters FrameLockState::Lock once
+ * max(min_syncs, 1) consecutive syncs arrived at frame spacing. In lock only
+ * the bit @c bits_in_frame after the previous sync is compared, so sync-like
+ * data inside a frame is ignored. A missed sync is flywheeled (the frame
+ * boundary is assumed and that frame is dropped); after @c lock_misses
+ * consecutive misses the synchronizer returns to Search and tests every bit.
+ *
+ * Frames emitted by the last
+ * processPacket() call are exposed through frameCount(), frameEndBit() and
+ * frameWords(); the buffers are reused across calls. By default every word
+ * slot is returned; setExtractionPlan() restricts the output to the plan's
+ * fields, which the word-parallel engine then reads straight from its packed
+ * 64-bit blocks without touching the other words.
+ */
+class PcmFrameSynchronizer
+{
+public:
+    explicit PcmFrameSynchronizer(const PcmFrameSyncConfig& config,
+                                  SyncEngine engine = SyncEngine::WordParallel,
+                                  SyncCorrelator::Kernel kernel = SyncCorrelator::bestKernel());
+
+    /**
+     * @brief Clears all stream state so the next packet starts a new bitstream.
+     * @param[in] stream_bit Global bit index of the first bit of the next packet,
+     *                       for streams decoded from part way in (default: start).
+     */
+    void reset(uint64_t stream_bit = 0);
+
+    /**
+     * @brief Restricts frame output to the fields of @p plan (in plan order).
+     *
+     * Call before the first packet; resets the stream state.
+     */
+    void setExtractionPlan(const ExtractionPlan& plan);
+
+    /// @return Plan in use (all word slots unless setExtractionPlan() was called).
+    const ExtractionPlan& extractionPlan() const { return m_plan; }
+
+    /**
+     * @brief Enables or disables the compile-time specialized lock-mode extractors.
+     *
+     * Frames with 16-bit words and a 16, 24 or 32-bit sync, and frames with
+     * 8, 10 or 12-bit words, are tracked in lock by template instances with
+     * constant sync/word masks and word spacing; other layouts (or
+     * @p enabled = false) use the generic runtime version. The choice is made
+     * here and in the constructor, not per frame.
+     */
+    void setSpecializedExtraction(bool enabled);
+
+    /// @return Name of the lock-mode extractor selected for this frame layout.
+    const char* extractorName() const { return m_extractor_name; }
+
+    /**
+     * @brief Feeds the next packet of raw PCM payload.
+     * @param[in] data      Payload bytes after the channel-specific data word.
+     * @param[in] num_bytes Number of payload bytes.
+     */
+    void processPacket(const uint8_t* data, size_t num_bytes);
+
+    /// @return Number of frames emitted by the last processPacket() call.
+    size_t frameCount() const { return m_frame_end_bits.size(); }
+
+    /// @return Global stream index of the final sync bit of frame @p i.
+    uint64_t frameEndBit(size_t i) const { return m_frame_end_bits[i]; }
+
+    /// @return Global stream index of the first bit of frame @p i.
+    uint64_t frameStartBit(size_t i) const
+    {
+        return m_frame_end_bits[i] + 1 - m_config.bits_in_frame;
+    }
+
+    /// @return Number of values per emitted frame (extractionPlan().size()).
+    size_t frameWidth() const { return m_plan.size(); }
+
+    /// @return Pointer to the frameWidth() plan values of frame @p i.
+    const uint64_t* frameWords(size_t i) const
+    {
+        return m_frame_words.data() + (i * m_plan.size());
+    }
+
+    uint64_t totalSyncs() const { return m_total_syncs; }      ///< @return Sync patterns seen so far.
+    uint64_t bitsProcessed() const { return m_bit_offset; }    ///< @return Stream bits consumed so far.
+    SyncEngine engine() const { return m_engine; }             ///< @return Active implementation.
+    FrameLockState lockState() const { return m_lock_state; }  ///< @return Current sync state.
+    uint64_t lockCount() const { return m_lock_count; }        ///< @return Transitions into Lock.
+    uint64_t unlockCount() const { return m_unlock_count; }    ///< @return Losses of lock.
+    uint64_t missedSyncs() const { return m_missed_syncs; }    ///< @return Predicted syncs not found in Lock.
+
+    /// @return Snapshot of the state that determines further output (see PcmFrameStreamState).
+    PcmFrameStreamState streamState() const;
+
+    /// @return SIMD kernel used by the word-parallel sync search.
+    SyncCorrelator::Kernel correlatorKernel() const { return m_correlator.kernel(); }
+
+    /// @return Human-readable engine name for log output.
+    static const char* engineName(SyncEngine engine);
+
+    /// @return Human-readable lock state name.
+    static const char* lockStateName(FrameLockState state);
+
+private:
+    /// @name Bit-serial engine
+    /// @{
+    void processPacketBitSerial(const uint8_t* data, size_t num_bytes);
+    /// @}
+
+    /// @name Word-parallel engine
+    /// @{
+    void processChunkWordParallel(const uint8_t* data, size_t num_bytes, bool swap_bytes);
+    uint64_t windowEndingAt(uint64_t local_bit) const;
+    void collectWordsUpTo(uint64_t last_bit);
+    bool frameComplete(uint64_t sync_bit) const;
+    void handleSync(uint64_t sync_bit);
+
+    template<uint32_t kSyncLen, uint32_t kWordLen>
+    uint64_t trackLocked(uint64_t chunk_end);
+    void selectExtractor(bool specialized);
+    /// @}
+
+    void emitFrame(uint64_t sync_bit);
+
+    /// @name Lock state machine (shared by both engines)
+    /// @{
+    void updateLock(bool spaced);
+    bool checkLockedSync(uint64_t sync_bit, bool matched, bool complete);
+    /// @}
+
+    PcmFrameSyncConfig m_config;            ///< Frame layout and sync parameters.
+    SyncEngine m_engine;                    ///< Active implementation.
+
+    uint64_t m_bit_offset = 0;              ///< Global index of the first bit of the current packet/chunk.
+    uint64_t m_stream_start = 0;            ///< Global index of the first bit after reset().
+    uint64_t m_sync_count = UINT64_MAX;     ///< Correctly spaced syncs (-1 until the first one).
+    uint64_t m_total_syncs = 0;             ///< Every sync pattern match.
+    ExtractionPlan m_plan;                  ///< Fields copied out of every emitted frame.
+    uint64_t m_lfsr_history = 0;            ///< RNRZ-L descrambler history (bit 0 = newest input).
+
+    /// @name Lock state
+    /// @{
+    FrameLockState m_lock_state = FrameLockState::Search; ///< Search / check / lock.
+    uint64_t m_consecutive_syncs = 0;       ///< Syncs in a row at frame spacing.
+    uint32_t m_misses = 0;                  ///< Consecutive missed syncs while locked.
+    uint64_t m_lock_count = 0;              ///< Transitions into Lock.
+    uint64_t m_unlock_count = 0;            ///< Transitions out of Lock.
+    uint64_t m_missed_syncs = 0;            ///< Predicted syncs not found while locked.
+    /// @}
+
+    /// @name Bit-serial state
+    /// @{
+    uint64_t m_test_word = 0;               ///< Shift register of the most recent 64 bits.
+    uint32_t m_frame_bit_count = 0;         ///< Bits since the last sync.
+    uint32_t m_frame_word_count = 0;        ///< One-based index of the next data word.
+    uint32_t m_word_bit_count = 0;          ///< Bits accumulated into the current data word.
+    int32_t m_save_data = 0;                ///< 0=waiting, 1=collecting, 2=frame complete.
+    std::vector<uint64_t> m_current_words;  ///< All word slots of the frame being collected.
+    std::vector<uint8_t> m_scratch;         ///< Swapped/descrambled copy of the packet.
+    /// @}
+
+    /// @name Word-parallel state
+    /// @{
+    std::vector<uint64_t> m_blocks;         ///< [0] = previous 64 stream bits, [1..] = chunk words.
+    uint64_t m_tail = 0;                    ///< Last 64 stream bits of the previous chunk.
+    uint64_t m_last_sync = UINT64_MAX;      ///< Global index of the last sync bit (-1 before any).
+    std::vector<uint64_t> m_field_values;   ///< Plan values of the frame being collected.
+    std::vector<uint64_t> m_frame_scratch;  ///< Unpacked data words + zero sync slot (dense lock mode).
+    uint32_t m_fields_collected = 0;        ///< Plan fields collected since the last sync.
+    uint64_t m_data_bits = 0;               ///< Bits from a sync to the end of its last data word.
+    bool m_in_frame = false;                ///< True once a sync has been seen.
+    SyncCorrelator m_correlator;            ///< Vectorized sync search over m_blocks.
+    std::vector<uint64_t> m_hits;           ///< Per-block sync hit words.
+
+    using TrackLockedFn = uint64_t (PcmFrameSynchronizer::*)(uint64_t);
+    TrackLockedFn m_track_locked = nullptr; ///< Lock-mode extractor chosen for the frame layout.
+    const char* m_extractor_name = "";      ///< Name of m_track_locked.
+    /// @}
+
+    std::vector<uint64_t> m_frame_end_bits; ///< Emitted frames: final sync bit.
+    std::vector<uint64_t> m_frame_words;    ///< Emitted frames: flattened word arrays.
+};
+
+#endif // PCMFRAMESYNC_H
@@ -0,0 +1,84 @@
+/**
+ * @file pcmpackettable.h
+ * @brief Header-scan index of one PCM channel's packets, split into decode chunks.
+ */
+
+#ifndef PCMPACKETTABLE_H
+#define PCMPACKETTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "irig106ch10.h"
+#include "i106_time.h"
+
+/// @brief Location and timing of one PCM packet (built from its header only).
+struct PcmPacketEntry {
+    int64_t data_offset = 0;  ///< File offset of the packet body (channel-specific data word).
+    uint32_t data_len = 0;    ///< Packet body length in bytes (ulDataLen).
+    uint32_t time_ref = 0;    ///< Index of the time reference in effect for this packet.
+    int64_t packet_time = 0;  ///< Header relative time (100 ns units).
+    uint64_t start_bit = 0;   ///< Global stream bit of the payload's first bit.
+};
+
+/// @brief Packet range decoded by one parallel worker.
+struct PcmDecodeChunk {
+    size_t lead_in = 0;  ///< First packet decoded; [lead_in, first) only primes the decoder.
+    size_t first = 0;    ///< First packet whose frames belong to this chunk.
+    size_t end = 0;      ///< One past the last packet of this chunk.
+};
+
+/**
+ * @brief PCM packets of one channel in file order, plus the time references.
+ *
+ * Filled by a header-only pass over the file: each entry records where the
+ * payload is and which IRIG time reference (the latest time packet read
+ * before it) converts its frames to IRIG time, so any packet range can be
+ * decoded independently of the others.
+ */
+class PcmPacketTable
+{
+public:
+    /// Removes all packets and time references.
+    void clear();
+
+    /// Appends a time reference that applies to packets added after it.
+    void addTimeReference(const Irig106::SuTimeRef& time_ref);
+
+    /**
+     * @brief Appends a packet.
+     * @param[in] data_offset File offset of the packet body.
+     * @param[in] data_len    Packet body length (channel-specific word + payload).
+     * @param[in] packet_time Header relative time (100 ns units).
+     */
+    void addPacket(int64_t data_offset, uint32_t data_len, int64_t packet_time);
+
+    size_t size() const { return m_packets.size(); }                     ///< @return Number of packets.
+    bool isEmpty() const { return m_packets.empty(); }                   ///< @return true if no packets.
+    const PcmPacketEntry& packet(size_t i) const { return m_packets[i]; } ///< @return Packet @p i.
+
+    /// @return Time reference @p i.
+    const Irig106::SuTimeRef& timeReference(size_t i) const { return m_time_refs[i]; }
+    size_t timeReferenceCount() const { return m_time_refs.size(); }      ///< @return Number of references.
+
+    /// @return Sum of PCM payload bytes over all packets.
+    uint64_t payloadBytes() const { return m_total_bits / 8; }
+
+    /**
+     * @brief Splits the packets into contiguous chunks of about @p target_bytes payload.
+     *
+     * Every chunk after the first starts its decode at least @p lead_in_bits
+     * stream bits (and at least one packet) before the packets it owns, so the
+     * frame synchronizer, descrambler and packet timing are primed when the
+     * owned range begins.
+     */
+    std::vector<PcmDecodeChunk> planChunks(uint64_t target_bytes, uint64_t lead_in_bits) const;
+
+private:
+    std::vector<PcmPacketEntry> m_packets;        ///< Packets in file order.
+    std::vector<Irig106::SuTimeRef> m_time_refs;  ///< Time references in file order.
+    uint64_t m_total_bits = 0;                    ///< Payload bits of all packets.
+};
+
+#endif // PCMPACKETTABLE_H
@@ -3,7 +3,8 @@
  * @brief Orchestrates worker thread lifecycle and batch processing sequencing.
  *
  * Owns all transient processing state: the background QThread, the
- * FrameProcessor instance, progress tracking, and the batch state machine.
+ * FrameProcessor instances, the batch worker pool, progress tracking, and the
+ * batch state machine.
  * MainViewModel constructs one of these, passes non-owning pointers to the
  * shared model objects, and wires its signals into the ViewModel's own signals.
  */
@@ -11,26 +12,45 @@
 #ifndef PROCESSINGCOORDINATOR_H
 #define PROCESSINGCOORDINATOR_H
 
+#include <QFutureWatcher>
 #include <QMap>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QThread>
 #include <QVector>
 
 #include "batchfileinfo.h"
+#include "batchscheduler.h"
 #include "processingparams.h"
 
-class Chapter10Reader;
 class FrameProcessor;
 class FrameSetup;
 
+/**
+ * @brief Pre-scan result of one batch file, built off the GUI thread.
+ *
+ * Returned by the batch start's rescan tasks; the coordinator copies the
+ * pre-scan fields back into the batch list as each file completes.
+ */
+struct BatchPreScanResult
+{
+    BatchFileInfo info; ///< Copy of the entry with its pre-scan fields filled in.
+    QStringList   log;  ///< Log lines to emit on the GUI thread.
+};
+
 /**
  * @brief Owns the worker thread lifecycle and batch processing state machine.
  *
  * Constructed by MainViewModel as a child QObject (so it is destroyed before
  * the ViewModel's own member variables). Holds non-owning pointers to the
- * shared Chapter10Reader, FrameSetup, and batch file list — all of which are
- * owned by MainViewModel and outlive the coordinator.
+ * shared FrameSetup and batch file list — both owned by MainViewModel and
+ * outliving the coordinator.
+ *
+ * Batch files run concurrently on a pool of persistent worker threads, one
+ * FrameProcessor per file, in the order and under the limits set by a
+ * BatchScheduler. Each file keeps the status, retry and cancel behaviour of a
+ * sequential batch; only the order in which files start and finish changes.
  */
 class ProcessingCoordinator : public QObject
 {
@@ -41,12 +61,10 @@ public:
      * @brief Constructs the coordinator with non-owning pointers to shared state.
      * @param batch_files  Pointer to ViewModel's m_batch_files vector.
      * @param frame_setup  Pointer to ViewModel's FrameSetup instance.
-     * @param reader       Pointer to ViewModel's Chapter10Reader instance.
      * @param parent       QObject parent (should be the owning MainViewModel).
      */
     explicit ProcessingCoordinator(QVector<BatchFileInfo>* batch_files,
                                    FrameSetup*             frame_setup,
-                                   Chapter10Reader*        reader,
                                    QObject*                parent = nullptr);
     ~ProcessingCoordinator();
 
@@ -71,8 +89,14 @@ public:
     /**
      * @brief Starts batch processing.
      *
-     * Pre-scans all valid batch files, then launches the batch state machine.
+     * Files whose intake pre-scan is missing or stale are scanned again on the
+     * QtConcurrent global pool (batchPreScanProgress()); the batch state
+     * machine starts once they are done, or the batch ends if
+     * cancelProcessing() is called first. processing() is true throughout.
      * Settings values are captured at call time and held constant for the run.
+     * Files start largest first on up to the configured number of workers
+     * (see setBatchConcurrency()); the cores are shared between the files
+     * running at once through each run's decode thread count.
      */
     void startBatchProcessing(const QString&              output_dir,
                               int                         sample_rate_index,
@@ -84,7 +108,8 @@ public:
 
     /**
      * @brief Re-queues failed batch files and re-runs processing.
-     * Settings values are re-captured so any user changes take effect.
+     * Settings values are re-captured so any user changes take effect; the
+     * failed files are pre-scanned again as in startBatchProcessing().
      */
     void retryFailedFiles(const QString&              frame_sync_str,
                           int                         polarity_idx,
@@ -92,9 +117,16 @@ public:
                           const QString&              scale_str,
                           const QVector<QVector<bool>>& receiver_states);
 
-    /// Requests abort of the active processor and flags the batch as cancelled.
+    /// Requests abort of the active processors and pre-scans, and flags the batch as cancelled.
     void cancelProcessing();
 
+    /**
+     * @brief Sets the batch worker pool limits used from the next batch or retry.
+     * @param workers          Files processed at once (0 = one per physical core).
+     * @param files_per_device Files read at once from one storage device (0 = no limit).
+     */
+    void setBatchConcurrency(int workers, int files_per_device = UIConstants::kBatchFilesPerDevice);
+
     /**
      * @brief Pre-scans a single file to detect encoding and verify sync.
      *
@@ -111,6 +143,27 @@ public:
                     const QString& filename,
                     const QString& frame_sync_str);
 
+    /**
+     * @brief Builds the pre-scan parameters shared by the files of a batch.
+     * @param frame_sync_str Frame sync hex string from settings.
+     * @param data_words     Data words per minor frame (FrameSetup::length()).
+     * @param[out] params    Frame sync and minor frame layout; the file and channel are left unset.
+     * @return false if the frame sync or frame setup is unusable.
+     */
+    static bool batchPreScanParams(const QString& frame_sync_str, int data_words, ProcessingParams& params);
+
+    /**
+     * @brief Pre-scans the resolved PCM channel of one batch file — safe to run on any thread.
+     *
+     * Sets preScanOk and isRandomized, and records the channel and frame
+     * layout the result is for, so a later batch start can reuse it.
+     *
+     * @param[in,out] info     File to scan.
+     * @param[in]     params   Parameters from batchPreScanParams().
+     * @param[out]    log      Pre-scan log lines, for the caller to emit.
+     */
+    static void preScanBatchFile(BatchFileInfo& info, const ProcessingParams& params, QStringList& log);
+
     /// Resets transient batch counters/index. Called by MainViewModel::clearState().
     void reset();
 
@@ -129,6 +182,8 @@ signals:
     void processingStateChanged(bool active);
     /// Emitted when the batch moves to a new file.
     void batchFileProcessing(int file_index, int total);
+    /// Emitted as the batch start's pre-scans complete: @p scanned of @p total files.
+    void batchPreScanProgress(int scanned, int total);
     /// Emitted after the coordinator mutates the batch file list.
     /// ViewModel rebuilds the status summary and re-emits batchFilesChanged().
     void batchFilesUpdated();
@@ -145,27 +200,62 @@ private:
     /// Builds a name-to-index map for O(1) parameter lookup in the frame setup.
     QMap<QString, int> buildParameterMap() const;
 
-    /// Creates a FrameProcessor and starts it on a background thread.
+    /// Creates a FrameProcessor and starts it on a background thread (single-file mode).
     void launchWorkerThread(const ProcessingParams& params);
-    /// Runs pre-scan on all valid, unprocessed batch files.
+    /// Pre-scans on the pool the unprocessed batch files whose intake pre-scan is missing or stale, then calls runScannedBatch().
     void preScanBatchFiles();
-    /// Advances the batch state machine to the next file.
+    /// Starts the batch once its files are pre-scanned, or ends it if it was cancelled meanwhile.
+    void runScannedBatch();
+    /// Settles the files that need no run and queues the others on the scheduler.
+    void beginBatchRun();
+    /// Starts queued batch files while workers are free; ends the batch once none are left running.
     void processNextBatchFile();
+    /// Builds the parameters of batch file @p index and starts it on a pool worker. @return false if it failed to start.
+    bool launchBatchFile(int index);
+    /// Logs the batch summary and reports the end of the batch.
+    void finishBatch();
 
     // Slots connected to FrameProcessor signals
     void onProgressUpdated(int percent);
     void onProcessingFinished(bool success);
     void onLogMessage(const QString& message);
+    void onBatchFileProgress(int index, int percent);
+    void onBatchFileFinished(int index, bool success);
+
+    // Slots connected to the pre-scan watcher
+    void onBatchFilePreScanned(int result_index);
+    void onBatchPreScanFinished();
 
     // Non-owning pointers — lifetime guaranteed by ViewModel (parent QObject)
     QVector<BatchFileInfo>* m_batch_files;
     FrameSetup*             m_frame_setup;
-    Chapter10Reader*        m_reader;
 
     // Thread lifecycle
     QThread*        m_worker_thread     = nullptr;
     FrameProcessor* m_current_processor = nullptr;
 
+    /// @brief A batch file running on a pool worker.
+    struct BatchRun {
+        FrameProcessor* processor = nullptr; ///< Processor of the file (lives on thread).
+        QThread*        thread    = nullptr; ///< Pool worker running it.
+        int             percent   = 0;       ///< Last progress reported for the file.
+    };
+
+    // Batch worker pool — threads persist across files and batches
+    QVector<QThread*>   m_pool_threads;
+    QVector<QThread*>   m_idle_threads;
+    QMap<int, BatchRun> m_batch_runs;
+    BatchScheduler      m_batch_scheduler;
+    int                 m_batch_workers          = 0;
+    int                 m_batch_files_per_device = UIConstants::kBatchFilesPerDevice;
+    int                 m_batch_decode_threads   = 1;
+
+    // Batch start pre-scans — tasks on the QtConcurrent global pool, one per file to scan
+    QFutureWatcher<BatchPreScanResult>* m_pre_scan_watcher = nullptr;
+    QVector<int>                        m_pre_scan_indexes;
+    int                                 m_pre_scan_count   = 0;
+    bool                                m_pre_scanning     = false;
+
     // Processing state
     bool    m_processing       = false;
     int     m_progress_percent = 0;
@@ -173,7 +263,6 @@ private:
     QString m_last_output_file;
 
     // Batch state machine
-    int     m_batch_current_index    = 0;
     bool    m_batch_cancelled        = false;
     QString m_batch_output_dir;
     int     m_batch_success_count    = 0;
@@ -187,6 +276,8 @@ private:
     int                    m_slope_idx     = 0;
     QString                m_scale_str;
     QVector<QVector<bool>> m_receiver_states;
+    CalibrationParams      m_batch_calibration;
+    bool                   m_batch_receivers_ok = false;
 };
 
 #endif // PROCESSINGCOORDINATOR_H
@@ -8,6 +8,13 @@
 
 #include <cstdint>
 #include <QString>
+#include <QVector>
+
+#include "ch10packetsource.h"
+#include "constants.h"
+#include "pcmframesync.h"
+
+class FrameSetup;
 
 /// @brief Calibration scaling parameters.
 struct CalibrationParams {
@@ -16,6 +23,32 @@ struct CalibrationParams {
     bool negative_polarity = false; ///< True if AGC polarity is negative.
 };
 
+/// @brief Additional output of a channel: the same frames averaged at another rate.
+struct RateOutput {
+    double sample_rate = 1;       ///< Output rows per second (1 mHz to kMaxSampleRate).
+    QString outfile;              ///< Path to the CSV output file at this rate.
+};
+
+/// @brief Extraction window of a multi-window run, written to its own CSV.
+struct TimeWindow {
+    uint64_t start_seconds = 0;   ///< Start of the window (IRIG seconds).
+    uint64_t stop_seconds = 0;    ///< End of the window (IRIG seconds).
+    QString outfile;              ///< Path to this window's CSV output file.
+};
+
+/// @brief Frame layout and output of a PCM channel decoded in the same pass as the primary one.
+struct PcmChannelParams {
+    int pcm_channel_id = -1;      ///< PCM channel ID.
+    uint64_t frame_sync = 0;      ///< Frame sync pattern as a numeric value.
+    int sync_pattern_length = 0;  ///< Sync pattern length in bits.
+    int words_in_minor_frame = 0; ///< Words per PCM minor frame (data words + 1).
+    int bits_in_minor_frame = 0;  ///< Total bits per PCM minor frame.
+    bool is_randomized = false;   ///< True if RNRZ-L encoded.
+    const FrameSetup* frame_setup = nullptr; ///< Parameter definitions (enabled words, calibration).
+    QString outfile;              ///< Path to this channel's CSV output file.
+    QVector<RateOutput> extra_rates; ///< Further outputs of this channel at other rates.
+};
+
 /// @brief Validated parameters bundle passed to the worker thread.
 struct ProcessingParams {
     QString filename;              ///< Path to the .ch10 input file.
@@ -28,9 +61,18 @@ struct ProcessingParams {
     CalibrationParams calibration; ///< Calibration slope/scale parameters.
     uint64_t start_seconds = 0;   ///< Start of extraction window (IRIG seconds).
     uint64_t stop_seconds = 0;    ///< End of extraction window (IRIG seconds).
-    int sample_rate = 1;          ///< Output sample rate in Hz.
+    double sample_rate = 1;       ///< Output sample rate in Hz (1 mHz to kMaxSampleRate).
     QString outfile;              ///< Path to the CSV output file.
     bool is_randomized = false;   ///< True if RNRZ-L encoding detected by preScan.
+    SyncEngine sync_engine = SyncEngine::WordParallel; ///< Frame synchronizer implementation.
+    uint32_t lock_misses = 3;     ///< Missed syncs before frame lock drops to search (0 = no lock).
+    int decode_threads = 0;       ///< Intra-file decode threads (0 = one per core, 1 = serial).
+    uint64_t parallel_chunk_bytes = PCMConstants::kParallelChunkBytes; ///< Minimum PCM payload per decode chunk.
+    Ch10PacketSource::Backend packet_source = Ch10PacketSource::Backend::Mapped; ///< How the input file is read.
+    size_t prefetch_block_bytes = PCMConstants::kPrefetchBlockBytes; ///< Block size of the Prefetched source.
+    QVector<RateOutput> extra_rates; ///< Further outputs of the selected channel at other rates.
+    QVector<PcmChannelParams> extra_pcm_channels; ///< Further PCM channels decoded in the same file pass.
+    QVector<TimeWindow> windows;  ///< Windows in start order, each to its own CSV (replaces start/stop/outfile if not empty).
 };
 
 #endif // PROCESSINGPARAMS_H
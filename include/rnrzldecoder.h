@@ -0,0 +1,54 @@
+/**
+ * @file rnrzldecoder.h
+ * @brief IRIG 106 Appendix D RNRZ-L descrambler, 64 bits at a time.
+ */
+
+#ifndef RNRZLDECODER_H
+#define RNRZLDECODER_H
+
+#include <cstdint>
+
+/**
+ * @brief Self-synchronizing RNRZ-L descrambler (15-bit LFSR, taps 14 and 15).
+ *
+ * Every output bit is the input bit XOR the inputs 14 and 15 bits earlier,
+ * so a whole 64-bit block can be descrambled with two shifts and two XORs.
+ * The 15-bit @c lfsr holds the most recent input bits (bit 0 = newest) and is
+ * carried across packets exactly like the original per-bit implementation.
+ */
+class RnrzlDecoder
+{
+public:
+    static constexpr uint16_t kLfsrMask = 0x7FFF; ///< 15-bit LFSR state mask.
+
+    /**
+     * @brief Descrambles a buffer in place, 64 bits per step.
+     * @param[in,out] data       Byte buffer (MSB first); bits past @p total_bits are untouched.
+     * @param[in]     total_bits Number of valid bits in the buffer.
+     * @param[in,out] lfsr       15-bit LFSR state carried across packets.
+     */
+    static void derandomize(uint8_t* data, uint64_t total_bits, uint16_t& lfsr);
+
+    /// Reference per-bit implementation; same contract as derandomize().
+    static void derandomizeBitSerial(uint8_t* data, uint64_t total_bits, uint16_t& lfsr);
+
+    /**
+     * @brief Descrambles one MSB-first 64-bit block.
+     * @param[in]     in      Scrambled input block.
+     * @param[in,out] history Previous input bits (bit 0 = newest); updated to this block's last 15 bits.
+     * @return Descrambled block.
+     */
+    static inline uint64_t derandomizeBlock(uint64_t in, uint64_t& history)
+    {
+        constexpr int kTap1 = 14;
+        constexpr int kTap2 = 15;
+        constexpr int kBlockBits = 64;
+        const uint64_t out = in
+            ^ ((in >> kTap1) | (history << (kBlockBits - kTap1)))
+            ^ ((in >> kTap2) | (history << (kBlockBits - kTap2)));
+        history = in & kLfsrMask;
+        return out;
+    }
+};
+
+#endif // RNRZLDECODER_H
@@ -0,0 +1,192 @@
+/**
+ * @file spscring.h
+ * @brief Bounded single-producer / single-consumer ring buffer for pipeline stages.
+ */
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Lock-free bounded queue between exactly one producer and one consumer thread.
+ *
+ * Capacity is rounded up to a power of two. tryPush()/tryPop() never block;
+ * push()/pop() spin briefly, then sleep in short steps until space or an item
+ * is available, which gives back-pressure without a mutex. close() ends the
+ * stream: pop() drains the remaining items and then returns false.
+ *
+ * Occupancy counters (peak and mean fill at push time, number of blocking
+ * waits on each side) show which side of the queue is the bottleneck. Each
+ * counter is written by one side only and is meant to be read after the run.
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    /// @param[in] capacity Minimum number of queued items (at least 1).
+    explicit SpscRing(size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        m_slots.resize(size);
+        m_mask = size - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    SpscRing(SpscRing&&) = delete;
+    SpscRing& operator=(SpscRing&&) = delete;
+    ~SpscRing() = default;
+
+    /// Producer: moves @p item in if there is room. @return false if full.
+    bool tryPush(T& item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t used = tail - m_head.load(std::memory_order_acquire);
+        if (used == m_slots.size())
+        {
+            return false;
+        }
+        m_slots[tail & m_mask] = std::move(item);
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        // Occupancy as seen by the producer, including this item
+        m_pushes.store(m_pushes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_fill_sum.store(m_fill_sum.load(std::memory_order_relaxed) + used + 1, std::memory_order_relaxed);
+        if (used + 1 > m_peak.load(std::memory_order_relaxed))
+        {
+            m_peak.store(used + 1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /// Consumer: moves the oldest item into @p item. @return false if empty.
+    bool tryPop(T& item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        item = std::move(m_slots[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Producer: waits for room, then pushes. @return false if the ring was closed.
+    bool push(T item)
+    {
+        if (tryPush(item))
+        {
+            return true;
+        }
+        m_full_waits.store(m_full_waits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        for (int spins = 0; !tryPush(item); spins++)
+        {
+            if (isClosed())
+            {
+                return false;
+            }
+            backoff(spins);
+        }
+        return true;
+    }
+
+    /// Consumer: waits for an item. @return false once closed and drained.
+    bool pop(T& item)
+    {
+        if (tryPop(item))
+        {
+            return true;
+        }
+        m_empty_waits.store(m_empty_waits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        for (int spins = 0; !tryPop(item); spins++)
+        {
+            // Items pushed before close() are still delivered
+            if (isClosed())
+            {
+                return tryPop(item);
+            }
+            backoff(spins);
+        }
+        return true;
+    }
+
+    /// Ends the stream; wakes a waiting consumer (and a producer waiting for room).
+    void close() { m_closed.store(true, std::memory_order_release); }
+    bool isClosed() const { return m_closed.load(std::memory_order_acquire); } ///< @return true after close().
+
+    size_t capacity() const { return m_slots.size(); } ///< @return Number of slots.
+
+    /// @return Items currently queued (approximate while both sides run).
+    size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    /// @name Occupancy counters
+    /// @{
+    size_t peakSize() const { return m_peak.load(std::memory_order_relaxed); }              ///< @return Highest fill.
+    uint64_t pushCount() const { return m_pushes.load(std::memory_order_relaxed); }          ///< @return Items pushed.
+    uint64_t fullWaits() const { return m_full_waits.load(std::memory_order_relaxed); }      ///< @return Producer waits.
+    uint64_t emptyWaits() const { return m_empty_waits.load(std::memory_order_relaxed); }    ///< @return Consumer waits.
+
+    /// @return Mean number of queued items right after each push.
+    double meanFill() const
+    {
+        const uint64_t pushes = pushCount();
+        return (pushes == 0) ? 0.0
+                             : static_cast<double>(m_fill_sum.load(std::memory_order_relaxed)) /
+                                   static_cast<double>(pushes);
+    }
+    /// @}
+
+private:
+    /// Spins for a short while, then sleeps so a stalled stage does not burn a core.
+    static void backoff(int spins)
+    {
+        constexpr int kSpinLimit = 64;
+        constexpr auto kSleep = std::chrono::microseconds(50);
+        if (spins < kSpinLimit)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            std::this_thread::sleep_for(kSleep);
+        }
+    }
+
+    static constexpr size_t kCacheLine = 64;
+
+    std::vector<T> m_slots;                                ///< Ring storage.
+    size_t m_mask = 0;                                     ///< Slot count - 1.
+    alignas(kCacheLine) std::atomic<size_t> m_head{0};     ///< Next slot to pop (consumer-owned).
+    alignas(kCacheLine) std::atomic<size_t> m_tail{0};     ///< Next slot to push (producer-owned).
+    alignas(kCacheLine) std::atomic<bool> m_closed{false}; ///< Set by close().
+
+    /// @name Producer-side counters
+    /// @{
+    std::atomic<uint64_t> m_pushes{0};      ///< Items pushed.
+    std::atomic<uint64_t> m_fill_sum{0};    ///< Sum of fill levels after each push.
+    std::atomic<size_t> m_peak{0};          ///< Highest fill level.
+    std::atomic<uint64_t> m_full_waits{0};  ///< push() calls that had to wait.
+    /// @}
+
+    /// @name Consumer-side counters
+    /// @{
+    alignas(kCacheLine) std::atomic<uint64_t> m_empty_waits{0}; ///< pop() calls that had to wait.
+    /// @}
+};
+
+#endif // SPSCRING_H
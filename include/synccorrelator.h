@@ -0,0 +1,92 @@
+/**
+ * @file synccorrelator.h
+ * @brief Runtime-dispatched SIMD correlator for PCM frame sync patterns.
+ */
+
+#ifndef SYNCCORRELATOR_H
+#define SYNCCORRELATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Tests a masked sync pattern (up to 64 bits) at every bit offset of a bitstream.
+ *
+ * The stream is packed MSB-first into 64-bit blocks (see packBlocks()). For
+ * each block the correlator returns a hit word in which bit (63 - i) is set
+ * when the masked 64-bit window ending at bit i of that block equals the
+ * pattern, i.e. the same test as @c (test_word & sync_mask) == sync_pat after
+ * shifting that bit in. Several blocks are tested per instruction by the SSE4.2,
+ * AVX2 and AVX-512 kernels; the best kernel supported by the host CPU is
+ * chosen at runtime and the scalar kernel remains as the fallback.
+ */
+class SyncCorrelator
+{
+public:
+    /// @brief Correlator implementation, ordered from slowest to fastest.
+    enum class Kernel {
+        Scalar,  ///< Portable 64-bit implementation.
+        Sse42,   ///< 2 blocks per step (SSE4.2 hosts).
+        Avx2,    ///< 4 blocks per step.
+        Avx512   ///< 8 blocks per step (AVX-512F).
+    };
+
+    /**
+     * @brief Prepares the per-bit comparison taps for a pattern.
+     * @param[in] sync_pat  Right-aligned sync pattern.
+     * @param[in] sync_mask Mask applied to the 64-bit test window.
+     * @param[in] kernel    Requested kernel; unsupported kernels fall back to bestKernel().
+     */
+    SyncCorrelator(uint64_t sync_pat, uint64_t sync_mask, Kernel kernel = bestKernel());
+
+    /**
+     * @brief Computes hit words for blocks 1..num_blocks.
+     *
+     * @param[in]  blocks     num_blocks + 1 words; blocks[0] holds the 64 bits
+     *                        preceding blocks[1] (zero at stream start).
+     * @param[in]  num_blocks Number of blocks to test.
+     * @param[out] hits       num_blocks hit words; hits[k - 1] belongs to blocks[k].
+     */
+    void findHits(const uint64_t* blocks, size_t num_blocks, uint64_t* hits) const;
+
+    /**
+     * @brief Packs bytes MSB-first into 64-bit blocks, zero-padding the last block.
+     * @param[in]  data      Source bytes.
+     * @param[in]  num_bytes Number of source bytes.
+     * @param[in]  history   The 64 stream bits preceding @p data, stored in blocks[0].
+     * @param[out] blocks    Resized to ceil(num_bytes / 8) + 1 words.
+     * @return Number of payload blocks (excluding the history block).
+     */
+    static size_t packBlocks(const uint8_t* data, size_t num_bytes, uint64_t history,
+                             std::vector<uint64_t>& blocks);
+
+    /**
+     * @brief Convenience search: true if the pattern ends at any bit of @p data.
+     *
+     * Matches are only accepted once at least @p sync_pat_len bits were seen,
+     * mirroring the bits_loaded guard of the frame state machine.
+     */
+    bool containsPattern(const uint8_t* data, uint64_t total_bits, uint32_t sync_pat_len) const;
+
+    Kernel kernel() const { return m_kernel; }  ///< @return Kernel in use.
+
+    /// @return Fastest kernel supported by the host CPU and operating system.
+    static Kernel bestKernel();
+
+    /// @return true if @p kernel can run on this host.
+    static bool isSupported(Kernel kernel);
+
+    /// @return Human-readable kernel name for log output.
+    static const char* kernelName(Kernel kernel);
+
+private:
+    uint64_t m_sync_pat;                ///< Right-aligned sync pattern.
+    uint64_t m_sync_mask;               ///< Mask applied to the test window.
+    Kernel m_kernel;                    ///< Kernel in use.
+    bool m_never_matches;               ///< Pattern has bits outside the mask.
+    std::vector<uint32_t> m_tap_shift;  ///< Test-window bit positions covered by the mask.
+    std::vector<uint64_t> m_tap_invert; ///< All-ones where the pattern bit is zero.
+};
+
+#endif // SYNCCORRELATOR_H
@@ -0,0 +1,128 @@
+/**
+ * @file timebinaccumulator.h
+ * @brief Averages frame values into fixed-rate output time bins.
+ */
+
+#ifndef TIMEBINACCUMULATOR_H
+#define TIMEBINACCUMULATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Sums per-frame values into output bins of 1 / sample_rate seconds.
+ *
+ * Times are integer 100 ns ticks. Bin k covers the ticks after
+ * start + k periods up to and including start + (k + 1) periods (bin 0 also
+ * takes the window start itself), so a frame's bin is found by one integer
+ * division however far it lies from the previous frame. The rate is held as
+ * an exact fraction of bins per tick (resolved to 1 mHz), so bin edges do not
+ * drift over long recordings. A frame inside [start_seconds, stop_seconds]
+ * advances the current bin only when it falls into a later bin; a frame in an
+ * earlier bin is averaged into the current one. Each bin keeps a running sum
+ * per output column plus a frame count. A bin that received frames is closed
+ * when a later frame advances past it; closed bins are kept until
+ * clearClosedBins() so the caller can write them out.
+ *
+ * For parallel decoding, an accumulator per chunk starts from bin 0 like the
+ * serial run and additionally records the individual values of its first bin
+ * (setRecordFirstBin()). appendChunk() then continues the serial sums with
+ * those values, so merged output is bit-identical to a single pass.
+ */
+class TimeBinAccumulator
+{
+public:
+    /**
+     * @param[in] start_seconds Start of the extraction window (IRIG seconds).
+     * @param[in] stop_seconds  End of the extraction window (IRIG seconds).
+     * @param[in] sample_rate   Output rows per second (positive, up to PCMConstants::kMaxSampleRate).
+     * @param[in] value_columns Output column of each value passed to addFrame().
+     * @param[in] num_columns   Number of output columns.
+     */
+    TimeBinAccumulator(uint64_t start_seconds, uint64_t stop_seconds, double sample_rate,
+                       std::vector<uint32_t> value_columns, size_t num_columns);
+
+    /// Keeps the values of every frame in the first bin (chunk accumulators only).
+    void setRecordFirstBin(bool enabled) { m_record_first = enabled; }
+
+    /// @return true if @p ticks lies inside [start_seconds, stop_seconds].
+    bool inWindow(int64_t ticks) const { return ticks >= m_start && ticks <= m_stop; }
+
+    /**
+     * @brief Adds one frame.
+     * @param[in] ticks  Frame time in 100 ns ticks since the IRIG epoch.
+     * @param[in] values One scaled value per entry of @c value_columns.
+     * @return false if @p ticks is outside the extraction window (frame ignored).
+     */
+    bool addFrame(int64_t ticks, const double* values);
+
+    /// Closes the current bin if it received frames (end of input).
+    void flush();
+
+    /**
+     * @brief Continues this (serial) accumulator with a chunk decoded independently.
+     *
+     * Frames of the chunk's first bin are re-added one by one to the current
+     * bin when they belong to it; later bins are taken over as summed. Returns
+     * false, leaving this accumulator unchanged, in the rare case where a later
+     * chunk bin would also fold into the current bin (time running backwards
+     * across the chunk edge); the caller must then decode the chunk serially.
+     */
+    bool appendChunk(const TimeBinAccumulator& chunk);
+
+    /// @return false if appendChunk() would refuse @p chunk (checked without changing anything).
+    bool canAppendChunk(const TimeBinAccumulator& chunk) const;
+
+    /// @name Closed bins (in output order)
+    /// @{
+    size_t closedBins() const { return m_bin_indices.size(); }                    ///< @return Number of closed bins.
+    int64_t binTime(size_t i) const { return binStart(m_bin_indices[i]); }        ///< @return Start tick of bin @p i.
+    int binSamples(size_t i) const { return m_bin_samples[i]; }                   ///< @return Frames summed in bin @p i.
+    /// @return num_columns sums of bin @p i.
+    const double* binSums(size_t i) const { return m_bin_sums.data() + (i * m_num_columns); }
+    void clearClosedBins();                                                       ///< Drops the closed bins.
+    /// @}
+
+    size_t columnCount() const { return m_num_columns; }  ///< @return Number of output columns.
+
+private:
+    void closeBin();
+
+    /// @return Bin of a frame at @p ticks (inside the window).
+    uint64_t binIndex(int64_t ticks) const;
+
+    /// @return Start tick of bin @p index, rounded to the nearest tick.
+    int64_t binStart(uint64_t index) const;
+
+    int64_t m_start = 0;                 ///< Window start (ticks).
+    int64_t m_stop = 0;                  ///< Window end (ticks).
+    uint64_t m_bins_per_span = 1;        ///< Bins per m_span_ticks (reduced fraction).
+    uint64_t m_span_ticks = 1;           ///< Ticks spanned by m_bins_per_span bins.
+    std::vector<uint32_t> m_columns;     ///< Output column of each frame value.
+    size_t m_num_columns = 0;            ///< Output columns per bin.
+
+    /// @name Current bin
+    /// @{
+    uint64_t m_index = 0;                ///< Bin number counted from the window start.
+    int m_samples = 0;                   ///< Frames summed so far.
+    std::vector<double> m_sums;          ///< Running sum per column.
+    /// @}
+
+    /// @name Closed bins
+    /// @{
+    std::vector<uint64_t> m_bin_indices; ///< Bin numbers.
+    std::vector<int> m_bin_samples;      ///< Frame counts.
+    std::vector<double> m_bin_sums;      ///< Flattened column sums.
+    /// @}
+
+    /// @name First-bin record (chunk accumulators)
+    /// @{
+    bool m_record_first = false;         ///< Keep values of the first bin's frames.
+    bool m_has_frames = false;           ///< At least one frame was added.
+    uint64_t m_first_index = 0;          ///< Bin number of the first frame.
+    std::vector<double> m_first_values;  ///< Flattened values of the first bin's frames.
+    /// @}
+};
+
+#endif // TIMEBINACCUMULATOR_H
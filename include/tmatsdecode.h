@@ -0,0 +1,33 @@
+/**
+ * @file tmatsdecode.h
+ * @brief Thread-safe entry point to the irig106 TMATS decoder.
+ */
+
+#ifndef TMATSDECODE_H
+#define TMATSDECODE_H
+
+#include <mutex>
+
+#include "i106_decode_tmats.h"
+
+namespace TmatsDecode
+{
+    /**
+     * @brief Calls enI106_Decode_Tmats() under a process-wide lock.
+     *
+     * The library keeps the SuTmatsInfo being filled in a file-scope static
+     * for its allocator and clears it when done, so two files decoding their
+     * TMATS at once (batch intake, concurrent batch runs, a background
+     * catalog) would allocate into each other's info. The decode is a few
+     * kilobytes of text per file, so serializing it costs nothing measurable.
+     */
+    inline Irig106::EnI106Status decode(Irig106::SuI106Ch10Header* header, void* data,
+                                        Irig106::SuTmatsInfo* info)
+    {
+        static std::mutex mutex;
+        const std::lock_guard<std::mutex> lock(mutex);
+        return Irig106::enI106_Decode_Tmats(header, data, info);
+    }
+}
+
+#endif // TMATSDECODE_H
@@ -0,0 +1,143 @@
+/**
+ * @file batchscheduler.cpp
+ * @brief Implementation of BatchScheduler — largest-first dispatch under worker and device limits.
+ */
+
+#include "batchscheduler.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QStorageInfo>
+#include <QThread>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+BatchScheduler::BatchScheduler(int max_workers, int max_per_device)
+    : m_max_workers(std::max(max_workers, 1)),
+      m_max_per_device(std::max(max_per_device, 0))
+{
+}
+
+void BatchScheduler::addFile(int index, qint64 size, const QString& device)
+{
+    // Keep the queue largest first; equal sizes stay in list order
+    const auto pos = std::upper_bound(m_queue.begin(), m_queue.end(), size,
+                                      [](qint64 value, const File& file) { return value > file.size; });
+    m_queue.insert(pos, File{index, size, device});
+}
+
+int BatchScheduler::takeNext()
+{
+    if (running() >= m_max_workers)
+    {
+        return -1;
+    }
+
+    for (qsizetype i = 0; i < m_queue.size(); i++)
+    {
+        const File file = m_queue[i];
+        if (m_max_per_device > 0 && m_device_use.value(file.device) >= m_max_per_device)
+        {
+            continue;
+        }
+        m_queue.removeAt(i);
+        m_running.insert(file.index, file.device);
+        m_device_use[file.device]++;
+        return file.index;
+    }
+    return -1;
+}
+
+void BatchScheduler::finish(int index)
+{
+    const auto it = m_running.find(index);
+    if (it == m_running.end())
+    {
+        return;
+    }
+    m_device_use[it.value()]--;
+    m_running.erase(it);
+}
+
+void BatchScheduler::clearQueue()
+{
+    m_queue.clear();
+}
+
+int BatchScheduler::concurrency() const
+{
+    // Files per device, capped by the device limit, then by the workers
+    QMap<QString, int> per_device;
+    for (const auto& file : m_queue)
+    {
+        per_device[file.device]++;
+    }
+    for (auto it = m_running.cbegin(); it != m_running.cend(); ++it)
+    {
+        per_device[it.value()]++;
+    }
+
+    int total = 0;
+    for (const int files : std::as_const(per_device))
+    {
+        total += (m_max_per_device > 0) ? std::min(files, m_max_per_device) : files;
+    }
+    return std::clamp(total, 1, m_max_workers);
+}
+
+int BatchScheduler::physicalCoreCount()
+{
+    int cores = 0;
+#ifdef _WIN32
+    DWORD length = 0;
+    GetLogicalProcessorInformation(nullptr, &length);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> info(length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!info.empty() && GetLogicalProcessorInformation(info.data(), &length) != 0)
+    {
+        cores = static_cast<int>(std::count_if(info.begin(), info.end(), [](const auto& entry) {
+            return entry.Relationship == RelationProcessorCore;
+        }));
+    }
+#else
+    // One (physical id, core id) pair per core; /proc files report no size, so read them whole
+    QFile cpuinfo("/proc/cpuinfo");
+    if (cpuinfo.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QSet<QString> core_ids;
+        QString physical_id;
+        for (const QByteArray& line : cpuinfo.readAll().split('\n'))
+        {
+            const QString text = QString::fromLatin1(line);
+            const QString key = text.section(':', 0, 0).trimmed();
+            if (key == "physical id")
+            {
+                physical_id = text.section(':', 1).trimmed();
+            }
+            else if (key == "core id")
+            {
+                core_ids.insert(physical_id + '/' + text.section(':', 1).trimmed());
+            }
+        }
+        cores = static_cast<int>(core_ids.size());
+    }
+#endif
+    return (cores > 0) ? cores : QThread::idealThreadCount();
+}
+
+QString BatchScheduler::storageDevice(const QString& path)
+{
+    const QStorageInfo storage(QFileInfo(path).absolutePath());
+    if (!storage.isValid())
+    {
+        return {};
+    }
+    return QString::fromLocal8Bit(storage.device());
+}
+// End of file!
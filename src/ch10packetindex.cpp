@@ -0,0 +1,252 @@
+/**
+ * @file ch10packetindex.cpp
+ * @brief Implementation of Ch10PacketIndex — sidecar load/save and packet selection.
+ */
+
+#include "ch10packetindex.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "constants.h"
+#include "i106_time.h"
+
+using namespace Irig106;
+
+namespace {
+    /// Identifies an index sidecar; the last byte is the format version.
+    constexpr std::array<char, 8> kIndexMagic = {'C', 'h', '1', '0', 'I', 'd', 'x', '\x01'};
+    /// Written in native byte order; reads back differently on a foreign-endian host.
+    constexpr uint32_t kByteOrderMark = 0x01020304;
+
+    /// @brief Fixed-size start of a sidecar; the columns follow in declaration order.
+    struct IndexFileHeader {
+        std::array<char, 8> magic = kIndexMagic;  ///< kIndexMagic.
+        uint32_t byte_order = kByteOrderMark;     ///< kByteOrderMark.
+        uint32_t reserved = 0;                    ///< Zero.
+        int64_t file_size = 0;                    ///< Size of the indexed file.
+        int64_t file_mtime_ms = 0;                ///< Modification time of the indexed file (ms since epoch).
+        uint64_t packets = 0;                     ///< Elements per column.
+    };
+
+    /// Bytes per packet over all columns.
+    constexpr size_t kBytesPerPacket = sizeof(int64_t) + sizeof(int64_t) + sizeof(uint32_t) + sizeof(uint32_t) +
+                                       sizeof(uint16_t) + sizeof(uint8_t);
+
+    /// @return Modification time of @p info in ms since the epoch.
+    int64_t modifiedMs(const QFileInfo& info)
+    {
+        return info.lastModified().toMSecsSinceEpoch();
+    }
+
+    /// Writes @p column in one call. @return false on a short write.
+    template <typename T>
+    bool writeColumn(QSaveFile& file, const std::vector<T>& column)
+    {
+        const auto bytes = static_cast<qint64>(column.size() * sizeof(T));
+        return bytes == 0 || file.write(reinterpret_cast<const char*>(column.data()), bytes) == bytes;
+    }
+
+    /// Reads @p count elements into @p column in one call. @return false on a short read.
+    template <typename T>
+    bool readColumn(QFile& file, std::vector<T>& column, size_t count)
+    {
+        column.resize(count);
+        const auto bytes = static_cast<qint64>(count * sizeof(T));
+        return bytes == 0 || file.read(reinterpret_cast<char*>(column.data()), bytes) == bytes;
+    }
+
+    /**
+     * @brief Source that visits a fixed, ascending list of packet offsets.
+     *
+     * next() positions the wrapped source on the next listed offset and reads
+     * the header there, so packets between listed offsets are never parsed.
+     * Everything else is forwarded to the wrapped source.
+     */
+    class SelectedPacketSource : public Ch10PacketSource
+    {
+    public:
+        SelectedPacketSource(std::unique_ptr<Ch10PacketSource> source, std::vector<int64_t> offsets)
+            : m_source(std::move(source)),
+              m_offsets(std::move(offsets))
+        {
+            seekCursor(m_source->position());
+        }
+
+        Backend backend() const override { return m_source->backend(); }
+
+        EnI106Status next(Ch10Packet& packet) override
+        {
+            if (m_cursor >= m_offsets.size())
+            {
+                m_source->setPosition(m_source->size());
+                return I106_EOF;
+            }
+            const int64_t offset = m_offsets[m_cursor++];
+            if (!m_source->setPosition(offset))
+            {
+                return I106_READ_ERROR;
+            }
+            const EnI106Status status = m_source->next(packet);
+            if (status == I106_OK && packet.offset != offset)
+            {
+                // The file no longer matches its index
+                return I106_READ_ERROR;
+            }
+            return status;
+        }
+
+        EnI106Status readData(Ch10Packet& packet) override { return m_source->readData(packet); }
+
+        bool setPosition(int64_t offset) override
+        {
+            seekCursor(offset);
+            return m_source->setPosition(offset);
+        }
+
+        int64_t position() const override { return m_source->position(); }
+        int64_t size() const override { return m_source->size(); }
+        const uint8_t* fileBytes() const override { return m_source->fileBytes(); }
+        Ch10ReadStats readStats() const override { return m_source->readStats(); }
+
+    private:
+        /// Points the cursor at the first listed packet at or after @p offset.
+        void seekCursor(int64_t offset)
+        {
+            m_cursor = static_cast<size_t>(std::lower_bound(m_offsets.begin(), m_offsets.end(), offset) -
+                                           m_offsets.begin());
+        }
+
+        std::unique_ptr<Ch10PacketSource> m_source;  ///< Wrapped source.
+        std::vector<int64_t> m_offsets;              ///< Header offsets to visit, ascending.
+        size_t m_cursor = 0;                         ///< Next entry of m_offsets.
+    };
+}
+
+QString Ch10PacketIndex::sidecarPath(const QString& filename)
+{
+    return filename + PCMConstants::kPacketIndexSuffix;
+}
+
+void Ch10PacketIndex::clear()
+{
+    m_offsets.clear();
+    m_rel_times.clear();
+    m_packet_lengths.clear();
+    m_data_lengths.clear();
+    m_channel_ids.clear();
+    m_data_types.clear();
+}
+
+void Ch10PacketIndex::append(const Ch10Packet& packet)
+{
+    int64_t rel_time = 0;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay, cppcoreguidelines-pro-type-const-cast)
+    vTimeArray2LLInt(const_cast<uint8_t*>(packet.header.aubyRefTime), &rel_time);
+
+    m_offsets.push_back(packet.offset);
+    m_rel_times.push_back(rel_time);
+    m_packet_lengths.push_back(packet.header.ulPacketLen);
+    m_data_lengths.push_back(packet.header.ulDataLen);
+    m_channel_ids.push_back(packet.header.uChID);
+    m_data_types.push_back(packet.header.ubyDataType);
+}
+
+void Ch10PacketIndex::append(int64_t offset, int64_t rel_time, uint16_t channel_id, uint8_t data_type)
+{
+    m_offsets.push_back(offset);
+    m_rel_times.push_back(rel_time);
+    m_packet_lengths.push_back(0);
+    m_data_lengths.push_back(0);
+    m_channel_ids.push_back(channel_id);
+    m_data_types.push_back(data_type);
+}
+
+bool Ch10PacketIndex::save(const QString& filename) const
+{
+    const QFileInfo info(filename);
+    IndexFileHeader header;
+    header.file_size = info.size();
+    header.file_mtime_ms = modifiedMs(info);
+    header.packets = size();
+
+    // Written to a temporary file and renamed, so a reader never sees half an index
+    QSaveFile file(sidecarPath(filename));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    const bool written =
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == static_cast<qint64>(sizeof(header)) &&
+        writeColumn(file, m_offsets) && writeColumn(file, m_rel_times) &&
+        writeColumn(file, m_packet_lengths) && writeColumn(file, m_data_lengths) &&
+        writeColumn(file, m_channel_ids) && writeColumn(file, m_data_types);
+    if (!written)
+    {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+bool Ch10PacketIndex::load(const QString& filename)
+{
+    clear();
+
+    const QFileInfo info(filename);
+    QFile file(sidecarPath(filename));
+    if (!info.exists() || !file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    IndexFileHeader header;
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) != static_cast<qint64>(sizeof(header)) ||
+        header.magic != kIndexMagic || header.byte_order != kByteOrderMark ||
+        header.file_size != info.size() || header.file_mtime_ms != modifiedMs(info) ||
+        static_cast<uint64_t>(file.size()) != sizeof(header) + (header.packets * kBytesPerPacket))
+    {
+        return false;
+    }
+
+    const auto count = static_cast<size_t>(header.packets);
+    const bool read = readColumn(file, m_offsets, count) && readColumn(file, m_rel_times, count) &&
+                      readColumn(file, m_packet_lengths, count) && readColumn(file, m_data_lengths, count) &&
+                      readColumn(file, m_channel_ids, count) && readColumn(file, m_data_types, count);
+
+    // Packets must lie inside the file, in order and without overlapping
+    bool consistent = read;
+    for (size_t i = 0; consistent && i < count; i++)
+    {
+        const int64_t end = m_offsets[i] + static_cast<int64_t>(m_packet_lengths[i]);
+        consistent = m_offsets[i] >= 0 && m_offsets[i] < header.file_size &&
+                     (i + 1 == count || end <= m_offsets[i + 1]);
+    }
+    if (!consistent)
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<Ch10PacketSource> Ch10PacketIndex::selectPackets(std::unique_ptr<Ch10PacketSource> source,
+                                                                 const PacketFilter& filter) const
+{
+    std::vector<int64_t> offsets;
+    for (size_t i = 0; i < size(); i++)
+    {
+        if (filter(m_channel_ids[i], m_data_types[i]))
+        {
+            offsets.push_back(m_offsets[i]);
+        }
+    }
+    return std::make_unique<SelectedPacketSource>(std::move(source), std::move(offsets));
+}
+// End of file!
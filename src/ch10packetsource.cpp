@@ -0,0 +1,777 @@
+/**
+ * @file ch10packetsource.cpp
+ * @brief Implementation of Ch10PacketSource — memory-mapped, prefetching and irig106 packet readers.
+ */
+
+#include "ch10packetsource.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QFile>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#include "constants.h"
+#include "spscring.h"
+
+using namespace Irig106;
+
+namespace {
+    /// @return Primary plus (if flagged) secondary header bytes of @p header.
+    uint32_t headerSize(const SuI106Ch10Header& header)
+    {
+        return HEADER_SIZE + (((header.ubyPacketFlags & I106CH10_PFLAGS_SEC_HEADER) != 0) ? SEC_HEADER_SIZE : 0);
+    }
+
+    /// @return true if the open @p file starts with a sync word, the check made by enI106Ch10Open().
+    bool hasSyncSignature(QFile& file)
+    {
+        uint16_t signature = 0;
+        return file.read(reinterpret_cast<char*>(&signature), sizeof(signature)) == sizeof(signature) &&
+               signature == IRIG106_SYNC;
+    }
+
+    /**
+     * @brief Guards the irig106 handle table.
+     *
+     * enI106Ch10Open() picks a free slot of the library's global handle table
+     * and enI106Ch10Close() releases it without any locking, so two sources
+     * opening at once (concurrent batch runs, window searches, background
+     * catalogs) could claim the same handle. Opens and closes are rare, so
+     * serializing them costs nothing measurable; reads use a handle's own
+     * slot and need no lock.
+     */
+    std::mutex& handleTableMutex()
+    {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    /**
+     * @brief Packets parsed in user space from bytes supplied by a subclass.
+     *
+     * Follows enI106Ch10ReadNextHeaderFile() step for step — sync word, header
+     * checksum, secondary header checksum, one I106_HEADER_CHKSUM_BAD report
+     * per loss of sync, then a byte-by-byte search — so every backend returns
+     * the same packet sequence for any input, corrupt or not.
+     *
+     * Bytes are only requested at or after the start of the header being
+     * tried, except after setPosition(), so a subclass may drop anything
+     * before the last requested offset.
+     */
+    class ParsedCh10Source : public Ch10PacketSource
+    {
+    public:
+        EnI106Status next(Ch10Packet& packet) override
+        {
+            if (m_state == State::Data)
+            {
+                // Skip the unread body. The library seeks, which drops sync, so
+                // a corrupt header right after a skipped body is not reported
+                m_position = m_packet_start + m_packet_len;
+                m_state = State::Unsynced;
+            }
+
+            std::array<uint8_t, HEADER_SIZE + SEC_HEADER_SIZE> bytes = {};
+            while (true)
+            {
+                const int64_t start = m_position;
+                if (start < 0 || start + HEADER_SIZE > m_size)
+                {
+                    m_state = State::Unsynced;
+                    m_position = m_size;
+                    return I106_EOF;
+                }
+                // Both headers at once, so a failed candidate never needs bytes before the next one
+                const auto available = static_cast<size_t>(std::min<int64_t>(bytes.size(), m_size - start));
+                if (!fetch(start, bytes.data(), available))
+                {
+                    m_state = State::Unsynced;
+                    return I106_READ_ERROR;
+                }
+                std::memcpy(&packet.header, bytes.data(), HEADER_SIZE);
+                m_position = start + HEADER_SIZE;
+
+                bool header_ok = packet.header.uSync == IRIG106_SYNC;
+                if (header_ok && packet.header.uChecksum != uCalcHeaderChecksum(&packet.header))
+                {
+                    if (m_state != State::Unsynced)
+                    {
+                        m_state = State::Unsynced;
+                        return I106_HEADER_CHKSUM_BAD;
+                    }
+                    header_ok = false;
+                }
+                if (header_ok && (packet.header.ubyPacketFlags & I106CH10_PFLAGS_SEC_HEADER) != 0)
+                {
+                    if (m_position + SEC_HEADER_SIZE > m_size)
+                    {
+                        m_state = State::Unsynced;
+                        m_position = m_size;
+                        return I106_EOF;
+                    }
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+                    std::memcpy(packet.header.abySecHdr, bytes.data() + HEADER_SIZE, SEC_HEADER_SIZE);
+                    m_position += SEC_HEADER_SIZE;
+                    if (packet.header.uSecChecksum != uCalcSecHeaderChecksum(&packet.header))
+                    {
+                        if (m_state != State::Unsynced)
+                        {
+                            m_state = State::Unsynced;
+                            return I106_HEADER_CHKSUM_BAD;
+                        }
+                        header_ok = false;
+                    }
+                }
+                if (header_ok)
+                {
+                    break;
+                }
+
+                // Not a header: search again one byte further on
+                m_state = State::Unsynced;
+                m_position = start + 1;
+            }
+
+            packet.offset = m_position - headerSize(packet.header);
+            packet.header_size = headerSize(packet.header);
+            packet.data_size = packet.header.ulPacketLen - packet.header_size;
+            packet.data = (packet.dataOffset() + packet.data_size <= m_size)
+                ? peek(packet.dataOffset())
+                : nullptr;
+            m_packet_start = packet.offset;
+            m_packet_len = packet.header.ulPacketLen;
+            m_state = State::Data;
+            return I106_OK;
+        }
+
+        EnI106Status readData(Ch10Packet& packet) override
+        {
+            if (m_state != State::Data)
+            {
+                m_state = State::Unsynced;
+                return I106_READ_ERROR;
+            }
+            if (packet.dataOffset() + packet.data_size > m_size)
+            {
+                // Body runs past the end of the file
+                m_state = State::Unsynced;
+                m_position = m_size;
+                return I106_EOF;
+            }
+            const EnI106Status status = readBody(packet.dataOffset(), packet.data_size, packet.data);
+            if (status != I106_OK)
+            {
+                packet.data = nullptr;
+                m_state = State::Unsynced;
+                return status;
+            }
+            m_position = packet.dataOffset() + packet.data_size;
+            m_state = State::Header;
+            return I106_OK;
+        }
+
+        bool setPosition(int64_t offset) override
+        {
+            if (offset < 0)
+            {
+                return false;
+            }
+            m_position = offset;
+            m_state = State::Unsynced;
+            return true;
+        }
+
+        int64_t position() const override { return m_position; }
+        int64_t size() const override { return m_size; }
+
+    protected:
+        /// Copies @p length bytes at @p offset (inside the file) to @p dst. @return false on a read error.
+        virtual bool fetch(int64_t offset, uint8_t* dst, size_t length) = 0;
+
+        /// Points @p body at @p length bytes at @p offset (inside the file). @return I106_OK or a read error.
+        virtual EnI106Status readBody(int64_t offset, uint32_t length, const uint8_t*& body) = 0;
+
+        /// @return The body at @p offset if it is available without reading, else nullptr.
+        virtual const uint8_t* peek(int64_t /*offset*/) const { return nullptr; }
+
+        void setSize(int64_t size) { m_size = size; }  ///< Sets the file size once opened.
+
+    private:
+        /// Read state, as in the library's handle table.
+        enum class State { Header, Data, Unsynced };
+
+        int64_t m_size = 0;           ///< File size in bytes.
+        int64_t m_position = 0;       ///< Next byte to parse.
+        int64_t m_packet_start = 0;   ///< Header offset of the current packet.
+        int64_t m_packet_len = 0;     ///< Length of the current packet.
+        State m_state = State::Header;
+    };
+
+    /// @brief Packets parsed in place from a copy-on-write whole-file mapping.
+    class MappedCh10Source : public ParsedCh10Source
+    {
+    public:
+        /// @return false if @p filename cannot be opened or mapped, or is not a Chapter 10 file.
+        bool open(const QString& filename)
+        {
+            m_file.setFileName(filename);
+            if (!m_file.open(QIODevice::ReadOnly) || !hasSyncSignature(m_file))
+            {
+                return false;
+            }
+            const int64_t size = m_file.size();
+            setSize(size);
+
+            // Private so the const views can be handed to the irig106 decoders,
+            // which take non-const buffers; they only read them
+            m_bytes = m_file.map(0, size, QFileDevice::MapPrivateOption);
+            if (m_bytes == nullptr)
+            {
+                return false;
+            }
+#ifndef _WIN32
+            // Hints only: read-ahead for a front-to-back pass, and huge pages
+            // where the kernel supports them for file mappings
+            madvise(m_bytes, static_cast<size_t>(size), MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+            madvise(m_bytes, static_cast<size_t>(size), MADV_HUGEPAGE);
+#endif
+#endif
+            return true;
+        }
+
+        Backend backend() const override { return Backend::Mapped; }
+        const uint8_t* fileBytes() const override { return m_bytes; }
+
+        void adviseSparseReads() override
+        {
+#ifndef _WIN32
+            madvise(m_bytes, static_cast<size_t>(size()), MADV_RANDOM);
+#endif
+        }
+
+        Ch10ReadStats readStats() const override
+        {
+            Ch10ReadStats stats;
+            stats.bytes = m_furthest;
+            return stats;
+        }
+
+    protected:
+        bool fetch(int64_t offset, uint8_t* dst, size_t length) override
+        {
+            std::memcpy(dst, m_bytes + offset, length); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            m_furthest = std::max(m_furthest, offset + static_cast<int64_t>(length));
+            return true;
+        }
+
+        EnI106Status readBody(int64_t offset, uint32_t length, const uint8_t*& body) override
+        {
+            body = m_bytes + offset; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            m_furthest = std::max(m_furthest, offset + static_cast<int64_t>(length));
+            return I106_OK;
+        }
+
+        const uint8_t* peek(int64_t offset) const override
+        {
+            return m_bytes + offset; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+    private:
+        QFile m_file;                 ///< Mapped file (kept open while mapped).
+        uint8_t* m_bytes = nullptr;   ///< Start of the mapping.
+        int64_t m_furthest = 0;       ///< End of the furthest bytes parsed.
+    };
+
+    /**
+     * @brief Packets parsed from large blocks read ahead on a background thread.
+     *
+     * The prefetch thread reads kPrefetchBlocks buffers of @c block_bytes in
+     * turn, starting at a block-aligned offset, and queues them on an
+     * SpscRing; the parser returns buffers it has moved past on a second ring.
+     * The parser holds at most two blocks (a header or body crossing a block
+     * edge), so the thread always has a buffer to fill. Bodies larger than a
+     * block are copied block by block. A position before the held blocks, or
+     * further ahead than the blocks in flight, restarts the thread there
+     * instead of reading the gap.
+     */
+    class PrefetchedCh10Source : public ParsedCh10Source
+    {
+    public:
+        explicit PrefetchedCh10Source(size_t block_bytes)
+            : m_block_bytes(static_cast<int64_t>(std::max(block_bytes, PCMConstants::kMinPrefetchBlockBytes)))
+        {
+            for (size_t b = 0; b < PCMConstants::kPrefetchBlocks; b++)
+            {
+                m_blocks.push_back(std::make_unique<Block>());
+                m_blocks.back()->bytes.resize(static_cast<size_t>(m_block_bytes));
+            }
+        }
+
+        ~PrefetchedCh10Source() override
+        {
+            stopPrefetch();
+        }
+
+        /// @return false if @p filename cannot be opened or is not a Chapter 10 file.
+        bool open(const QString& filename)
+        {
+            // Unbuffered: blocks go straight from read() into the ring buffers
+            m_file.setFileName(filename);
+            if (!m_file.open(QIODevice::ReadOnly | QIODevice::Unbuffered) || !hasSyncSignature(m_file))
+            {
+                return false;
+            }
+            setSize(m_file.size());
+            startPrefetch(0);
+            return true;
+        }
+
+        Backend backend() const override { return Backend::Prefetched; }
+
+        Ch10ReadStats readStats() const override
+        {
+            Ch10ReadStats stats;
+            stats.bytes = m_bytes_read.load(std::memory_order_relaxed);
+            stats.read_ns = m_read_ns.load(std::memory_order_relaxed);
+            stats.waits = m_waits + ((m_filled != nullptr) ? m_filled->emptyWaits() : 0);
+            return stats;
+        }
+
+    protected:
+        bool fetch(int64_t offset, uint8_t* dst, size_t length) override
+        {
+            // Keep the first byte's block: a failed header is retried one byte on
+            return copyOut(offset, dst, length, offset);
+        }
+
+        EnI106Status readBody(int64_t offset, uint32_t length, const uint8_t*& body) override
+        {
+            if (static_cast<qsizetype>(length) > PCMConstants::kMaxPacketBufferSize)
+            {
+                return I106_BUFFER_TOO_SMALL;
+            }
+            const Block* block = blockAt(offset, offset);
+            if (block == nullptr)
+            {
+                return I106_READ_ERROR;
+            }
+            const int64_t in_block = offset - block->offset;
+            if (in_block + length <= block->size)
+            {
+                body = block->bytes.data() + in_block; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                return I106_OK;
+            }
+
+            // Crosses a block edge: assemble it, releasing each block once copied
+            if (m_spill.size() < length)
+            {
+                m_spill.resize(length);
+            }
+            uint8_t* dst = m_spill.data();
+            int64_t at = offset;
+            size_t left = length;
+            while (left > 0)
+            {
+                const size_t piece = std::min<size_t>(left, static_cast<size_t>(m_block_bytes));
+                if (!copyOut(at, dst, piece, at))
+                {
+                    return I106_READ_ERROR;
+                }
+                dst += piece; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                at += static_cast<int64_t>(piece);
+                left -= piece;
+            }
+            body = m_spill.data();
+            return I106_OK;
+        }
+
+    private:
+        /// @brief One prefetched block of the file.
+        struct Block {
+            std::vector<uint8_t> bytes;   ///< Buffer of block_bytes.
+            int64_t offset = 0;           ///< File offset of bytes[0].
+            int64_t size = 0;             ///< Bytes read into the buffer.
+
+            int64_t end() const { return offset + size; }  ///< @return File offset after the block.
+        };
+
+        /**
+         * @brief Copies @p length bytes at @p offset to @p dst.
+         * @param[in] keep_from Bytes before this offset are no longer needed.
+         */
+        bool copyOut(int64_t offset, uint8_t* dst, size_t length, int64_t keep_from)
+        {
+            while (length > 0)
+            {
+                const Block* block = blockAt(offset, keep_from);
+                if (block == nullptr)
+                {
+                    return false;
+                }
+                const int64_t in_block = offset - block->offset;
+                const auto piece = static_cast<size_t>(std::min<int64_t>(static_cast<int64_t>(length),
+                                                                         block->size - in_block));
+                std::memcpy(dst, block->bytes.data() + in_block, piece); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                dst += piece;                                            // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                offset += static_cast<int64_t>(piece);
+                length -= piece;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns the held block containing @p offset, waiting for it if needed.
+         * @param[in] keep_from Blocks ending at or before this offset are handed back to the thread.
+         * @return The block, or nullptr if the file could not be read that far.
+         */
+        const Block* blockAt(int64_t offset, int64_t keep_from)
+        {
+            const int64_t held_from = m_held.empty() ? m_stream_end : m_held.front()->offset;
+            const auto in_flight = static_cast<int64_t>(PCMConstants::kPrefetchBlocks) * m_block_bytes;
+            if (offset < held_from || offset >= m_stream_end + in_flight)
+            {
+                startPrefetch(offset);
+            }
+
+            releaseBefore(keep_from);
+            while (m_held.empty() || m_held.back()->end() <= offset)
+            {
+                Block* block = nullptr;
+                if (!m_filled->pop(block))
+                {
+                    return nullptr;
+                }
+                m_held.push_back(block);
+                m_stream_end = block->end();
+                releaseBefore(keep_from);
+            }
+            for (const Block* block : m_held)
+            {
+                if (offset >= block->offset && offset < block->end())
+                {
+                    return block;
+                }
+            }
+            return nullptr;
+        }
+
+        /// Hands held blocks that end at or before @p offset back to the prefetch thread.
+        void releaseBefore(int64_t offset)
+        {
+            while (!m_held.empty() && m_held.front()->end() <= offset)
+            {
+                m_free->push(m_held.front());
+                m_held.pop_front();
+            }
+        }
+
+        /// (Re)starts the prefetch thread at the block containing @p offset.
+        void startPrefetch(int64_t offset)
+        {
+            stopPrefetch();
+            const int64_t aligned = offset - (offset % m_block_bytes);
+            m_filled = std::make_unique<SpscRing<Block*>>(PCMConstants::kPrefetchBlocks);
+            m_free = std::make_unique<SpscRing<Block*>>(PCMConstants::kPrefetchBlocks);
+            for (const auto& block : m_blocks)
+            {
+                m_free->push(block.get());
+            }
+            m_stream_end = aligned;
+            m_stop.store(false, std::memory_order_relaxed);
+            m_reader = std::thread([this, aligned]() { prefetch(aligned); });
+        }
+
+        /// Stops the prefetch thread and takes back every block.
+        void stopPrefetch()
+        {
+            if (!m_reader.joinable())
+            {
+                return;
+            }
+            m_stop.store(true, std::memory_order_release);
+            m_free->close();
+            m_filled->close();
+            m_reader.join();
+            m_waits += m_filled->emptyWaits();
+            m_held.clear();
+        }
+
+        /// Prefetch thread: reads consecutive blocks from @p offset until the end of the file.
+        void prefetch(int64_t offset)
+        {
+            const int64_t size = this->size();
+            if (!m_file.seek(offset))
+            {
+                m_filled->close();
+                return;
+            }
+            while (offset < size && !m_stop.load(std::memory_order_acquire))
+            {
+                Block* block = nullptr;
+                if (!m_free->pop(block) || m_stop.load(std::memory_order_acquire))
+                {
+                    break;
+                }
+
+                const int64_t wanted = std::min(m_block_bytes, size - offset);
+                const auto began = std::chrono::steady_clock::now();
+                int64_t got = 0;
+                while (got < wanted)
+                {
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    const qint64 count = m_file.read(reinterpret_cast<char*>(block->bytes.data()) + got, wanted - got);
+                    if (count <= 0)
+                    {
+                        break;
+                    }
+                    got += count;
+                }
+                const auto took = std::chrono::steady_clock::now() - began;
+                m_read_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(took).count(),
+                                    std::memory_order_relaxed);
+                m_bytes_read.fetch_add(got, std::memory_order_relaxed);
+
+                // A short block (read error or the file shrank) ends the stream
+                block->offset = offset;
+                block->size = got;
+                offset += got;
+                if (got == 0 || !m_filled->push(block) || got < wanted)
+                {
+                    break;
+                }
+            }
+            m_filled->close();
+        }
+
+        const int64_t m_block_bytes;                       ///< Block size and alignment.
+        QFile m_file;                                      ///< Input file (read by the prefetch thread only).
+        std::vector<std::unique_ptr<Block>> m_blocks;      ///< Every block buffer.
+        std::unique_ptr<SpscRing<Block*>> m_filled;        ///< Blocks read, in file order.
+        std::unique_ptr<SpscRing<Block*>> m_free;          ///< Blocks to read into.
+        std::deque<Block*> m_held;                         ///< Blocks the parser is using, in file order.
+        int64_t m_stream_end = 0;                          ///< End of the last block taken from m_filled.
+        std::vector<uint8_t> m_spill;                      ///< Bodies that cross a block edge.
+        std::thread m_reader;                              ///< Prefetch thread.
+        std::atomic<bool> m_stop{false};                   ///< Asks the prefetch thread to finish.
+        std::atomic<int64_t> m_bytes_read{0};              ///< Bytes read by the prefetch thread.
+        std::atomic<int64_t> m_read_ns{0};                 ///< Time spent in read().
+        uint64_t m_waits = 0;                              ///< Parser waits on rings already discarded.
+    };
+
+    /// @brief Packets read through the irig106 file handle into a reused buffer.
+    class LibraryCh10Source : public Ch10PacketSource
+    {
+    public:
+        ~LibraryCh10Source() override
+        {
+            if (m_handle >= 0)
+            {
+                const std::lock_guard<std::mutex> lock(handleTableMutex());
+                enI106Ch10Close(m_handle);
+            }
+        }
+
+        /// @return false if @p filename cannot be opened or is not a Chapter 10 file.
+        bool open(const QString& filename)
+        {
+            const QByteArray path = filename.toUtf8();
+            EnI106Status status;
+            {
+                const std::lock_guard<std::mutex> lock(handleTableMutex());
+                status = enI106Ch10Open(&m_handle, path.constData(), I106_READ);
+            }
+            if (status != I106_OK && status != I106_OPEN_WARNING)
+            {
+                m_handle = -1;
+                return false;
+            }
+            m_size = QFile(filename).size();
+            return true;
+        }
+
+        Backend backend() const override { return Backend::Library; }
+
+        EnI106Status next(Ch10Packet& packet) override
+        {
+            const EnI106Status status = enI106Ch10ReadNextHeader(m_handle, &packet.header);
+            if (status != I106_OK)
+            {
+                return status;
+            }
+            packet.header_size = headerSize(packet.header);
+            packet.offset = position() - packet.header_size;
+            packet.data_size = packet.header.ulPacketLen - packet.header_size;
+            packet.data = nullptr;
+            m_bytes_read += packet.header_size;
+            return I106_OK;
+        }
+
+        EnI106Status readData(Ch10Packet& packet) override
+        {
+            if (static_cast<qsizetype>(packet.data_size) > PCMConstants::kMaxPacketBufferSize)
+            {
+                return I106_BUFFER_TOO_SMALL;
+            }
+            if (m_buffer.size() < packet.data_size)
+            {
+                m_buffer.resize(packet.data_size);
+            }
+            const EnI106Status status = enI106Ch10ReadData(m_handle, static_cast<unsigned long>(m_buffer.size()),
+                                                           m_buffer.data());
+            packet.data = (status == I106_OK) ? m_buffer.data() : nullptr;
+            m_bytes_read += (status == I106_OK) ? packet.data_size : 0;
+            return status;
+        }
+
+        bool setPosition(int64_t offset) override
+        {
+            return enI106Ch10SetPos(m_handle, offset) == I106_OK;
+        }
+
+        int64_t position() const override
+        {
+            int64_t offset = 0;
+            enI106Ch10GetPos(m_handle, &offset);
+            return offset;
+        }
+
+        int64_t size() const override { return m_size; }
+
+        Ch10ReadStats readStats() const override
+        {
+            Ch10ReadStats stats;
+            stats.bytes = m_bytes_read;
+            return stats;
+        }
+
+    private:
+        int m_handle = -1;               ///< irig106 file handle.
+        int64_t m_size = 0;              ///< File size in bytes.
+        int64_t m_bytes_read = 0;        ///< Header and body bytes read.
+        std::vector<uint8_t> m_buffer;   ///< Body of the current packet (capacity reused).
+    };
+}
+
+std::unique_ptr<Ch10PacketSource> Ch10PacketSource::open(const QString& filename, Backend backend,
+                                                         size_t block_bytes)
+{
+    if (backend == Backend::Prefetched)
+    {
+        auto prefetched = std::make_unique<PrefetchedCh10Source>(block_bytes);
+        if (prefetched->open(filename))
+        {
+            return prefetched;
+        }
+        return nullptr;
+    }
+    if (backend == Backend::Mapped)
+    {
+        auto mapped = std::make_unique<MappedCh10Source>();
+        if (mapped->open(filename))
+        {
+            return mapped;
+        }
+    }
+
+    auto library = std::make_unique<LibraryCh10Source>();
+    if (library->open(filename))
+    {
+        return library;
+    }
+    return nullptr;
+}
+
+EnI106Status Ch10PacketSource::readAt(int64_t offset, Ch10Packet& packet)
+{
+    if (!setPosition(offset))
+    {
+        return I106_READ_ERROR;
+    }
+    const EnI106Status status = next(packet);
+    if (status != I106_OK)
+    {
+        return status;
+    }
+    if (packet.offset != offset)
+    {
+        return I106_READ_ERROR;
+    }
+    return readData(packet);
+}
+
+EnI106Status Ch10PacketSource::previous(int64_t end, Ch10Packet& packet, const PacketFilter& filter)
+{
+    end = std::min(end, size());
+    int64_t distance = PCMConstants::kBackwardSearchBytes;
+    while (true)
+    {
+        const int64_t start = std::max<int64_t>(0, end - distance);
+        if (!setPosition(start))
+        {
+            return I106_READ_ERROR;
+        }
+
+        // Walk the headers of the window; the last packet ending in it wins
+        bool found = false;
+        Ch10Packet candidate;
+        while (true)
+        {
+            const EnI106Status status = next(candidate);
+            if (status == I106_HEADER_CHKSUM_BAD)
+            {
+                continue;  // the next call resyncs
+            }
+            if (status == I106_EOF || (status == I106_OK && candidate.offset >= end))
+            {
+                break;
+            }
+            if (status != I106_OK)
+            {
+                return status;
+            }
+            if (candidate.offset + static_cast<int64_t>(candidate.header.ulPacketLen) <= end &&
+                (!filter || filter(candidate.header.uChID, candidate.header.ubyDataType)))
+            {
+                packet = candidate;
+                found = true;
+            }
+        }
+        if (found)
+        {
+            packet.data = nullptr;
+            return I106_OK;
+        }
+        if (start == 0)
+        {
+            return I106_BOF;
+        }
+        distance *= 2;
+    }
+}
+
+QString Ch10PacketSource::backendName(Backend backend)
+{
+    switch (backend)
+    {
+    case Backend::Mapped:
+        return QStringLiteral("memory-mapped");
+    case Backend::Prefetched:
+        return QStringLiteral("prefetched blocks");
+    case Backend::Library:
+        return QStringLiteral("irig106 read");
+    }
+    return {};
+}
+// End of file!
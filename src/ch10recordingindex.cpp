@@ -0,0 +1,226 @@
+/**
+ * @file ch10recordingindex.cpp
+ * @brief Implementation of Ch10RecordingIndex — root/node index packet decoding.
+ */
+
+#include "ch10recordingindex.h"
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "i106_time.h"
+
+using namespace Irig106;
+
+namespace {
+    /// @name Channel-specific data word of an index packet
+    /// @{
+    constexpr uint32_t kIndexTypeNode = 0x80000000;   ///< Bit 31: node index (clear for a root index).
+    constexpr uint32_t kFileSizePresent = 0x40000000; ///< Bit 30: file size follows the CSDW.
+    constexpr uint32_t kDataHeaderPresent = 0x20000000; ///< Bit 29: entries carry an intra-packet data header.
+    constexpr uint32_t kEntryCountMask = 0x0000FFFF;  ///< Bits 15-0: number of entries.
+    /// @}
+
+    constexpr size_t kTimeStampSize = 8;  ///< Intra-packet time stamp; an RTC uses its first 6 bytes.
+    constexpr size_t kRootEntrySize = kTimeStampSize + sizeof(int64_t);                    ///< Time, node offset.
+    constexpr size_t kNodeEntrySize = kTimeStampSize + sizeof(uint32_t) + sizeof(int64_t); ///< Time, channel/type, packet offset.
+
+    /// @return Little-endian value of type T at @p bytes.
+    template <typename T>
+    T readValue(const uint8_t* bytes)
+    {
+        T value = 0;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    /// @return Relative time of the RTC time stamp at @p bytes.
+    int64_t readRelTime(const uint8_t* bytes)
+    {
+        std::array<uint8_t, 6> rtc = {};
+        std::memcpy(rtc.data(), bytes, rtc.size());
+        int64_t rel_time = 0;
+        vTimeArray2LLInt(rtc.data(), &rel_time);
+        return rel_time;
+    }
+
+    /**
+     * @brief Checks the parts common to root and node packets.
+     * @param[in]  packet     Packet with its body read.
+     * @param[in]  node       true for a node packet, false for a root packet.
+     * @param[in]  entry_size Bytes per entry.
+     * @param[out] csdw       Channel-specific data word.
+     * @return Offset of the first entry in the body, or 0 if the packet is not of the expected kind and size.
+     */
+    size_t checkIndexPacket(const Ch10Packet& packet, bool node, size_t entry_size, uint32_t& csdw)
+    {
+        const uint32_t data_len = packet.header.ulDataLen;
+        if (packet.header.ubyDataType != I106CH10_DTYPE_RECORDING_INDEX || packet.data == nullptr ||
+            data_len > packet.data_size || data_len < sizeof(uint32_t) ||
+            (packet.header.ubyPacketFlags & I106CH10_PFLAGS_IPTIMESRC) != 0)
+        {
+            return 0;
+        }
+        csdw = readValue<uint32_t>(packet.data);
+        if (((csdw & kIndexTypeNode) != 0) != node || (csdw & kDataHeaderPresent) != 0)
+        {
+            return 0;
+        }
+        const size_t first_entry = sizeof(uint32_t) + (((csdw & kFileSizePresent) != 0) ? sizeof(int64_t) : 0);
+        const size_t count = csdw & kEntryCountMask;
+        return (count > 0 && data_len == first_entry + (count * entry_size)) ? first_entry : 0;
+    }
+}
+
+bool Ch10RecordingIndex::decodeRoot(const Ch10Packet& packet, Root& root)
+{
+    uint32_t csdw = 0;
+    const size_t first_entry = checkIndexPacket(packet, false, kRootEntrySize, csdw);
+    if (first_entry == 0)
+    {
+        return false;
+    }
+
+    root = Root();
+    if ((csdw & kFileSizePresent) != 0)
+    {
+        root.file_size = readValue<int64_t>(packet.data + sizeof(uint32_t));
+    }
+    // The last entry links to the previous root
+    const size_t count = csdw & kEntryCountMask;
+    for (size_t i = 0; i < count; i++)
+    {
+        const int64_t offset = readValue<int64_t>(packet.data + first_entry + (i * kRootEntrySize) + kTimeStampSize);
+        if (i + 1 < count)
+        {
+            root.node_offsets.push_back(offset);
+        }
+        else
+        {
+            root.previous_root = offset;
+        }
+    }
+    return true;
+}
+
+bool Ch10RecordingIndex::decodeNode(const Ch10Packet& packet, std::vector<Entry>& entries)
+{
+    uint32_t csdw = 0;
+    const size_t first_entry = checkIndexPacket(packet, true, kNodeEntrySize, csdw);
+    if (first_entry == 0)
+    {
+        return false;
+    }
+
+    const size_t count = csdw & kEntryCountMask;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint8_t* bytes = packet.data + first_entry + (i * kNodeEntrySize);
+        const auto channel_and_type = readValue<uint32_t>(bytes + kTimeStampSize);
+        Entry entry;
+        entry.rel_time = readRelTime(bytes);
+        entry.channel_id = static_cast<uint16_t>(channel_and_type & 0xFFFF);
+        entry.data_type = static_cast<uint8_t>((channel_and_type >> 16) & 0xFF);
+        entry.offset = readValue<int64_t>(bytes + kTimeStampSize + sizeof(uint32_t));
+        entries.push_back(entry);
+    }
+    return true;
+}
+
+bool Ch10RecordingIndex::read(Ch10PacketSource& source, Ch10PacketIndex& index)
+{
+    index.clear();
+    const int64_t file_size = source.size();
+
+    // The recording ends with a root index packet
+    Ch10Packet packet;
+    if (source.previous(file_size, packet) != I106_OK ||
+        packet.header.ubyDataType != I106CH10_DTYPE_RECORDING_INDEX)
+    {
+        return false;
+    }
+
+    // Follow the roots back to the first; each lists the nodes written since the one before
+    std::vector<std::vector<int64_t>> nodes_per_root;
+    int64_t root_offset = packet.offset;
+    while (true)
+    {
+        Root root;
+        if (source.readAt(root_offset, packet) != I106_OK || !decodeRoot(packet, root) || root.file_size > file_size)
+        {
+            return false;
+        }
+        nodes_per_root.push_back(std::move(root.node_offsets));
+        if (root.previous_root == root_offset)
+        {
+            break;
+        }
+        if (root.previous_root < 0 || root.previous_root > root_offset)
+        {
+            return false;
+        }
+        root_offset = root.previous_root;
+    }
+
+    // Nodes in file order, then their entries
+    std::vector<Entry> entries;
+    int64_t last_node = -1;
+    for (auto root = nodes_per_root.rbegin(); root != nodes_per_root.rend(); ++root)
+    {
+        for (const int64_t node_offset : *root)
+        {
+            if (node_offset <= last_node || node_offset >= file_size ||
+                source.readAt(node_offset, packet) != I106_OK || !decodeNode(packet, entries))
+            {
+                return false;
+            }
+            last_node = node_offset;
+        }
+    }
+    if (entries.empty())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].offset < 0 || entries[i].offset >= file_size ||
+            (i > 0 && entries[i].offset <= entries[i - 1].offset))
+        {
+            return false;
+        }
+    }
+
+    // Spot-check both ends of the list against the packets themselves
+    const auto listed = [&source, &packet](const Entry& entry) {
+        int64_t rel_time = 0;
+        if (!source.setPosition(entry.offset) || source.next(packet) != I106_OK || packet.offset != entry.offset)
+        {
+            return false;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        vTimeArray2LLInt(packet.header.aubyRefTime, &rel_time);
+        return packet.header.uChID == entry.channel_id && packet.header.ubyDataType == entry.data_type &&
+               rel_time == entry.rel_time;
+    };
+    if (!listed(entries.front()) || !listed(entries.back()))
+    {
+        return false;
+    }
+
+    // Recorders index data packets; the TMATS packet that opens the file is added if left out
+    if (entries.front().offset != 0 && source.setPosition(0) && source.next(packet) == I106_OK &&
+        packet.offset == 0 && packet.header.ubyDataType == I106CH10_DTYPE_TMATS)
+    {
+        int64_t rel_time = 0;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        vTimeArray2LLInt(packet.header.aubyRefTime, &rel_time);
+        index.append(0, rel_time, packet.header.uChID, packet.header.ubyDataType);
+    }
+    for (const Entry& entry : entries)
+    {
+        index.append(entry.offset, entry.rel_time, entry.channel_id, entry.data_type);
+    }
+    return true;
+}
+// End of file!
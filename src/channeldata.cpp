@@ -45,3 +45,8 @@ void ChannelData::incrementChannelCount()
 {
     m_channel_count++;
 }
+
+void ChannelData::setChannelCount(int channel_count)
+{
+    m_channel_count = channel_count;
+}
@@ -5,7 +5,16 @@
 
 #include "chapter10reader.h"
 
+#include <utility>
+#include <vector>
+
+#include "ch10packetindex.h"
+#include "ch10packetsource.h"
+#include "ch10recordingindex.h"
 #include "constants.h"
+#include "i106_decode_time.h"
+#include "irigtime.h"
+#include "tmatsdecode.h"
 
 using namespace Irig106;
 
@@ -13,10 +22,9 @@ Chapter10Reader::Chapter10Reader(QObject* parent) :
     QObject(parent),
     m_status(I106_OK),
     m_filename(""),
-    m_file_handle(0),
-    m_header(),
-    m_relative_start_time{},
-    m_relative_stop_time{},
+    m_time_ref(),
+    m_relative_start_time(0),
+    m_relative_stop_time(0),
     m_file_start_time(),
     m_file_stop_time(),
     m_time_difference(0),
@@ -25,11 +33,6 @@ Chapter10Reader::Chapter10Reader(QObject* parent) :
     m_current_time_channel(-1),
     m_current_pcm_channel(-1)
 {
-    m_buffer.resize(PCMConstants::kDefaultBufferSize);
-
-    // Initialize start/stop time structures to zero
-    memset(&m_file_start_time, 0, sizeof(tm));
-    memset(&m_file_stop_time, 0, sizeof(tm));
 }
 
 Chapter10Reader::~Chapter10Reader()
@@ -37,34 +40,6 @@ Chapter10Reader::~Chapter10Reader()
     qDeleteAll(m_channel_data);
 }
 
-bool Chapter10Reader::tryLoadingFile(const QString& filename)
-{
-    m_status = enI106Ch10Open(&m_file_handle, filename.toLocal8Bit().constData(), I106_READ);
-
-    if (m_status != I106_OK && m_status != I106_OPEN_WARNING)
-    {
-        emit displayErrorMessage(QString("Error opening data file."));
-        return false;
-    }
-
-    m_status = enI106_SyncTime(m_file_handle, bFALSE, 0);
-
-    if (m_status != I106_OK)
-    {
-        emit displayErrorMessage(QString("Error establishing time sync."));
-        return false;
-    }
-
-    m_filename = filename;
-
-    return true;
-}
-
-void Chapter10Reader::closeFile() const
-{
-    enI106Ch10Close(m_file_handle);
-}
-
 void Chapter10Reader::clearSettings()
 {
     qDeleteAll(m_channel_data);
@@ -75,13 +50,13 @@ void Chapter10Reader::clearSettings()
     m_current_pcm_channel = -1;
 }
 
-void Chapter10Reader::inferChannelTypeFromHeader(int channel_id)
+void Chapter10Reader::inferChannelTypeFromHeader(int channel_id, uint8_t data_type)
 {
     if (!m_channel_data[channel_id]->channelType().isEmpty())
     {
         return;
     }
-    if (m_header.ubyDataType == I106CH10_DTYPE_IRIG_TIME)
+    if (data_type == I106CH10_DTYPE_IRIG_TIME)
     {
         m_channel_data[channel_id]->setChannelType(PCMConstants::kChannelTypeTime);
         if (m_channel_data[channel_id]->channelName().isEmpty())
@@ -89,7 +64,7 @@ void Chapter10Reader::inferChannelTypeFromHeader(int channel_id)
             m_channel_data[channel_id]->setChannelName("Time");
         }
     }
-    else if (m_header.ubyDataType == I106CH10_DTYPE_PCM_FMT_1)
+    else if (data_type == I106CH10_DTYPE_PCM_FMT_1)
     {
         m_channel_data[channel_id]->setChannelType(PCMConstants::kChannelTypePcm);
         if (m_channel_data[channel_id]->channelName().isEmpty())
@@ -99,97 +74,262 @@ void Chapter10Reader::inferChannelTypeFromHeader(int channel_id)
     }
 }
 
+bool Chapter10Reader::indexPackets(Ch10PacketSource& source, Ch10PacketIndex& index)
+{
+    source.adviseSparseReads();
+
+    Ch10Packet packet;
+    int64_t next_offset = 0;  // where the next packet starts if nothing was skipped
+    bool contiguous = true;
+    while (true)
+    {
+        // Read the next header
+        m_status = source.next(packet);
+        if (m_status != I106_OK)
+        {
+            break;
+        }
+
+        if (static_cast<qsizetype>(packet.data_size) > PCMConstants::kMaxPacketBufferSize)
+        {
+            emit displayErrorMessage("Memory allocation failed.");
+            return false;
+        }
+
+        // Bodies are skipped; the catalog reads back the few it needs.
+        // A body running past the end of the file ends the pass, as a failed
+        // readData() would (the library reports that as I106_EOF).
+        if (packet.dataOffset() + packet.data_size > source.size())
+        {
+            return true;
+        }
+
+        index.append(packet);
+        contiguous = contiguous && packet.offset == next_offset;
+        next_offset = packet.offset + packet.header.ulPacketLen;
+    } // end while
+
+    // Only a gap-free pass to the end of the file is saved. Where the resync
+    // skipped bytes (corrupt headers), a full read could stop at an error that
+    // an indexed read would jump over, so such files are always read in full.
+    // The sidecar is a cache: a read-only directory just means no reuse.
+    if (m_status == I106_EOF && contiguous && next_offset == source.size())
+    {
+        index.save(m_filename);
+    }
+    return true;
+}
+
 bool Chapter10Reader::loadChannels(const QString& filename)
 {
     m_filename = filename;
-    QByteArray ba_filename = m_filename.toLocal8Bit();
-    char* psz_filename = ba_filename.data();
 
     // Open the file
-    m_status = enI106Ch10Open(&m_file_handle, psz_filename, I106_READ);
-    if (m_status != I106_OK)
+    const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(m_filename);
+    if (source == nullptr)
     {
         emit displayErrorMessage("Error opening file: " + m_filename);
         return false;
     }
 
-    // Establish time reference so enI106_Rel2IrigTime() can convert
-    // relative header timestamps to absolute IRIG time.
-    m_status = enI106_SyncTime(m_file_handle, bFALSE, 0);
+    // Catalog from the sidecar index, else from the recorder's own index
+    // (no walk over the file), else walk the file once to build the sidecar
+    Ch10PacketIndex index;
+    bool cataloged = false;
+    if (index.load(m_filename))
+    {
+        cataloged = catalogPackets(*source, index);
+    }
+    else
+    {
+        // A recording index that leaves out a channel TMATS declares is not trusted
+        cataloged = Ch10RecordingIndex::read(*source, index) && catalogPackets(*source, index) &&
+                    tmatsChannelsCataloged();
+        if (!cataloged)
+        {
+            index.clear();
+            if (!source->setPosition(0) || !indexPackets(*source, index))
+            {
+                return false;
+            }
+            cataloged = catalogPackets(*source, index);
+        }
+    }
+
+    if (!cataloged)
+    {
+        emit displayErrorMessage("Error establishing time sync.");
+        return false;
+    }
+
+    finalizeTimeCalc();
+    categorizeChannels();
+
+    return true;
+}
+
+bool Chapter10Reader::loadTimeRange(const QString& filename)
+{
+    m_filename = filename;
+    m_times_loaded = false;
+
+    const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(m_filename);
+    if (source == nullptr)
+    {
+        emit displayErrorMessage("Error opening file: " + m_filename);
+        return false;
+    }
+    source->adviseSparseReads();
+
+    // The first time packet from the head sets the time reference and the start time
+    Ch10Packet packet;
+    bool found_time = false;
+    while (!found_time && (m_status = source->next(packet)) == I106_OK)
+    {
+        found_time = packet.header.ubyDataType == I106CH10_DTYPE_IRIG_TIME;
+    }
+    if (!found_time || source->readData(packet) != I106_OK)
+    {
+        emit displayErrorMessage("Error establishing time sync.");
+        return false;
+    }
+    // The decoder only reads the buffer
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    enI106_Decode_TimeF1(&packet.header, const_cast<uint8_t*>(packet.data), &m_irig_time);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+    enI106_SetRelTime2(&m_time_ref, &m_irig_time, packet.header.aubyRefTime);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+    vTimeArray2LLInt(packet.header.aubyRefTime, &m_relative_start_time);
+
+    // The last time packet, searched for backwards from the tail; at worst the first one
+    m_status = source->previous(source->size(), packet, [](uint16_t /*channel_id*/, uint8_t data_type) {
+        return data_type == I106CH10_DTYPE_IRIG_TIME;
+    });
     if (m_status != I106_OK)
     {
         emit displayErrorMessage("Error establishing time sync.");
-        closeFile();
         return false;
     }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+    vTimeArray2LLInt(packet.header.aubyRefTime, &m_relative_stop_time);
+
+    finalizeTimeCalc();
+    return true;
+}
 
+void Chapter10Reader::takeChannels(Chapter10Reader& other)
+{
+    clearSettings();
+    m_channel_data.swap(other.m_channel_data);
+    m_time_channels.swap(other.m_time_channels);
+    m_pcm_channels.swap(other.m_pcm_channels);
+    std::swap(m_tmats_info, other.m_tmats_info);
+    m_current_time_channel = other.m_current_time_channel;
+    m_current_pcm_channel = other.m_current_pcm_channel;
+    other.m_current_time_channel = -1;
+    other.m_current_pcm_channel = -1;
+}
+
+bool Chapter10Reader::catalogPackets(Ch10PacketSource& source, const Ch10PacketIndex& index)
+{
     bool found_start_time = false;
+    bool found_time_ref = false;
     qDeleteAll(m_channel_data);
     m_channel_data.clear();
 
-    while (true)
+    // Flat per-channel tallies indexed by channel ID: packet counts, and the
+    // first time or PCM data type seen (0 until then) for the fallback type
+    std::vector<int> channel_counts(PCMConstants::kMaxChannelCount, 0);
+    std::vector<uint8_t> channel_types(PCMConstants::kMaxChannelCount, 0);
+
+    const std::vector<int64_t>& offsets = index.offsets();
+    const std::vector<int64_t>& rel_times = index.relativeTimes();
+    const std::vector<uint16_t>& channel_ids = index.channelIds();
+    const std::vector<uint8_t>& data_types = index.dataTypes();
+
+    Ch10Packet packet;
+    for (size_t i = 0; i < index.size(); i++)
     {
-        // Read the next header
-        m_status = enI106Ch10ReadNextHeader(m_file_handle, &m_header);
-        if (m_status == I106_EOF)
+        const uint8_t data_type = data_types[i];
+
+        // Only the first time packet and TMATS packets are read back for their bodies
+        const bool time_ref_packet = !found_time_ref && data_type == I106CH10_DTYPE_IRIG_TIME;
+        if (time_ref_packet || data_type == I106CH10_DTYPE_TMATS)
         {
-            break;
+            m_status = source.readAt(offsets[i], packet);
+            if (m_status != I106_OK)
+            {
+                break;
+            }
         }
 
-        if (m_status != I106_OK)
+        const uint16_t channel_id = channel_ids[i];
+        channel_counts[channel_id]++;
+        if (channel_types[channel_id] == 0 &&
+            (data_type == I106CH10_DTYPE_IRIG_TIME || data_type == I106CH10_DTYPE_PCM_FMT_1))
         {
-            break;
+            channel_types[channel_id] = data_type;
         }
 
-        // Make sure our buffer is big enough
-        if (m_buffer.size() < static_cast<qsizetype>(uGetDataLen(&m_header)))
+        // The first time packet relates header times to IRIG time, as enI106_SyncTime() would
+        if (time_ref_packet)
         {
-            try {
-                m_buffer.resize(uGetDataLen(&m_header));
-            } catch (const std::bad_alloc&) {
-                emit displayErrorMessage("Memory allocation failed.");
-                closeFile();
-                return false;
-            }
+            // The decoder only reads the buffer
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            enI106_Decode_TimeF1(&packet.header, const_cast<uint8_t*>(packet.data), &m_irig_time);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+            enI106_SetRelTime2(&m_time_ref, &m_irig_time, packet.header.aubyRefTime);
+            found_time_ref = true;
         }
 
-        // Read the data buffer
-        m_status = enI106Ch10ReadData(m_file_handle, static_cast<unsigned long>(m_buffer.size()), m_buffer.data());
+        processPacketTime(data_type, rel_times[i], found_start_time);
 
-        // Check for data read errors
-        if (m_status != I106_OK)
+        // Check for TMATS
+        if (data_type == I106CH10_DTYPE_TMATS)
         {
-            break;
+            if (!processTmatsPacket(packet.header, packet.data))
+            {
+                break;
+            }
         }
+    } // end for
 
-        int channel_id = m_header.uChID;
-
-        // If the channel is not in the map, add it
-        if (!m_channel_data.contains(channel_id))
+    // One entry per channel seen, typed from its headers until TMATS names it
+    for (int channel_id = 0; channel_id < PCMConstants::kMaxChannelCount; channel_id++)
+    {
+        const auto id = static_cast<size_t>(channel_id);
+        if (channel_counts[id] == 0)
         {
-            m_channel_data.insert(channel_id, new ChannelData(channel_id));
+            continue;
         }
-        m_channel_data[channel_id]->incrementChannelCount();
-
-        // Set channel type and fallback name from packet header when not already set by TMATS
-        inferChannelTypeFromHeader(channel_id);
+        auto* channel = new ChannelData(channel_id);
+        channel->setChannelCount(channel_counts[id]);
+        m_channel_data.insert(channel_id, channel);
+        inferChannelTypeFromHeader(channel_id, channel_types[id]);
+    }
 
-        processPacketTime(m_header, found_start_time);
+    return found_time_ref;
+}
 
-        // Check for TMATS
-        if (m_header.ubyDataType == I106CH10_DTYPE_TMATS)
+bool Chapter10Reader::tmatsChannelsCataloged() const
+{
+    for (const SuRRecord* record = m_tmats_info.psuFirstRRecord; record != nullptr; record = record->psuNext)
+    {
+        for (const SuRDataSource* data_source = record->psuFirstDataSource; data_source != nullptr;
+             data_source = data_source->psuNext)
         {
-            if (!processTmatsPacket(m_header))
+            if (data_source->szTrackNumber == nullptr || data_source->szChannelDataType == nullptr)
             {
-                break;
+                continue;
+            }
+            const QString type(data_source->szChannelDataType);
+            if ((type == PCMConstants::kChannelTypeTime || type == PCMConstants::kChannelTypePcm) &&
+                !m_channel_data.contains(atoi(data_source->szTrackNumber)))
+            {
+                return false;
             }
         }
-    } // end while
-
-    finalizeTimeCalc();
-    categorizeChannels();
-    closeFile();
-
+    }
     return true;
 }
 
@@ -223,78 +363,72 @@ QStringList Chapter10Reader::getPCMChannelComboBoxList() const
     return buildChannelComboBoxList(m_pcm_channels);
 }
 
-// DOY is 1-indexed, so add 1
 int Chapter10Reader::getStartDayOfYear() const
 {
-    return m_times_loaded ? m_file_start_time.tm_yday + 1 : 0;
+    return m_times_loaded ? m_file_start_time.ddd : 0;
 }
 
 int Chapter10Reader::getStartHour() const
 {
-    return m_times_loaded ? m_file_start_time.tm_hour : 0;
+    return m_times_loaded ? m_file_start_time.hh : 0;
 }
 
 int Chapter10Reader::getStartMinute() const
 {
-    return m_times_loaded ? m_file_start_time.tm_min : 0;
+    return m_times_loaded ? m_file_start_time.mm : 0;
 }
 
 int Chapter10Reader::getStartSecond() const
 {
-    return m_times_loaded ? m_file_start_time.tm_sec : 0;
+    return m_times_loaded ? m_file_start_time.ss : 0;
 }
 
-// DOY is 1-indexed, so add 1
 int Chapter10Reader::getStopDayOfYear() const
 {
-    return m_times_loaded ? m_file_stop_time.tm_yday + 1 : 0;
+    return m_times_loaded ? m_file_stop_time.ddd : 0;
 }
 
 int Chapter10Reader::getStopHour() const
 {
-    return m_times_loaded ? m_file_stop_time.tm_hour : 0;
+    return m_times_loaded ? m_file_stop_time.hh : 0;
 }
 
 int Chapter10Reader::getStopMinute() const
 {
-    return m_times_loaded ? m_file_stop_time.tm_min : 0;
+    return m_times_loaded ? m_file_stop_time.mm : 0;
 }
 
 int Chapter10Reader::getStopSecond() const
 {
-    return m_times_loaded ? m_file_stop_time.tm_sec : 0;
+    return m_times_loaded ? m_file_stop_time.ss : 0;
 }
 
-void Chapter10Reader::processPacketTime(Irig106::SuI106Ch10Header& header, bool& found_start_time)
+void Chapter10Reader::processPacketTime(uint8_t data_type, int64_t relative_time, bool& found_start_time)
 {
-    // If we haven't found a time yet, checks to see if this is one
-    if (!found_start_time)
+    if (data_type != I106CH10_DTYPE_IRIG_TIME)
     {
-        if (header.ubyDataType == I106CH10_DTYPE_IRIG_TIME)
-        {
-            found_start_time = true;
-            memcpy(m_relative_start_time.data(),
-                   &header.aubyRefTime[0],
-                   sizeof(m_relative_start_time));
-        }
+        return;
     }
 
-    // Always catch the last time, which will be the stop time
-    if (header.ubyDataType == I106CH10_DTYPE_IRIG_TIME)
+    // The first time packet is the start time
+    if (!found_start_time)
     {
-        memcpy(m_relative_stop_time.data(),
-               &header.aubyRefTime[0],
-               sizeof(m_relative_stop_time));
+        found_start_time = true;
+        m_relative_start_time = relative_time;
     }
+
+    // Always catch the last time, which will be the stop time
+    m_relative_stop_time = relative_time;
 }
 
-bool Chapter10Reader::processTmatsPacket(Irig106::SuI106Ch10Header& header)
+bool Chapter10Reader::processTmatsPacket(Irig106::SuI106Ch10Header& header, const uint8_t* data)
 {
     // Decode TMATS metadata into m_tmats_info for later use by applyTmatsNames().
     // Name/type application is deferred to categorizeChannels() so that all channels
     // are already in m_channel_data before the TMATS lookup runs.
     memset(&m_tmats_info, 0, sizeof(m_tmats_info));
-    m_status = enI106_Decode_Tmats(&header, m_buffer.data(), &m_tmats_info);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    m_status = TmatsDecode::decode(&header, const_cast<uint8_t*>(data), &m_tmats_info);
     return m_status == I106_OK;
 }
 
@@ -302,12 +436,12 @@ void Chapter10Reader::finalizeTimeCalc()
 {
     // Translate start and stop times
     SuIrig106Time start_real_time;
-    enI106_Rel2IrigTime(m_file_handle, m_relative_start_time.data(), &start_real_time);
-    gmtime_s(&m_file_start_time, &(start_real_time.ulSecs));
+    enI106_RelInt2IrigTime2(&m_time_ref, m_relative_start_time, &start_real_time);
+    m_file_start_time = IrigTime::toTimeFields(static_cast<int64_t>(start_real_time.ulSecs));
 
     SuIrig106Time stop_real_time;
-    enI106_Rel2IrigTime(m_file_handle, m_relative_stop_time.data(), &stop_real_time);
-    gmtime_s(&m_file_stop_time, &(stop_real_time.ulSecs));
+    enI106_RelInt2IrigTime2(&m_time_ref, m_relative_stop_time, &stop_real_time);
+    m_file_stop_time = IrigTime::toTimeFields(static_cast<int64_t>(stop_real_time.ulSecs));
 
     m_times_loaded = true;
 
@@ -317,10 +451,10 @@ void Chapter10Reader::finalizeTimeCalc()
                                     PCMConstants::kSecondsPerMinute;
 
     m_time_difference = start_real_time.ulSecs -
-        ((static_cast<uint64_t>(m_file_start_time.tm_yday) * seconds_in_day) +
-         (static_cast<uint64_t>(m_file_start_time.tm_hour) * PCMConstants::kMinutesPerHour * PCMConstants::kSecondsPerMinute) +
-         (static_cast<uint64_t>(m_file_start_time.tm_min) * PCMConstants::kSecondsPerMinute) +
-         static_cast<uint64_t>(m_file_start_time.tm_sec));
+        ((static_cast<uint64_t>(m_file_start_time.ddd - 1) * seconds_in_day) +
+         (static_cast<uint64_t>(m_file_start_time.hh) * PCMConstants::kMinutesPerHour * PCMConstants::kSecondsPerMinute) +
+         (static_cast<uint64_t>(m_file_start_time.mm) * PCMConstants::kSecondsPerMinute) +
+         static_cast<uint64_t>(m_file_start_time.ss));
 }
 
 void Chapter10Reader::applyTmatsNames()
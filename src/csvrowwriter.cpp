@@ -0,0 +1,131 @@
+/**
+ * @file csvrowwriter.cpp
+ * @brief Implementation of CsvRowWriter — to_chars row formatting and block writes.
+ */
+
+#include "csvrowwriter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#include <QIODevice>
+
+namespace {
+    // Longest value: sign, 6 digits, point, "e-308" and the separating comma
+    constexpr size_t kMaxValueChars = 16;
+    // Milliseconds and the line feed
+    constexpr size_t kMillisChars = 4;
+    // Significant digits of QString::number(double)
+    constexpr int kValuePrecision = 6;
+
+    /// Writes @p value as exactly two digits.
+    char* putTwoDigits(char* out, int value)
+    {
+        constexpr int kBase10 = 10;
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        out[0] = static_cast<char>('0' + (value / kBase10));
+        out[1] = static_cast<char>('0' + (value % kBase10));
+        return out + 2;
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+}
+
+CsvRowWriter::CsvRowWriter(QIODevice& output, size_t flush_bytes)
+    : m_output(output),
+      m_flush_bytes(flush_bytes)
+{
+}
+
+CsvRowWriter::~CsvRowWriter()
+{
+    flush();
+}
+
+void CsvRowWriter::cachePrefix(int64_t whole_seconds)
+{
+    const TimeFields t = m_day.fields(whole_seconds);
+
+    // Day-of-year as integer, time as HH:MM:SS. (milliseconds follow per row)
+    char* const begin = m_prefix.data();
+    char* const end = begin + m_prefix.size(); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    char* out = std::to_chars(begin, end, t.ddd).ptr;
+    *out++ = ','; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    out = putTwoDigits(out, t.hh);
+    *out++ = ':'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    out = putTwoDigits(out, t.mm);
+    *out++ = ':'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    out = putTwoDigits(out, t.ss);
+    *out++ = '.'; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    m_prefix_len = static_cast<size_t>(out - begin);
+    m_prefix_second = whole_seconds;
+}
+
+void CsvRowWriter::writeRow(int64_t time_ticks, const double* sums, size_t num_columns, int n_samples)
+{
+    // Round to the nearest millisecond, as the original row builder did
+    const int64_t rounded_ticks = time_ticks + PCMConstants::kTimeRoundingTicks;
+    const int64_t whole_seconds = rounded_ticks / PCMConstants::kTicksPerSecond;
+    const auto millis = static_cast<int>((rounded_ticks % PCMConstants::kTicksPerSecond) /
+                                         PCMConstants::kTicksPerMillisecond);
+    if (whole_seconds != m_prefix_second)
+    {
+        cachePrefix(whole_seconds);
+    }
+
+    // Room for the longest possible row; grows only for unusually wide rows
+    const size_t needed = m_prefix_len + kMillisChars + (num_columns * kMaxValueChars);
+    if (m_buffer.size() - m_used < needed)
+    {
+        m_buffer.resize(std::max(m_used + needed, m_flush_bytes + needed));
+    }
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    char* out = m_buffer.data() + m_used;
+    char* const end = m_buffer.data() + m_buffer.size();
+    std::memcpy(out, m_prefix.data(), m_prefix_len);
+    out += m_prefix_len;
+    constexpr int kHundreds = 100;
+    *out++ = static_cast<char>('0' + (millis / kHundreds));
+    out = putTwoDigits(out, millis % kHundreds);
+
+    const auto divisor = static_cast<double>(n_samples);
+    for (size_t c = 0; c < num_columns; c++)
+    {
+        *out++ = ',';
+        const double value = sums[c] / divisor;
+        if (std::isnan(value))
+        {
+            // QString::number() prints every NaN unsigned
+            std::memcpy(out, "nan", 3);
+            out += 3;
+        }
+        else
+        {
+            out = std::to_chars(out, end, value, std::chars_format::general, kValuePrecision).ptr;
+        }
+    }
+    *out++ = '\n';
+    m_used = static_cast<size_t>(out - m_buffer.data());
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    m_rows++;
+
+    if (m_used >= m_flush_bytes)
+    {
+        flush();
+    }
+}
+
+bool CsvRowWriter::flush()
+{
+    if (m_used == 0)
+    {
+        return true;
+    }
+    const auto size = static_cast<qint64>(m_used);
+    const bool ok = m_output.isOpen() && m_output.write(m_buffer.data(), size) == size;
+    m_used = 0;
+    return ok;
+}
+// End of file!
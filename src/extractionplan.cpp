@@ -0,0 +1,70 @@
+/**
+ * @file extractionplan.cpp
+ * @brief Implementation of ExtractionPlan — compiling enabled words into flat fields.
+ */
+
+#include "extractionplan.h"
+
+#include <algorithm>
+
+uint32_t ExtractionPlan::dataWordCount(uint32_t words_in_frame, uint32_t word_len)
+{
+    if (words_in_frame >= 2)
+    {
+        return words_in_frame - 1;
+    }
+    if (words_in_frame == 1 && word_len <= 1)
+    {
+        return 1;
+    }
+    return 0;
+}
+
+ExtractionPlan ExtractionPlan::compile(const std::vector<int>& column_words, uint32_t words_in_frame,
+                                       uint32_t word_len, uint64_t word_mask)
+{
+    const uint32_t step = (word_len == 0) ? 1 : word_len;
+    const uint32_t data_words = dataWordCount(words_in_frame, word_len);
+
+    ExtractionPlan plan;
+    plan.m_fields.reserve(column_words.size());
+    for (size_t column = 0; column < column_words.size(); column++)
+    {
+        const int word = column_words[column];
+        if (word < 0 || static_cast<uint32_t>(word) >= words_in_frame)
+        {
+            continue;
+        }
+
+        ExtractionField field;
+        field.word = static_cast<uint32_t>(word);
+        field.column = static_cast<uint32_t>(column);
+        if (field.word < data_words)
+        {
+            field.end_bit = (field.word + 1) * step;
+            field.mask = word_mask;
+        }
+        else
+        {
+            // Unfilled sync slot: constant zero, ordered after the data words
+            field.end_bit = data_words * step;
+        }
+        plan.m_fields.push_back(field);
+    }
+
+    // Offset order lets the synchronizer collect fields as the stream advances
+    std::stable_sort(plan.m_fields.begin(), plan.m_fields.end(),
+                     [](const ExtractionField& a, const ExtractionField& b) { return a.end_bit < b.end_bit; });
+    return plan;
+}
+
+ExtractionPlan ExtractionPlan::allWords(uint32_t words_in_frame, uint32_t word_len, uint64_t word_mask)
+{
+    std::vector<int> column_words(words_in_frame);
+    for (uint32_t w = 0; w < words_in_frame; w++)
+    {
+        column_words[w] = static_cast<int>(w);
+    }
+    return compile(column_words, words_in_frame, word_len, word_mask);
+}
+// End of file!
@@ -5,32 +5,253 @@
 
 #include "frameprocessor.h"
 
-#include <ctime>
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include <QByteArray>
 #include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QFuture>
+#include <QThread>
+#include <QThreadPool>
 #include <QVector>
+#include <QtConcurrent/QtConcurrent>
 
 #include "constants.h"
+#include "csvrowwriter.h"
+#include "extractionplan.h"
 #include "framesetup.h"
 #include "i106_decode_pcmf1.h"
 #include "i106_decode_time.h"
+#include "irigtime.h"
+#include "pcmframedecoder.h"
+#include "pcmframesync.h"
+#include "pcmpackettable.h"
+#include "rnrzldecoder.h"
+#include "spscring.h"
+#include "synccorrelator.h"
+#include "timebinaccumulator.h"
+#include "tmatsdecode.h"
 
 using namespace Irig106;
 
 namespace {
-    // Time threshold for gap detection in seconds
-    constexpr double kTimeGapThreshold = 2.0;
-    // Conversion factor from 100ns units to seconds
-    constexpr double k100NsToSeconds = 1.0e-7;
+    // Time threshold for gap detection (2 s in 100 ns ticks)
+    constexpr int64_t kTimeGapThresholdTicks = 2 * PCMConstants::kTicksPerSecond;
     // Percentage reporting intervals
     constexpr int kPercent100 = 100;
     constexpr int kPercent10 = 10;
+
+    /// @brief Packet handed from the read stage to the decode stage.
+    struct PacketSlot {
+        enum class Kind { Pcm, TimeReference };
+        Kind kind = Kind::Pcm;       ///< Payload type.
+        const uint8_t* payload = nullptr;  ///< PCM payload after the channel-specific word.
+        QByteArray data;             ///< Copy of the body when the source's views do not outlive the packet.
+        size_t num_bytes = 0;        ///< PCM payload bytes after the channel-specific word.
+        int64_t packet_time = 0;     ///< Header relative time (100 ns units).
+        SuTimeRef time_ref = {};     ///< New time reference (TimeReference slots only).
+    };
+
+    /// @brief Closed output bins handed from the decode stage to the write stage.
+    struct RowBatch {
+        std::vector<int64_t> times;  ///< Bin start times (100 ns ticks).
+        std::vector<int> samples;    ///< Frames per bin.
+        std::vector<double> sums;    ///< Column sums, num_columns per bin.
+        size_t num_columns = 0;      ///< Output columns.
+        size_t output = 0;           ///< Channel output (rate) the rows belong to.
+
+        /// Moves the closed bins of output @p index out of @p bins, reusing this batch's capacity.
+        void take(TimeBinAccumulator& bins, size_t index)
+        {
+            output = index;
+            num_columns = bins.columnCount();
+            times.clear();
+            samples.clear();
+            sums.clear();
+            for (size_t b = 0; b < bins.closedBins(); b++)
+            {
+                times.push_back(bins.binTime(b));
+                samples.push_back(bins.binSamples(b));
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                sums.insert(sums.end(), bins.binSums(b), bins.binSums(b) + num_columns);
+            }
+            bins.clearClosedBins();
+        }
+    };
+
+    /// @brief Queues and recycled buffers between the pipeline stages of one channel.
+    struct PipelineLane {
+        // Each buffer circulates between a data ring and a free ring, so the
+        // pools bound memory and a full downstream stage stalls upstream
+        std::vector<PacketSlot> packet_pool;  ///< Packet buffers.
+        std::vector<RowBatch> row_pool;       ///< Row batches.
+        SpscRing<PacketSlot*> packets;        ///< Read -> decode.
+        SpscRing<PacketSlot*> free_packets;   ///< Decode -> read.
+        SpscRing<RowBatch*> rows;             ///< Decode -> write.
+        SpscRing<RowBatch*> free_rows;        ///< Write -> decode.
+
+        PipelineLane()
+            : packet_pool(PCMConstants::kPipelinePacketSlots),
+              row_pool(PCMConstants::kPipelineRowBatches),
+              packets(packet_pool.size()),
+              free_packets(packet_pool.size()),
+              rows(row_pool.size()),
+              free_rows(row_pool.size())
+        {
+            for (auto& slot : packet_pool)
+            {
+                free_packets.push(&slot);
+            }
+            for (auto& batch : row_pool)
+            {
+                free_rows.push(&batch);
+            }
+        }
+    };
+
+    /// @brief Output of one parallel decode worker.
+    struct ChunkResult {
+        std::unique_ptr<PcmFrameDecoder> decoder;  ///< Decoder state after the chunk's last packet.
+        std::vector<TimeBinAccumulator> bins;      ///< Bins of the frames in the owned packets, per output.
+        PcmFrameStreamState entry_state;           ///< Synchronizer state entering the owned packets.
+        PcmDecodeCounters counters;                ///< Counters of the owned packets only.
+        uint64_t payload_bytes = 0;                ///< Payload bytes read, lead-in included.
+        bool ok = false;                           ///< False on abort.
+    };
+
+    /**
+     * @brief Random access to indexed PCM payloads for one decode worker.
+     *
+     * Payloads are views into the mapped input file, which any number of
+     * workers share; the bytes viewed are counted for the read statistics.
+     */
+    class PayloadReader
+    {
+    public:
+        /// @param[in] file_bytes Mapped input file.
+        explicit PayloadReader(const uint8_t* file_bytes)
+            : m_file_bytes(file_bytes)
+        {
+        }
+
+        /// @return The @p num_bytes of payload of @p entry.
+        const uint8_t* payload(const PcmPacketEntry& entry, qint64 num_bytes)
+        {
+            m_bytes_read += static_cast<uint64_t>(num_bytes);
+            const qint64 offset = entry.data_offset + static_cast<qint64>(sizeof(SuPcmF1_ChanSpec));
+            return m_file_bytes + offset; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+
+        uint64_t bytesRead() const { return m_bytes_read; } ///< @return Payload bytes viewed so far.
+
+    private:
+        const uint8_t* m_file_bytes;    ///< Mapped input file.
+        uint64_t m_bytes_read = 0;      ///< Payload bytes viewed so far.
+    };
+
+    /**
+     * @brief Decodes packets [first, end) of @p table read through @p reader.
+     * @return false on abort.
+     */
+    bool decodePackets(PayloadReader& reader, const PcmPacketTable& table, size_t first, size_t end,
+                       PcmFrameDecoder& decoder, std::vector<TimeBinAccumulator>& bins,
+                       const std::atomic<bool>& abort_requested)
+    {
+        constexpr auto kChanSpecBytes = static_cast<qint64>(sizeof(SuPcmF1_ChanSpec));
+        for (size_t i = first; i < end; i++)
+        {
+            if (abort_requested.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            const PcmPacketEntry& entry = table.packet(i);
+            const qint64 num_bytes = static_cast<qint64>(entry.data_len) - kChanSpecBytes;
+            const uint8_t* payload = reader.payload(entry, num_bytes);
+
+            decoder.setTimeReference(table.timeReference(entry.time_ref));
+            decoder.processPacket(payload, static_cast<size_t>(num_bytes), entry.packet_time, bins);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Worker body: primes a decoder on the lead-in packets, then decodes the chunk.
+     *
+     * Starting the decoder at the lead-in's global bit offset reproduces the
+     * serial frame positions; the lead-in re-seeds the self-synchronizing RNRZ-L
+     * descrambler (15 bits suffice) and lets frame sync reach lock before the
+     * owned packets, whose frames go into a fresh accumulator that records its
+     * first bin for the ordered merge.
+     */
+    std::shared_ptr<ChunkResult> decodeChunk(const uint8_t* file_bytes, const PcmDecodeSetup& setup,
+                                             const PcmPacketTable& table, PcmDecodeChunk chunk,
+                                             const std::atomic<bool>& abort_requested)
+    {
+        auto result = std::make_shared<ChunkResult>();
+        PayloadReader reader(file_bytes);
+        result->decoder = std::make_unique<PcmFrameDecoder>(setup);
+        result->decoder->reset(table.packet(chunk.lead_in).start_bit);
+        std::vector<TimeBinAccumulator> lead_in_bins = setup.makeAccumulators();
+        if (!decodePackets(reader, table, chunk.lead_in, chunk.first, *result->decoder,
+                           lead_in_bins, abort_requested))
+        {
+            return result;
+        }
+
+        result->entry_state = result->decoder->synchronizer().streamState();
+        const PcmDecodeCounters entry_counters = result->decoder->counters();
+        result->bins = setup.makeAccumulators();
+        for (auto& bins : result->bins)
+        {
+            bins.setRecordFirstBin(true);
+        }
+        if (!decodePackets(reader, table, chunk.first, chunk.end, *result->decoder,
+                           result->bins, abort_requested))
+        {
+            return result;
+        }
+
+        result->counters = result->decoder->counters() - entry_counters;
+        result->payload_bytes = reader.bytesRead();
+        result->ok = true;
+        return result;
+    }
 }
 
+/// @brief Decoder, bins and CSV outputs of one PCM channel within a processing run.
+struct FrameProcessor::ChannelRun {
+    /// @brief One CSV output of the channel, at one sample rate.
+    struct Output {
+        double sample_rate = 1;                ///< Output rows per second.
+        QFile file;                            ///< CSV output file.
+        std::unique_ptr<CsvRowWriter> writer;  ///< Row formatter and write buffer of file (while open).
+
+        /// Writes out the buffered rows and closes the file.
+        void close()
+        {
+            if (writer) { writer->flush(); }
+            if (file.isOpen()) { file.close(); }
+        }
+    };
+
+    PcmChannelParams params;                   ///< Channel, frame layout and output paths.
+    QString log_prefix;                        ///< Prefix for this channel's log lines (multi-channel runs).
+    QVector<ParameterInfo> parameters;         ///< Copies of the enabled parameters.
+    QVector<ParameterInfo*> enabled_params;    ///< Pointers into parameters, in column order.
+    std::vector<std::unique_ptr<Output>> outputs; ///< Outputs, the channel's own rate first.
+    PcmDecodeSetup setup;                      ///< Decoder and accumulator setup.
+    std::unique_ptr<PcmFrameDecoder> decoder;  ///< Decoder (serial pipeline; log details).
+    std::vector<TimeBinAccumulator> bins;      ///< Output bins, one accumulator per output.
+    PcmDecodeCounters totals;                  ///< Decode counters for the summary.
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 //                          IRIG106 HELPER METHODS                            //
 ////////////////////////////////////////////////////////////////////////////////
@@ -139,33 +360,7 @@ EnI106Status FrameProcessor::assembleAttributesFromTMATS(SuTmatsInfo* tmats_info
 // Static method
 void FrameProcessor::derandomizeBitstream(uint8_t* data, uint64_t total_bits, uint16_t& lfsr)
 {
-    // Constants for RNRZ-L derandomization
-    const uint16_t kLfsrMask = 0x7FFF;
-    const int kTap1 = 13;
-    const int kTap2 = 14;
-
-    for (uint64_t i = 0; i < total_bits; i++)
-    {
-        uint32_t byte_idx = static_cast<uint32_t>(i >> 3);
-        uint8_t bit_idx = static_cast<uint8_t>(7 - (i & 7));
-
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        int in_bit  = (data[byte_idx] >> bit_idx) & 1;
-        int lfsr_out_bit = ((lfsr >> kTap1) & 1) ^ ((lfsr >> kTap2) & 1);
-        int descrambled_bit = in_bit ^ lfsr_out_bit;
-        lfsr = ((lfsr << 1) | in_bit) & kLfsrMask;
-
-        if (descrambled_bit != 0)
-        {
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            data[byte_idx] |= static_cast<uint8_t>(1 << bit_idx);
-        }
-        else
-        {
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            data[byte_idx] &= static_cast<uint8_t>(~(1 << bit_idx));
-        }
-    }
+    RnrzlDecoder::derandomize(data, total_bits, lfsr);
 }
 
 // Static method
@@ -173,24 +368,8 @@ bool FrameProcessor::hasSyncPattern(const uint8_t* data, uint64_t total_bits,
                                     uint64_t sync_pat, uint64_t sync_mask,
                                     uint32_t sync_pat_len)
 {
-    uint64_t test_word = 0;
-    uint64_t bits_loaded = 0;
-    const uint8_t kHighBitMask = 0x80;
-
-    for (uint64_t i = 0; i < total_bits; i++)
-    {
-        uint32_t byte_idx = static_cast<uint32_t>(i / 8);
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        uint8_t bit_val = ((data[byte_idx] & (kHighBitMask >> (i % 8))) != 0) ? 1 : 0;
-        test_word = (test_word << 1) | bit_val;
-        bits_loaded++;
-        if (bits_loaded >= sync_pat_len &&
-            (test_word & sync_mask) == sync_pat)
-        {
-            return true;
-        }
-    }
-    return false;
+    const SyncCorrelator correlator(sync_pat, sync_mask);
+    return correlator.containsPattern(data, total_bits, sync_pat_len);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -199,14 +378,11 @@ bool FrameProcessor::hasSyncPattern(const uint8_t* data, uint64_t total_bits,
 
 FrameProcessor::FrameProcessor(QObject* parent)
     : QObject(parent),
+      m_time_ref{},
       m_total_file_size(0),
       m_abort_requested(false)
 {
-    putenv("TZ=GMT0");
-    tzset();
-
     m_channel_info.resize(PCMConstants::kMaxChannelCount, nullptr);
-    m_buffer.resize(PCMConstants::kDefaultBufferSize);
 }
 
 FrameProcessor::~FrameProcessor()
@@ -250,22 +426,22 @@ bool FrameProcessor::preScan(const ProcessingParams& params,
     }
 
     // Read TMATS (first packet)
-    m_status = enI106Ch10ReadNextHeader(m_file_handle, &m_header);
-    if (m_status != I106_OK || m_header.ubyDataType != I106CH10_DTYPE_TMATS)
+    m_status = m_source->next(m_packet);
+    if (m_status != I106_OK || m_packet.header.ubyDataType != I106CH10_DTYPE_TMATS)
     {
         emit logMessage("Pre-scan: skipped — could not read TMATS.");
         closeFile();
         return false;
     }
 
-    if (!ensureBufferCapacity(static_cast<qsizetype>(m_header.ulPacketLen)))
+    if (static_cast<qsizetype>(m_packet.header.ulPacketLen) > PCMConstants::kMaxPacketBufferSize)
     {
         emit logMessage("Pre-scan: skipped — memory allocation failed.");
         closeFile();
         return false;
     }
 
-    m_status = enI106Ch10ReadData(m_file_handle, static_cast<unsigned long>(m_buffer.size()), m_buffer.data());
+    m_status = m_source->readData(m_packet);
     if (m_status != I106_OK)
     {
         emit logMessage("Pre-scan: skipped — could not read TMATS data.");
@@ -274,7 +450,9 @@ bool FrameProcessor::preScan(const ProcessingParams& params,
     }
 
     memset(&m_tmats_info, 0, sizeof(m_tmats_info));
-    m_status = enI106_Decode_Tmats(&m_header, m_buffer.data(), &m_tmats_info);
+    // The decoder only reads the buffer
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    m_status = TmatsDecode::decode(&m_packet.header, const_cast<uint8_t*>(m_packet.data), &m_tmats_info);
     if (m_status != I106_OK)
     {
         emit logMessage("Pre-scan: skipped — could not decode TMATS.");
@@ -324,6 +502,11 @@ bool FrameProcessor::preScan(const ProcessingParams& params,
     uint64_t sync_mask = pcm_attrs->ullMinorFrameSyncMask;
     uint32_t sync_len  = pcm_attrs->ulMinorFrameSyncPatLen;
 
+    // Jump from one packet of the channel to the next when the file is indexed
+    selectIndexedPackets([pcm_channel_id](uint16_t channel_id, uint8_t data_type) {
+        return data_type == I106CH10_DTYPE_PCM_FMT_1 && channel_id == pcm_channel_id;
+    });
+
     // -----------------------------------------------------------------------
     // Pass 1: NRZ-L scan — check raw (non-randomized) data for frame sync.
     //         Cache the byte-swapped packet bytes for possible pass 2.
@@ -335,38 +518,41 @@ bool FrameProcessor::preScan(const ProcessingParams& params,
 
     while (pcm_packets_scanned < max_packets)
     {
-        m_status = enI106Ch10ReadNextHeader(m_file_handle, &m_header);
+        m_status = m_source->next(m_packet);
         if (m_status == I106_EOF || m_status != I106_OK)
         {
             break;
         }
 
-        if (m_header.ubyDataType != I106CH10_DTYPE_PCM_FMT_1 ||
-            m_header.uChID != pcm_channel_id)
+        if (m_packet.header.ubyDataType != I106CH10_DTYPE_PCM_FMT_1 ||
+            m_packet.header.uChID != pcm_channel_id)
         {
             continue;
         }
 
-        if (!ensureBufferCapacity(static_cast<qsizetype>(m_header.ulPacketLen)))
+        if (static_cast<qsizetype>(m_packet.header.ulPacketLen) > PCMConstants::kMaxPacketBufferSize)
         {
             break;
         }
 
-        m_status = enI106Ch10ReadData(m_file_handle, static_cast<unsigned long>(m_buffer.size()), m_buffer.data());
+        m_status = m_source->readData(m_packet);
         if (m_status != I106_OK)
         {
             break;
         }
 
         uint32_t data_offset = sizeof(SuPcmF1_ChanSpec);
-        if (m_header.ulDataLen <= data_offset)
+        if (m_packet.header.ulDataLen <= data_offset)
         {
             continue;
         }
 
+        // Swap a copy; the packet bytes may be the mapped file itself
+        uint32_t raw_len  = m_packet.header.ulDataLen - data_offset;
         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        auto* raw_data = reinterpret_cast<uint8_t*>(m_buffer.data() + data_offset);
-        uint32_t raw_len  = m_header.ulDataLen - data_offset;
+        QByteArray raw_packet(reinterpret_cast<const char*>(m_packet.data + data_offset),
+                              static_cast<qsizetype>(raw_len));
+        auto* raw_data = reinterpret_cast<uint8_t*>(raw_packet.data());
 
         if (pcm_attrs->bDontSwapRawData == 0)
         {
@@ -382,9 +568,7 @@ bool FrameProcessor::preScan(const ProcessingParams& params,
         }
 
         // Cache byte-swapped packet for RNRZ-L pass if needed.
-        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-        cached_packets.append(
-            QByteArray(reinterpret_cast<const char*>(raw_data), static_cast<qsizetype>(raw_len)));
+        cached_packets.append(raw_packet);
 
         pcm_packets_scanned++;
     }
@@ -455,48 +639,328 @@ bool FrameProcessor::preScan(const ProcessingParams& params,
 //                            FILE I/O                                        //
 ////////////////////////////////////////////////////////////////////////////////
 
-bool FrameProcessor::ensureBufferCapacity(qsizetype required)
+bool FrameProcessor::openFile(const QString& filename, Ch10PacketSource::Backend backend, size_t block_bytes)
 {
-    if (required > PCMConstants::kMaxPacketBufferSize)
+    m_source_timer.start();
+    m_worker_read_bytes = 0;
+    m_source = Ch10PacketSource::open(filename, backend, block_bytes);
+    m_packet_index.load(filename);
+    if (m_source == nullptr)
+    {
+        emit errorOccurred("Error opening data file.");
         return false;
-    if (m_buffer.size() >= required)
-        return true;
-    try {
-        m_buffer.resize(required);
-        return true;
-    } catch (const std::bad_alloc&) {
+    }
+
+    if (!syncTimeReference())
+    {
+        emit errorOccurred("Error establishing time sync.");
         return false;
     }
+
+    return true;
 }
 
-bool FrameProcessor::openFile(const QString& filename)
+bool FrameProcessor::syncTimeReference()
 {
-    m_status = enI106Ch10Open(&m_file_handle, filename.toUtf8().constData(), I106_READ);
+    const int64_t start_pos = m_source->position();
 
-    if (m_status != I106_OK && m_status != I106_OPEN_WARNING)
+    bool found = false;
+    while (m_source->next(m_packet) == I106_OK)
     {
-        emit errorOccurred("Error opening data file.");
-        return false;
+        if (m_packet.header.ubyDataType != I106CH10_DTYPE_IRIG_TIME)
+        {
+            continue;
+        }
+
+        if (static_cast<qsizetype>(m_packet.header.ulPacketLen) <= PCMConstants::kMaxPacketBufferSize &&
+            m_source->readData(m_packet) == I106_OK)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            enI106_Decode_TimeF1(&m_packet.header, const_cast<uint8_t*>(m_packet.data), &m_irig_time);
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+            enI106_SetRelTime2(&m_time_ref, &m_irig_time, m_packet.header.aubyRefTime);
+            found = true;
+        }
+        break;
     }
 
-    m_status = enI106_SyncTime(m_file_handle, bFALSE, 0);
+    return m_source->setPosition(start_pos) && found;
+}
+
+bool FrameProcessor::readTimePacket(int64_t& prev_time_ticks, int& time_gaps_detected)
+{
+    if (static_cast<qsizetype>(m_packet.header.ulPacketLen) > PCMConstants::kMaxPacketBufferSize)
+    {
+        emit errorOccurred("Memory allocation failed.");
+        return false;
+    }
 
+    m_status = m_source->readData(m_packet);
     if (m_status != I106_OK)
     {
-        emit errorOccurred("Error establishing time sync.");
+        emit errorOccurred("File read error; aborting parsing.");
         return false;
     }
 
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    enI106_Decode_TimeF1(&m_packet.header, const_cast<uint8_t*>(m_packet.data), &m_irig_time);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+    enI106_SetRelTime2(&m_time_ref, &m_irig_time, m_packet.header.aubyRefTime);
+
+    const int64_t pkt_ticks = (static_cast<int64_t>(m_irig_time.ulSecs) * PCMConstants::kTicksPerSecond) +
+                              static_cast<int64_t>(m_irig_time.ulFrac);
+    if (prev_time_ticks >= 0)
+    {
+        const int64_t gap_ticks = pkt_ticks - prev_time_ticks;
+        if (gap_ticks > kTimeGapThresholdTicks)
+        {
+            time_gaps_detected++;
+            const double gap = static_cast<double>(gap_ticks) / static_cast<double>(PCMConstants::kTicksPerSecond);
+            const TimeFields gap_time = IrigTime::toTimeFields(pkt_ticks / PCMConstants::kTicksPerSecond);
+            constexpr int kBase10 = 10;
+            emit logMessage(QString("WARNING: Time gap of %1s at DOY %2 %3:%4:%5")
+                .arg(gap, 0, 'f', 1)
+                .arg(gap_time.ddd, 3, kBase10, QChar('0'))
+                .arg(gap_time.hh, 2, kBase10, QChar('0'))
+                .arg(gap_time.mm, 2, kBase10, QChar('0'))
+                .arg(gap_time.ss, 2, kBase10, QChar('0')));
+        }
+    }
+    prev_time_ticks = pkt_ticks;
     return true;
 }
 
-void FrameProcessor::closeFile() const
+void FrameProcessor::reportProgress(int64_t position, int& last_reported_percent)
+{
+    const int64_t range = m_progress_end - m_progress_begin;
+    if (range <= 0)
+    {
+        return;
+    }
+
+    // The window's end is an estimate; reading may run a little past it
+    const int64_t pass_percent =
+        std::clamp<int64_t>((position - m_progress_begin) * kPercent100 / range, 0, kPercent100);
+    const int percent = static_cast<int>(((static_cast<int64_t>(m_pass) * kPercent100) + pass_percent) / m_pass_count);
+    if (percent != last_reported_percent)
+    {
+        if (percent / kPercent10 != last_reported_percent / kPercent10 && percent > 0)
+        {
+            emit logMessage(QString::number(percent) + "% complete...");
+        }
+        last_reported_percent = percent;
+        emit progressUpdated(percent);
+    }
+}
+
+void FrameProcessor::seekToWindow(const ProcessingParams& params)
+{
+    const int64_t from = m_source->position();
+    m_progress_begin = from;
+    m_progress_end = m_total_file_size;
+
+    // A few headers are read per step, anywhere in the file
+    const std::unique_ptr<Ch10PacketSource> search = Ch10PacketSource::open(params.filename);
+    if (search == nullptr)
+    {
+        return;
+    }
+    search->adviseSparseReads();
+
+    // Start early enough for frame lock to form before the window opens
+    const uint64_t margin = PCMConstants::kWindowMarginSeconds;
+    const int64_t start = (params.start_seconds > margin)
+        ? findTimePacket(*search, m_packet_index, params.time_channel_id, params.start_seconds - margin, from)
+        : -1;
+    if (start > from && m_source->setPosition(start))
+    {
+        m_progress_begin = start;
+        constexpr double kBytesPerMB = 1024.0 * 1024.0;
+        emit logMessage(QString("Time window: skipped %1 MB before the start time")
+                        .arg(static_cast<double>(start - from) / kBytesPerMB, 0, 'f', 1));
+    }
+
+    // Reading stops at the first time packet past the stop (pastWindow()); this one precedes it
+    const int64_t stop = findTimePacket(*search, m_packet_index, params.time_channel_id,
+                                        params.stop_seconds + margin, m_progress_begin);
+    if (stop > m_progress_begin)
+    {
+        m_progress_end = stop;
+    }
+}
+
+int64_t FrameProcessor::findTimePacket(Ch10PacketSource& source, const Ch10PacketIndex& index,
+                                       int time_channel_id, uint64_t seconds, int64_t from)
+{
+    int64_t offset = 0;
+    uint64_t packet_seconds = 0;
+    if (!index.isEmpty())
+    {
+        std::vector<int64_t> time_offsets;
+        const std::vector<int64_t>& offsets = index.offsets();
+        const std::vector<uint16_t>& channel_ids = index.channelIds();
+        const std::vector<uint8_t>& data_types = index.dataTypes();
+        for (size_t i = 0; i < offsets.size(); i++)
+        {
+            if (offsets[i] >= from && data_types[i] == I106CH10_DTYPE_IRIG_TIME && channel_ids[i] == time_channel_id)
+            {
+                time_offsets.push_back(offsets[i]);
+            }
+        }
+
+        // Time packets before lo are at or before seconds; those from hi on are after it
+        size_t lo = 0;
+        size_t hi = time_offsets.size();
+        while (lo < hi)
+        {
+            const size_t mid = lo + ((hi - lo) / 2);
+            if (!probeTimePacket(source, time_channel_id, time_offsets[mid], time_offsets[mid] + 1,
+                                 offset, packet_seconds))
+            {
+                return -1;
+            }
+            if (packet_seconds <= seconds)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+        return (lo > 0) ? time_offsets[lo - 1] : -1;
+    }
+
+    // No index: halve the byte range on the first time packet after its middle...
+    int64_t found = -1;
+    int64_t lo = from;
+    int64_t hi = source.size();
+    while (hi - lo > PCMConstants::kWindowSearchBytes)
+    {
+        const int64_t mid = lo + ((hi - lo) / 2);
+        if (probeTimePacket(source, time_channel_id, mid, hi, offset, packet_seconds) && packet_seconds <= seconds)
+        {
+            found = offset;
+            lo = offset;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    // ...then walk the time packets left in it
+    while (probeTimePacket(source, time_channel_id, lo, hi, offset, packet_seconds) && packet_seconds <= seconds)
+    {
+        found = offset;
+        lo = offset + 1;
+    }
+    return found;
+}
+
+bool FrameProcessor::probeTimePacket(Ch10PacketSource& source, int time_channel_id, int64_t from, int64_t to,
+                                     int64_t& offset, uint64_t& seconds)
+{
+    if (!source.setPosition(from))
+    {
+        return false;
+    }
+
+    Ch10Packet packet;
+    EnI106Status status = I106_OK;
+    while ((status = source.next(packet)) == I106_OK || status == I106_HEADER_CHKSUM_BAD)
+    {
+        if (status != I106_OK ||
+            (packet.offset < to && (packet.header.ubyDataType != I106CH10_DTYPE_IRIG_TIME ||
+                                    packet.header.uChID != time_channel_id)))
+        {
+            continue;
+        }
+        if (packet.offset >= to ||
+            static_cast<qsizetype>(packet.header.ulPacketLen) > PCMConstants::kMaxPacketBufferSize ||
+            source.readData(packet) != I106_OK)
+        {
+            return false;
+        }
+
+        SuIrig106Time irig_time = {};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        enI106_Decode_TimeF1(&packet.header, const_cast<uint8_t*>(packet.data), &irig_time);
+        offset = packet.offset;
+        seconds = irig_time.ulSecs;
+        return true;
+    }
+    return false;
+}
+
+bool FrameProcessor::pastWindow(const ProcessingParams& params) const
+{
+    return static_cast<uint64_t>(m_irig_time.ulSecs) > params.stop_seconds + PCMConstants::kWindowMarginSeconds;
+}
+
+std::vector<FrameProcessor::WindowPass> FrameProcessor::planWindowPasses(const QVector<TimeWindow>& windows)
+{
+    std::vector<WindowPass> passes;
+    for (const auto& window : windows)
+    {
+        if (!passes.empty() &&
+            window.start_seconds <= passes.back().stop_seconds + PCMConstants::kWindowMergeGapSeconds)
+        {
+            passes.back().stop_seconds = std::max(passes.back().stop_seconds, window.stop_seconds);
+            passes.back().windows++;
+        }
+        else
+        {
+            passes.push_back(WindowPass{window.start_seconds, window.stop_seconds, 1});
+        }
+    }
+    return passes;
+}
+
+void FrameProcessor::closeFile()
+{
+    m_source.reset();
+    m_packet_index.clear();
+}
+
+void FrameProcessor::selectIndexedPackets(const Ch10PacketIndex::PacketFilter& filter)
+{
+    if (m_packet_index.isEmpty())
+    {
+        return;
+    }
+    m_source = m_packet_index.selectPackets(std::move(m_source), filter);
+    emit logMessage(QString("Packet index: %1 packets indexed; reading the selected channels only")
+                    .arg(m_packet_index.size()));
+}
+
+void FrameProcessor::logReadThroughput()
 {
-    if (m_file_handle >= 0)
+    constexpr double kBytesPerMB = 1024.0 * 1024.0;
+    constexpr double kNsPerSec = 1e9;
+    const Ch10ReadStats stats = m_source->readStats();
+    const double megabytes = static_cast<double>(stats.bytes) / kBytesPerMB;
+    const double seconds = static_cast<double>(m_source_timer.nsecsElapsed()) / kNsPerSec;
+
+    QString message = QString("Packet source: %1 MB read in %2s, %3 MB/s (%4)")
+        .arg(megabytes, 0, 'f', 1)
+        .arg(seconds, 0, 'f', 2)
+        .arg((seconds > 0) ? megabytes / seconds : 0.0, 0, 'f', 1)
+        .arg(Ch10PacketSource::backendName(m_source->backend()));
+    if (stats.read_ns > 0)
+    {
+        // Storage rate alone, excluding time the reads overlapped with decoding
+        message += QString("; storage %1 MB/s, %2 waits for prefetched blocks")
+            .arg(megabytes / (static_cast<double>(stats.read_ns) / kNsPerSec), 0, 'f', 1)
+            .arg(stats.waits);
+    }
+    if (m_worker_read_bytes > 0)
     {
-        enI106Ch10Close(m_file_handle);
+        // The header scan only touches headers; the payloads are first read by the decode workers
+        message += QString("; %1 MB of payload read by decode workers")
+            .arg(static_cast<double>(m_worker_read_bytes) / kBytesPerMB, 0, 'f', 1);
     }
-    // Vector clears automatically
+    emit logMessage(message);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -507,23 +971,43 @@ void FrameProcessor::closeFile() const
 bool FrameProcessor::process(const ProcessingParams& params, FrameSetup* frame_setup)
 {
     const auto& filename            = params.filename;
-    const auto& outfile             = params.outfile;
     const int   time_channel_id     = params.time_channel_id;
-    const int   pcm_channel_id      = params.pcm_channel_id;
-    const auto  frame_sync          = params.frame_sync;
-    const int   sync_pattern_len    = params.sync_pattern_length;
-    const int   words_in_minor_frame = params.words_in_minor_frame;
-    const int   bits_in_minor_frame = params.bits_in_minor_frame;
-    const auto  start_seconds       = params.start_seconds;
-    const auto  stop_seconds        = params.stop_seconds;
-    const int   sample_rate         = params.sample_rate;
-    const bool  is_randomized       = params.is_randomized;
+    const double sample_rate        = params.sample_rate;
+
+    // Several windows replace the single one; the run spans them all
+    const QVector<TimeWindow>& windows = params.windows;
+    const auto  start_seconds = windows.isEmpty() ? params.start_seconds : windows.front().start_seconds;
+    const auto  stop_seconds  = windows.isEmpty()
+        ? params.stop_seconds
+        : std::max_element(windows.begin(), windows.end(), [](const TimeWindow& a, const TimeWindow& b) {
+              return a.stop_seconds < b.stop_seconds;
+          })->stop_seconds;
 
     QElapsedTimer elapsed_timer;
     elapsed_timer.start();
 
     m_total_file_size = QFileInfo(filename).size();
-    int last_reported_percent = -1;
+
+    // The selected channel first, then the channels decoded alongside it
+    PcmChannelParams primary;
+    primary.pcm_channel_id       = params.pcm_channel_id;
+    primary.frame_sync           = params.frame_sync;
+    primary.sync_pattern_length  = params.sync_pattern_length;
+    primary.words_in_minor_frame = params.words_in_minor_frame;
+    primary.bits_in_minor_frame  = params.bits_in_minor_frame;
+    primary.is_randomized        = params.is_randomized;
+    primary.frame_setup          = frame_setup;
+    primary.outfile              = params.outfile;
+    primary.extra_rates          = params.extra_rates;
+    QVector<PcmChannelParams> channels{primary};
+    channels += params.extra_pcm_channels;
+
+    // Rates below one rate step would round to zero bins; both comparisons are false for NaN
+    const double min_rate = 1.0 / static_cast<double>(PCMConstants::kSampleRateSteps);
+    auto valid_rate = [min_rate](double rate) { return rate >= min_rate && rate <= PCMConstants::kMaxSampleRate; };
+    const QString rate_error = QString("Sample rate must be at least %1 Hz and at most %2 Hz.")
+                                   .arg(min_rate)
+                                   .arg(PCMConstants::kMaxSampleRate);
 
     // Validate channel IDs before using them as array indices
     if (time_channel_id < 0 || time_channel_id >= PCMConstants::kMaxChannelCount)
@@ -532,90 +1016,186 @@ bool FrameProcessor::process(const ProcessingParams& params, FrameSetup* frame_s
         emit processingFinished(false);
         return false;
     }
-    if (pcm_channel_id < 0 || pcm_channel_id >= PCMConstants::kMaxChannelCount)
+    for (const auto& channel : std::as_const(channels))
+    {
+        if (channel.pcm_channel_id < 0 || channel.pcm_channel_id >= PCMConstants::kMaxChannelCount)
+        {
+            emit errorOccurred("PCM channel ID is out of range.");
+            emit processingFinished(false);
+            return false;
+        }
+        if (channel.frame_setup == nullptr)
+        {
+            emit errorOccurred("No frame setup for PCM channel " + QString::number(channel.pcm_channel_id) + ".");
+            emit processingFinished(false);
+            return false;
+        }
+        for (const auto& rate : channel.extra_rates)
+        {
+            if (!valid_rate(rate.sample_rate))
+            {
+                emit errorOccurred(rate_error);
+                emit processingFinished(false);
+                return false;
+            }
+        }
+    }
+    if (!valid_rate(sample_rate))
+    {
+        emit errorOccurred(rate_error);
+        emit processingFinished(false);
+        return false;
+    }
+    if (!windows.isEmpty() && (!params.extra_rates.isEmpty() || !params.extra_pcm_channels.isEmpty()))
     {
-        emit errorOccurred("PCM channel ID is out of range.");
+        emit errorOccurred("Extraction windows cannot be combined with extra output rates or PCM channels.");
         emit processingFinished(false);
         return false;
     }
+    for (qsizetype w = 0; w < windows.size(); w++)
+    {
+        if (windows[w].start_seconds > windows[w].stop_seconds ||
+            (w > 0 && windows[w].start_seconds < windows[w - 1].start_seconds))
+        {
+            emit errorOccurred("Extraction windows must be in start order and each must start before it stops.");
+            emit processingFinished(false);
+            return false;
+        }
+    }
 
     // Clear channel info for this run
     freeChanInfoTable(m_channel_info);
 
     // Open input file and sync time
     emit logMessage("Opening Chapter 10 file...");
-    if (!openFile(filename))
+    if (!openFile(filename, params.packet_source, params.prefetch_block_bytes))
     {
         emit errorOccurred("Failed to load Chapter 10 file.");
         emit processingFinished(false);
         return false;
     }
+    emit logMessage("Packet source: " + Ch10PacketSource::backendName(m_source->backend()));
 
-    // Open output file
+    // Open output files
     emit logMessage("Creating output CSV file...");
-    QFile output(outfile);
-    if (!output.open(QIODevice::WriteOnly))
+    ChannelRuns runs;
+    for (const auto& channel : std::as_const(channels))
     {
-        emit errorOccurred("Failed to open output file: " + outfile);
-        closeFile();
-        emit processingFinished(false);
-        return false;
+        auto run = std::make_unique<ChannelRun>();
+        run->params = channel;
+        if (channels.size() > 1)
+        {
+            run->log_prefix = QString("PCM channel %1: ").arg(channel.pcm_channel_id);
+        }
+        QVector<RateOutput> rates{RateOutput{sample_rate, channel.outfile}};
+        rates += channel.extra_rates;
+        if (!windows.isEmpty())
+        {
+            // One output per window instead (windows come without other outputs)
+            rates.clear();
+            for (const auto& window : windows)
+            {
+                rates.push_back(RateOutput{sample_rate, window.outfile});
+            }
+        }
+        for (const auto& rate : std::as_const(rates))
+        {
+            auto output = std::make_unique<ChannelRun::Output>();
+            output->sample_rate = rate.sample_rate;
+            output->file.setFileName(rate.outfile);
+            run->outputs.push_back(std::move(output));
+        }
+        runs.push_back(std::move(run));
     }
 
     // Cleanup helper for error paths
+    auto close_outputs = [&runs]() {
+        for (auto& run : runs)
+        {
+            for (auto& output : run->outputs)
+            {
+                output->close();
+            }
+        }
+    };
     auto fail = [&](const QString& msg) -> bool {
         emit errorOccurred(msg);
-        if (output.isOpen()) { output.close(); }
+        close_outputs();
         closeFile();
         emit processingFinished(false);
         return false;
     };
 
-    // Pre-cache enabled parameters to avoid repeated iteration in hot loops
-    QVector<ParameterInfo*> enabled_params;
-    enabled_params.reserve(frame_setup->length());
-    for (int i = 0; i < frame_setup->length(); i++)
+    for (auto& run : runs)
     {
-        ParameterInfo* param = frame_setup->getParameter(i);
-        if (param->is_enabled)
+        for (auto& output : run->outputs)
         {
-            enabled_params.push_back(param);
+            if (!output->file.open(QIODevice::WriteOnly))
+            {
+                return fail("Failed to open output file: " + output->file.fileName());
+            }
+            output->writer = std::make_unique<CsvRowWriter>(output->file);
         }
     }
 
-    // Write CSV header
-    QString header_line = QStringLiteral("Day,Time");
-    for (const auto* param : enabled_params)
+    for (auto& run : runs)
     {
-        header_line += ',' + param->name;
-    }
-    header_line += '\n';
-    output.write(header_line.toUtf8());
-
-    // Read and process the first packet (must be TMATS)
-    emit logMessage("Reading TMATS metadata...");
-    m_status = enI106Ch10ReadNextHeader(m_file_handle, &m_header);
+        // Copy the enabled parameters; each run keeps its own sample_sum scratch
+        const FrameSetup* channel_setup = run->params.frame_setup;
+        run->parameters.reserve(channel_setup->length());
+        for (int i = 0; i < channel_setup->length(); i++)
+        {
+            const ParameterInfo* param = channel_setup->getParameter(i);
+            if (param->is_enabled)
+            {
+                run->parameters.push_back(*param);
+                run->parameters.back().sample_sum = 0;
+            }
+        }
+        for (auto& param : run->parameters)
+        {
+            run->enabled_params.push_back(&param);
+        }
+
+        // Write CSV header
+        QString header_line = QStringLiteral("Day,Time");
+        for (const auto* param : std::as_const(run->enabled_params))
+        {
+            header_line += ',' + param->name;
+        }
+        header_line += '\n';
+        const QByteArray header_bytes = header_line.toUtf8();
+        for (auto& output : run->outputs)
+        {
+            output->file.write(header_bytes);
+        }
+    }
+
+    // Read and process the first packet (must be TMATS)
+    emit logMessage("Reading TMATS metadata...");
+    m_status = m_source->next(m_packet);
 
     if (m_status != I106_OK)
     {
         return fail("Failed to read first header.");
     }
 
-    if (m_header.ubyDataType == I106CH10_DTYPE_TMATS)
+    if (m_packet.header.ubyDataType == I106CH10_DTYPE_TMATS)
     {
-        if (!ensureBufferCapacity(static_cast<qsizetype>(m_header.ulPacketLen)))
+        if (static_cast<qsizetype>(m_packet.header.ulPacketLen) > PCMConstants::kMaxPacketBufferSize)
         {
             return fail("Memory allocation failed.");
         }
 
-        m_status = enI106Ch10ReadData(m_file_handle, static_cast<unsigned long>(m_buffer.size()), m_buffer.data());
+        m_status = m_source->readData(m_packet);
         if (m_status != I106_OK)
         {
             return fail("Failed to read data from first header.");
         }
 
         memset(&m_tmats_info, 0, sizeof(m_tmats_info));
-        m_status = enI106_Decode_Tmats(&m_header, m_buffer.data(), &m_tmats_info);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        m_status = TmatsDecode::decode(&m_packet.header, const_cast<uint8_t*>(m_packet.data), &m_tmats_info);
         if (m_status != I106_OK)
         {
             return fail("Failed to process TMATS info from first header.");
@@ -632,98 +1212,346 @@ bool FrameProcessor::process(const ProcessingParams& params, FrameSetup* frame_s
         return fail("Failed to find TMATS message.");
     }
 
-    // Set up PCM attributes for the selected channel
+    // Set up PCM attributes and a frame decoder for each channel
     emit logMessage("Setting up PCM attributes...");
-    if (m_channel_info[pcm_channel_id] == nullptr)
+    for (auto& run : runs)
     {
-        return fail("Channel info not set up for selected PCM channel.");
+        const PcmChannelParams& channel = run->params;
+        if (m_channel_info[channel.pcm_channel_id] == nullptr)
+        {
+            return fail("Channel info not set up for selected PCM channel.");
+        }
+
+        auto* pcm_attrs = static_cast<SuPcmF1_Attributes*>(m_channel_info[channel.pcm_channel_id]->psuAttributes);
+        if (pcm_attrs == nullptr)
+        {
+            return fail("Unable to load PCM attributes.");
+        }
+
+        Set_Attributes_Ext_PcmF1(pcm_attrs->psuRDataSrc, pcm_attrs,
+                                  -1, // lRecordNum
+                                  -1, // lBitsPerSec
+                                  PCMConstants::kCommonWordLen,
+                                  -1, // lWordTransferOrder
+                                  -1, // lParityType
+                                  -1, // lParityTransferOrder
+                                  PCMConstants::kNumMinorFrames,
+                                  channel.words_in_minor_frame,
+                                  channel.bits_in_minor_frame,
+                                  -1, // lMinorFrameSyncType
+                                  channel.sync_pattern_length,
+                                  static_cast<int64_t>(channel.frame_sync), // llMinorFrameSyncPat
+                                  -1, // lMinSyncs
+                                  -1, // llMinorFrameSyncMask
+                                  -1); // lNoByteSwap (use TMATS default)
+
+        PcmDecodeSetup& setup = run->setup;
+        PcmFrameSyncConfig& sync_config = setup.sync;
+        sync_config.sync_pat = pcm_attrs->ullMinorFrameSyncPat;
+        sync_config.sync_mask = pcm_attrs->ullMinorFrameSyncMask;
+        sync_config.sync_pat_len = pcm_attrs->ulMinorFrameSyncPatLen;
+        sync_config.bits_in_frame = pcm_attrs->ulBitsInMinorFrame;
+        sync_config.words_in_frame = pcm_attrs->ulWordsInMinorFrame;
+        sync_config.word_len = pcm_attrs->ulCommonWordLen;
+        sync_config.word_mask = pcm_attrs->ullCommonWordMask;
+        sync_config.min_syncs = pcm_attrs->ulMinSyncs;
+        sync_config.swap_bytes = (pcm_attrs->bDontSwapRawData == 0); // library default: swap
+        sync_config.randomized = channel.is_randomized; // determined by preScan encoding result
+        sync_config.lock_misses = params.lock_misses;
+        setup.engine = params.sync_engine;
+
+        // Compile the words to extract: one field per enabled parameter column
+        const QVector<ParameterInfo*>& enabled_params = run->enabled_params;
+        std::vector<int> column_words;
+        column_words.reserve(static_cast<size_t>(enabled_params.size()));
+        for (const auto* param : enabled_params)
+        {
+            column_words.push_back(param->word);
+        }
+        setup.plan = ExtractionPlan::compile(column_words, sync_config.words_in_frame,
+                                             sync_config.word_len, sync_config.word_mask);
+        for (size_t f = 0; f < setup.plan.size(); f++)
+        {
+            const ParameterInfo* param = enabled_params[static_cast<int>(setup.plan.field(f).column)];
+            setup.slopes.push_back(param->slope);
+            setup.scales.push_back(param->scale);
+        }
+        setup.delta_100ns = pcm_attrs->dDelta100NanoSeconds;
+        setup.start_seconds = start_seconds;
+        setup.stop_seconds = stop_seconds;
+        setup.sample_rates.clear();
+        for (const auto& output : run->outputs)
+        {
+            setup.sample_rates.push_back(output->sample_rate);
+        }
+        setup.windows.clear();
+        for (const auto& window : windows)
+        {
+            setup.windows.emplace_back(window.start_seconds, window.stop_seconds);
+        }
+        setup.num_columns = static_cast<size_t>(enabled_params.size());
+
+        run->decoder = std::make_unique<PcmFrameDecoder>(setup);
+        run->bins = setup.makeAccumulators();
     }
 
-    auto* pcm_attrs = static_cast<SuPcmF1_Attributes*>(m_channel_info[pcm_channel_id]->psuAttributes);
-    if (pcm_attrs == nullptr)
+    // With an index, only the time channel and the decoded PCM channels are read
+    std::vector<bool> pcm_selected(PCMConstants::kMaxChannelCount, false);
+    for (const auto& run : runs)
     {
-        return fail("Unable to load PCM attributes.");
+        pcm_selected[static_cast<size_t>(run->params.pcm_channel_id)] = true;
     }
+    selectIndexedPackets([&pcm_selected, time_channel_id](uint16_t channel_id, uint8_t data_type) {
+        return (data_type == I106CH10_DTYPE_IRIG_TIME && channel_id == time_channel_id) ||
+               (data_type == I106CH10_DTYPE_PCM_FMT_1 && pcm_selected[channel_id]);
+    });
 
-    Set_Attributes_Ext_PcmF1(pcm_attrs->psuRDataSrc, pcm_attrs,
-                              -1, // lRecordNum
-                              -1, // lBitsPerSec
-                              PCMConstants::kCommonWordLen,
-                              -1, // lWordTransferOrder
-                              -1, // lParityType
-                              -1, // lParityTransferOrder
-                              PCMConstants::kNumMinorFrames,
-                              words_in_minor_frame,
-                              bits_in_minor_frame,
-                              -1, // lMinorFrameSyncType
-                              sync_pattern_len,
-                              static_cast<int64_t>(frame_sync), // llMinorFrameSyncPat
-                              -1, // lMinSyncs
-                              -1, // llMinorFrameSyncMask
-                              -1); // lNoByteSwap (use TMATS default)
+    // Time gap detection
+    int time_gaps_detected = 0;
 
     // -----------------------------------------------------------------------
-    // Set up frame extraction state machine
+    // Read packets and decode PCM data: serially, or in parallel chunks
     // -----------------------------------------------------------------------
-    uint64_t sync_pat = pcm_attrs->ullMinorFrameSyncPat;
-    uint64_t sync_mask = pcm_attrs->ullMinorFrameSyncMask;
-    uint32_t sync_pat_len = pcm_attrs->ulMinorFrameSyncPatLen;
-    uint32_t bits_in_frame = pcm_attrs->ulBitsInMinorFrame;
-    uint32_t words_in_frame = pcm_attrs->ulWordsInMinorFrame;
-    uint32_t word_len = pcm_attrs->ulCommonWordLen;
-    uint64_t word_mask = pcm_attrs->ullCommonWordMask;
-    double delta_100ns = pcm_attrs->dDelta100NanoSeconds;
-
-    uint64_t test_word = 0;
-    uint64_t bits_loaded = 0;
-    uint32_t minor_frame_bit_count = 0;
-    uint32_t minor_frame_word_count = 0;
-    uint32_t data_word_bit_count = 0;
-    int32_t save_data = 0;     // 0=waiting, 1=collecting, 2=frame complete
-    uint64_t sync_count = UINT64_MAX; // -1 equivalent: no sync found yet
-    uint64_t total_syncs_found = 0;
-    uint64_t total_frames_extracted = 0;
-    uint64_t total_bytes_processed = 0;
+    const int decode_threads = (params.decode_threads > 0) ? params.decode_threads
+                                                           : QThread::idealThreadCount();
+    // Workers view payloads in the mapping; without one they would read the file a second time
+    const bool mapped = m_source->fileBytes() != nullptr;
+    const bool parallel = mapped && decode_threads > 1 &&
+        static_cast<uint64_t>(m_total_file_size) >= 2 * params.parallel_chunk_bytes;
+    if (!mapped && decode_threads > 1)
+    {
+        emit logMessage(QString("Parallel decode needs the mapped packet source; decoding serially (%1)")
+                        .arg(Ch10PacketSource::backendName(m_source->backend())));
+    }
+
+    emit logMessage("Processing PCM data...");
+    emit logMessage(QString("Frame sync engine: %1 (%2 correlator)")
+                    .arg(PcmFrameSynchronizer::engineName(params.sync_engine),
+                         SyncCorrelator::kernelName(runs.front()->decoder->synchronizer().correlatorKernel())));
+    if (runs.size() > 1)
+    {
+        emit logMessage(QString("Decoding %1 PCM channels in one pass over the file").arg(runs.size()));
+    }
+    for (const auto& run : runs)
+    {
+        const PcmFrameSyncConfig& sync_config = run->setup.sync;
+        emit logMessage(run->log_prefix + QString("Extraction plan: %1 fields from %2-word minor frames")
+                        .arg(run->setup.plan.size()).arg(sync_config.words_in_frame));
+        if (params.lock_misses > 0)
+        {
+            emit logMessage(run->log_prefix + QString("Frame lock: flywheel after %1 consecutive syncs, "
+                                                      "search after %2 missed syncs (%3 extractor)")
+                            .arg(qMax<uint64_t>(sync_config.min_syncs, 1)).arg(params.lock_misses)
+                            .arg(run->decoder->synchronizer().extractorName()));
+        }
+        if (run->outputs.size() > 1)
+        {
+            QString rate_labels;
+            for (const auto& output : run->outputs)
+            {
+                rate_labels += (rate_labels.isEmpty() ? "" : ", ") + QString::number(output->sample_rate) + " Hz";
+            }
+            emit logMessage(run->log_prefix + QString("Output rates: %1 from one decode").arg(rate_labels));
+        }
+    }
+    emit logMessage(QString("Time window: start=%1s stop=%2s")
+                    .arg(start_seconds).arg(stop_seconds));
+
+    // One pass per group of nearby windows, seeking in between
+    const std::vector<WindowPass> passes = windows.isEmpty()
+        ? std::vector<WindowPass>{WindowPass{start_seconds, stop_seconds, 1}}
+        : planWindowPasses(windows);
+    if (!windows.isEmpty())
+    {
+        emit logMessage(QString("Extraction windows: %1 in %2 pass(es) over the file")
+                        .arg(windows.size()).arg(passes.size()));
+    }
+    m_pass_count = static_cast<int>(passes.size());
+    bool completed = true;
+    for (m_pass = 0; completed && m_pass < m_pass_count; m_pass++)
+    {
+        ProcessingParams pass_params = params;
+        pass_params.start_seconds = passes[static_cast<size_t>(m_pass)].start_seconds;
+        pass_params.stop_seconds = passes[static_cast<size_t>(m_pass)].stop_seconds;
+        seekToWindow(pass_params);
+        completed = parallel ? decodeParallel(pass_params, runs, decode_threads, time_gaps_detected)
+                             : decodePipelined(pass_params, runs, time_gaps_detected);
+    }
+
+    logReadThroughput();
+    closeFile();
+
+    if (!completed)
+    {
+        emit logMessage("Processing cancelled by user.");
+        close_outputs();
+        emit processingFinished(false);
+        return false;
+    }
+
+    // Flush the last set of accumulated samples
     uint64_t rows_written = 0;
+    qint64 output_bytes = 0;
+    for (auto& run : runs)
+    {
+        for (size_t o = 0; o < run->outputs.size(); o++)
+        {
+            ChannelRun::Output& output = *run->outputs[o];
+            run->bins[o].flush();
+            writeClosedBins(*output.writer, run->bins[o]);
+            output.close();
+            rows_written += output.writer->rowsWritten();
+            output_bytes += QFileInfo(output.file.fileName()).size();
+        }
+    }
+
+    emit progressUpdated(kPercent100);
+    bool frames_found = true;
+    for (const auto& run : runs)
+    {
+        const PcmDecodeCounters& totals = run->totals;
+        emit logMessage(run->log_prefix + QString::number(totals.bytes) + " bytes processed, "
+                        + QString::number(totals.syncs) + " syncs found, "
+                        + QString::number(totals.frames) + " frames extracted.");
+        if (params.lock_misses > 0)
+        {
+            emit logMessage(run->log_prefix + QString("Frame lock: %1 locks, %2 unlocks, %3 missed syncs.")
+                            .arg(totals.locks)
+                            .arg(totals.unlocks)
+                            .arg(totals.missed_syncs));
+        }
+
+        if (totals.syncs == 0)
+        {
+            emit errorOccurred(run->log_prefix + "Frame sync pattern was not found in the data stream. "
+                               "Verify the frame sync pattern and PCM channel are correct.");
+            frames_found = false;
+        }
+        else if (totals.frames == 0)
+        {
+            emit errorOccurred(run->log_prefix + "Frame sync pattern was found but no valid frames were extracted. "
+                               "Check the frame parameters and time window settings.");
+            frames_found = false;
+        }
+    }
 
-    QVector<uint64_t> frame_words(words_in_frame, 0);
+    if (!frames_found)
+    {
+        emit processingFinished(false);
+        return false;
+    }
 
-    // CSV output state
-    double sample_period = 1.0 / static_cast<double>(sample_rate);
-    double current_time_sample = static_cast<double>(start_seconds);
-    double next_time_sample = current_time_sample + sample_period;
-    int n_samples = 0;
+    qint64 elapsed_ms = elapsed_timer.elapsed();
+    constexpr double kMsPerSec = 1000.0;
+    double elapsed_sec = static_cast<double>(elapsed_ms) / kMsPerSec;
+    constexpr double kMB = 1024.0 * 1024.0;
+    constexpr double kKB = 1024.0;
+    QString output_size_str = (output_bytes >= static_cast<qint64>(kMB))
+        ? QString::number(static_cast<double>(output_bytes) / kMB, 'f', 1) + " MB"
+        : QString::number(static_cast<double>(output_bytes) / kKB, 'f', 1) + " KB";
 
-    for (auto* param : enabled_params)
+    emit logMessage(QString("Processing complete — %1 rows written, %2, elapsed %3s.")
+        .arg(rows_written)
+        .arg(output_size_str)
+        .arg(elapsed_sec, 0, 'f', 1));
+
+    if (time_gaps_detected > 0)
     {
-        param->sample_sum = 0;
+        emit logMessage(QString("WARNING: %1 time gap(s) detected in recording.").arg(time_gaps_detected));
     }
 
-    // Timestamp tracking: keep current and previous packet time references
-    uint64_t global_bit_offset = 0;
-    PacketTimeRef current_time_ref = {0, 0, 0};
-    PacketTimeRef prev_time_ref = {0, 0, 0};
-    bool has_time_ref = false;
+    emit processingFinished(true);
+    return true;
+}
 
-    // Time gap detection
-    double prev_time_seconds = -1.0;
-    int time_gaps_detected = 0;
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+bool FrameProcessor::decodePipelined(const ProcessingParams& params, ChannelRuns& runs,
+                                     int& time_gaps_detected)
+{
+    // Each channel gets a decode and a write stage fed by its own queues
+    std::vector<std::unique_ptr<PipelineLane>> lanes;
+    for (size_t c = 0; c < runs.size(); c++)
+    {
+        lanes.push_back(std::make_unique<PipelineLane>());
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(static_cast<int>(2 * lanes.size()));
+    std::vector<QFuture<void>> stages;
+    for (size_t c = 0; c < runs.size(); c++)
+    {
+        PipelineLane& lane = *lanes[c];
+        ChannelRun& run = *runs[c];
+        // A window pass after a seek starts a new stream
+        run.decoder->reset();
+        run.decoder->setTimeReference(m_time_ref);
+
+        // Decode stage: frames into bins, closed bins handed on in batches
+        stages.push_back(QtConcurrent::run(&pool, [&lane, &run, this]() {
+            PacketSlot* slot = nullptr;
+            bool input_open = true;
+            while (input_open)
+            {
+                input_open = lane.packets.pop(slot);
+                if (input_open)
+                {
+                    if (slot->kind == PacketSlot::Kind::TimeReference)
+                    {
+                        run.decoder->setTimeReference(slot->time_ref);
+                    }
+                    else
+                    {
+                        run.decoder->processPacket(slot->payload, slot->num_bytes, slot->packet_time, run.bins);
+                    }
+                    lane.free_packets.push(slot);
+                }
+                else if (!m_abort_requested.load(std::memory_order_relaxed))
+                {
+                    for (auto& bins : run.bins)
+                    {
+                        bins.flush();
+                    }
+                }
 
-    // Derandomization state (determined by preScan encoding result)
-    bool needs_derand = is_randomized;
-    uint16_t lfsr_state = 0;
+                for (size_t o = 0; o < run.bins.size(); o++)
+                {
+                    if (run.bins[o].closedBins() > 0)
+                    {
+                        RowBatch* batch = nullptr;
+                        lane.free_rows.pop(batch);
+                        batch->take(run.bins[o], o);
+                        lane.rows.push(batch);
+                    }
+                }
+            }
+            lane.rows.close();
+        }));
 
-    // -----------------------------------------------------------------------
-    // Single pass: read packets and process PCM data immediately
-    // -----------------------------------------------------------------------
-    emit logMessage("Processing PCM data...");
-    emit logMessage(QString("Time window: start=%1s stop=%2s")
-                    .arg(start_seconds).arg(stop_seconds));
-    int packet_count = 0;
+        // Write stage: format rows and write the channel's CSVs
+        stages.push_back(QtConcurrent::run(&pool, [&lane, &run]() {
+            RowBatch* batch = nullptr;
+            while (lane.rows.pop(batch))
+            {
+                CsvRowWriter& writer = *run.outputs[batch->output]->writer;
+                for (size_t r = 0; r < batch->times.size(); r++)
+                {
+                    writer.writeRow(batch->times[r], batch->sums.data() + (r * batch->num_columns), // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                    batch->num_columns, batch->samples[r]);
+                }
+                lane.free_rows.push(batch);
+            }
+        }));
+    }
 
-    while (true)
+    // Read stage (this thread, which also emits every signal)
+    int packet_count = 0;
+    int last_reported_percent = -1;
+    int64_t prev_time_ticks = -1;
+    bool completed = true;
+    bool read_failed = false;
+    while (!read_failed)
     {
-        m_status = enI106Ch10ReadNextHeader(m_file_handle, &m_header);
+        m_status = m_source->next(m_packet);
         if (m_status == I106_EOF)
         {
             break;
@@ -736,335 +1564,400 @@ bool FrameProcessor::process(const ProcessingParams& params, FrameSetup* frame_s
 
         if (m_abort_requested.load(std::memory_order_relaxed))
         {
-            emit logMessage("Processing cancelled by user.");
-            emit processingFinished(false);
-            return false;
+            completed = false;
+            break;
         }
 
         // Report progress every N packets to reduce I/O overhead
         packet_count++;
         if (m_total_file_size > 0 && (packet_count % PCMConstants::kProgressReportInterval) == 0)
         {
-            int64_t current_pos = 0;
-            enI106Ch10GetPos(m_file_handle, &current_pos);
-            int percent = static_cast<int>(current_pos * kPercent100 / m_total_file_size);
-            if (percent != last_reported_percent)
-            {
-                if (percent / kPercent10 != last_reported_percent / kPercent10 && percent > 0)
-                {
-                    emit logMessage(QString::number(percent) + "% complete...");
-                }
-                last_reported_percent = percent;
-                emit progressUpdated(percent);
-            }
+            reportProgress(m_source->position(), last_reported_percent);
         }
 
-        // Process IRIG time packets to maintain time sync
-        if (m_header.ubyDataType == I106CH10_DTYPE_IRIG_TIME && m_header.uChID == time_channel_id)
+        // Process IRIG time packets to maintain time sync on every channel
+        if (m_packet.header.ubyDataType == I106CH10_DTYPE_IRIG_TIME && m_packet.header.uChID == params.time_channel_id)
         {
-            if (!ensureBufferCapacity(static_cast<qsizetype>(m_header.ulPacketLen)))
+            if (!readTimePacket(prev_time_ticks, time_gaps_detected) || pastWindow(params))
             {
-                emit errorOccurred("Memory allocation failed.");
                 break;
             }
-
-            m_status = enI106Ch10ReadData(m_file_handle, static_cast<unsigned long>(m_buffer.size()), m_buffer.data());
-            if (m_status != I106_OK)
+            for (auto& lane : lanes)
             {
-                emit errorOccurred("File read error; aborting parsing.");
-                break;
+                PacketSlot* slot = nullptr;
+                lane->free_packets.pop(slot);
+                slot->kind = PacketSlot::Kind::TimeReference;
+                slot->time_ref = m_time_ref;
+                lane->packets.push(slot);
             }
+        }
 
-            enI106_Decode_TimeF1(&m_header, m_buffer.data(), &m_irig_time);
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
-            enI106_SetRelTime(m_file_handle, &m_irig_time, m_header.aubyRefTime);
-
-            double pkt_time = static_cast<double>(m_irig_time.ulSecs) +
-                              (k100NsToSeconds * static_cast<double>(m_irig_time.ulFrac));
-            if (prev_time_seconds >= 0)
-            {
-                double gap = pkt_time - prev_time_seconds;
-                if (gap > kTimeGapThreshold)
-                {
-                    time_gaps_detected++;
-                    auto gap_epoch = static_cast<time_t>(pkt_time);
-                    struct tm* gt = gmtime(&gap_epoch);
-                    if (gt != nullptr)
-                    {
-                        constexpr int kBase10 = 10;
-                        emit logMessage(QString("WARNING: Time gap of %1s at DOY %2 %3:%4:%5")
-                            .arg(gap, 0, 'f', 1)
-                            .arg(gt->tm_yday + 1, 3, kBase10, QChar('0'))
-                            .arg(gt->tm_hour, 2, kBase10, QChar('0'))
-                            .arg(gt->tm_min, 2, kBase10, QChar('0'))
-                            .arg(gt->tm_sec, 2, kBase10, QChar('0')));
-                    }
-                }
-            }
-            prev_time_seconds = pkt_time;
+        if (m_packet.header.ubyDataType != I106CH10_DTYPE_PCM_FMT_1)
+        {
+            continue;
         }
 
-        // Process PCM data from the selected channel
-        if (m_header.ubyDataType == I106CH10_DTYPE_PCM_FMT_1 && m_header.uChID == pcm_channel_id)
+        // Process PCM data for every run on this channel; the packet is read once
+        const PacketSlot* first_slot = nullptr;
+        for (size_t c = 0; c < runs.size(); c++)
         {
-            if (!ensureBufferCapacity(static_cast<qsizetype>(m_header.ulPacketLen)))
+            if (runs[c]->params.pcm_channel_id != m_packet.header.uChID)
             {
-                emit errorOccurred("Memory allocation failed.");
-                break;
+                continue;
             }
 
-            m_status = enI106Ch10ReadData(m_file_handle, static_cast<unsigned long>(m_buffer.size()), m_buffer.data());
-            if (m_status != I106_OK)
+            if (static_cast<qsizetype>(m_packet.header.ulPacketLen) > PCMConstants::kMaxPacketBufferSize)
             {
-                emit errorOccurred("File read error; aborting parsing.");
+                emit errorOccurred("Memory allocation failed.");
+                read_failed = true;
                 break;
             }
 
-            // Skip the 4-byte SuPcmF1_ChanSpec header to get raw PCM data
-            uint32_t data_offset = sizeof(SuPcmF1_ChanSpec);
-            if (m_header.ulDataLen <= data_offset)
+            PacketSlot* slot = nullptr;
+            lanes[c]->free_packets.pop(slot);
+            if (first_slot == nullptr)
             {
-                continue;
-            }
+                m_status = m_source->readData(m_packet);
+                if (m_status != I106_OK)
+                {
+                    lanes[c]->free_packets.push(slot);
+                    emit errorOccurred("File read error; aborting parsing.");
+                    read_failed = true;
+                    break;
+                }
 
-            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-            auto* raw_data = reinterpret_cast<uint8_t*>(m_buffer.data() + data_offset);
-            uint32_t raw_len = m_header.ulDataLen - data_offset;
-            uint64_t packet_bits = static_cast<uint64_t>(raw_len) * 8;
+                // Skip the 4-byte SuPcmF1_ChanSpec header to get raw PCM data.
+                // Byte swapping and derandomization are fused into the synchronizer.
+                if (m_packet.header.ulDataLen <= sizeof(SuPcmF1_ChanSpec))
+                {
+                    lanes[c]->free_packets.push(slot);
+                    break;
+                }
 
-            // Byte-swap raw data if needed (library default: swap)
-            if (pcm_attrs->bDontSwapRawData == 0)
-            {
-                SwapBytes_PcmF1(raw_data, static_cast<long>(raw_len));
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                const uint8_t* payload = m_packet.data + sizeof(SuPcmF1_ChanSpec);
+                if (m_source->fileBytes() != nullptr)
+                {
+                    // Mapped input: the decode stage reads the file's own bytes
+                    slot->payload = payload;
+                }
+                else
+                {
+                    const auto num_bytes = static_cast<qsizetype>(m_packet.header.ulDataLen - sizeof(SuPcmF1_ChanSpec));
+                    slot->data.resize(num_bytes);
+                    memcpy(slot->data.data(), payload, static_cast<size_t>(num_bytes));
+                    slot->payload = reinterpret_cast<const uint8_t*>(slot->data.constData());
+                }
             }
-
-            if (needs_derand)
+            else
             {
-                derandomizeBitstream(raw_data, packet_bits, lfsr_state);
+                // Another run on the same channel shares the bytes already read
+                slot->data = first_slot->data;
+                slot->payload = (m_source->fileBytes() != nullptr)
+                    ? first_slot->payload
+                    : reinterpret_cast<const uint8_t*>(slot->data.constData());
             }
 
-            // Update time references (keep current + previous for boundary frames)
-            int64_t pkt_base_time = 0;
+            slot->kind = PacketSlot::Kind::Pcm;
+            slot->num_bytes = m_packet.header.ulDataLen - sizeof(SuPcmF1_ChanSpec);
             // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
-            vTimeArray2LLInt(m_header.aubyRefTime, &pkt_base_time);
-
-            if (has_time_ref)
+            vTimeArray2LLInt(m_packet.header.aubyRefTime, &slot->packet_time);
+            lanes[c]->packets.push(slot);
+            if (first_slot == nullptr)
             {
-                prev_time_ref = current_time_ref;
+                first_slot = slot;
             }
+        }
+    }
 
-            current_time_ref.base_time = pkt_base_time;
-            current_time_ref.start_bit = global_bit_offset;
-            current_time_ref.num_bits = packet_bits;
-            has_time_ref = true;
+    for (auto& lane : lanes)
+    {
+        lane->packets.close();
+    }
+    for (auto& stage : stages)
+    {
+        stage.waitForFinished();
+    }
 
-            constexpr uint64_t kAbortCheckMask = 0xFFFF;
-            // Process all bits in this packet through the frame extraction state machine
-            for (uint64_t bit_pos = 0; bit_pos < packet_bits; bit_pos++)
-            {
-                if ((bit_pos & kAbortCheckMask) == 0 && m_abort_requested.load(std::memory_order_relaxed))
-                {
-                    emit logMessage("Processing cancelled by user.");
-                    emit processingFinished(false);
-                    return false;
-                }
+    for (size_t c = 0; c < runs.size(); c++)
+    {
+        const PipelineLane& lane = *lanes[c];
+        runs[c]->totals += runs[c]->decoder->counters();
+        emit logMessage(runs[c]->log_prefix +
+                        QString("Pipeline: packet queue peak %1/%2 (mean %3), row queue peak %4/%5; "
+                                "waits: read %6, decode %7 starved / %8 blocked, write %9 starved")
+                        .arg(lane.packets.peakSize()).arg(lane.packets.capacity())
+                        .arg(lane.packets.meanFill(), 0, 'f', 1)
+                        .arg(lane.rows.peakSize()).arg(lane.rows.capacity())
+                        .arg(lane.free_packets.emptyWaits())
+                        .arg(lane.packets.emptyWaits())
+                        .arg(lane.free_rows.emptyWaits())
+                        .arg(lane.rows.emptyWaits()));
+    }
+    return completed;
+}
 
-                uint32_t mbyte_idx = static_cast<uint32_t>(bit_pos / 8);
-                constexpr uint8_t kHighBit = 0x80;
-                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
-                uint8_t bit_val = ((raw_data[mbyte_idx] & (kHighBit >> (bit_pos % 8))) != 0) ? 1 : 0;
+////////////////////////////////////////////////////////////////////////////////
+//                         PARALLEL DECODING                                  //
+////////////////////////////////////////////////////////////////////////////////
 
-                test_word = (test_word << 1) | bit_val;
-                bits_loaded++;
-                minor_frame_bit_count++;
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+bool FrameProcessor::scanPcmPackets(const ProcessingParams& params, const ChannelRuns& runs,
+                                    std::vector<PcmPacketTable>& tables, int& time_gaps_detected)
+{
+    int64_t prev_time_ticks = -1;
+    tables.assign(runs.size(), PcmPacketTable());
+    for (auto& table : tables)
+    {
+        table.addTimeReference(m_time_ref);
+    }
 
-                // Check for sync word
-                if (bits_loaded >= sync_pat_len &&
-                    (test_word & sync_mask) == sync_pat)
-                {
-                    total_syncs_found++;
+    while (true)
+    {
+        m_status = m_source->next(m_packet);
+        if (m_status == I106_EOF)
+        {
+            break;
+        }
+        if (m_status != I106_OK)
+        {
+            emit errorOccurred("File read error during data collection.");
+            break;
+        }
 
-                    if (minor_frame_bit_count == bits_in_frame)
-                    {
-                        sync_count++;
-
-                        if (sync_count >= pcm_attrs->ulMinSyncs && save_data > 1)
-                        {
-                            // Compute per-frame time using bit-level interpolation
-                            uint64_t global_bit_pos = global_bit_offset + bit_pos;
-                            uint64_t frame_start_bit = global_bit_pos + 1 - bits_in_frame;
-
-                            const PacketTimeRef& ref =
-                                (frame_start_bit >= current_time_ref.start_bit)
-                                    ? current_time_ref : prev_time_ref;
-
-                            int64_t frame_rel_time = ref.base_time +
-                                static_cast<int64_t>(
-                                    static_cast<double>(frame_start_bit - ref.start_bit) * delta_100ns);
-
-                            enI106_RelInt2IrigTime(m_file_handle, frame_rel_time, &m_irig_time);
-                            double current_time = (k100NsToSeconds * static_cast<double>(m_irig_time.ulFrac))
-                                                  + static_cast<double>(m_irig_time.ulSecs);
-                            bool write_samples = false;
-
-                            if (current_time >= static_cast<double>(start_seconds) && current_time <= static_cast<double>(stop_seconds))
-                            {
-                                if (next_time_sample < current_time)
-                                {
-                                    if (n_samples > 0)
-                                    {
-                                        writeTimeSample(output, current_time_sample, n_samples, enabled_params);
-                                        rows_written++;
-                                    }
-
-                                    n_samples = 0;
-                                    write_samples = true;
-                                }
-
-                                if (write_samples)
-                                {
-                                    while (next_time_sample < current_time)
-                                    {
-                                        current_time_sample += sample_period;
-                                        next_time_sample += sample_period;
-                                    }
-                                }
-
-                                for (auto* param : enabled_params)
-                                {
-                                    if (param->word >= 0 &&
-                                        param->word < static_cast<int>(words_in_frame))
-                                    {
-                                        int64_t raw_value = static_cast<int64_t>(frame_words[param->word] & word_mask);
-                                        double scaled_value = (static_cast<double>(raw_value) + param->scale) * param->slope;
-                                        param->sample_sum += scaled_value;
-                                    }
-                                }
-
-                                n_samples++;
-                                total_frames_extracted++;
-                            }
-                        }
-                    }
+        if (m_abort_requested.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
 
-                    minor_frame_bit_count = 0;
-                    minor_frame_word_count = 1;
-                    data_word_bit_count = 0;
-                    save_data = 1;
-                }
-                else
-                {
-                    // Accumulate data word bits between sync patterns
-                    if (save_data == 1)
-                    {
-                        data_word_bit_count++;
-                        if (data_word_bit_count >= word_len)
-                        {
-                            if (minor_frame_word_count - 1 < words_in_frame)
-                            {
-                                frame_words[minor_frame_word_count - 1] = test_word;
-                            }
-                            data_word_bit_count = 0;
-                            minor_frame_word_count++;
-                        }
-
-                        if (minor_frame_word_count >= words_in_frame)
-                        {
-                            save_data = 2;
-                        }
-                    }
-                }
+        // Time packets are tiny; read them so every PCM packet knows its reference
+        if (m_packet.header.ubyDataType == I106CH10_DTYPE_IRIG_TIME && m_packet.header.uChID == params.time_channel_id)
+        {
+            if (!readTimePacket(prev_time_ticks, time_gaps_detected) || pastWindow(params))
+            {
+                break;
+            }
+            for (auto& table : tables)
+            {
+                table.addTimeReference(m_time_ref);
             }
+            continue;
+        }
 
-            global_bit_offset += packet_bits;
-            total_bytes_processed += raw_len;
+        if (m_packet.header.ubyDataType != I106CH10_DTYPE_PCM_FMT_1 ||
+            std::none_of(runs.begin(), runs.end(), [this](const std::unique_ptr<ChannelRun>& run) {
+                return run->params.pcm_channel_id == m_packet.header.uChID;
+            }))
+        {
+            continue;
         }
-    }
 
-    closeFile();
+        // Same guards as the serial read, checked from the header alone
+        if (static_cast<qsizetype>(m_packet.header.ulPacketLen) > PCMConstants::kMaxPacketBufferSize)
+        {
+            emit errorOccurred("Memory allocation failed.");
+            break;
+        }
 
-    // Flush the last set of accumulated samples
-    if (n_samples > 0)
-    {
-        writeTimeSample(output, current_time_sample, n_samples, enabled_params);
-        rows_written++;
+        const int64_t data_offset = m_packet.dataOffset();
+        const int64_t body_len = static_cast<int64_t>(m_packet.header.ulPacketLen) - m_packet.header_size;
+        if (body_len < static_cast<int64_t>(m_packet.header.ulDataLen) || data_offset + body_len > m_total_file_size)
+        {
+            emit errorOccurred("File read error; aborting parsing.");
+            break;
+        }
+
+        if (m_packet.header.ulDataLen <= sizeof(SuPcmF1_ChanSpec))
+        {
+            continue;
+        }
+
+        int64_t pkt_base_time = 0;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        vTimeArray2LLInt(m_packet.header.aubyRefTime, &pkt_base_time);
+        for (size_t r = 0; r < runs.size(); r++)
+        {
+            if (runs[r]->params.pcm_channel_id == m_packet.header.uChID)
+            {
+                tables[r].addPacket(data_offset, m_packet.header.ulDataLen, pkt_base_time);
+            }
+        }
     }
 
-    output.close();
-    emit progressUpdated(kPercent100);
-    emit logMessage(QString::number(total_bytes_processed) + " bytes processed, "
-                    + QString::number(total_syncs_found) + " syncs found, "
-                    + QString::number(total_frames_extracted) + " frames extracted.");
+    return true;
+}
 
-    if (total_syncs_found == 0)
+bool FrameProcessor::decodeParallel(const ProcessingParams& params, ChannelRuns& runs,
+                                    int threads, int& time_gaps_detected)
+{
+    emit logMessage("Scanning packet headers...");
+    std::vector<PcmPacketTable> tables;
+    if (!scanPcmPackets(params, runs, tables, time_gaps_detected))
     {
-        emit errorOccurred("Frame sync pattern was not found in the data stream. "
-                           "Verify the frame sync pattern and PCM channel are correct.");
-        emit processingFinished(false);
         return false;
     }
 
-    if (total_frames_extracted == 0)
+    // Channels are decoded one after another, each on all threads; their
+    // payloads are disjoint, so the file is still read about once in total
+    uint64_t total_bytes = 0;
+    for (const auto& table : tables)
     {
-        emit errorOccurred("Frame sync pattern was found but no valid frames were extracted. "
-                           "Check the frame parameters and time window settings.");
-        emit processingFinished(false);
-        return false;
+        total_bytes += table.payloadBytes();
     }
 
-    qint64 elapsed_ms = elapsed_timer.elapsed();
-    constexpr double kMsPerSec = 1000.0;
-    double elapsed_sec = static_cast<double>(elapsed_ms) / kMsPerSec;
-    qint64 output_bytes = QFileInfo(outfile).size();
-    constexpr double kMB = 1024.0 * 1024.0;
-    constexpr double kKB = 1024.0;
-    QString output_size_str = (output_bytes >= static_cast<qint64>(kMB))
-        ? QString::number(static_cast<double>(output_bytes) / kMB, 'f', 1) + " MB"
-        : QString::number(static_cast<double>(output_bytes) / kKB, 'f', 1) + " KB";
-
-    emit logMessage(QString("Processing complete — %1 rows written, %2, elapsed %3s.")
-        .arg(rows_written)
-        .arg(output_size_str)
-        .arg(elapsed_sec, 0, 'f', 1));
+    uint64_t decoded_bytes = 0;
+    int last_reported_percent = -1;
+    for (size_t r = 0; r < runs.size(); r++)
+    {
+        if (tables[r].isEmpty())
+        {
+            continue;
+        }
+        if (!decodeChannelChunks(params, *runs[r], tables[r], threads,
+                                 decoded_bytes, total_bytes, last_reported_percent))
+        {
+            return false;
+        }
+        decoded_bytes += tables[r].payloadBytes();
+    }
+    return true;
+}
 
-    if (time_gaps_detected > 0)
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+bool FrameProcessor::decodeChannelChunks(const ProcessingParams& params, ChannelRun& run,
+                                         const PcmPacketTable& table, int threads,
+                                         uint64_t progress_base, uint64_t progress_total,
+                                         int& last_reported_percent)
+{
+    const PcmDecodeSetup& setup = run.setup;
+    std::vector<TimeBinAccumulator>& bins = run.bins;
+
+    // Enough lead-in for frame lock to form, plus a word for the descrambler
+    const uint64_t lead_in_bits =
+        (static_cast<uint64_t>(setup.sync.min_syncs + PCMConstants::kParallelLeadInFrames) * setup.sync.bits_in_frame) +
+        std::numeric_limits<uint64_t>::digits;
+    const uint64_t target_bytes = std::max<uint64_t>(
+        params.parallel_chunk_bytes,
+        table.payloadBytes() / (static_cast<uint64_t>(threads) * PCMConstants::kParallelChunksPerThread));
+    const std::vector<PcmDecodeChunk> chunks = table.planChunks(target_bytes, lead_in_bits);
+    threads = static_cast<int>(std::min<size_t>(static_cast<size_t>(threads), chunks.size()));
+    emit logMessage(run.log_prefix + QString("Parallel decode: %1 packets in %2 chunks on %3 threads")
+                    .arg(table.size()).arg(chunks.size()).arg(threads));
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    std::deque<QFuture<std::shared_ptr<ChunkResult>>> pending;
+    size_t submitted = 0;
+    const size_t max_in_flight = static_cast<size_t>(threads) * 2;
+    const uint8_t* file_bytes = m_source->fileBytes();
+
+    // Merge in file order. A chunk whose entry state matches the state the
+    // merged run reached is exact; otherwise (no lock at the edge, time running
+    // backwards) the previous chunk's decoder continues through it serially.
+    std::unique_ptr<PcmFrameDecoder> carry;
+    PayloadReader replay_reader(file_bytes);
+    size_t replayed_chunks = 0;
+    bool completed = true;
+    for (size_t c = 0; c < chunks.size(); c++)
     {
-        emit logMessage(QString("WARNING: %1 time gap(s) detected in recording.").arg(time_gaps_detected));
+        while (submitted < chunks.size() && submitted < c + max_in_flight)
+        {
+            const PcmDecodeChunk chunk = chunks[submitted++];
+            pending.push_back(QtConcurrent::run(&pool, [&setup, &table, file_bytes, chunk, this]() {
+                return decodeChunk(file_bytes, setup, table, chunk, m_abort_requested);
+            }));
+        }
+
+        const std::shared_ptr<ChunkResult> result = pending.front().result();
+        pending.pop_front();
+        if (m_abort_requested.load(std::memory_order_relaxed) || !result->ok)
+        {
+            completed = false;
+            break;
+        }
+        m_worker_read_bytes += result->payload_bytes;
+
+        // Every output rate must take the chunk, or none does
+        bool converged = (carry == nullptr) ||
+                         (result->entry_state == carry->synchronizer().streamState());
+        for (size_t o = 0; converged && o < bins.size(); o++)
+        {
+            converged = bins[o].canAppendChunk(result->bins[o]);
+        }
+        if (converged)
+        {
+            for (size_t o = 0; o < bins.size(); o++)
+            {
+                bins[o].appendChunk(result->bins[o]);
+            }
+            run.totals += result->counters;
+            carry = std::move(result->decoder);
+        }
+        else if (carry != nullptr)
+        {
+            replayed_chunks++;
+            const PcmDecodeCounters before = carry->counters();
+            if (!decodePackets(replay_reader, table, chunks[c].first, chunks[c].end, *carry, bins,
+                               m_abort_requested))
+            {
+                completed = false;
+                break;
+            }
+            run.totals += carry->counters() - before;
+        }
+
+        for (size_t o = 0; o < bins.size(); o++)
+        {
+            writeClosedBins(*run.outputs[o]->writer, bins[o]);
+        }
+
+        // Progress by payload decoded over all channels, scaled to the file size
+        const uint64_t chunk_end_bytes = (c + 1 < chunks.size())
+            ? table.packet(chunks[c + 1].first).start_bit / 8
+            : table.payloadBytes();
+        const double fraction = static_cast<double>(progress_base + chunk_end_bytes) /
+                                static_cast<double>(std::max<uint64_t>(progress_total, 1));
+        reportProgress(m_progress_begin +
+                           static_cast<int64_t>(fraction * static_cast<double>(m_progress_end - m_progress_begin)),
+                       last_reported_percent);
     }
 
-    emit processingFinished(true);
-    return true;
+    // Workers reference the table and setup; finish them before returning
+    pool.waitForDone();
+    m_worker_read_bytes += replay_reader.bytesRead();
+
+    if (replayed_chunks > 0)
+    {
+        emit logMessage(run.log_prefix + QString("Parallel decode: %1 of %2 chunk edges re-decoded serially.")
+                        .arg(replayed_chunks).arg(chunks.size() - 1));
+    }
+    return completed;
 }
 
 void FrameProcessor::writeTimeSample(QFile& output,
-                                         double current_time_sample,
+                                         int64_t current_time_ticks,
                                          int n_samples,
                                          const QVector<ParameterInfo*>& enabled_params)
 {
-    // add 0.5 ms to time sample so that it rounds up. nicer this way, accounts for floating point imprecision
-    double rounded_time = current_time_sample + PCMConstants::kTimeRoundingOffset;
-    uint64_t whole_time = static_cast<uint64_t>(rounded_time);
-    constexpr double kMillisPerSecond = 1000.0;
-    unsigned int millis =
-        static_cast<unsigned int>((rounded_time - static_cast<double>(whole_time)) * kMillisPerSecond);
-
-    time_t epoch = static_cast<time_t>(whole_time);
-    struct tm* t = gmtime(&epoch);
-
-    // Day-of-year as integer, time as HH:MM:SS.mmm (Excel-compatible)
-    constexpr int kBase10 = 10;
-    QString row = QString("%1,%2:%3:%4.%5")
-        .arg(t->tm_yday + 1)
-        .arg(t->tm_hour, 2, kBase10, QChar('0'))
-        .arg(t->tm_min, 2, kBase10, QChar('0'))
-        .arg(t->tm_sec, 2, kBase10, QChar('0'))
-        .arg(millis, 3, kBase10, QChar('0'));
+    std::vector<double> sums;
+    sums.reserve(static_cast<size_t>(enabled_params.size()));
     for (auto* param : enabled_params)
     {
-        row += ',' + QString::number(param->sample_sum / n_samples);
+        sums.push_back(param->sample_sum);
         param->sample_sum = 0;
     }
-    row += '\n';
-    output.write(row.toUtf8());
+
+    CsvRowWriter writer(output);
+    writer.writeRow(current_time_ticks, sums.data(), sums.size(), n_samples);
+    writer.flush();
+}
+
+void FrameProcessor::writeClosedBins(CsvRowWriter& writer, TimeBinAccumulator& bins)
+{
+    for (size_t b = 0; b < bins.closedBins(); b++)
+    {
+        writer.writeRow(bins.binTime(b), bins.binSums(b), bins.columnCount(), bins.binSamples(b));
+    }
+    bins.clearClosedBins();
 }
 // End of file!
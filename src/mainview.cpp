@@ -465,25 +465,12 @@ void MainView::setUpConnections()
     connect(m_view_model, &MainViewModel::batchModeChanged, this, &MainView::updateFileList);
     connect(m_view_model, &MainViewModel::batchFileUpdated, this, [this](int fileIndex) {
         // Update just the status cell for the affected file — no full tree rebuild
-        if (m_file_list->topLevelItemCount() == 0)
-        {
-            return;
-        }
-        QTreeWidgetItem* root = m_file_list->topLevelItem(0);
-        // Find item by ViewModel index (UserRole), not visual position
-        QTreeWidgetItem* file_item = nullptr;
-        for (int i = 0; i < root->childCount(); ++i)
-        {
-            if (root->child(i)->data(0, Qt::UserRole).toInt() == fileIndex)
-            {
-                file_item = root->child(i);
-                break;
-            }
-        }
+        QTreeWidgetItem* file_item = batchFileItem(fileIndex);
         if (!file_item)
         {
             return;
         }
+        QTreeWidgetItem* root = m_file_list->topLevelItem(0);
         const QVector<BatchFileInfo>& files = m_view_model->batchFiles();
         const BatchFileInfo& info = files[fileIndex];
 
@@ -507,6 +494,24 @@ void MainView::setUpConnections()
         statusBar()->showMessage("Processing file " + QString::number(index + 1) +
                                 " of " + QString::number(total));
     });
+    connect(m_view_model, &MainViewModel::batchFileLoaded, this, &MainView::onBatchFileLoaded);
+    connect(m_view_model, &MainViewModel::batchLoadProgress, this, [this](int loaded, int total) {
+        m_progress_bar->setValue((total > 0) ? (loaded * UIConstants::kProgressBarMax) / total : 0);
+        statusBar()->showMessage("Loaded " + QString::number(loaded) + " of " + QString::number(total) + " files");
+    });
+    connect(m_view_model, &MainViewModel::batchPreScanProgress, this, [this](int scanned, int total) {
+        m_progress_bar->setValue((total > 0) ? (scanned * UIConstants::kProgressBarMax) / total : 0);
+        statusBar()->showMessage("Pre-scanned " + QString::number(scanned) + " of " + QString::number(total) + " files");
+    });
+    connect(m_view_model, &MainViewModel::batchLoadingChanged, this, [this]() {
+        // Cancel stops the intake while it runs
+        const bool loading = m_view_model->batchLoading();
+        m_cancel_action->setEnabled(loading || m_view_model->processing());
+        if (!loading)
+        {
+            m_progress_bar->setValue(0);
+        }
+    });
     connect(m_view_model, &MainViewModel::channelListsChanged, this, &MainView::onChannelListsChanged);
     connect(m_view_model, &MainViewModel::fileLoadedChanged, this, &MainView::onFileLoadedChanged);
     connect(m_view_model, &MainViewModel::fileLoadedChanged, this, &MainView::updateStatusBar);
@@ -612,7 +617,8 @@ void MainView::onFileLoadedChanged()
 
 void MainView::onFileTimesChanged()
 {
-    if (!m_view_model->fileLoaded())
+    // The range is known before the channel catalog finishes
+    if (!m_view_model->fileLoaded() && !m_view_model->channelsLoading())
     {
         return;
     }
@@ -1221,6 +1227,11 @@ void MainView::applyBatchFileStatus(QTreeWidgetItem* item, const BatchFileInfo&
         item->setForeground(1, QColor("#DAA520"));
         item->setToolTip(1, info.skipReason);
     }
+    else if (!info.loaded)
+    {
+        item->setText(1, "Loading");
+        item->setForeground(1, QColor("gray"));
+    }
     else if (info.processed && info.processedOk)
     {
         item->setText(1, "Done");
@@ -1252,6 +1263,57 @@ void MainView::applyBatchFileStatus(QTreeWidgetItem* item, const BatchFileInfo&
     }
 }
 
+QTreeWidgetItem* MainView::batchFileItem(int file_index) const
+{
+    if (m_file_list->topLevelItemCount() == 0)
+    {
+        return nullptr;
+    }
+    QTreeWidgetItem* root = m_file_list->topLevelItem(0);
+    // Find item by ViewModel index (UserRole), not visual position
+    for (int i = 0; i < root->childCount(); ++i)
+    {
+        if (root->child(i)->data(0, Qt::UserRole).toInt() == file_index)
+        {
+            return root->child(i);
+        }
+    }
+    return nullptr;
+}
+
+void MainView::onBatchFileLoaded(int file_index)
+{
+    QTreeWidgetItem* file_item = batchFileItem(file_index);
+    if (!file_item)
+    {
+        return;
+    }
+    const BatchFileInfo& info = m_view_model->batchFiles()[file_index];
+    applyBatchFileStatus(file_item, info);
+
+    // The channel rows were built empty while the file was loading
+    auto fill_combo = [this](QTreeWidgetItem* row, const QStringList& channels, int resolved) {
+        QWidget* container = (row != nullptr) ? m_file_list->itemWidget(row, 0) : nullptr;
+        QComboBox* combo = (container != nullptr) ? container->findChild<QComboBox*>() : nullptr;
+        if (!combo)
+        {
+            return;
+        }
+        QSignalBlocker blocker(combo);
+        combo->clear();
+        combo->addItems(channels);
+        if (resolved >= 0 && resolved < channels.size())
+        {
+            combo->setCurrentIndex(resolved);
+        }
+        combo->setEnabled(!channels.isEmpty());
+    };
+    fill_combo(file_item->child(0), info.timeChannelStrings, info.resolvedTimeIndex);
+    fill_combo(file_item->child(1), info.pcmChannelStrings, info.resolvedPcmIndex);
+
+    m_file_list->topLevelItem(0)->setText(0, m_view_model->batchStatusSummary());
+}
+
 void MainView::populateBatchFileList()
 {
     m_file_list->setHeaderHidden(true);
@@ -13,6 +13,7 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QMap>
+#include <QtConcurrent/QtConcurrent>
 
 #include "chapter10reader.h"
 #include "constants.h"
@@ -101,13 +102,15 @@ MainViewModel::MainViewModel(QObject* parent)
     connect(m_settings, &SettingsManager::logMessage,
             this, &MainViewModel::logMessageReceived);
 
-    m_coordinator = new ProcessingCoordinator(&m_batch_files, m_frame_setup, m_reader, this);
+    m_coordinator = new ProcessingCoordinator(&m_batch_files, m_frame_setup, this);
     connect(m_coordinator, &ProcessingCoordinator::progressChanged,
             this, [this]() { emit progressPercentChanged(); });
     connect(m_coordinator, &ProcessingCoordinator::processingStateChanged,
             this, [this]() { emit processingChanged(); emit controlsEnabledChanged(); });
     connect(m_coordinator, &ProcessingCoordinator::batchFileProcessing,
             this, &MainViewModel::batchFileProcessing);
+    connect(m_coordinator, &ProcessingCoordinator::batchPreScanProgress,
+            this, &MainViewModel::batchPreScanProgress);
     connect(m_coordinator, &ProcessingCoordinator::batchFilesUpdated,
             this, [this]() { rebuildBatchStatusSummary(); emit batchFilesChanged(); });
     connect(m_coordinator, &ProcessingCoordinator::processingFinished,
@@ -120,6 +123,11 @@ MainViewModel::MainViewModel(QObject* parent)
 
 MainViewModel::~MainViewModel()
 {
+    // Intake tasks own their readers; unstarted ones are dropped
+    if (m_intake_watcher != nullptr)
+    {
+        m_intake_watcher->cancel();
+    }
     // m_coordinator is a child QObject and is auto-deleted before these.
     delete m_reader;
     delete m_frame_setup;
@@ -159,6 +167,7 @@ QStringList MainViewModel::pcmChannelList() const
 int MainViewModel::timeChannelIndex() const { return m_time_channel_index; }
 int MainViewModel::pcmChannelIndex() const { return m_pcm_channel_index; }
 bool MainViewModel::fileLoaded() const { return m_file_loaded; }
+bool MainViewModel::channelsLoading() const { return m_channels_loading; }
 int MainViewModel::progressPercent() const { return m_coordinator->progressPercent(); }
 bool MainViewModel::processing() const { return m_coordinator->processing(); }
 bool MainViewModel::controlsEnabled() const { return m_file_loaded && !m_coordinator->processing(); }
@@ -570,6 +579,7 @@ QString MainViewModel::fileMetadataSummary() const
 
 bool MainViewModel::batchMode() const { return m_batch_mode; }
 int MainViewModel::batchFileCount() const { return static_cast<int>(m_batch_files.size()); }
+bool MainViewModel::batchLoading() const { return m_batch_loading; }
 
 int MainViewModel::batchValidCount() const
 {
@@ -618,6 +628,12 @@ void MainViewModel::rebuildBatchStatusSummary()
         m_batch_status_summary.clear();
         return;
     }
+    if (m_batch_loading)
+    {
+        m_batch_status_summary = "Loading " + QString::number(m_batch_files.size()) + " files (" +
+            QString::number(m_batch_loaded_count) + " read)";
+        return;
+    }
     m_batch_status_summary =
         QString::number(m_batch_files.size()) + " files loaded (" +
         QString::number(batchValidCount()) + " valid, " +
@@ -639,87 +655,179 @@ void MainViewModel::openFiles(const QStringList& filenames)
 
     emit logMessageReceived("--- Loading " + QString::number(filenames.size()) + " files ---");
 
+    // List every file at once; intake fills each entry in as its file completes
     for (const QString& filepath : filenames)
     {
         BatchFileInfo info;
         info.filepath = filepath;
         info.filename = QFileInfo(filepath).fileName();
         info.fileSize = QFileInfo(filepath).size();
+        m_batch_files.append(info);
+    }
 
-        Chapter10Reader temp_reader;
-        if (temp_reader.loadChannels(filepath))
-        {
-            info.pcmChannelStrings = temp_reader.getPCMChannelComboBoxList();
-            info.timeChannelStrings = temp_reader.getTimeChannelComboBoxList();
+    // Pre-scan with the current settings; a batch started with other settings scans again
+    ProcessingParams scan_params;
+    const bool pre_scan = ProcessingCoordinator::batchPreScanParams(m_settings_frame_sync,
+                                                                    m_frame_setup->length(), scan_params);
 
-            for (const QString& s : info.pcmChannelStrings)
-            {
-                info.pcmChannelIds.append(s.split(" - ").first().toInt());
-            }
+    m_batch_loaded_count = 0;
+    setBatchLoading(true);
+    rebuildBatchStatusSummary();
+    emit inputFilenameChanged();
+    emit batchFilesChanged();
+    emit batchLoadProgress(0, static_cast<int>(filenames.size()));
 
-            emit logMessageReceived("  Loaded: " + info.filename +
-                " (PCM: " + QString::number(info.pcmChannelStrings.size()) +
-                ", Time: " + QString::number(info.timeChannelStrings.size()) + ")");
-        }
-        else
-        {
-            info.skip = true;
-            info.skipReason = "Failed to read file metadata";
-            emit logMessageReceived("  WARNING: Could not load " + info.filename);
-        }
+    if (m_intake_watcher == nullptr)
+    {
+        m_intake_watcher = new QFutureWatcher<BatchIntakeResult>(this);
+        connect(m_intake_watcher, &QFutureWatcher<BatchIntakeResult>::resultReadyAt,
+                this, &MainViewModel::onBatchFileLoaded);
+        connect(m_intake_watcher, &QFutureWatcher<BatchIntakeResult>::finished,
+                this, &MainViewModel::onBatchIntakeFinished);
+    }
+    m_intake_watcher->setFuture(QtConcurrent::mapped(filenames, [scan_params, pre_scan](const QString& filepath) {
+        return loadBatchFile(filepath, scan_params, pre_scan);
+    }));
+}
 
-        m_batch_files.append(info);
+BatchIntakeResult MainViewModel::loadBatchFile(const QString& filepath, const ProcessingParams& scan_params,
+                                               bool pre_scan)
+{
+    BatchIntakeResult result;
+    BatchFileInfo& info = result.info;
+    info.filepath = filepath;
+    info.filename = QFileInfo(filepath).fileName();
+    info.fileSize = QFileInfo(filepath).size();
+    info.loaded   = true;
+
+    Chapter10Reader reader;
+    if (!reader.loadChannels(filepath))
+    {
+        info.skip = true;
+        info.skipReason = "Failed to read file metadata";
+        result.log.append("  WARNING: Could not load " + info.filename);
+        return result;
+    }
+
+    info.pcmChannelStrings = reader.getPCMChannelComboBoxList();
+    info.timeChannelStrings = reader.getTimeChannelComboBoxList();
+    for (const QString& s : std::as_const(info.pcmChannelStrings))
+    {
+        info.pcmChannelIds.append(s.split(" - ").first().toInt());
+    }
+    for (const QString& s : std::as_const(info.timeChannelStrings))
+    {
+        info.timeChannelIds.append(s.split(" - ").first().toInt());
     }
 
-    // Auto-resolve each file to its first PCM/time channel
-    validateBatchFiles();
+    // Kept with the entry so processing does not catalog the file again
+    info.startSeconds = reader.dhmsToUInt64(reader.getStartDayOfYear(), reader.getStartHour(),
+                                            reader.getStartMinute(),    reader.getStartSecond());
+    info.stopSeconds  = reader.dhmsToUInt64(reader.getStopDayOfYear(),  reader.getStopHour(),
+                                            reader.getStopMinute(),     reader.getStopSecond());
 
-    m_file_loaded = true;
+    result.log.append("  Loaded: " + info.filename +
+        " (PCM: " + QString::number(info.pcmChannelStrings.size()) +
+        ", Time: " + QString::number(info.timeChannelStrings.size()) + ")");
 
-    for (const QString& filepath : filenames)
+    resolveBatchFileChannels(info);
+
+    // Straight after the catalog, while the file's pages are still cached
+    if (pre_scan && !info.skip)
     {
-        addRecentFile(filepath);
+        ProcessingCoordinator::preScanBatchFile(info, scan_params, result.log);
     }
+    return result;
+}
+
+void MainViewModel::onBatchFileLoaded(int index)
+{
+    BatchIntakeResult result = m_intake_watcher->resultAt(index);
+
+    // A newer openFiles() or clearState() supersedes this intake
+    if (!m_batch_loading || index >= m_batch_files.size() ||
+        m_batch_files[index].filepath != result.info.filepath)
+    {
+        return;
+    }
+
+    for (const QString& line : std::as_const(result.log))
+    {
+        emit logMessageReceived(line);
+    }
+    m_batch_files[index] = result.info;
+    m_batch_loaded_count++;
 
     rebuildBatchStatusSummary();
-    emit inputFilenameChanged();
-    emit fileLoadedChanged();
-    emit batchFilesChanged();
+    emit batchFileLoaded(index);
+    emit batchLoadProgress(m_batch_loaded_count, static_cast<int>(m_batch_files.size()));
 }
 
-void MainViewModel::validateBatchFiles()
+void MainViewModel::onBatchIntakeFinished()
 {
-    if (!m_batch_mode || m_batch_files.isEmpty())
+    if (!m_batch_loading)
     {
         return;
     }
+    setBatchLoading(false);
 
-    for (BatchFileInfo& info : m_batch_files)
+    // Cancelled: files not read yet stay listed and are skipped
+    if (m_batch_loaded_count < m_batch_files.size())
     {
-        if (info.skipReason == "Failed to read file metadata")
+        for (BatchFileInfo& info : m_batch_files)
         {
-            continue;
+            if (!info.loaded)
+            {
+                info.skip = true;
+                info.skipReason = "Loading cancelled";
+            }
         }
+        emit logMessageReceived("Loading cancelled: " + QString::number(m_batch_loaded_count) + " of " +
+            QString::number(m_batch_files.size()) + " files read.");
+    }
 
-        info.skip = false;
-        info.skipReason.clear();
-        info.hasPcmChannel = !info.pcmChannelStrings.isEmpty();
-        info.hasTimeChannel = !info.timeChannelStrings.isEmpty();
+    m_file_loaded = true;
 
-        // Auto-select first available channel in each file
-        info.resolvedPcmIndex = info.hasPcmChannel ? 0 : -1;
-        info.resolvedTimeIndex = info.hasTimeChannel ? 0 : -1;
+    for (const BatchFileInfo& info : std::as_const(m_batch_files))
+    {
+        addRecentFile(info.filepath);
+    }
 
-        if (!info.hasPcmChannel)
-        {
-            info.skip = true;
-            info.skipReason = "No PCM channels in file";
-        }
-        else if (!info.hasTimeChannel)
-        {
-            info.skip = true;
-            info.skipReason = "No time channels in file";
-        }
+    rebuildBatchStatusSummary();
+    emit inputFilenameChanged();
+    emit fileLoadedChanged();
+    emit batchFilesChanged();
+}
+
+void MainViewModel::setBatchLoading(bool loading)
+{
+    if (m_batch_loading != loading)
+    {
+        m_batch_loading = loading;
+        emit batchLoadingChanged();
+    }
+}
+
+void MainViewModel::resolveBatchFileChannels(BatchFileInfo& info)
+{
+    info.skip = false;
+    info.skipReason.clear();
+    info.hasPcmChannel = !info.pcmChannelStrings.isEmpty();
+    info.hasTimeChannel = !info.timeChannelStrings.isEmpty();
+
+    // Auto-select first available channel in each file
+    info.resolvedPcmIndex = info.hasPcmChannel ? 0 : -1;
+    info.resolvedTimeIndex = info.hasTimeChannel ? 0 : -1;
+
+    if (!info.hasPcmChannel)
+    {
+        info.skip = true;
+        info.skipReason = "No PCM channels in file";
+    }
+    else if (!info.hasTimeChannel)
+    {
+        info.skip = true;
+        info.skipReason = "No time channels in file";
     }
 }
 
@@ -781,7 +889,7 @@ void MainViewModel::setBatchFileTimeChannel(int fileIndex, int channelIndex)
 
 void MainViewModel::retryFailedFiles()
 {
-    if (m_coordinator->processing() || !m_batch_mode)
+    if (m_coordinator->processing() || !m_batch_mode || m_batch_loading)
     {
         return;
     }
@@ -792,7 +900,8 @@ void MainViewModel::retryFailedFiles()
 void MainViewModel::reorderBatchFile(int from, int to)
 {
     const int count = m_batch_files.size();
-    if (from < 0 || from >= count || to < 0 || to >= count || from == to)
+    // Intake results are matched to the list by position
+    if (m_batch_loading || from < 0 || from >= count || to < 0 || to >= count || from == to)
     {
         return;
     }
@@ -803,7 +912,7 @@ void MainViewModel::reorderBatchFile(int from, int to)
 
 void MainViewModel::startBatchProcessing(const QString& output_dir, int sample_rate_index)
 {
-    if (m_coordinator->processing())
+    if (m_coordinator->processing() || m_batch_loading)
     {
         return;
     }
@@ -842,7 +951,9 @@ void MainViewModel::openFile(const QString& filename)
     QFileInfo file_info(filename);
     emit logMessageReceived("Opening: " + file_info.fileName());
 
-    if (!m_reader->loadChannels(filename))
+    // The time range needs only the two ends of the file, so the extraction
+    // window can be set while the channels are cataloged
+    if (!m_reader->loadTimeRange(filename))
     {
         m_input_filename.clear();
         return;
@@ -860,20 +971,6 @@ void MainViewModel::openFile(const QString& filename)
     emit logMessageReceived("  File size: " + size_str +
         ", Recording duration: " + QString::number(duration_sec) + "s");
 
-    // Log channels found
-    QStringList time_list = m_reader->getTimeChannelComboBoxList();
-    QStringList pcm_list = m_reader->getPCMChannelComboBoxList();
-    emit logMessageReceived("  Time channels: " + (time_list.isEmpty() ? "none" : QString::number(time_list.size())));
-    for (const QString& ch : time_list)
-    {
-        emit logMessageReceived("    " + ch);
-    }
-    emit logMessageReceived("  PCM channels: " + (pcm_list.isEmpty() ? "none" : QString::number(pcm_list.size())));
-    for (const QString& ch : pcm_list)
-    {
-        emit logMessageReceived("    " + ch);
-    }
-
     // Log file time range
     emit logMessageReceived("  Time range: " +
         QString("%1:%2:%3:%4")
@@ -888,6 +985,72 @@ void MainViewModel::openFile(const QString& filename)
             .arg(m_reader->getStopMinute(), 2, UIConstants::kDecimalBase, QChar('0'))
             .arg(m_reader->getStopSecond(), 2, UIConstants::kDecimalBase, QChar('0')));
 
+    setChannelsLoading(true);
+    emit inputFilenameChanged();
+    emit fileTimesChanged();
+
+    if (m_catalog_watcher == nullptr)
+    {
+        m_catalog_watcher = new QFutureWatcher<ChannelCatalogResult>(this);
+        connect(m_catalog_watcher, &QFutureWatcher<ChannelCatalogResult>::finished,
+                this, &MainViewModel::onChannelCatalogFinished);
+    }
+    m_catalog_watcher->setFuture(QtConcurrent::run(&MainViewModel::loadChannelCatalog, filename));
+}
+
+ChannelCatalogResult MainViewModel::loadChannelCatalog(const QString& filename)
+{
+    ChannelCatalogResult result;
+    result.filename = filename;
+    auto reader = std::make_shared<Chapter10Reader>();
+    // Direct connection: the message is stored on the worker thread before loadChannels() returns
+    QObject::connect(reader.get(), &Chapter10Reader::displayErrorMessage,
+                     [&result](const QString& message) { result.error = message; });
+    if (reader->loadChannels(filename))
+    {
+        result.reader = std::move(reader);
+    }
+    return result;
+}
+
+void MainViewModel::onChannelCatalogFinished()
+{
+    ChannelCatalogResult result = m_catalog_watcher->result();
+
+    // A newer openFile() or clearState() supersedes this catalog
+    if (!m_channels_loading || result.filename != m_input_filename)
+    {
+        return;
+    }
+    setChannelsLoading(false);
+
+    if (result.reader == nullptr)
+    {
+        if (!result.error.isEmpty())
+        {
+            emit errorOccurred(result.error);
+        }
+        m_input_filename.clear();
+        emit inputFilenameChanged();
+        emit fileTimesChanged();
+        return;
+    }
+    m_reader->takeChannels(*result.reader);
+
+    // Log channels found
+    QStringList time_list = m_reader->getTimeChannelComboBoxList();
+    QStringList pcm_list = m_reader->getPCMChannelComboBoxList();
+    emit logMessageReceived("  Time channels: " + (time_list.isEmpty() ? "none" : QString::number(time_list.size())));
+    for (const QString& ch : time_list)
+    {
+        emit logMessageReceived("    " + ch);
+    }
+    emit logMessageReceived("  PCM channels: " + (pcm_list.isEmpty() ? "none" : QString::number(pcm_list.size())));
+    for (const QString& ch : pcm_list)
+    {
+        emit logMessageReceived("    " + ch);
+    }
+
     // Log current frame settings
     emit logMessageReceived("  FrameSync=" + m_settings_frame_sync +
         ", Polarity=" + QString(UIConstants::kPolarityLabels[m_settings_polarity_idx]) +
@@ -898,15 +1061,23 @@ void MainViewModel::openFile(const QString& filename)
         ", Frame setup=" + QString::number(m_frame_setup->length()) + " parameters");
 
     m_file_loaded = true;
-    addRecentFile(filename);
+    addRecentFile(m_input_filename);
     emit inputFilenameChanged();
     emit channelListsChanged();
-    emit fileTimesChanged();
     emit fileLoadedChanged();
 
     m_coordinator->runPreScan(m_reader->getCurrentPCMChannelID(), m_input_filename, m_settings_frame_sync);
 }
 
+void MainViewModel::setChannelsLoading(bool loading)
+{
+    if (m_channels_loading != loading)
+    {
+        m_channels_loading = loading;
+        emit channelsLoadingChanged();
+    }
+}
+
 void MainViewModel::startProcessing(const QString& output_file,
                                      const QString& start_time,
                                      const QString& stop_time,
@@ -989,6 +1160,12 @@ void MainViewModel::clearState()
     m_input_filename.clear();
     m_last_output_file.clear();
     m_file_loaded = false;
+    setChannelsLoading(false);
+    if (m_batch_loading)
+    {
+        m_intake_watcher->cancel();
+        setBatchLoading(false);
+    }
     m_time_channel_index = 0;
     m_pcm_channel_index = 0;
 
@@ -1016,6 +1193,12 @@ void MainViewModel::clearState()
 
 void MainViewModel::cancelProcessing()
 {
+    if (m_batch_loading)
+    {
+        // No further files start; those being read finish and are dropped
+        m_intake_watcher->cancel();
+        return;
+    }
     m_coordinator->cancelProcessing();
 }
 
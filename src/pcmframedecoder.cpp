@@ -0,0 +1,169 @@
+/**
+ * @file pcmframedecoder.cpp
+ * @brief Implementation of PcmFrameDecoder — frame timestamps and calibration.
+ */
+
+#include "pcmframedecoder.h"
+
+#include <utility>
+
+#include "constants.h"
+
+using namespace Irig106;
+
+TimeBinAccumulator PcmDecodeSetup::makeAccumulator(size_t rate_index) const
+{
+    std::vector<uint32_t> columns(plan.size());
+    for (size_t f = 0; f < plan.size(); f++)
+    {
+        columns[f] = plan.field(f).column;
+    }
+    const auto window = windows.empty() ? std::make_pair(start_seconds, stop_seconds) : windows[rate_index];
+    return TimeBinAccumulator(window.first, window.second, sample_rates[rate_index], std::move(columns), num_columns);
+}
+
+std::vector<TimeBinAccumulator> PcmDecodeSetup::makeAccumulators() const
+{
+    std::vector<TimeBinAccumulator> bins;
+    bins.reserve(sample_rates.size());
+    for (size_t r = 0; r < sample_rates.size(); r++)
+    {
+        bins.push_back(makeAccumulator(r));
+    }
+    return bins;
+}
+
+PcmDecodeCounters& PcmDecodeCounters::operator+=(const PcmDecodeCounters& other)
+{
+    bytes += other.bytes;
+    frames += other.frames;
+    syncs += other.syncs;
+    locks += other.locks;
+    unlocks += other.unlocks;
+    missed_syncs += other.missed_syncs;
+    return *this;
+}
+
+PcmDecodeCounters PcmDecodeCounters::operator-(const PcmDecodeCounters& other) const
+{
+    PcmDecodeCounters diff;
+    diff.bytes = bytes - other.bytes;
+    diff.frames = frames - other.frames;
+    diff.syncs = syncs - other.syncs;
+    diff.locks = locks - other.locks;
+    diff.unlocks = unlocks - other.unlocks;
+    diff.missed_syncs = missed_syncs - other.missed_syncs;
+    return diff;
+}
+
+PcmFrameDecoder::PcmFrameDecoder(const PcmDecodeSetup& setup)
+    : m_sync(setup.sync, setup.engine),
+      m_slopes(setup.slopes),
+      m_scales(setup.scales),
+      m_delta_100ns(setup.delta_100ns),
+      m_values(setup.plan.size(), 0.0)
+{
+    m_sync.setExtractionPlan(setup.plan);
+}
+
+PcmDecodeCounters PcmFrameDecoder::counters() const
+{
+    PcmDecodeCounters counters;
+    counters.bytes = m_bytes_processed;
+    counters.frames = m_frames_extracted;
+    counters.syncs = m_sync.totalSyncs();
+    counters.locks = m_sync.lockCount();
+    counters.unlocks = m_sync.unlockCount();
+    counters.missed_syncs = m_sync.missedSyncs();
+    return counters;
+}
+
+void PcmFrameDecoder::setTimeReference(const SuTimeRef& time_ref)
+{
+    const int64_t irig_ticks = (static_cast<int64_t>(time_ref.suIrigTime.ulSecs) * PCMConstants::kTicksPerSecond) +
+                               static_cast<int64_t>(time_ref.suIrigTime.ulFrac);
+    m_irig_offset = irig_ticks - time_ref.uRelTime;
+}
+
+void PcmFrameDecoder::reset(uint64_t stream_bit)
+{
+    m_sync.reset(stream_bit);
+    m_current_ref = PacketTimeRef();
+    m_previous_ref = PacketTimeRef();
+    m_has_time_ref = false;
+    m_bit_offset = stream_bit;
+    m_frames_extracted = 0;
+    m_bytes_processed = 0;
+}
+
+void PcmFrameDecoder::processPacket(const uint8_t* payload, size_t num_bytes, int64_t packet_time,
+                                    TimeBinAccumulator& bins)
+{
+    decodePacket(payload, num_bytes, packet_time, &bins, 1);
+}
+
+void PcmFrameDecoder::processPacket(const uint8_t* payload, size_t num_bytes, int64_t packet_time,
+                                    std::vector<TimeBinAccumulator>& bins)
+{
+    decodePacket(payload, num_bytes, packet_time, bins.data(), bins.size());
+}
+
+void PcmFrameDecoder::decodePacket(const uint8_t* payload, size_t num_bytes, int64_t packet_time,
+                                   TimeBinAccumulator* bins, size_t num_bins)
+{
+    const uint64_t packet_bits = static_cast<uint64_t>(num_bytes) * 8;
+
+    // Keep current + previous packet references for frames spanning a boundary
+    if (m_has_time_ref)
+    {
+        m_previous_ref = m_current_ref;
+    }
+    m_current_ref.base_time = packet_time;
+    m_current_ref.start_bit = m_bit_offset;
+    m_current_ref.num_bits = packet_bits;
+    m_has_time_ref = true;
+
+    m_sync.processPacket(payload, num_bytes);
+
+    const size_t width = m_sync.frameWidth();
+    for (size_t frame = 0; frame < m_sync.frameCount(); frame++)
+    {
+        // Compute per-frame time using bit-level interpolation
+        const uint64_t frame_start_bit = m_sync.frameStartBit(frame);
+        const PacketTimeRef& ref =
+            (frame_start_bit >= m_current_ref.start_bit) ? m_current_ref : m_previous_ref;
+
+        const int64_t frame_rel_time = ref.base_time +
+            static_cast<int64_t>(static_cast<double>(frame_start_bit - ref.start_bit) * m_delta_100ns);
+        const int64_t frame_ticks = frame_rel_time + m_irig_offset;
+
+        // Frames outside every accumulator's window are not calibrated
+        bool in_window = false;
+        for (size_t b = 0; b < num_bins && !in_window; b++)
+        {
+            in_window = bins[b].inWindow(frame_ticks); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        if (!in_window)
+        {
+            continue;
+        }
+
+        // The synchronizer only extracted the planned words, already masked
+        const uint64_t* frame_values = m_sync.frameWords(frame);
+        for (size_t f = 0; f < width; f++)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            const auto raw_value = static_cast<int64_t>(frame_values[f]);
+            m_values[f] = (static_cast<double>(raw_value) + m_scales[f]) * m_slopes[f];
+        }
+        for (size_t b = 0; b < num_bins; b++)
+        {
+            bins[b].addFrame(frame_ticks, m_values.data()); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+        m_frames_extracted++;
+    }
+
+    m_bit_offset += packet_bits;
+    m_bytes_processed += num_bytes;
+}
+// End of file!
@@ -0,0 +1,810 @@
+/**
+ * @file pcmframesync.cpp
+ * @brief Implementation of PcmFrameSynchronizer — bit-serial and word-parallel engines.
+ */
+
+#include "pcmframesync.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <stdlib.h>
+#endif
+
+#include "rnrzldecoder.h"
+
+namespace {
+    constexpr uint32_t kBitsPerWord = 64;
+    constexpr uint64_t kTopBit = 0x8000000000000000ULL;
+
+    /// Counts leading zero bits of a non-zero 64-bit value.
+    inline int countLeadingZeros(uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return 63 - static_cast<int>(index);
+#else
+        return __builtin_clzll(value);
+#endif
+    }
+
+    /// Reverses the byte order of a 64-bit value.
+    inline uint64_t byteSwap64(uint64_t value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_uint64(value);
+#else
+        return __builtin_bswap64(value);
+#endif
+    }
+
+    // Payload is packed in chunks so the packed blocks, hit words and source
+    // bytes of one chunk stay cache-resident through sync search and extraction.
+    constexpr size_t kChunkBytes = 32 * 1024;
+    constexpr size_t kBytesPerBlock = 8;
+
+    /**
+     * @brief Converts 8 payload bytes (native little-endian load) to an MSB-first block.
+     *
+     * With pair swapping the stream order is b1 b0 b3 b2 ..., i.e. the four
+     * 16-bit lanes of the native load in reverse order.
+     */
+    template<bool kSwapPairs>
+    inline uint64_t toStreamOrder(uint64_t native)
+    {
+        if (kSwapPairs)
+        {
+            constexpr uint64_t kLowHalves = 0x0000FFFF0000FFFFULL;
+            const uint64_t halves = (native >> 32) | (native << 32);
+            return ((halves & kLowHalves) << 16) | ((halves >> 16) & kLowHalves);
+        }
+        return byteSwap64(native);
+    }
+
+    /**
+     * @brief Fused byte-swap + RNRZ-L descramble + 64-bit packing of one chunk.
+     *
+     * Writes ceil(num_bytes / 8) blocks to @p out; the last block is zero-padded.
+     * @p history carries the descrambler input history across calls.
+     */
+    template<bool kSwapPairs, bool kRandomized>
+    void conditionBlocks(const uint8_t* src, size_t num_bytes, uint64_t* out, uint64_t& history)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const size_t full_blocks = num_bytes / kBytesPerBlock;
+        for (size_t b = 0; b < full_blocks; b++)
+        {
+            uint64_t native = 0;
+            memcpy(&native, src + (b * kBytesPerBlock), kBytesPerBlock);
+            uint64_t block = toStreamOrder<kSwapPairs>(native);
+            if (kRandomized)
+            {
+                block = RnrzlDecoder::derandomizeBlock(block, history);
+            }
+            out[b] = block;
+        }
+
+        const size_t rem_bytes = num_bytes % kBytesPerBlock;
+        if (rem_bytes != 0)
+        {
+            uint8_t padded[kBytesPerBlock] = {};
+            memcpy(padded, src + (full_blocks * kBytesPerBlock), rem_bytes);
+            uint64_t native = 0;
+            memcpy(&native, padded, kBytesPerBlock);
+            uint64_t block = toStreamOrder<kSwapPairs>(native);
+            if (kRandomized)
+            {
+                const uint64_t rem_bits = rem_bytes * 8;
+                const uint64_t prev_history = history;
+                const uint64_t valid_mask = ~(~0ULL >> rem_bits);
+                const uint64_t in = block;
+                block = RnrzlDecoder::derandomizeBlock(in, history) & valid_mask;
+                history = ((prev_history << rem_bits) | (in >> (64 - rem_bits))) & RnrzlDecoder::kLfsrMask;
+            }
+            out[full_blocks] = block;
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /// Mask of the @p bits low-order bits.
+    constexpr uint64_t lowMask(uint32_t bits)
+    {
+        return (bits >= kBitsPerWord) ? ~0ULL : ((1ULL << bits) - 1);
+    }
+
+    /// Branch-free 64-bit window ending at @p local_bit (>= 63) of MSB-first blocks.
+    inline uint64_t windowAt(const uint64_t* blocks, uint64_t local_bit)
+    {
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const uint64_t block = local_bit / kBitsPerWord;
+        const uint64_t offset = local_bit % kBitsPerWord;
+        return (blocks[block] >> (kBitsPerWord - 1 - offset)) | ((blocks[block - 1] << offset) << 1);
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    // Plans reading at least one word in four unpack the whole frame
+    constexpr size_t kDensePlanRatio = 4;
+
+    /**
+     * @brief Unpacks @p data_words fixed-width words following the sync at @p sync_local.
+     *
+     * One 64-bit window serves 64 / kWordLen consecutive words, with constant
+     * shifts and mask per word.
+     */
+    template<uint32_t kWordLen>
+    void unpackWords(const uint64_t* blocks, uint64_t sync_local, uint32_t data_words, uint64_t* words)
+    {
+        constexpr uint32_t kPerWindow = kBitsPerWord / kWordLen;
+        constexpr uint64_t kMask = (1ULL << kWordLen) - 1;
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        uint32_t k = 0;
+        for (; k + kPerWindow <= data_words; k += kPerWindow)
+        {
+            const uint64_t window = windowAt(blocks, sync_local + (uint64_t{k + kPerWindow} * kWordLen));
+            for (uint32_t j = 0; j < kPerWindow; j++)
+            {
+                words[k + j] = (window >> ((kPerWindow - 1 - j) * kWordLen)) & kMask;
+            }
+        }
+        if (k < data_words)
+        {
+            const uint32_t rest = data_words - k;
+            const uint64_t window = windowAt(blocks, sync_local + (uint64_t{data_words} * kWordLen));
+            for (uint32_t j = 0; j < rest; j++)
+            {
+                words[k + j] = (window >> ((rest - 1 - j) * kWordLen)) & kMask;
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    using ConditionFn = void (*)(const uint8_t*, size_t, uint64_t*, uint64_t&);
+
+    /// Picks the branch-free specialization for a payload format.
+    ConditionFn conditionFunction(bool swap_pairs, bool randomized)
+    {
+        if (swap_pairs)
+        {
+            return randomized ? &conditionBlocks<true, true> : &conditionBlocks<true, false>;
+        }
+        return randomized ? &conditionBlocks<false, true> : &conditionBlocks<false, false>;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                       CONSTRUCTOR / STATE                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+PcmFrameSynchronizer::PcmFrameSynchronizer(const PcmFrameSyncConfig& config,
+                                           SyncEngine engine,
+                                           SyncCorrelator::Kernel kernel)
+    : m_config(config),
+      m_engine(engine),
+      m_plan(ExtractionPlan::allWords(config.words_in_frame, config.word_len, config.word_mask)),
+      m_correlator(config.sync_pat, config.sync_mask, kernel)
+{
+    const uint64_t step = (m_config.word_len == 0) ? 1 : m_config.word_len;
+    m_data_bits = static_cast<uint64_t>(ExtractionPlan::dataWordCount(m_config.words_in_frame,
+                                                                      m_config.word_len)) * step;
+    selectExtractor(true);
+    reset();
+}
+
+void PcmFrameSynchronizer::setExtractionPlan(const ExtractionPlan& plan)
+{
+    m_plan = plan;
+    reset();
+}
+
+void PcmFrameSynchronizer::setSpecializedExtraction(bool enabled)
+{
+    selectExtractor(enabled);
+}
+
+void PcmFrameSynchronizer::reset(uint64_t stream_bit)
+{
+    m_bit_offset = stream_bit;
+    m_stream_start = stream_bit;
+    m_sync_count = UINT64_MAX;
+    m_total_syncs = 0;
+    m_lfsr_history = 0;
+
+    m_lock_state = FrameLockState::Search;
+    m_consecutive_syncs = 0;
+    m_misses = 0;
+    m_lock_count = 0;
+    m_unlock_count = 0;
+    m_missed_syncs = 0;
+
+    m_test_word = 0;
+    m_frame_bit_count = 0;
+    m_frame_word_count = 0;
+    m_word_bit_count = 0;
+    m_save_data = 0;
+    m_current_words.assign(m_config.words_in_frame, 0);
+
+    m_tail = 0;
+    m_last_sync = UINT64_MAX;
+    m_field_values.assign(m_plan.size(), 0);
+    m_frame_scratch.assign(static_cast<size_t>(ExtractionPlan::dataWordCount(m_config.words_in_frame,
+                                                                            m_config.word_len)) + 1, 0);
+    m_fields_collected = 0;
+    m_in_frame = false;
+
+    m_frame_end_bits.clear();
+    m_frame_words.clear();
+}
+
+bool PcmFrameStreamState::operator==(const PcmFrameStreamState& other) const
+{
+    return bit_offset == other.bit_offset && lock_state == other.lock_state &&
+           spaced_syncs == other.spaced_syncs && consecutive_syncs == other.consecutive_syncs &&
+           misses == other.misses && lfsr_history == other.lfsr_history &&
+           last_bits == other.last_bits && last_sync == other.last_sync &&
+           frame_bit_count == other.frame_bit_count && frame_word_count == other.frame_word_count &&
+           word_bit_count == other.word_bit_count && save_data == other.save_data &&
+           words == other.words;
+}
+
+PcmFrameStreamState PcmFrameSynchronizer::streamState() const
+{
+    PcmFrameStreamState state;
+    state.bit_offset = m_bit_offset;
+    state.lock_state = m_lock_state;
+
+    // m_sync_count + 1 spaced syncs so far (-1 wraps to 0); frames are gated
+    // on m_sync_count >= min_syncs, which stays true once reached
+    state.spaced_syncs = std::min<uint64_t>(m_sync_count + 1, m_config.min_syncs + 1);
+    if (m_lock_state != FrameLockState::Lock && m_config.lock_misses > 0)
+    {
+        state.consecutive_syncs = std::min<uint64_t>(m_consecutive_syncs,
+                                                     std::max<uint64_t>(m_config.min_syncs, 1));
+    }
+    if (m_lock_state == FrameLockState::Lock)
+    {
+        state.misses = m_misses;
+    }
+    if (m_config.randomized)
+    {
+        state.lfsr_history = m_lfsr_history;
+    }
+
+    if (m_engine == SyncEngine::BitSerial)
+    {
+        state.last_bits = m_test_word;
+        state.frame_bit_count = m_frame_bit_count;
+        state.frame_word_count = m_frame_word_count;
+        state.word_bit_count = m_word_bit_count;
+        state.save_data = m_save_data;
+        state.words = m_current_words;
+        return state;
+    }
+
+    state.last_bits = m_tail;
+    if (m_in_frame)
+    {
+        state.last_sync = m_last_sync;
+        state.words.assign(m_field_values.begin(),
+                           m_field_values.begin() + static_cast<std::ptrdiff_t>(m_fields_collected));
+    }
+    return state;
+}
+
+const char* PcmFrameSynchronizer::engineName(SyncEngine engine)
+{
+    switch (engine)
+    {
+    case SyncEngine::BitSerial:
+        return "bit-serial";
+    case SyncEngine::WordParallel:
+        return "word-parallel";
+    }
+    return "unknown";
+}
+
+const char* PcmFrameSynchronizer::lockStateName(FrameLockState state)
+{
+    switch (state)
+    {
+    case FrameLockState::Search:
+        return "search";
+    case FrameLockState::Check:
+        return "check";
+    case FrameLockState::Lock:
+        return "lock";
+    }
+    return "unknown";
+}
+
+void PcmFrameSynchronizer::processPacket(const uint8_t* data, size_t num_bytes)
+{
+    m_frame_end_bits.clear();
+    m_frame_words.clear();
+
+    if (num_bytes == 0)
+    {
+        return;
+    }
+
+    if (m_engine == SyncEngine::BitSerial)
+    {
+        processPacketBitSerial(data, num_bytes);
+        return;
+    }
+
+    // SwapBytes_PcmF1 rejects odd-length buffers and leaves them unswapped
+    const bool swap_bytes = m_config.swap_bytes && (num_bytes % 2 == 0);
+    for (size_t offset = 0; offset < num_bytes; offset += kChunkBytes)
+    {
+        const size_t len = (num_bytes - offset < kChunkBytes) ? (num_bytes - offset) : kChunkBytes;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        processChunkWordParallel(data + offset, len, swap_bytes);
+    }
+}
+
+void PcmFrameSynchronizer::emitFrame(uint64_t sync_bit)
+{
+    m_frame_end_bits.push_back(sync_bit);
+    if (m_engine == SyncEngine::WordParallel)
+    {
+        m_frame_words.insert(m_frame_words.end(), m_field_values.begin(), m_field_values.end());
+        return;
+    }
+
+    // Bit-serial engine stores every slot; gather the planned ones
+    for (size_t f = 0; f < m_plan.size(); f++)
+    {
+        const ExtractionField& field = m_plan.field(f);
+        m_frame_words.push_back(m_current_words[field.word] & field.mask);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                         LOCK STATE MACHINE                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+void PcmFrameSynchronizer::updateLock(bool spaced)
+{
+    // Called for every sync found while searching every bit
+    m_consecutive_syncs = spaced ? m_consecutive_syncs + 1 : 0;
+    m_lock_state = FrameLockState::Check;
+
+    const uint64_t syncs_to_lock = std::max<uint64_t>(m_config.min_syncs, 1);
+    if (m_config.lock_misses > 0 && m_consecutive_syncs >= syncs_to_lock)
+    {
+        m_lock_state = FrameLockState::Lock;
+        m_misses = 0;
+        m_lock_count++;
+    }
+}
+
+bool PcmFrameSynchronizer::checkLockedSync(uint64_t sync_bit, bool matched, bool complete)
+{
+    if (matched)
+    {
+        m_total_syncs++;
+        m_sync_count++;
+        m_consecutive_syncs++;
+        m_misses = 0;
+        if (m_sync_count >= m_config.min_syncs && complete)
+        {
+            emitFrame(sync_bit);
+        }
+        return true;
+    }
+
+    m_missed_syncs++;
+    m_consecutive_syncs = 0;
+    m_misses++;
+    if (m_misses >= m_config.lock_misses)
+    {
+        // Lost lock: resume the every-bit search after this position
+        m_lock_state = FrameLockState::Search;
+        m_unlock_count++;
+        return false;
+    }
+
+    // Flywheel: assume the frame boundary and drop the frame it closes
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                          BIT-SERIAL ENGINE                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+void PcmFrameSynchronizer::processPacketBitSerial(const uint8_t* raw_data, size_t num_bytes)
+{
+    const uint64_t packet_bits = static_cast<uint64_t>(num_bytes) * 8;
+    constexpr uint8_t kHighBit = 0x80;
+
+    // Reference path: separate swap and descramble passes over a copy
+    m_scratch.assign(raw_data, raw_data + num_bytes); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    if (m_config.swap_bytes && (num_bytes % 2 == 0))
+    {
+        for (size_t i = 0; i + 1 < num_bytes; i += 2)
+        {
+            std::swap(m_scratch[i], m_scratch[i + 1]);
+        }
+    }
+    if (m_config.randomized)
+    {
+        auto lfsr = static_cast<uint16_t>(m_lfsr_history);
+        RnrzlDecoder::derandomizeBitSerial(m_scratch.data(), packet_bits, lfsr);
+        m_lfsr_history = lfsr;
+    }
+    const uint8_t* data = m_scratch.data();
+
+    for (uint64_t bit_pos = 0; bit_pos < packet_bits; bit_pos++)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        uint8_t bit_val = ((data[bit_pos / 8] & (kHighBit >> (bit_pos % 8))) != 0) ? 1 : 0;
+        const uint64_t global_bit = m_bit_offset + bit_pos;
+
+        m_test_word = (m_test_word << 1) | bit_val;
+        m_frame_bit_count++;
+
+        bool frame_boundary = false;
+        if (m_lock_state == FrameLockState::Lock)
+        {
+            // Only the predicted sync position is compared
+            if (m_frame_bit_count == m_config.bits_in_frame)
+            {
+                frame_boundary = checkLockedSync(global_bit,
+                                                 (m_test_word & m_config.sync_mask) == m_config.sync_pat,
+                                                 m_save_data > 1);
+            }
+        }
+        else if (global_bit + 1 >= m_stream_start + m_config.sync_pat_len &&
+                 (m_test_word & m_config.sync_mask) == m_config.sync_pat)
+        {
+            m_total_syncs++;
+
+            const bool spaced = (m_frame_bit_count == m_config.bits_in_frame);
+            if (spaced)
+            {
+                m_sync_count++;
+
+                if (m_sync_count >= m_config.min_syncs && m_save_data > 1)
+                {
+                    emitFrame(global_bit);
+                }
+            }
+            updateLock(spaced);
+            frame_boundary = true;
+        }
+
+        if (frame_boundary)
+        {
+            m_frame_bit_count = 0;
+            m_frame_word_count = 1;
+            m_word_bit_count = 0;
+            m_save_data = 1;
+        }
+        else if (m_save_data == 1)
+        {
+            // Accumulate data word bits between sync patterns
+            m_word_bit_count++;
+            if (m_word_bit_count >= m_config.word_len)
+            {
+                if (m_frame_word_count - 1 < m_config.words_in_frame)
+                {
+                    m_current_words[m_frame_word_count - 1] = m_test_word & m_config.word_mask;
+                }
+                m_word_bit_count = 0;
+                m_frame_word_count++;
+            }
+
+            if (m_frame_word_count >= m_config.words_in_frame)
+            {
+                m_save_data = 2;
+            }
+        }
+    }
+
+    m_bit_offset += packet_bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                         WORD-PARALLEL ENGINE                               //
+////////////////////////////////////////////////////////////////////////////////
+
+// Local bit numbering: bit t of m_blocks (MSB of m_blocks[0] is t = 0) is global
+// stream bit m_bit_offset + t - 64, so block 0 replays the previous chunk's tail.
+
+uint64_t PcmFrameSynchronizer::windowEndingAt(uint64_t local_bit) const
+{
+    const size_t block = static_cast<size_t>(local_bit / kBitsPerWord);
+    const uint32_t offset = static_cast<uint32_t>(local_bit % kBitsPerWord);
+    if (offset == kBitsPerWord - 1)
+    {
+        return m_blocks[block];
+    }
+    return (m_blocks[block] >> (kBitsPerWord - 1 - offset)) |
+           (m_blocks[block - 1] << (offset + 1));
+}
+
+void PcmFrameSynchronizer::collectWordsUpTo(uint64_t last_bit)
+{
+    if (!m_in_frame)
+    {
+        return;
+    }
+
+    // Only planned words are read, each as one 64-bit window over m_blocks
+    const size_t num_fields = m_plan.size();
+    const ExtractionField* fields = m_plan.fields();
+    while (m_fields_collected < num_fields)
+    {
+        const ExtractionField& field = fields[m_fields_collected]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const uint64_t word_end = m_last_sync + field.end_bit;
+        if (word_end > last_bit)
+        {
+            break;
+        }
+        m_field_values[m_fields_collected] = (field.mask == 0) ? 0
+            : (windowEndingAt(word_end - m_bit_offset + kBitsPerWord) & field.mask);
+        m_fields_collected++;
+    }
+}
+
+bool PcmFrameSynchronizer::frameComplete(uint64_t sync_bit) const
+{
+    if (!m_in_frame)
+    {
+        return false;
+    }
+    // Every data word must have ended before this sync
+    return (m_config.words_in_frame < 2)
+        ? (sync_bit >= m_last_sync + 2)
+        : (m_last_sync + m_data_bits < sync_bit);
+}
+
+void PcmFrameSynchronizer::handleSync(uint64_t sync_bit)
+{
+    m_total_syncs++;
+
+    // Words ending before this sync belong to the frame it closes
+    collectWordsUpTo(sync_bit - 1);
+
+    const bool complete = frameComplete(sync_bit);
+
+    const auto spacing = static_cast<uint32_t>(sync_bit - m_last_sync);
+    const bool spaced = (spacing == m_config.bits_in_frame);
+    if (spaced)
+    {
+        m_sync_count++;
+        if (m_sync_count >= m_config.min_syncs && complete)
+        {
+            emitFrame(sync_bit);
+        }
+    }
+    updateLock(spaced);
+
+    m_last_sync = sync_bit;
+    m_fields_collected = 0;
+    m_in_frame = true;
+}
+
+void PcmFrameSynchronizer::processChunkWordParallel(const uint8_t* data, size_t num_bytes, bool swap_bytes)
+{
+    const uint64_t packet_bits = static_cast<uint64_t>(num_bytes) * 8;
+    const uint64_t local_end = packet_bits + kBitsPerWord;
+
+    // Single sweep over the source bytes: swap, descramble and pack
+    const size_t num_blocks = (num_bytes + kBytesPerBlock - 1) / kBytesPerBlock;
+    m_blocks.resize(num_blocks + 1);
+    m_blocks[0] = m_tail;
+    conditionFunction(swap_bytes, m_config.randomized)(data, num_bytes, m_blocks.data() + 1, m_lfsr_history);
+
+    const uint64_t chunk_end = m_bit_offset + packet_bits;
+    uint64_t search_from = m_bit_offset;
+    size_t hits_from = num_blocks + 1;  // first block with valid m_hits
+    m_hits.resize(num_blocks);
+
+    while (true)
+    {
+        if (m_lock_state == FrameLockState::Lock)
+        {
+            // Flywheel: jump frame to frame until lock is lost or the chunk ends
+            search_from = (this->*m_track_locked)(chunk_end);
+            if (m_lock_state == FrameLockState::Lock)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // Search / check: correlate the rest of the chunk once, then walk the hits
+        const size_t first_block = static_cast<size_t>((search_from - m_bit_offset) / kBitsPerWord) + 1;
+        if (first_block > num_blocks)
+        {
+            break;
+        }
+        if (first_block < hits_from)
+        {
+            m_correlator.findHits(m_blocks.data() + (first_block - 1), num_blocks - first_block + 1,
+                                  m_hits.data() + (first_block - 1));
+            hits_from = first_block;
+        }
+
+        bool locked = false;
+        for (size_t block = first_block; block <= num_blocks && !locked; block++)
+        {
+            uint64_t hits = m_hits[block - 1];
+            if (hits == 0)
+            {
+                continue;
+            }
+
+            // Bit (63 - i) marks a sync ending at local bit 64 * block + i
+            const uint64_t block_start = static_cast<uint64_t>(block) * kBitsPerWord;
+            const uint64_t valid = local_end - block_start;
+            if (valid < kBitsPerWord)
+            {
+                hits &= ~(~0ULL >> valid);
+            }
+            if (block == first_block)
+            {
+                hits &= ~0ULL >> ((search_from - m_bit_offset) % kBitsPerWord);
+            }
+
+            while (hits != 0)
+            {
+                const int i = countLeadingZeros(hits);
+                hits &= ~(kTopBit >> i);
+
+                const uint64_t sync_bit = m_bit_offset + block_start + static_cast<uint64_t>(i) - kBitsPerWord;
+                if (sync_bit + 1 < m_stream_start + m_config.sync_pat_len)
+                {
+                    continue;
+                }
+                handleSync(sync_bit);
+                if (m_lock_state == FrameLockState::Lock)
+                {
+                    search_from = sync_bit + 1;
+                    locked = true;
+                    break;
+                }
+            }
+        }
+        if (!locked)
+        {
+            break;
+        }
+    }
+
+    collectWordsUpTo(m_bit_offset + packet_bits - 1);
+
+    m_tail = windowEndingAt(local_end - 1);
+    m_bit_offset += packet_bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                       LOCK-MODE EXTRACTORS                                 //
+////////////////////////////////////////////////////////////////////////////////
+
+// kSyncLen / kWordLen of 0 take the value from m_config at runtime. Specialized
+// instances are only selected when the masks are the plain low-bit masks of
+// those lengths, so the constants below equal the runtime values.
+template<uint32_t kSyncLen, uint32_t kWordLen>
+uint64_t PcmFrameSynchronizer::trackLocked(uint64_t chunk_end)
+{
+    constexpr bool kFixedSync = (kSyncLen != 0);
+    constexpr bool kFixedWord = (kWordLen != 0);
+    const uint64_t sync_mask = kFixedSync ? lowMask(kSyncLen) : m_config.sync_mask;
+    const uint64_t sync_pat = m_config.sync_pat;
+    const uint64_t bits_in_frame = m_config.bits_in_frame;
+    const size_t num_fields = m_plan.size();
+    const ExtractionField* fields = m_plan.fields();
+    const uint64_t* blocks = m_blocks.data();
+    const uint64_t chunk_start = m_bit_offset - kBitsPerWord;  // global bit of local bit 0
+
+    // Frames too short for the planned words fall back to the bounded collector
+    const bool fields_fit = m_plan.lastEndBit() < bits_in_frame;
+    // Dense plans unpack every data word, several per 64-bit window, then gather
+    const uint32_t data_words = static_cast<uint32_t>(m_frame_scratch.size()) - 1;
+    const bool dense = kFixedWord && fields_fit && (m_data_bits < bits_in_frame) &&
+                       (num_fields * kDensePlanRatio >= data_words);
+
+    while (true)
+    {
+        const uint64_t expected = m_last_sync + bits_in_frame;
+        if (expected >= chunk_end)
+        {
+            return chunk_end;
+        }
+
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const uint64_t frame_base = m_last_sync - chunk_start;
+        if (!fields_fit)
+        {
+            collectWordsUpTo(expected - 1);
+        }
+        else if (dense && m_fields_collected == 0 && m_last_sync + 1 >= m_bit_offset)
+        {
+            if constexpr (kFixedWord)
+            {
+                unpackWords<kWordLen>(blocks, frame_base, data_words, m_frame_scratch.data());
+            }
+            for (size_t f = 0; f < num_fields; f++)
+            {
+                // The scratch slot past the data words is the zero sync slot
+                m_field_values[f] = m_frame_scratch[fields[f].word];
+            }
+            m_fields_collected = static_cast<uint32_t>(num_fields);
+        }
+        else
+        {
+            // Remaining fields of this frame (all of them unless it began in an earlier chunk)
+            for (; m_fields_collected < num_fields; m_fields_collected++)
+            {
+                const ExtractionField& field = fields[m_fields_collected];
+                const uint64_t window = kFixedWord ? windowAt(blocks, frame_base + field.end_bit)
+                                                   : windowEndingAt(frame_base + field.end_bit);
+                m_field_values[m_fields_collected] = window & field.mask;
+            }
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        const uint64_t window = windowAt(blocks, expected - chunk_start);
+        if (!checkLockedSync(expected, (window & sync_mask) == sync_pat, frameComplete(expected)))
+        {
+            return expected + 1;
+        }
+        m_last_sync = expected;
+        m_fields_collected = 0;
+    }
+}
+
+void PcmFrameSynchronizer::selectExtractor(bool specialized)
+{
+    m_track_locked = &PcmFrameSynchronizer::trackLocked<0, 0>;
+    m_extractor_name = "generic";
+    if (!specialized || m_config.word_mask != lowMask(m_config.word_len) ||
+        m_config.sync_mask != lowMask(m_config.sync_pat_len))
+    {
+        return;
+    }
+
+    switch (m_config.word_len)
+    {
+    case 16:
+        switch (m_config.sync_pat_len)
+        {
+        case 16:
+            m_track_locked = &PcmFrameSynchronizer::trackLocked<16, 16>;
+            m_extractor_name = "16-bit words, 16-bit sync";
+            break;
+        case 24:
+            m_track_locked = &PcmFrameSynchronizer::trackLocked<24, 16>;
+            m_extractor_name = "16-bit words, 24-bit sync";
+            break;
+        case 32:
+            m_track_locked = &PcmFrameSynchronizer::trackLocked<32, 16>;
+            m_extractor_name = "16-bit words, 32-bit sync";
+            break;
+        default:
+            break;
+        }
+        break;
+    case 8:
+        m_track_locked = &PcmFrameSynchronizer::trackLocked<0, 8>;
+        m_extractor_name = "8-bit words";
+        break;
+    case 10:
+        m_track_locked = &PcmFrameSynchronizer::trackLocked<0, 10>;
+        m_extractor_name = "10-bit words";
+        break;
+    case 12:
+        m_track_locked = &PcmFrameSynchronizer::trackLocked<0, 12>;
+        m_extractor_name = "12-bit words";
+        break;
+    default:
+        break;
+    }
+}
+// End of file!
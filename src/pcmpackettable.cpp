@@ -0,0 +1,77 @@
+/**
+ * @file pcmpackettable.cpp
+ * @brief Implementation of PcmPacketTable — packet index and chunk planning.
+ */
+
+#include "pcmpackettable.h"
+
+#include <algorithm>
+
+#include "i106_decode_tmats.h"
+#include "i106_decode_pcmf1.h"
+
+using namespace Irig106;
+
+void PcmPacketTable::clear()
+{
+    m_packets.clear();
+    m_time_refs.clear();
+    m_total_bits = 0;
+}
+
+void PcmPacketTable::addTimeReference(const SuTimeRef& time_ref)
+{
+    m_time_refs.push_back(time_ref);
+}
+
+void PcmPacketTable::addPacket(int64_t data_offset, uint32_t data_len, int64_t packet_time)
+{
+    PcmPacketEntry entry;
+    entry.data_offset = data_offset;
+    entry.data_len = data_len;
+    entry.time_ref = m_time_refs.empty() ? 0 : static_cast<uint32_t>(m_time_refs.size() - 1);
+    entry.packet_time = packet_time;
+    entry.start_bit = m_total_bits;
+    m_packets.push_back(entry);
+
+    // The 4-byte SuPcmF1_ChanSpec precedes the PCM payload
+    m_total_bits += static_cast<uint64_t>(data_len - sizeof(SuPcmF1_ChanSpec)) * 8;
+}
+
+std::vector<PcmDecodeChunk> PcmPacketTable::planChunks(uint64_t target_bytes, uint64_t lead_in_bits) const
+{
+    std::vector<PcmDecodeChunk> chunks;
+    const uint64_t target_bits = std::max<uint64_t>(target_bytes, 1) * 8;
+
+    size_t first = 0;
+    while (first < m_packets.size())
+    {
+        // Extend to the first packet boundary at or past the target size
+        size_t end = first + 1;
+        while (end < m_packets.size() &&
+               m_packets[end].start_bit - m_packets[first].start_bit < target_bits)
+        {
+            end++;
+        }
+
+        PcmDecodeChunk chunk;
+        chunk.first = first;
+        chunk.end = end;
+        if (first > 0)
+        {
+            // Latest packet starting at least lead_in_bits before the chunk
+            const uint64_t chunk_bit = m_packets[first].start_bit;
+            const uint64_t wanted = (chunk_bit > lead_in_bits) ? chunk_bit - lead_in_bits : 0;
+            const auto after = std::upper_bound(m_packets.begin(), m_packets.begin() + static_cast<std::ptrdiff_t>(first),
+                                                wanted, [](uint64_t bit, const PcmPacketEntry& entry) {
+                                                    return bit < entry.start_bit;
+                                                });
+            const auto lead_in = static_cast<size_t>(after - m_packets.begin());
+            chunk.lead_in = std::min(lead_in > 0 ? lead_in - 1 : 0, first - 1);
+        }
+        chunks.push_back(chunk);
+        first = end;
+    }
+    return chunks;
+}
+// End of file!
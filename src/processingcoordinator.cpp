@@ -5,30 +5,36 @@
 
 #include "processingcoordinator.h"
 
+#include <algorithm>
+#include <utility>
+
 #include <QFileInfo>
 #include <QMap>
+#include <QtConcurrent/QtConcurrent>
 
-#include "chapter10reader.h"
 #include "constants.h"
 #include "frameprocessor.h"
 #include "framesetup.h"
 
 ProcessingCoordinator::ProcessingCoordinator(QVector<BatchFileInfo>* batch_files,
                                              FrameSetup*             frame_setup,
-                                             Chapter10Reader*        reader,
                                              QObject*                parent)
     : QObject(parent),
       m_batch_files(batch_files),
-      m_frame_setup(frame_setup),
-      m_reader(reader)
+      m_frame_setup(frame_setup)
 {
     Q_ASSERT(batch_files != nullptr);
     Q_ASSERT(frame_setup != nullptr);
-    Q_ASSERT(reader != nullptr);
 }
 
 ProcessingCoordinator::~ProcessingCoordinator()
 {
+    // Pre-scan tasks own copies of their files; unstarted ones are dropped
+    if (m_pre_scanning)
+    {
+        m_pre_scan_watcher->cancel();
+    }
+
     if (m_worker_thread != nullptr && m_worker_thread->isRunning())
     {
         if (m_current_processor != nullptr)
@@ -39,6 +45,22 @@ ProcessingCoordinator::~ProcessingCoordinator()
         m_worker_thread->wait();
     }
     delete m_worker_thread;
+
+    // Pool threads finish their current file (aborted) before they quit
+    for (const auto& run : std::as_const(m_batch_runs))
+    {
+        run.processor->requestAbort();
+    }
+    for (QThread* thread : std::as_const(m_pool_threads))
+    {
+        thread->quit();
+        thread->wait();
+    }
+    for (const auto& run : std::as_const(m_batch_runs))
+    {
+        delete run.processor;
+    }
+    qDeleteAll(m_pool_threads);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,7 +102,6 @@ void ProcessingCoordinator::startBatchProcessing(const QString&              out
                                                   const QVector<QVector<bool>>& receiver_states)
 {
     m_batch_output_dir         = output_dir;
-    m_batch_current_index      = 0;
     m_batch_cancelled          = false;
     m_batch_success_count      = 0;
     m_batch_skip_count         = 0;
@@ -92,8 +113,6 @@ void ProcessingCoordinator::startBatchProcessing(const QString&              out
     m_scale_str                = scale_str;
     m_receiver_states          = receiver_states;
 
-    preScanBatchFiles();
-
     m_processing       = true;
     m_progress_percent = 0;
     emit processingStateChanged(true);
@@ -102,7 +121,7 @@ void ProcessingCoordinator::startBatchProcessing(const QString&              out
     emit logMessageReceived("--- Batch Processing: " +
         QString::number(m_batch_files->size()) + " files ---");
 
-    processNextBatchFile();
+    preScanBatchFiles();
 }
 
 void ProcessingCoordinator::retryFailedFiles(const QString&              frame_sync_str,
@@ -121,27 +140,25 @@ void ProcessingCoordinator::retryFailedFiles(const QString&              frame_s
     {
         if (info.processed && !info.processedOk && !info.skip)
         {
-            info.processed   = false;
-            info.processedOk = false;
-            info.preScanOk   = false;
+            info.processed           = false;
+            info.processedOk         = false;
+            info.preScanOk           = false;
+            info.preScanPcmChannelId = -1;
         }
     }
 
-    m_batch_current_index = 0;
     m_batch_cancelled     = false;
     m_batch_success_count = 0;
     m_batch_skip_count    = 0;
     m_batch_error_count   = 0;
 
-    preScanBatchFiles();
-
     m_processing       = true;
     m_progress_percent = 0;
     emit processingStateChanged(true);
     emit progressChanged(0);
 
     emit logMessageReceived("--- Batch Retry: Re-processing failed files ---");
-    processNextBatchFile();
+    preScanBatchFiles();
 }
 
 void ProcessingCoordinator::cancelProcessing()
@@ -150,9 +167,24 @@ void ProcessingCoordinator::cancelProcessing()
     {
         m_current_processor->requestAbort();
     }
+    for (const auto& run : std::as_const(m_batch_runs))
+    {
+        run.processor->requestAbort();
+    }
+    if (m_pre_scanning)
+    {
+        // No further pre-scans start; those running finish and the batch ends
+        m_pre_scan_watcher->cancel();
+    }
     m_batch_cancelled = true;
 }
 
+void ProcessingCoordinator::setBatchConcurrency(int workers, int files_per_device)
+{
+    m_batch_workers          = std::max(workers, 0);
+    m_batch_files_per_device = std::max(files_per_device, 0);
+}
+
 bool ProcessingCoordinator::runPreScan(int            pcm_channel_id,
                                         const QString& filename,
                                         const QString& frame_sync_str)
@@ -197,7 +229,11 @@ bool ProcessingCoordinator::runPreScan(int            pcm_channel_id,
 
 void ProcessingCoordinator::reset()
 {
-    m_batch_current_index = 0;
+    if (m_pre_scanning)
+    {
+        m_pre_scan_watcher->cancel();
+        m_pre_scanning = false;
+    }
     m_batch_cancelled     = false;
     m_batch_output_dir.clear();
     m_batch_success_count = 0;
@@ -309,81 +345,150 @@ void ProcessingCoordinator::launchWorkerThread(const ProcessingParams& params)
     m_worker_thread->start();
 }
 
-void ProcessingCoordinator::preScanBatchFiles()
+bool ProcessingCoordinator::batchPreScanParams(const QString& frame_sync_str, int data_words, ProcessingParams& params)
 {
     bool sync_ok = false;
-    uint64_t scan_sync = m_frame_sync_str.toULongLong(&sync_ok, UIConstants::kHexBase);
-    if (!sync_ok)
+    params.frame_sync = frame_sync_str.toULongLong(&sync_ok, UIConstants::kHexBase);
+    if (!sync_ok || data_words == 0)
     {
+        return false;
+    }
+
+    params.sync_pattern_length  = static_cast<int>(frame_sync_str.length()) * 4;
+    params.words_in_minor_frame = data_words + 1;
+    params.bits_in_minor_frame  = (data_words * PCMConstants::kCommonWordLen) + params.sync_pattern_length;
+    return true;
+}
+
+void ProcessingCoordinator::preScanBatchFile(BatchFileInfo& info, const ProcessingParams& params, QStringList& log)
+{
+    int idx = info.resolvedPcmIndex;
+    if (idx < 0 || idx >= info.pcmChannelIds.size())
+    {
+        info.preScanOk           = false;
+        info.preScanPcmChannelId = -1;
         return;
     }
 
-    int scan_sync_len = static_cast<int>(m_frame_sync_str.length()) * 4;
-    int data_words    = m_frame_setup->length();
-    if (data_words == 0)
+    ProcessingParams scan_params = params;
+    scan_params.filename         = info.filepath;
+    scan_params.pcm_channel_id   = info.pcmChannelIds[idx];
+
+    FrameProcessor scanner;
+    // Direct connection: lines are stored on the calling thread before preScan() returns
+    QObject::connect(&scanner, &FrameProcessor::logMessage,
+                     [&log](const QString& message) { log.append(message); });
+
+    info.preScanOk           = scanner.preScan(scan_params, info.isRandomized);
+    info.preScanPcmChannelId = scan_params.pcm_channel_id;
+    info.preScanFrameSync    = params.frame_sync;
+    info.preScanSyncBits     = params.sync_pattern_length;
+    info.preScanFrameWords   = params.words_in_minor_frame;
+}
+
+void ProcessingCoordinator::preScanBatchFiles()
+{
+    ProcessingParams scan_params;
+    if (!batchPreScanParams(m_frame_sync_str, m_frame_setup->length(), scan_params))
     {
+        runScannedBatch();
         return;
     }
-    int scan_words = data_words + 1;
-    int scan_bits  = (data_words * PCMConstants::kCommonWordLen) + scan_sync_len;
 
-    for (BatchFileInfo& info : *m_batch_files)
+    QVector<BatchFileInfo> pending;
+    m_pre_scan_indexes.clear();
+    for (int index = 0; index < m_batch_files->size(); index++)
     {
+        BatchFileInfo& info = (*m_batch_files)[index];
         if (info.skip || info.processedOk)
         {
             continue;
         }
 
+        // Without a resolved channel there is nothing to read; settle it here
         int idx = info.resolvedPcmIndex;
         if (idx < 0 || idx >= info.pcmChannelIds.size())
         {
-            info.preScanOk = false;
+            QStringList log;
+            preScanBatchFile(info, scan_params, log);
             continue;
         }
-        int pcm_ch_id = info.pcmChannelIds[idx];
 
-        ProcessingParams scan_params;
-        scan_params.filename             = info.filepath;
-        scan_params.pcm_channel_id       = pcm_ch_id;
-        scan_params.frame_sync           = scan_sync;
-        scan_params.sync_pattern_length  = scan_sync_len;
-        scan_params.words_in_minor_frame = scan_words;
-        scan_params.bits_in_minor_frame  = scan_bits;
+        // Intake already scanned this channel with the same frame layout
+        if (info.preScanPcmChannelId == info.pcmChannelIds[idx] &&
+            info.preScanFrameSync == scan_params.frame_sync &&
+            info.preScanSyncBits == scan_params.sync_pattern_length &&
+            info.preScanFrameWords == scan_params.words_in_minor_frame)
+        {
+            continue;
+        }
 
-        FrameProcessor scanner;
-        connect(&scanner, &FrameProcessor::logMessage,
-                this, &ProcessingCoordinator::logMessageReceived);
+        pending.append(info);
+        m_pre_scan_indexes.append(index);
+    }
 
-        info.preScanOk = scanner.preScan(scan_params, info.isRandomized);
+    if (pending.isEmpty())
+    {
+        emit batchFilesUpdated();
+        runScannedBatch();
+        return;
     }
 
-    emit batchFilesUpdated();
+    emit logMessageReceived("Pre-scanning " + QString::number(pending.size()) + " file(s) with the batch settings");
+    m_pre_scan_count = 0;
+    m_pre_scanning   = true;
+    emit batchPreScanProgress(0, static_cast<int>(pending.size()));
+
+    if (m_pre_scan_watcher == nullptr)
+    {
+        m_pre_scan_watcher = new QFutureWatcher<BatchPreScanResult>(this);
+        connect(m_pre_scan_watcher, &QFutureWatcher<BatchPreScanResult>::resultReadyAt,
+                this, &ProcessingCoordinator::onBatchFilePreScanned);
+        connect(m_pre_scan_watcher, &QFutureWatcher<BatchPreScanResult>::finished,
+                this, &ProcessingCoordinator::onBatchPreScanFinished);
+    }
+    m_pre_scan_watcher->setFuture(QtConcurrent::mapped(pending, [scan_params](const BatchFileInfo& info) {
+        BatchPreScanResult result;
+        result.info = info;
+        preScanBatchFile(result.info, scan_params, result.log);
+        return result;
+    }));
 }
 
-void ProcessingCoordinator::processNextBatchFile()
+void ProcessingCoordinator::runScannedBatch()
 {
-    while (m_batch_current_index < m_batch_files->size())
+    if (m_batch_cancelled)
     {
-        if (m_batch_cancelled)
-        {
-            emit logMessageReceived("Batch cancelled by user. Remaining files skipped.");
-            break;
-        }
+        // Files not scanned keep their stale pre-scan key and are scanned by the next start
+        emit logMessageReceived("Batch cancelled by user. Remaining files skipped.");
+        finishBatch();
+        return;
+    }
+
+    beginBatchRun();
+    processNextBatchFile();
+}
+
+void ProcessingCoordinator::beginBatchRun()
+{
+    const int workers = (m_batch_workers > 0) ? m_batch_workers : BatchScheduler::physicalCoreCount();
+    m_batch_scheduler = BatchScheduler(workers, m_batch_files_per_device);
 
-        BatchFileInfo& info = (*m_batch_files)[m_batch_current_index];
+    // Files that need no run are settled in list order; the rest are queued
+    for (int index = 0; index < m_batch_files->size(); index++)
+    {
+        BatchFileInfo& info = (*m_batch_files)[index];
 
         if (info.skip)
         {
             emit logMessageReceived("  Skipping: " + info.filename + " (" + info.skipReason + ")");
             m_batch_skip_count++;
-            m_batch_current_index++;
             continue;
         }
 
         if (info.processed && info.processedOk)
         {
             m_batch_success_count++;
-            m_batch_current_index++;
             continue;
         }
 
@@ -393,96 +498,158 @@ void ProcessingCoordinator::processNextBatchFile()
             info.processedOk = false;
             m_batch_error_count++;
             emit logMessageReceived("  ERROR: Pre-scan failed (no frame sync) for " + info.filename + " — file skipped.");
-            m_batch_current_index++;
             continue;
         }
 
-        emit batchFileProcessing(m_batch_current_index, static_cast<int>(m_batch_files->size()));
-        emit logMessageReceived("--- Processing file " +
-            QString::number(m_batch_current_index + 1) + " of " +
-            QString::number(m_batch_files->size()) + ": " + info.filename + " ---");
+        m_batch_scheduler.addFile(index, info.fileSize, BatchScheduler::storageDevice(info.filepath));
+    }
 
-        m_reader->clearSettings();
-        if (!m_reader->loadChannels(info.filepath))
-        {
-            info.processed   = true;
-            info.processedOk = false;
-            m_batch_error_count++;
-            emit logMessageReceived("  ERROR: Could not load " + info.filename);
-            m_batch_current_index++;
-            continue;
-        }
+    // Calibration is the same for every file; apply it once, before any worker reads the setup
+    double scale_dB_per_V                 = m_scale_str.toDouble();
+    m_batch_calibration.scale_lower_bound = UIConstants::kSlopeVoltageLower[m_slope_idx] * scale_dB_per_V;
+    m_batch_calibration.scale_upper_bound = UIConstants::kSlopeVoltageUpper[m_slope_idx] * scale_dB_per_V;
+    m_batch_calibration.negative_polarity = (m_polarity_idx == 1);
+    m_batch_receivers_ok                  = prepareFrameSetupParameters(m_batch_calibration);
+
+    // Share the cores between the files that can run at once
+    const int concurrency  = m_batch_scheduler.concurrency();
+    m_batch_decode_threads = std::max(1, QThread::idealThreadCount() / concurrency);
+    if (m_batch_scheduler.queued() > 1)
+    {
+        emit logMessageReceived(QString("Batch workers: up to %1 files at once, %2 decode thread(s) each, largest first")
+                                .arg(concurrency).arg(m_batch_decode_threads));
+    }
+}
 
-        int pcm_idx  = info.resolvedPcmIndex;
-        int time_idx = info.resolvedTimeIndex;
+void ProcessingCoordinator::processNextBatchFile()
+{
+    if (m_batch_cancelled && m_batch_scheduler.queued() > 0)
+    {
+        emit logMessageReceived("Batch cancelled by user. Remaining files skipped.");
+        m_batch_scheduler.clearQueue();
+    }
 
-        if (pcm_idx < 0 || time_idx < 0)
+    int index = m_batch_scheduler.takeNext();
+    while (index >= 0)
+    {
+        if (!launchBatchFile(index))
         {
-            info.processed   = true;
-            info.processedOk = false;
-            m_batch_error_count++;
-            emit logMessageReceived("  ERROR: Channel not selected for " + info.filename);
-            m_batch_current_index++;
-            continue;
+            m_batch_scheduler.finish(index);
         }
+        index = m_batch_scheduler.takeNext();
+    }
 
-        m_reader->pcmChannelChanged(pcm_idx + 1);
-        m_reader->timeChannelChanged(time_idx + 1);
-
-        ProcessingParams params;
-        params.filename        = info.filepath;
-        params.time_channel_id = m_reader->getCurrentTimeChannelID();
-        params.pcm_channel_id  = m_reader->getCurrentPCMChannelID();
-
-        bool frame_sync_ok = false;
-        params.frame_sync            = m_frame_sync_str.toULongLong(&frame_sync_ok, UIConstants::kHexBase);
-        params.sync_pattern_length   = static_cast<int>(m_frame_sync_str.length()) * 4;
-        int data_words               = m_frame_setup->length();
-        params.words_in_minor_frame  = data_words + 1;
-        params.bits_in_minor_frame   = (data_words * PCMConstants::kCommonWordLen) + params.sync_pattern_length;
-
-        double scale_dB_per_V                   = m_scale_str.toDouble();
-        double voltage_lower                     = UIConstants::kSlopeVoltageLower[m_slope_idx];
-        double voltage_upper                     = UIConstants::kSlopeVoltageUpper[m_slope_idx];
-        params.calibration.scale_lower_bound    = voltage_lower * scale_dB_per_V;
-        params.calibration.scale_upper_bound    = voltage_upper * scale_dB_per_V;
-        params.calibration.negative_polarity    = (m_polarity_idx == 1);
-
-        params.start_seconds = m_reader->dhmsToUInt64(
-            m_reader->getStartDayOfYear(), m_reader->getStartHour(),
-            m_reader->getStartMinute(),    m_reader->getStartSecond());
-        params.stop_seconds  = m_reader->dhmsToUInt64(
-            m_reader->getStopDayOfYear(),  m_reader->getStopHour(),
-            m_reader->getStopMinute(),     m_reader->getStopSecond());
-
-        switch (m_batch_sample_rate_index)
-        {
-            case 0:  params.sample_rate = UIConstants::kSampleRate1Hz;   break;
-            case 1:  params.sample_rate = UIConstants::kSampleRate10Hz;  break;
-            case 2:  params.sample_rate = UIConstants::kSampleRate100Hz; break;
-            default: params.sample_rate = UIConstants::kSampleRate1Hz;   break;
-        }
+    if (m_batch_scheduler.running() == 0)
+    {
+        finishBatch();
+    }
+    else
+    {
+        onBatchFileProgress(-1, 0);
+    }
+}
 
-        params.outfile = m_batch_output_dir + "/" +
-            UIConstants::kBatchOutputPrefix + QFileInfo(info.filepath).baseName() +
-            UIConstants::kOutputExtension;
-        info.outputFile       = params.outfile;
-        params.is_randomized  = info.isRandomized;
+bool ProcessingCoordinator::launchBatchFile(int index)
+{
+    BatchFileInfo& info = (*m_batch_files)[index];
 
-        if (!prepareFrameSetupParameters(params.calibration))
-        {
-            info.processed   = true;
-            info.processedOk = false;
-            m_batch_error_count++;
-            emit logMessageReceived("  ERROR: No receivers selected for " + info.filename);
-            m_batch_current_index++;
-            continue;
-        }
+    emit batchFileProcessing(index, static_cast<int>(m_batch_files->size()));
+    emit logMessageReceived("--- Processing file " +
+        QString::number(index + 1) + " of " +
+        QString::number(m_batch_files->size()) + ": " + info.filename + " ---");
 
-        launchWorkerThread(params);
-        return;
+    // Channel IDs and the time range come from the intake catalog; the file is not read again
+    int pcm_idx  = info.resolvedPcmIndex;
+    int time_idx = info.resolvedTimeIndex;
+
+    if (pcm_idx < 0 || pcm_idx >= info.pcmChannelIds.size() ||
+        time_idx < 0 || time_idx >= info.timeChannelIds.size())
+    {
+        info.processed   = true;
+        info.processedOk = false;
+        m_batch_error_count++;
+        emit logMessageReceived("  ERROR: Channel not selected for " + info.filename);
+        return false;
+    }
+
+    ProcessingParams params;
+    params.filename        = info.filepath;
+    params.time_channel_id = info.timeChannelIds[time_idx];
+    params.pcm_channel_id  = info.pcmChannelIds[pcm_idx];
+
+    bool frame_sync_ok = false;
+    params.frame_sync            = m_frame_sync_str.toULongLong(&frame_sync_ok, UIConstants::kHexBase);
+    params.sync_pattern_length   = static_cast<int>(m_frame_sync_str.length()) * 4;
+    int data_words               = m_frame_setup->length();
+    params.words_in_minor_frame  = data_words + 1;
+    params.bits_in_minor_frame   = (data_words * PCMConstants::kCommonWordLen) + params.sync_pattern_length;
+    params.calibration           = m_batch_calibration;
+
+    params.start_seconds         = info.startSeconds;
+    params.stop_seconds          = info.stopSeconds;
+
+    switch (m_batch_sample_rate_index)
+    {
+        case 0:  params.sample_rate = UIConstants::kSampleRate1Hz;   break;
+        case 1:  params.sample_rate = UIConstants::kSampleRate10Hz;  break;
+        case 2:  params.sample_rate = UIConstants::kSampleRate100Hz; break;
+        default: params.sample_rate = UIConstants::kSampleRate1Hz;   break;
     }
 
+    params.outfile = m_batch_output_dir + "/" +
+        UIConstants::kBatchOutputPrefix + QFileInfo(info.filepath).baseName() +
+        UIConstants::kOutputExtension;
+    info.outputFile        = params.outfile;
+    params.is_randomized   = info.isRandomized;
+    params.decode_threads  = m_batch_decode_threads;
+
+    if (!m_batch_receivers_ok)
+    {
+        info.processed   = true;
+        info.processedOk = false;
+        m_batch_error_count++;
+        emit logMessageReceived("  ERROR: No receivers selected for " + info.filename);
+        return false;
+    }
+
+    // Reuse an idle pool thread, or add one up to the worker limit
+    if (m_idle_threads.isEmpty())
+    {
+        auto* thread = new QThread;
+        thread->start();
+        m_pool_threads.push_back(thread);
+        m_idle_threads.push_back(thread);
+    }
+    QThread* thread = m_idle_threads.takeLast();
+
+    auto* processor = new FrameProcessor;
+    processor->moveToThread(thread);
+    m_batch_runs.insert(index, BatchRun{processor, thread, 0});
+
+    // Log lines of files running side by side are told apart by file name
+    const QString prefix = (m_batch_scheduler.maxWorkers() > 1) ? "  [" + info.filename + "] " : QString();
+    connect(processor, &FrameProcessor::progressUpdated, this, [this, index](int percent) {
+        onBatchFileProgress(index, percent);
+    });
+    connect(processor, &FrameProcessor::processingFinished, this, [this, index](bool success) {
+        onBatchFileFinished(index, success);
+    });
+    connect(processor, &FrameProcessor::logMessage, this, [this, prefix](const QString& message) {
+        emit logMessageReceived(prefix + message);
+    });
+    connect(processor, &FrameProcessor::errorOccurred, this, [this, prefix](const QString& message) {
+        emit errorOccurred(prefix + message);
+    });
+
+    FrameSetup* frame_setup = m_frame_setup;
+    QMetaObject::invokeMethod(processor, [processor, params, frame_setup]() {
+        processor->process(params, frame_setup);
+    }, Qt::QueuedConnection);
+    return true;
+}
+
+void ProcessingCoordinator::finishBatch()
+{
     // All files processed (or batch cancelled)
     m_processing       = false;
     m_progress_percent = UIConstants::kProgressBarMax;
@@ -506,15 +673,7 @@ void ProcessingCoordinator::processNextBatchFile()
 
 void ProcessingCoordinator::onProgressUpdated(int percent)
 {
-    int total = static_cast<int>(m_batch_files->size());
-    if (total > 0 && m_batch_current_index < total)
-    {
-        m_progress_percent = ((m_batch_current_index * UIConstants::kProgressBarMax) + percent) / total;
-    }
-    else
-    {
-        m_progress_percent = percent;
-    }
+    m_progress_percent = percent;
     emit progressChanged(m_progress_percent);
 }
 
@@ -527,45 +686,102 @@ void ProcessingCoordinator::onProcessingFinished(bool success)
     delete m_worker_thread;
     m_worker_thread = nullptr;
 
-    if (!m_batch_files->isEmpty() && m_batch_current_index < m_batch_files->size())
+    if (success)
     {
-        // Batch mode: update file result and advance state machine
-        BatchFileInfo& info = (*m_batch_files)[m_batch_current_index];
-        info.processed   = true;
-        info.processedOk = success;
+        m_progress_percent = UIConstants::kProgressBarMax;
+    }
+    m_processing = false;
+    emit progressChanged(m_progress_percent);
+    emit processingStateChanged(false);
+    emit processingFinished(success, m_last_output_file);
+}
 
-        if (success)
-        {
-            m_batch_success_count++;
-            emit logMessageReceived("  Completed: " + info.filename + " -> " + info.outputFile);
-        }
-        else
-        {
-            m_batch_error_count++;
-            emit logMessageReceived("  ERROR: Processing failed for " + info.filename);
-        }
+void ProcessingCoordinator::onBatchFileProgress(int index, int percent)
+{
+    auto it = m_batch_runs.find(index);
+    if (it != m_batch_runs.end())
+    {
+        it->percent = percent;
+    }
+
+    // Settled files count whole; running files count by their own progress
+    int total = static_cast<int>(m_batch_files->size());
+    if (total <= 0)
+    {
+        return;
+    }
+    int done = (m_batch_success_count + m_batch_skip_count + m_batch_error_count) * UIConstants::kProgressBarMax;
+    for (const auto& run : std::as_const(m_batch_runs))
+    {
+        done += run.percent;
+    }
+    m_progress_percent = std::min(done / total, UIConstants::kProgressBarMax);
+    emit progressChanged(m_progress_percent);
+}
 
-        m_batch_current_index++;
+void ProcessingCoordinator::onBatchFileFinished(int index, bool success)
+{
+    const BatchRun run = m_batch_runs.take(index);
+    run.processor->deleteLater();
+    m_idle_threads.push_back(run.thread);
+    m_batch_scheduler.finish(index);
 
-        int file_progress = (m_batch_current_index * UIConstants::kProgressBarMax)
-                            / static_cast<int>(m_batch_files->size());
-        m_progress_percent = file_progress;
-        emit progressChanged(m_progress_percent);
+    BatchFileInfo& info = (*m_batch_files)[index];
+    info.processed   = true;
+    info.processedOk = success;
 
-        processNextBatchFile();
+    if (success)
+    {
+        m_batch_success_count++;
+        emit logMessageReceived("  Completed: " + info.filename + " -> " + info.outputFile);
     }
     else
     {
-        // Single-file mode
-        if (success)
-        {
-            m_progress_percent = UIConstants::kProgressBarMax;
-        }
-        m_processing = false;
-        emit progressChanged(m_progress_percent);
-        emit processingStateChanged(false);
-        emit processingFinished(success, m_last_output_file);
+        m_batch_error_count++;
+        emit logMessageReceived("  ERROR: Processing failed for " + info.filename);
+    }
+
+    processNextBatchFile();
+}
+
+void ProcessingCoordinator::onBatchFilePreScanned(int result_index)
+{
+    const BatchPreScanResult result = m_pre_scan_watcher->resultAt(result_index);
+    const int index = m_pre_scan_indexes.value(result_index, -1);
+
+    // reset() supersedes this pre-scan
+    if (!m_pre_scanning || index < 0 || index >= m_batch_files->size() ||
+        (*m_batch_files)[index].filepath != result.info.filepath)
+    {
+        return;
     }
+
+    for (const QString& line : std::as_const(result.log))
+    {
+        emit logMessageReceived(line);
+    }
+    BatchFileInfo& info      = (*m_batch_files)[index];
+    info.preScanOk           = result.info.preScanOk;
+    info.isRandomized        = result.info.isRandomized;
+    info.preScanPcmChannelId = result.info.preScanPcmChannelId;
+    info.preScanFrameSync    = result.info.preScanFrameSync;
+    info.preScanSyncBits     = result.info.preScanSyncBits;
+    info.preScanFrameWords   = result.info.preScanFrameWords;
+
+    m_pre_scan_count++;
+    emit batchPreScanProgress(m_pre_scan_count, static_cast<int>(m_pre_scan_indexes.size()));
+}
+
+void ProcessingCoordinator::onBatchPreScanFinished()
+{
+    if (!m_pre_scanning)
+    {
+        return;
+    }
+    m_pre_scanning = false;
+
+    emit batchFilesUpdated();
+    runScannedBatch();
 }
 
 void ProcessingCoordinator::onLogMessage(const QString& message)
@@ -0,0 +1,113 @@
+/**
+ * @file rnrzldecoder.cpp
+ * @brief Implementation of RnrzlDecoder — word-at-a-time and reference descramblers.
+ */
+
+#include "rnrzldecoder.h"
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+
+namespace {
+    constexpr uint64_t kBitsPerBlock = 64;
+    constexpr uint64_t kBytesPerBlock = 8;
+
+    /// Converts between MSB-first byte order and a native (little-endian) word.
+    inline uint64_t byteSwap64(uint64_t value)
+    {
+#ifdef _MSC_VER
+        return _byteswap_uint64(value);
+#else
+        return __builtin_bswap64(value);
+#endif
+    }
+
+    /// Loads up to 8 bytes MSB-first into the top of a 64-bit block.
+    inline uint64_t loadBlock(const uint8_t* data, uint64_t count)
+    {
+        uint64_t value = 0;
+        for (uint64_t i = 0; i < kBytesPerBlock; i++)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            value = (value << 8) | ((i < count) ? data[i] : 0);
+        }
+        return value;
+    }
+
+    /// Stores the top @p count bytes of a block MSB-first.
+    inline void storeBlock(uint8_t* data, uint64_t value, uint64_t count)
+    {
+        for (uint64_t i = 0; i < count; i++)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            data[i] = static_cast<uint8_t>(value >> (kBitsPerBlock - 8 - (i * 8)));
+        }
+    }
+}
+
+void RnrzlDecoder::derandomize(uint8_t* data, uint64_t total_bits, uint16_t& lfsr)
+{
+    uint64_t history = lfsr;
+    const uint64_t full_blocks = total_bits / kBitsPerBlock;
+
+    for (uint64_t b = 0; b < full_blocks; b++)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        uint8_t* block = data + (b * kBytesPerBlock);
+        uint64_t word = 0;
+        memcpy(&word, block, kBytesPerBlock);
+        word = byteSwap64(derandomizeBlock(byteSwap64(word), history));
+        memcpy(block, &word, kBytesPerBlock);
+    }
+
+    const uint64_t rem_bits = total_bits % kBitsPerBlock;
+    if (rem_bits != 0)
+    {
+        // Partial tail: descramble a padded block, then merge back only the valid bits
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        uint8_t* block = data + (full_blocks * kBytesPerBlock);
+        const uint64_t rem_bytes = (rem_bits + 7) / 8;
+        const uint64_t in = loadBlock(block, rem_bytes);
+        const uint64_t prev_history = history;
+        const uint64_t out = derandomizeBlock(in, history);
+
+        const uint64_t valid_mask = ~(~0ULL >> rem_bits);
+        storeBlock(block, (out & valid_mask) | (in & ~valid_mask), rem_bytes);
+        history = ((prev_history << rem_bits) | (in >> (kBitsPerBlock - rem_bits))) & kLfsrMask;
+    }
+
+    lfsr = static_cast<uint16_t>(history & kLfsrMask);
+}
+
+void RnrzlDecoder::derandomizeBitSerial(uint8_t* data, uint64_t total_bits, uint16_t& lfsr)
+{
+    const int kTap1 = 13;
+    const int kTap2 = 14;
+
+    for (uint64_t i = 0; i < total_bits; i++)
+    {
+        uint32_t byte_idx = static_cast<uint32_t>(i >> 3);
+        uint8_t bit_idx = static_cast<uint8_t>(7 - (i & 7));
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        int in_bit  = (data[byte_idx] >> bit_idx) & 1;
+        int lfsr_out_bit = ((lfsr >> kTap1) & 1) ^ ((lfsr >> kTap2) & 1);
+        int descrambled_bit = in_bit ^ lfsr_out_bit;
+        lfsr = ((lfsr << 1) | in_bit) & kLfsrMask;
+
+        if (descrambled_bit != 0)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            data[byte_idx] |= static_cast<uint8_t>(1 << bit_idx);
+        }
+        else
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            data[byte_idx] &= static_cast<uint8_t>(~(1 << bit_idx));
+        }
+    }
+}
+// End of file!
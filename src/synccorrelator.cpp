@@ -0,0 +1,392 @@
+/**
+ * @file synccorrelator.cpp
+ * @brief Implementation of SyncCorrelator — scalar, SSE4.2, AVX2 and AVX-512 kernels.
+ */
+
+#include "synccorrelator.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SYNC_CORRELATOR_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang need per-function target attributes to emit wider instructions
+// from a baseline build; MSVC accepts the intrinsics unconditionally.
+#if defined(SYNC_CORRELATOR_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SYNC_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SYNC_TARGET(isa)
+#endif
+
+namespace {
+    constexpr uint32_t kBitsPerBlock = 64;
+    constexpr size_t kBytesPerBlock = 8;
+    constexpr size_t kContainsChunkBlocks = 64;
+
+    /// Loads 8 bytes MSB-first.
+    inline uint64_t loadBlock(const uint8_t* data)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < kBytesPerBlock; i++)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            value = (value << 8) | data[i];
+        }
+        return value;
+    }
+
+    /// Loads up to 8 bytes MSB-first, zero-padding the tail.
+    inline uint64_t loadPartialBlock(const uint8_t* data, size_t count)
+    {
+        uint8_t bytes[kBytesPerBlock] = {};
+        memcpy(bytes, data, count);
+        return loadBlock(bytes);
+    }
+
+    struct TapSet
+    {
+        const uint32_t* shift;
+        const uint64_t* invert;
+        size_t count;
+    };
+
+    void findHitsScalar(const TapSet& taps, const uint64_t* blocks, size_t first, size_t last, uint64_t* hits)
+    {
+        for (size_t k = first; k <= last; k++)
+        {
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            const uint64_t cur = blocks[k];
+            const uint64_t prev = blocks[k - 1];
+            uint64_t acc = ~0ULL;
+            for (size_t t = 0; t < taps.count && acc != 0; t++)
+            {
+                const uint32_t j = taps.shift[t];
+                const uint64_t shifted = (j == 0) ? cur : ((cur >> j) | (prev << (kBitsPerBlock - j)));
+                acc &= shifted ^ taps.invert[t];
+            }
+            hits[k - 1] = acc;
+            // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+#ifdef SYNC_CORRELATOR_X86
+    // The vector kernels test consecutive blocks in separate 64-bit lanes. A
+    // shift count of 64 yields zero in every lane, so tap j = 0 needs no special case.
+
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast)
+    SYNC_TARGET("sse4.2")
+    size_t findHitsSse42(const TapSet& taps, const uint64_t* blocks, size_t num_blocks, uint64_t* hits)
+    {
+        constexpr size_t kLanes = 2;
+        size_t k = 1;
+        for (; k + kLanes - 1 <= num_blocks; k += kLanes)
+        {
+            const __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + k));
+            const __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + k - 1));
+            __m128i acc = _mm_set1_epi64x(-1);
+            for (size_t t = 0; t < taps.count; t++)
+            {
+                const __m128i right = _mm_cvtsi32_si128(static_cast<int>(taps.shift[t]));
+                const __m128i left = _mm_cvtsi32_si128(static_cast<int>(kBitsPerBlock - taps.shift[t]));
+                const __m128i shifted = _mm_or_si128(_mm_srl_epi64(cur, right), _mm_sll_epi64(prev, left));
+                acc = _mm_and_si128(acc, _mm_xor_si128(shifted, _mm_set1_epi64x(static_cast<long long>(taps.invert[t]))));
+                if (_mm_testz_si128(acc, acc) != 0)
+                {
+                    break;
+                }
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(hits + k - 1), acc);
+        }
+        return k;
+    }
+
+    SYNC_TARGET("avx2")
+    size_t findHitsAvx2(const TapSet& taps, const uint64_t* blocks, size_t num_blocks, uint64_t* hits)
+    {
+        constexpr size_t kLanes = 4;
+        size_t k = 1;
+        for (; k + kLanes - 1 <= num_blocks; k += kLanes)
+        {
+            const __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks + k));
+            const __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks + k - 1));
+            __m256i acc = _mm256_set1_epi64x(-1);
+            for (size_t t = 0; t < taps.count; t++)
+            {
+                const __m128i right = _mm_cvtsi32_si128(static_cast<int>(taps.shift[t]));
+                const __m128i left = _mm_cvtsi32_si128(static_cast<int>(kBitsPerBlock - taps.shift[t]));
+                const __m256i shifted = _mm256_or_si256(_mm256_srl_epi64(cur, right), _mm256_sll_epi64(prev, left));
+                acc = _mm256_and_si256(acc, _mm256_xor_si256(shifted, _mm256_set1_epi64x(static_cast<long long>(taps.invert[t]))));
+                if (_mm256_testz_si256(acc, acc) != 0)
+                {
+                    break;
+                }
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(hits + k - 1), acc);
+        }
+        return k;
+    }
+
+    SYNC_TARGET("avx512f")
+    size_t findHitsAvx512(const TapSet& taps, const uint64_t* blocks, size_t num_blocks, uint64_t* hits)
+    {
+        constexpr size_t kLanes = 8;
+        constexpr int kAndXor = 0x60;  // ternary-logic truth table for a & (b ^ c)
+        constexpr __mmask8 kAllLanes = 0xFF;
+        size_t k = 1;
+        for (; k + kLanes - 1 <= num_blocks; k += kLanes)
+        {
+            const __m512i cur = _mm512_loadu_si512(blocks + k);
+            const __m512i prev = _mm512_loadu_si512(blocks + k - 1);
+            __m512i acc = _mm512_set1_epi64(-1);
+            for (size_t t = 0; t < taps.count; t++)
+            {
+                const __m512i right = _mm512_set1_epi64(taps.shift[t]);
+                const __m512i left = _mm512_set1_epi64(kBitsPerBlock - taps.shift[t]);
+                // Zero-masked shifts: the unmasked forms trip -Wmaybe-uninitialized in GCC 12 headers
+                const __m512i shifted = _mm512_or_si512(_mm512_maskz_srlv_epi64(kAllLanes, cur, right),
+                                                        _mm512_maskz_sllv_epi64(kAllLanes, prev, left));
+                acc = _mm512_ternarylogic_epi64(acc, shifted,
+                                                _mm512_set1_epi64(static_cast<long long>(taps.invert[t])), kAndXor);
+                if (_mm512_test_epi64_mask(acc, acc) == 0)
+                {
+                    break;
+                }
+            }
+            _mm512_storeu_si512(hits + k - 1, acc);
+        }
+        return k;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-type-reinterpret-cast)
+
+#ifdef _MSC_VER
+    bool msvcSupports(SyncCorrelator::Kernel kernel)
+    {
+        constexpr int kSse42Bit = 20;
+        constexpr int kOsxsaveBit = 27;
+        constexpr int kAvx2Bit = 5;
+        constexpr int kAvx512fBit = 16;
+        constexpr unsigned kYmmState = 0x6;
+        constexpr unsigned kZmmState = 0xE6;
+
+        int regs[4] = {};
+        __cpuid(regs, 1);
+        const bool sse42 = ((regs[2] >> kSse42Bit) & 1) != 0;
+        const bool osxsave = ((regs[2] >> kOsxsaveBit) & 1) != 0;
+        const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+        __cpuidex(regs, 7, 0);
+
+        switch (kernel)
+        {
+        case SyncCorrelator::Kernel::Scalar:
+            return true;
+        case SyncCorrelator::Kernel::Sse42:
+            return sse42;
+        case SyncCorrelator::Kernel::Avx2:
+            return ((xcr0 & kYmmState) == kYmmState) && (((regs[1] >> kAvx2Bit) & 1) != 0);
+        case SyncCorrelator::Kernel::Avx512:
+            return ((xcr0 & kZmmState) == kZmmState) && (((regs[1] >> kAvx512fBit) & 1) != 0);
+        }
+        return false;
+    }
+#endif
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                          KERNEL SELECTION                                  //
+////////////////////////////////////////////////////////////////////////////////
+
+bool SyncCorrelator::isSupported(Kernel kernel)
+{
+#if defined(SYNC_CORRELATOR_X86) && defined(_MSC_VER)
+    return msvcSupports(kernel);
+#elif defined(SYNC_CORRELATOR_X86)
+    __builtin_cpu_init();
+    switch (kernel)
+    {
+    case Kernel::Scalar:
+        return true;
+    case Kernel::Sse42:
+        return __builtin_cpu_supports("sse4.2") != 0;
+    case Kernel::Avx2:
+        return __builtin_cpu_supports("avx2") != 0;
+    case Kernel::Avx512:
+        return __builtin_cpu_supports("avx512f") != 0;
+    }
+    return false;
+#else
+    return kernel == Kernel::Scalar;
+#endif
+}
+
+SyncCorrelator::Kernel SyncCorrelator::bestKernel()
+{
+    static const Kernel best = []() {
+        for (Kernel k : { Kernel::Avx512, Kernel::Avx2, Kernel::Sse42 })
+        {
+            if (isSupported(k))
+            {
+                return k;
+            }
+        }
+        return Kernel::Scalar;
+    }();
+    return best;
+}
+
+const char* SyncCorrelator::kernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::Scalar:
+        return "scalar";
+    case Kernel::Sse42:
+        return "SSE4.2";
+    case Kernel::Avx2:
+        return "AVX2";
+    case Kernel::Avx512:
+        return "AVX-512";
+    }
+    return "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                            CORRELATION                                     //
+////////////////////////////////////////////////////////////////////////////////
+
+SyncCorrelator::SyncCorrelator(uint64_t sync_pat, uint64_t sync_mask, Kernel kernel)
+    : m_sync_pat(sync_pat),
+      m_sync_mask(sync_mask),
+      m_kernel(isSupported(kernel) ? kernel : bestKernel()),
+      m_never_matches((sync_pat & ~sync_mask) != 0)
+{
+    // Each mask bit j compares the stream bit j positions before the candidate end bit
+    for (uint32_t j = 0; j < kBitsPerBlock; j++)
+    {
+        if (((m_sync_mask >> j) & 1) != 0)
+        {
+            m_tap_shift.push_back(j);
+            m_tap_invert.push_back(((m_sync_pat >> j) & 1) != 0 ? 0 : ~0ULL);
+        }
+    }
+}
+
+void SyncCorrelator::findHits(const uint64_t* blocks, size_t num_blocks, uint64_t* hits) const
+{
+    if (m_never_matches)
+    {
+        memset(hits, 0, num_blocks * sizeof(uint64_t));
+        return;
+    }
+
+    const TapSet taps = { m_tap_shift.data(), m_tap_invert.data(), m_tap_shift.size() };
+    size_t next = 1;
+
+#ifdef SYNC_CORRELATOR_X86
+    switch (m_kernel)
+    {
+    case Kernel::Avx512:
+        next = findHitsAvx512(taps, blocks, num_blocks, hits);
+        break;
+    case Kernel::Avx2:
+        next = findHitsAvx2(taps, blocks, num_blocks, hits);
+        break;
+    case Kernel::Sse42:
+        next = findHitsSse42(taps, blocks, num_blocks, hits);
+        break;
+    case Kernel::Scalar:
+        break;
+    }
+#endif
+
+    // Scalar kernel, or the blocks left over after the last full vector
+    findHitsScalar(taps, blocks, next, num_blocks, hits);
+}
+
+size_t SyncCorrelator::packBlocks(const uint8_t* data, size_t num_bytes, uint64_t history,
+                                  std::vector<uint64_t>& blocks)
+{
+    const size_t full_blocks = num_bytes / kBytesPerBlock;
+    const size_t remainder = num_bytes % kBytesPerBlock;
+    const size_t num_blocks = full_blocks + (remainder != 0 ? 1 : 0);
+
+    blocks.resize(num_blocks + 1);
+    blocks[0] = history;
+    for (size_t b = 0; b < full_blocks; b++)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        blocks[b + 1] = loadBlock(data + (b * kBytesPerBlock));
+    }
+    if (remainder != 0)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        blocks[num_blocks] = loadPartialBlock(data + (full_blocks * kBytesPerBlock), remainder);
+    }
+    return num_blocks;
+}
+
+bool SyncCorrelator::containsPattern(const uint8_t* data, uint64_t total_bits, uint32_t sync_pat_len) const
+{
+    if (m_never_matches)
+    {
+        return false;
+    }
+
+    // Fixed-size chunks keep the search allocation-free
+    uint64_t blocks[kContainsChunkBlocks + 1] = {};
+    uint64_t hits[kContainsChunkBlocks] = {};
+    const uint64_t total_blocks = (total_bits + kBitsPerBlock - 1) / kBitsPerBlock;
+    const size_t total_bytes = static_cast<size_t>((total_bits + 7) / 8);
+
+    for (uint64_t first = 0; first < total_blocks; first += kContainsChunkBlocks)
+    {
+        const size_t count = static_cast<size_t>(
+            (total_blocks - first < kContainsChunkBlocks) ? (total_blocks - first) : kContainsChunkBlocks);
+        for (size_t b = 0; b < count; b++)
+        {
+            const size_t byte_pos = static_cast<size_t>((first + b) * kBytesPerBlock);
+            const size_t avail = total_bytes - byte_pos;
+            // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-bounds-constant-array-index)
+            blocks[b + 1] = (avail >= kBytesPerBlock) ? loadBlock(data + byte_pos)
+                                                      : loadPartialBlock(data + byte_pos, avail);
+            // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+
+        findHits(blocks, count, hits);
+
+        for (size_t b = 0; b < count; b++)
+        {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+            uint64_t block_hits = hits[b];
+            const uint64_t block_start = (first + b) * kBitsPerBlock;
+
+            // Drop end positions past the buffer or before a full pattern was loaded
+            if (total_bits - block_start < kBitsPerBlock)
+            {
+                block_hits &= ~(~0ULL >> (total_bits - block_start));
+            }
+            if (block_start + kBitsPerBlock < sync_pat_len)
+            {
+                block_hits = 0;
+            }
+            else if (block_start < sync_pat_len)
+            {
+                block_hits &= ~0ULL >> (sync_pat_len - 1 - block_start);
+            }
+            if (block_hits != 0)
+            {
+                return true;
+            }
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-constant-array-index)
+        blocks[0] = blocks[count];
+    }
+    return false;
+}
+// End of file!
@@ -0,0 +1,185 @@
+/**
+ * @file timebinaccumulator.cpp
+ * @brief Implementation of TimeBinAccumulator — fixed-rate averaging and chunk merging.
+ */
+
+#include "timebinaccumulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+#include "constants.h"
+
+TimeBinAccumulator::TimeBinAccumulator(uint64_t start_seconds, uint64_t stop_seconds, double sample_rate,
+                                       std::vector<uint32_t> value_columns, size_t num_columns)
+    : m_start(static_cast<int64_t>(start_seconds) * PCMConstants::kTicksPerSecond),
+      m_stop(static_cast<int64_t>(stop_seconds) * PCMConstants::kTicksPerSecond),
+      m_columns(std::move(value_columns)),
+      m_num_columns(num_columns),
+      m_sums(num_columns, 0.0)
+{
+    // Bins per tick as a reduced fraction: rate steps over (steps per Hz * ticks per second)
+    const auto rate_steps = static_cast<uint64_t>(std::max(std::llround(sample_rate * static_cast<double>(PCMConstants::kSampleRateSteps)), 1LL));
+    const uint64_t span = static_cast<uint64_t>(PCMConstants::kSampleRateSteps)
+                          * static_cast<uint64_t>(PCMConstants::kTicksPerSecond);
+    const uint64_t divisor = std::gcd(rate_steps, span);
+    m_bins_per_span = rate_steps / divisor;
+    m_span_ticks = span / divisor;
+}
+
+uint64_t TimeBinAccumulator::binIndex(int64_t ticks) const
+{
+    if (ticks <= m_start)
+    {
+        return 0;
+    }
+
+    // ceil(offset * bins / span) - 1, split so the product cannot overflow
+    const auto offset = static_cast<uint64_t>(ticks - m_start);
+    const uint64_t whole = offset / m_span_ticks;
+    const uint64_t rest = offset % m_span_ticks;
+    return (whole * m_bins_per_span) + (((rest * m_bins_per_span) + m_span_ticks - 1) / m_span_ticks) - 1;
+}
+
+int64_t TimeBinAccumulator::binStart(uint64_t index) const
+{
+    // round(index * span / bins), split the same way
+    const uint64_t whole = index / m_bins_per_span;
+    const uint64_t rest = index % m_bins_per_span;
+    const uint64_t ticks = (whole * m_span_ticks) +
+                           (((2 * rest * m_span_ticks) + m_bins_per_span) / (2 * m_bins_per_span));
+    return m_start + static_cast<int64_t>(ticks);
+}
+
+bool TimeBinAccumulator::addFrame(int64_t ticks, const double* values)
+{
+    if (!inWindow(ticks))
+    {
+        return false;
+    }
+
+    // Frames in an earlier bin join the current one
+    const uint64_t index = binIndex(ticks);
+    if (index > m_index)
+    {
+        closeBin();
+        m_index = index;
+    }
+
+    const size_t width = m_columns.size();
+    if (m_record_first && (!m_has_frames || m_index == m_first_index))
+    {
+        m_first_index = m_index;
+        m_first_values.insert(m_first_values.end(), values, values + width); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    m_has_frames = true;
+
+    for (size_t i = 0; i < width; i++)
+    {
+        m_sums[m_columns[i]] += values[i]; // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+    m_samples++;
+    return true;
+}
+
+void TimeBinAccumulator::flush()
+{
+    closeBin();
+}
+
+void TimeBinAccumulator::closeBin()
+{
+    if (m_samples == 0)
+    {
+        return;
+    }
+    m_bin_indices.push_back(m_index);
+    m_bin_samples.push_back(m_samples);
+    m_bin_sums.insert(m_bin_sums.end(), m_sums.begin(), m_sums.end());
+    std::fill(m_sums.begin(), m_sums.end(), 0.0);
+    m_samples = 0;
+}
+
+void TimeBinAccumulator::clearClosedBins()
+{
+    m_bin_indices.clear();
+    m_bin_samples.clear();
+    m_bin_sums.clear();
+}
+
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+bool TimeBinAccumulator::appendChunk(const TimeBinAccumulator& chunk)
+{
+    if (!chunk.m_has_frames)
+    {
+        return true;
+    }
+
+    if (!canAppendChunk(chunk))
+    {
+        return false;
+    }
+
+    // The chunk's first bin is its first closed bin, or still open
+    const uint64_t head = chunk.m_first_index;
+    const bool head_closed = !chunk.m_bin_indices.empty();
+    const int head_samples = head_closed ? chunk.m_bin_samples.front() : chunk.m_samples;
+
+    m_has_frames = true;
+    size_t copy_from = 0;
+    if (head <= m_index)
+    {
+        const size_t width = chunk.m_columns.size();
+        for (size_t f = 0; f < static_cast<size_t>(head_samples); f++)
+        {
+            for (size_t i = 0; i < width; i++)
+            {
+                m_sums[m_columns[i]] += chunk.m_first_values[(f * width) + i];
+            }
+        }
+        m_samples += head_samples;
+        copy_from = 1;
+    }
+    if (!head_closed)
+    {
+        if (copy_from == 0)
+        {
+            closeBin();
+            m_index = chunk.m_index;
+            m_samples = chunk.m_samples;
+            m_sums = chunk.m_sums;
+        }
+        return true;
+    }
+
+    // Later bins were summed from zero in frame order, exactly as serially
+    closeBin();
+    const size_t num_bins = chunk.m_bin_indices.size();
+    for (size_t b = copy_from; b < num_bins; b++)
+    {
+        m_bin_indices.push_back(chunk.m_bin_indices[b]);
+        m_bin_samples.push_back(chunk.m_bin_samples[b]);
+        const auto sums = chunk.m_bin_sums.begin() + static_cast<std::ptrdiff_t>(b * m_num_columns);
+        m_bin_sums.insert(m_bin_sums.end(), sums, sums + static_cast<std::ptrdiff_t>(m_num_columns));
+    }
+    m_index = chunk.m_index;
+    m_samples = chunk.m_samples;
+    m_sums = chunk.m_sums;
+    return true;
+}
+
+bool TimeBinAccumulator::canAppendChunk(const TimeBinAccumulator& chunk) const
+{
+    if (!chunk.m_has_frames || chunk.m_bin_indices.empty())
+    {
+        return true;
+    }
+
+    // The serial run folds every frame up to the current bin into it; only the
+    // first chunk bin has per-frame values to re-add in the serial order
+    const uint64_t second = (chunk.m_bin_indices.size() > 1) ? chunk.m_bin_indices[1] : chunk.m_index;
+    return second > std::max(m_index, chunk.m_first_index);
+}
+// End of file!
@@ -0,0 +1,52 @@
+/**
+ * @file ch10testpackets.h
+ * @brief Synthetic Chapter 10 packets shared by the packet, index, reader and processor tests.
+ */
+
+#ifndef CH10TESTPACKETS_H
+#define CH10TESTPACKETS_H
+
+#include <cstdint>
+#include <cstring>
+
+#include <QByteArray>
+
+#include "irig106ch10.h"
+
+/**
+ * @brief Builds a packet on @p channel carrying @p body, with valid checksums.
+ * @param[in] channel   Channel ID.
+ * @param[in] data_type Chapter 10 data type (I106CH10_DTYPE_*).
+ * @param[in] body      Packet body; padded with zeros to a multiple of 4 bytes.
+ * @param[in] rel_time  Relative time counter stamped in the header (low 6 bytes).
+ * @param[in] flags     Packet flags byte.
+ * @param[in] secondary True to add a secondary header (and its flag) after the header.
+ * @return The packet bytes.
+ */
+inline QByteArray makePacket(uint16_t channel, uint8_t data_type, const QByteArray& body, int64_t rel_time = 0,
+                             uint8_t flags = 0, bool secondary = false)
+{
+    Irig106::SuI106Ch10Header header = {};
+    const uint32_t header_size = HEADER_SIZE + (secondary ? SEC_HEADER_SIZE : 0);
+    const auto padded = static_cast<uint32_t>((body.size() + 3) & ~3);
+    header.uSync = IRIG106_SYNC;
+    header.uChID = channel;
+    header.ulPacketLen = header_size + padded;
+    header.ulDataLen = static_cast<uint32_t>(body.size());
+    header.ubyDataType = data_type;
+    header.ubyPacketFlags = static_cast<uint8_t>(flags | (secondary ? I106CH10_PFLAGS_SEC_HEADER : 0));
+    std::memcpy(header.aubyRefTime, &rel_time, sizeof(header.aubyRefTime));
+    header.uChecksum = Irig106::uCalcHeaderChecksum(&header);
+    if (secondary)
+    {
+        header.abyTime[0] = 0x5A;
+        header.uSecChecksum = Irig106::uCalcSecHeaderChecksum(&header);
+    }
+
+    QByteArray packet(reinterpret_cast<const char*>(&header), static_cast<qsizetype>(header_size));
+    packet += body;
+    packet.append(static_cast<qsizetype>(padded) - body.size(), '\0');
+    return packet;
+}
+
+#endif // CH10TESTPACKETS_H
@@ -4,19 +4,32 @@
 #include <QTextStream>
 #include <QtTest>
 
+#include "tst_batchscheduler.h"
+#include "tst_ch10packetindex.h"
+#include "tst_ch10packetsource.h"
+#include "tst_ch10recordingindex.h"
 #include "tst_channeldata.h"
 #include "tst_chapter10reader.h"
 #include "tst_constants.h"
+#include "tst_csvrowwriter.h"
+#include "tst_extractionplan.h"
 #include "tst_frameprocessor.h"
+#include "tst_irigtime.h"
 #include "tst_framesetup.h"
 #include "tst_mainviewmodel_batch.h"
 #include "tst_mainviewmodel_helpers.h"
 #include "tst_mainviewmodel_state.h"
+#include "tst_pcmframesync.h"
+#include "tst_pcmpackettable.h"
 #include "tst_plotviewmodel.h"
 #include "tst_receivergridwidget.h"
+#include "tst_rnrzldecoder.h"
+#include "tst_spscring.h"
 #include "tst_processingcoordinator.h"
 #include "tst_settingsdialog.h"
 #include "tst_settingsmanager.h"
+#include "tst_synccorrelator.h"
+#include "tst_timebinaccumulator.h"
 #include "tst_timeextractionwidget.h"
 
 /// Runs a single test suite and appends results to the shared log file.
@@ -87,6 +100,18 @@ int main(int argc, char* argv[])
     status |= runSuite<TestChapter10Reader>(log_path);
     status |= runSuite<TestConstants>(log_path);
     status |= runSuite<TestFrameProcessor>(log_path);
+    status |= runSuite<TestPcmFrameSync>(log_path);
+    status |= runSuite<TestSyncCorrelator>(log_path);
+    status |= runSuite<TestRnrzlDecoder>(log_path);
+    status |= runSuite<TestExtractionPlan>(log_path);
+    status |= runSuite<TestTimeBinAccumulator>(log_path);
+    status |= runSuite<TestPcmPacketTable>(log_path);
+    status |= runSuite<TestSpscRing>(log_path);
+    status |= runSuite<TestCsvRowWriter>(log_path);
+    status |= runSuite<TestIrigTime>(log_path);
+    status |= runSuite<TestCh10PacketSource>(log_path);
+    status |= runSuite<TestCh10PacketIndex>(log_path);
+    status |= runSuite<TestCh10RecordingIndex>(log_path);
     status |= runSuite<TestMainViewModelHelpers>(log_path);
     status |= runSuite<TestMainViewModelState>(log_path);
     status |= runSuite<TestFrameSetup>(log_path);
@@ -97,6 +122,7 @@ int main(int argc, char* argv[])
     status |= runSuite<TestTimeExtractionWidget>(log_path);
     status |= runSuite<TestReceiverGridWidget>(log_path);
     status |= runSuite<TestProcessingCoordinator>(log_path);
+    status |= runSuite<TestBatchScheduler>(log_path);
 
     return status;
 }
@@ -17,7 +17,11 @@ win32 {
 
 # Application sources (exclude main.cpp to avoid duplicate main)
 SOURCES += \
+    $$PWD/../src/batchscheduler.cpp \
     $$PWD/../src/channeldata.cpp \
+    $$PWD/../src/ch10packetindex.cpp \
+    $$PWD/../src/ch10packetsource.cpp \
+    $$PWD/../src/ch10recordingindex.cpp \
     $$PWD/../src/chapter10reader.cpp \
     $$PWD/../src/framesetup.cpp \
     $$PWD/../src/mainviewmodel.cpp \
@@ -27,6 +31,14 @@ SOURCES += \
     $$PWD/../src/settingsdialog.cpp \
     $$PWD/../src/timeextractionwidget.cpp \
     $$PWD/../src/frameprocessor.cpp \
+    $$PWD/../src/csvrowwriter.cpp \
+    $$PWD/../src/extractionplan.cpp \
+    $$PWD/../src/pcmframedecoder.cpp \
+    $$PWD/../src/pcmframesync.cpp \
+    $$PWD/../src/pcmpackettable.cpp \
+    $$PWD/../src/rnrzldecoder.cpp \
+    $$PWD/../src/synccorrelator.cpp \
+    $$PWD/../src/timebinaccumulator.cpp \
     $$PWD/../src/plotviewmodel.cpp \
     $$PWD/../src/plotwidget.cpp \
     $$PWD/../src/settingsmanager.cpp \
@@ -34,7 +46,11 @@ SOURCES += \
 
 # Application headers
 HEADERS += \
+    $$PWD/../include/batchscheduler.h \
     $$PWD/../include/channeldata.h \
+    $$PWD/../include/ch10packetindex.h \
+    $$PWD/../include/ch10packetsource.h \
+    $$PWD/../include/ch10recordingindex.h \
     $$PWD/../include/chapter10reader.h \
     $$PWD/../include/constants.h \
     $$PWD/../include/framesetup.h \
@@ -43,6 +59,17 @@ HEADERS += \
     $$PWD/../include/mainview.h \
     $$PWD/../include/receivergridwidget.h \
     $$PWD/../include/frameprocessor.h \
+    $$PWD/../include/csvrowwriter.h \
+    $$PWD/../include/extractionplan.h \
+    $$PWD/../include/irigtime.h \
+    $$PWD/../include/pcmframedecoder.h \
+    $$PWD/../include/pcmframesync.h \
+    $$PWD/../include/pcmpackettable.h \
+    $$PWD/../include/rnrzldecoder.h \
+    $$PWD/../include/spscring.h \
+    $$PWD/../include/synccorrelator.h \
+    $$PWD/../include/timebinaccumulator.h \
+    $$PWD/../include/tmatsdecode.h \
     $$PWD/../include/processingparams.h \
     $$PWD/../include/timefields.h \
     $$PWD/../include/batchfileinfo.h \
@@ -93,8 +120,12 @@ HEADERS += \
 SOURCES += \
     main.cpp \
     tst_channeldata.cpp \
+    tst_ch10packetindex.cpp \
+    tst_ch10packetsource.cpp \
+    tst_ch10recordingindex.cpp \
     tst_chapter10reader.cpp \
     tst_constants.cpp \
+    tst_csvrowwriter.cpp \
     tst_mainviewmodel_helpers.cpp \
     tst_mainviewmodel_state.cpp \
     tst_framesetup.cpp \
@@ -103,15 +134,29 @@ SOURCES += \
     tst_mainviewmodel_batch.cpp \
     tst_plotviewmodel.cpp \
     tst_frameprocessor.cpp \
+    tst_extractionplan.cpp \
+    tst_irigtime.cpp \
+    tst_pcmframesync.cpp \
+    tst_pcmpackettable.cpp \
+    tst_rnrzldecoder.cpp \
+    tst_spscring.cpp \
+    tst_synccorrelator.cpp \
+    tst_timebinaccumulator.cpp \
     tst_timeextractionwidget.cpp \
     tst_receivergridwidget.cpp \
-    tst_processingcoordinator.cpp
+    tst_processingcoordinator.cpp \
+    tst_batchscheduler.cpp
 
 # Test headers (needed for MOC processing)
 HEADERS += \
+    ch10testpackets.h \
     tst_channeldata.h \
+    tst_ch10packetindex.h \
+    tst_ch10packetsource.h \
+    tst_ch10recordingindex.h \
     tst_chapter10reader.h \
     tst_constants.h \
+    tst_csvrowwriter.h \
     tst_mainviewmodel_batch.h \
     tst_mainviewmodel_helpers.h \
     tst_mainviewmodel_state.h \
@@ -120,6 +165,15 @@ HEADERS += \
     tst_settingsdialog.h \
     tst_settingsmanager.h \
     tst_frameprocessor.h \
+    tst_extractionplan.h \
+    tst_irigtime.h \
+    tst_pcmframesync.h \
+    tst_pcmpackettable.h \
+    tst_rnrzldecoder.h \
+    tst_spscring.h \
+    tst_synccorrelator.h \
+    tst_timebinaccumulator.h \
     tst_timeextractionwidget.h \
     tst_receivergridwidget.h \
-    tst_processingcoordinator.h
+    tst_processingcoordinator.h \
+    tst_batchscheduler.h
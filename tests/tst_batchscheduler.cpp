@@ -0,0 +1,133 @@
+#include "tst_batchscheduler.h"
+
+#include <QtTest>
+
+#include "batchscheduler.h"
+
+void TestBatchScheduler::emptyQueueReturnsNone()
+{
+    BatchScheduler scheduler(4, 2);
+    QCOMPARE(scheduler.takeNext(), -1);
+    QCOMPARE(scheduler.running(), 0);
+    QCOMPARE(scheduler.queued(), 0);
+    QCOMPARE(scheduler.concurrency(), 1);
+}
+
+void TestBatchScheduler::largestFileFirst()
+{
+    BatchScheduler scheduler(1, 0);
+    scheduler.addFile(0, 100, "disk");
+    scheduler.addFile(1, 300, "disk");
+    scheduler.addFile(2, 200, "disk");
+
+    QCOMPARE(scheduler.takeNext(), 1);
+    scheduler.finish(1);
+    QCOMPARE(scheduler.takeNext(), 2);
+    scheduler.finish(2);
+    QCOMPARE(scheduler.takeNext(), 0);
+    scheduler.finish(0);
+    QCOMPARE(scheduler.takeNext(), -1);
+}
+
+void TestBatchScheduler::equalSizesKeepListOrder()
+{
+    BatchScheduler scheduler(3, 0);
+    scheduler.addFile(0, 50, "disk");
+    scheduler.addFile(1, 50, "disk");
+    scheduler.addFile(2, 50, "disk");
+
+    QCOMPARE(scheduler.takeNext(), 0);
+    QCOMPARE(scheduler.takeNext(), 1);
+    QCOMPARE(scheduler.takeNext(), 2);
+}
+
+void TestBatchScheduler::workerLimitBoundsRunning()
+{
+    BatchScheduler scheduler(2, 0);
+    for (int i = 0; i < 4; i++)
+    {
+        scheduler.addFile(i, 10, "disk");
+    }
+
+    QVERIFY(scheduler.takeNext() >= 0);
+    QVERIFY(scheduler.takeNext() >= 0);
+    QCOMPARE(scheduler.takeNext(), -1);
+    QCOMPARE(scheduler.running(), 2);
+    QCOMPARE(scheduler.queued(), 2);
+}
+
+void TestBatchScheduler::deviceLimitSkipsBusyDevice()
+{
+    // The largest file on a busy device waits while a smaller one on a free device starts
+    BatchScheduler scheduler(4, 1);
+    scheduler.addFile(0, 300, "disk_a");
+    scheduler.addFile(1, 200, "disk_a");
+    scheduler.addFile(2, 100, "disk_b");
+
+    QCOMPARE(scheduler.takeNext(), 0);
+    QCOMPARE(scheduler.takeNext(), 2);
+    QCOMPARE(scheduler.takeNext(), -1);
+    QCOMPARE(scheduler.queued(), 1);
+}
+
+void TestBatchScheduler::finishFreesDeviceSlot()
+{
+    BatchScheduler scheduler(4, 1);
+    scheduler.addFile(0, 300, "disk_a");
+    scheduler.addFile(1, 200, "disk_a");
+
+    QCOMPARE(scheduler.takeNext(), 0);
+    QCOMPARE(scheduler.takeNext(), -1);
+
+    scheduler.finish(0);
+    QCOMPARE(scheduler.takeNext(), 1);
+    QCOMPARE(scheduler.running(), 1);
+
+    // Finishing a file that is not running changes nothing
+    scheduler.finish(7);
+    QCOMPARE(scheduler.running(), 1);
+}
+
+void TestBatchScheduler::clearQueueKeepsRunning()
+{
+    BatchScheduler scheduler(1, 0);
+    scheduler.addFile(0, 10, "disk");
+    scheduler.addFile(1, 10, "disk");
+
+    QCOMPARE(scheduler.takeNext(), 0);
+    scheduler.clearQueue();
+    QCOMPARE(scheduler.queued(), 0);
+    QCOMPARE(scheduler.running(), 1);
+
+    scheduler.finish(0);
+    QCOMPARE(scheduler.takeNext(), -1);
+}
+
+void TestBatchScheduler::concurrencyHonoursLimits()
+{
+    // Two devices, two files each: one per device with a limit of 1
+    BatchScheduler limited(8, 1);
+    limited.addFile(0, 10, "disk_a");
+    limited.addFile(1, 10, "disk_a");
+    limited.addFile(2, 10, "disk_b");
+    limited.addFile(3, 10, "disk_b");
+    QCOMPARE(limited.concurrency(), 2);
+
+    // No device limit: capped by the workers only
+    BatchScheduler unlimited(3, 0);
+    for (int i = 0; i < 5; i++)
+    {
+        unlimited.addFile(i, 10, "disk_a");
+    }
+    QCOMPARE(unlimited.concurrency(), 3);
+
+    // Fewer files than workers
+    BatchScheduler idle(8, 0);
+    idle.addFile(0, 10, "disk_a");
+    QCOMPARE(idle.concurrency(), 1);
+}
+
+void TestBatchScheduler::physicalCoreCountPositive()
+{
+    QVERIFY(BatchScheduler::physicalCoreCount() > 0);
+}
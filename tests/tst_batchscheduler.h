@@ -0,0 +1,22 @@
+#ifndef TST_BATCHSCHEDULER_H
+#define TST_BATCHSCHEDULER_H
+
+#include <QObject>
+
+class TestBatchScheduler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void emptyQueueReturnsNone();
+    void largestFileFirst();
+    void equalSizesKeepListOrder();
+    void workerLimitBoundsRunning();
+    void deviceLimitSkipsBusyDevice();
+    void finishFreesDeviceSlot();
+    void clearQueueKeepsRunning();
+    void concurrencyHonoursLimits();
+    void physicalCoreCountPositive();
+};
+
+#endif // TST_BATCHSCHEDULER_H
@@ -0,0 +1,214 @@
+/**
+ * @file tst_ch10packetindex.cpp
+ * @brief Implementation of Ch10PacketIndex unit tests.
+ */
+
+#include "tst_ch10packetindex.h"
+
+#include <vector>
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "ch10packetindex.h"
+#include "ch10testpackets.h"
+
+using namespace Irig106;
+
+namespace {
+    /// Writes a recording of interleaved time and PCM channels to @p path.
+    bool writeRecording(const QString& path)
+    {
+        QByteArray bytes = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray(20, '\0'), 0);
+        for (uint8_t i = 0; i < 10; i++)
+        {
+            bytes += makePacket(1, I106CH10_DTYPE_IRIG_TIME, QByteArray(8, '\x01'), i);
+            bytes += makePacket(3, I106CH10_DTYPE_PCM_FMT_1, QByteArray(100 + i, '\x03'), i);
+            bytes += makePacket(4, I106CH10_DTYPE_PCM_FMT_1, QByteArray(60, '\x04'), i);
+        }
+        QFile file(path);
+        return file.open(QIODevice::WriteOnly) && file.write(bytes) == bytes.size();
+    }
+
+    /// Indexes every packet of @p path in file order.
+    Ch10PacketIndex indexFile(const QString& path)
+    {
+        Ch10PacketIndex index;
+        const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(path);
+        Ch10Packet packet;
+        while (source != nullptr && source->next(packet) == I106_OK)
+        {
+            index.append(packet);
+        }
+        return index;
+    }
+
+    /// @return Offsets returned by @p source from its current position to the end.
+    std::vector<int64_t> readOffsets(Ch10PacketSource& source)
+    {
+        std::vector<int64_t> offsets;
+        Ch10Packet packet;
+        while (source.next(packet) == I106_OK && source.readData(packet) == I106_OK)
+        {
+            offsets.push_back(packet.offset);
+        }
+        return offsets;
+    }
+}
+
+void TestCh10PacketIndex::savesAndLoadsSidecar()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeRecording(path));
+
+    const Ch10PacketIndex index = indexFile(path);
+    QCOMPARE(index.size(), static_cast<size_t>(31));
+    QCOMPARE(Ch10PacketIndex::sidecarPath(path), path + ".idx");
+    QVERIFY(index.save(path));
+
+    Ch10PacketIndex loaded;
+    QVERIFY(loaded.load(path));
+    QCOMPARE(loaded.offsets(), index.offsets());
+    QCOMPARE(loaded.relativeTimes(), index.relativeTimes());
+    QCOMPARE(loaded.packetLengths(), index.packetLengths());
+    QCOMPARE(loaded.dataLengths(), index.dataLengths());
+    QCOMPARE(loaded.channelIds(), index.channelIds());
+    QCOMPARE(loaded.dataTypes(), index.dataTypes());
+    QCOMPARE(loaded.relativeTimes()[2], static_cast<int64_t>(0));
+    QCOMPARE(loaded.relativeTimes()[5], static_cast<int64_t>(1));
+    QCOMPARE(loaded.dataLengths()[2], static_cast<uint32_t>(100));
+}
+
+void TestCh10PacketIndex::rejectsStaleSidecar()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeRecording(path));
+    QVERIFY(indexFile(path).save(path));
+
+    // Touched: same size, different modification time
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+    file.close();
+    Ch10PacketIndex index;
+    QVERIFY(!index.load(path));
+    QVERIFY(index.isEmpty());
+
+    // Re-indexed, then grown
+    QVERIFY(indexFile(path).save(path));
+    QVERIFY(index.load(path));
+    QVERIFY(file.open(QIODevice::Append));
+    QVERIFY(file.write(makePacket(1, I106CH10_DTYPE_IRIG_TIME, QByteArray(8, '\x01'), 11)) > 0);
+    file.close();
+    QVERIFY(!index.load(path));
+    QVERIFY(index.isEmpty());
+}
+
+void TestCh10PacketIndex::rejectsDamagedSidecar()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeRecording(path));
+    QVERIFY(indexFile(path).save(path));
+
+    QFile sidecar(Ch10PacketIndex::sidecarPath(path));
+    QVERIFY(sidecar.open(QIODevice::ReadOnly));
+    const QByteArray bytes = sidecar.readAll();
+    sidecar.close();
+
+    // true if the sidecar holding @p contents is accepted
+    auto loads = [&path](const QByteArray& contents) {
+        QFile damaged(Ch10PacketIndex::sidecarPath(path));
+        if (!damaged.open(QIODevice::WriteOnly) || damaged.write(contents) != contents.size())
+        {
+            return false;
+        }
+        damaged.close();
+        Ch10PacketIndex index;
+        return index.load(path) || !index.isEmpty();
+    };
+    QVERIFY(loads(bytes));
+    QVERIFY(!loads(bytes.left(bytes.size() - 1)));
+    QVERIFY(!loads(QByteArray("X") + bytes.mid(1)));
+    QVERIFY(!loads(QByteArray()));
+
+    // Offsets out of order (first two swapped; the offsets column follows the 40-byte header)
+    QByteArray swapped = bytes;
+    const QByteArray first = swapped.mid(40, 8);
+    swapped.replace(40, 8, swapped.mid(48, 8));
+    swapped.replace(48, 8, first);
+    QVERIFY(!loads(swapped));
+}
+
+void TestCh10PacketIndex::selectPacketsMatchesFilteredRead()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeRecording(path));
+    const Ch10PacketIndex index = indexFile(path);
+
+    auto filter = [](uint16_t channel_id, uint8_t data_type) {
+        return (data_type == I106CH10_DTYPE_IRIG_TIME && channel_id == 1) ||
+               (data_type == I106CH10_DTYPE_PCM_FMT_1 && channel_id == 4);
+    };
+    std::vector<int64_t> expected;
+    for (size_t i = 0; i < index.size(); i++)
+    {
+        if (filter(index.channelIds()[i], index.dataTypes()[i]))
+        {
+            expected.push_back(index.offsets()[i]);
+        }
+    }
+    QCOMPARE(expected.size(), static_cast<size_t>(20));
+
+    for (const auto backend : {Ch10PacketSource::Backend::Mapped, Ch10PacketSource::Backend::Library,
+                               Ch10PacketSource::Backend::Prefetched})
+    {
+        std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(path, backend, 64);
+        QVERIFY(source != nullptr);
+        source = index.selectPackets(std::move(source), filter);
+        QCOMPARE(readOffsets(*source), expected);
+
+        // Selection resumes at the first selected packet at or after a new position
+        QVERIFY(source->setPosition(expected[9] + 1));
+        QCOMPARE(readOffsets(*source), std::vector<int64_t>(expected.begin() + 10, expected.end()));
+    }
+
+    // Packets the index no longer matches are read errors, not silently different data
+    std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(path);
+    QVERIFY(source != nullptr);
+    Ch10PacketIndex shifted;
+    Ch10Packet packet;
+    while (source->next(packet) == I106_OK)
+    {
+        packet.offset += 4;
+        shifted.append(packet);
+    }
+    source->setPosition(0);
+    source = shifted.selectPackets(std::move(source), filter);
+    QCOMPARE(source->next(packet), I106_READ_ERROR);
+}
+
+void TestCh10PacketIndex::readAtRequiresPacketStart()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeRecording(path));
+    const Ch10PacketIndex index = indexFile(path);
+    const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(path);
+    QVERIFY(source != nullptr);
+
+    Ch10Packet packet;
+    QCOMPARE(source->readAt(index.offsets()[5], packet), I106_OK);
+    QCOMPARE(packet.offset, index.offsets()[5]);
+    QCOMPARE(packet.header.uChID, index.channelIds()[5]);
+    QVERIFY(packet.data != nullptr);
+    QCOMPARE(packet.data[0], static_cast<uint8_t>(index.channelIds()[5]));
+
+    // Inside a packet: the next header found is elsewhere
+    QCOMPARE(source->readAt(index.offsets()[5] + 2, packet), I106_READ_ERROR);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file tst_ch10packetindex.h
+ * @brief Unit tests for Ch10PacketIndex — sidecar round trip, validation and packet selection.
+ */
+
+#ifndef TST_CH10PACKETINDEX_H
+#define TST_CH10PACKETINDEX_H
+
+#include <QObject>
+
+class TestCh10PacketIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void savesAndLoadsSidecar();
+    void rejectsStaleSidecar();
+    void rejectsDamagedSidecar();
+    void selectPacketsMatchesFilteredRead();
+    void readAtRequiresPacketStart();
+};
+
+#endif // TST_CH10PACKETINDEX_H
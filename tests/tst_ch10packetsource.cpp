@@ -0,0 +1,302 @@
+/**
+ * @file tst_ch10packetsource.cpp
+ * @brief Implementation of Ch10PacketSource unit tests.
+ */
+
+#include "tst_ch10packetsource.h"
+
+#include <vector>
+
+#include <QTemporaryFile>
+#include <QtTest>
+
+#include "ch10packetsource.h"
+#include "ch10testpackets.h"
+
+using namespace Irig106;
+
+namespace {
+    /// One next() / readData() step as seen by a caller.
+    struct Step {
+        EnI106Status status = I106_OK;
+        EnI106Status data_status = I106_OK;
+        int64_t offset = 0;
+        uint16_t channel = 0;
+        QByteArray body;
+
+        bool operator==(const Step& other) const
+        {
+            return status == other.status && data_status == other.data_status && offset == other.offset &&
+                   channel == other.channel && body == other.body;
+        }
+    };
+
+    /// @return Body of @p size bytes counting up from @p seed.
+    QByteArray makeBody(int size, int seed)
+    {
+        QByteArray body(size, '\0');
+        for (int i = 0; i < size; i++)
+        {
+            body[i] = static_cast<char>(seed + i);
+        }
+        return body;
+    }
+
+    /// Prefetch block sizes that put block edges inside headers and bodies of the test packets.
+    const std::vector<size_t> kSmallBlocks = {64, 100, 4096};
+
+    /// Reads every packet of @p path with @p backend, including the final status.
+    std::vector<Step> readAll(const QString& path, Ch10PacketSource::Backend backend,
+                              size_t block_bytes = PCMConstants::kPrefetchBlockBytes)
+    {
+        std::vector<Step> steps;
+        const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(path, backend, block_bytes);
+        if (source == nullptr || source->backend() != backend)
+        {
+            return steps;
+        }
+
+        Ch10Packet packet;
+        while (true)
+        {
+            Step step;
+            step.status = source->next(packet);
+            if (step.status == I106_OK)
+            {
+                step.offset = packet.offset;
+                step.channel = packet.header.uChID;
+                step.data_status = source->readData(packet);
+                if (step.data_status == I106_OK)
+                {
+                    step.body = QByteArray(reinterpret_cast<const char*>(packet.data),
+                                           static_cast<qsizetype>(packet.header.ulDataLen));
+                }
+            }
+            steps.push_back(step);
+            if (step.status == I106_EOF || step.data_status != I106_OK)
+            {
+                break;
+            }
+        }
+        return steps;
+    }
+
+    /// Writes a TMATS packet followed by @p bytes to @p file, as a recording starts.
+    bool writeFile(QTemporaryFile& file, const QByteArray& bytes)
+    {
+        const QByteArray contents = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray("G\\DSI\\N:0;\r\n")) + bytes;
+        return file.open() && file.write(contents) == contents.size() && file.flush();
+    }
+
+    /// Size of the TMATS packet written by writeFile().
+    const qsizetype kTmatsSize = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray("G\\DSI\\N:0;\r\n")).size();
+}
+
+void TestCh10PacketSource::readsPacketsInOrder()
+{
+    const QByteArray first = makePacket(1, I106CH10_DTYPE_IRIG_TIME, makeBody(10, 1));
+    const QByteArray second = makePacket(3, I106CH10_DTYPE_PCM_FMT_1, makeBody(100, 7), 0, 0, true);
+    const QByteArray third = makePacket(3, I106CH10_DTYPE_PCM_FMT_1, makeBody(64, 9));
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, first + second + third));
+
+    const std::vector<Step> mapped = readAll(file.fileName(), Ch10PacketSource::Backend::Mapped);
+    QCOMPARE(mapped.size(), static_cast<size_t>(5));
+    QCOMPARE(mapped[0].offset, static_cast<int64_t>(0));
+    QCOMPARE(mapped[1].offset, static_cast<int64_t>(kTmatsSize));
+    QCOMPARE(mapped[2].offset, static_cast<int64_t>(kTmatsSize + first.size()));
+    QCOMPARE(mapped[3].offset, static_cast<int64_t>(kTmatsSize + first.size() + second.size()));
+    QCOMPARE(mapped[2].channel, static_cast<uint16_t>(3));
+    QCOMPARE(mapped[2].body, makeBody(100, 7));
+    QCOMPARE(mapped[4].status, I106_EOF);
+
+    QVERIFY(mapped == readAll(file.fileName(), Ch10PacketSource::Backend::Library));
+    for (const size_t block_bytes : kSmallBlocks)
+    {
+        QVERIFY(mapped == readAll(file.fileName(), Ch10PacketSource::Backend::Prefetched, block_bytes));
+    }
+}
+
+void TestCh10PacketSource::backendsAgreeOnCorruptInput()
+{
+    // A false sync word, a header with a bad checksum and a bad secondary header,
+    // each reported once; the search resumes after the header bytes just read
+    QByteArray bad_header = makePacket(5, I106CH10_DTYPE_PCM_FMT_1, makeBody(16, 3));
+    bad_header[20] = static_cast<char>(bad_header[20] ^ 0x01);
+    QByteArray bad_secondary = makePacket(6, I106CH10_DTYPE_PCM_FMT_1, makeBody(16, 4), 0, 0, true);
+    bad_secondary[30] = static_cast<char>(bad_secondary[30] ^ 0x01);
+
+    const QByteArray bytes = makePacket(1, I106CH10_DTYPE_IRIG_TIME, makeBody(8, 0)) +
+                             QByteArray("\x25\xEB not a packet header!!", HEADER_SIZE) +
+                             makePacket(2, I106CH10_DTYPE_PCM_FMT_1, makeBody(40, 1)) +
+                             bad_header +
+                             makePacket(3, I106CH10_DTYPE_PCM_FMT_1, makeBody(20, 2)) +
+                             bad_secondary +
+                             makePacket(4, I106CH10_DTYPE_PCM_FMT_1, makeBody(12, 5), 0, 0, true);
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, bytes));
+
+    const std::vector<Step> mapped = readAll(file.fileName(), Ch10PacketSource::Backend::Mapped);
+    const std::vector<Step> library = readAll(file.fileName(), Ch10PacketSource::Backend::Library);
+    QVERIFY(!mapped.empty());
+    QVERIFY(mapped == library);
+    for (const size_t block_bytes : kSmallBlocks)
+    {
+        QVERIFY(mapped == readAll(file.fileName(), Ch10PacketSource::Backend::Prefetched, block_bytes));
+    }
+
+    std::vector<uint16_t> channels;
+    int checksum_errors = 0;
+    for (const Step& step : mapped)
+    {
+        if (step.status == I106_OK)
+        {
+            channels.push_back(step.channel);
+        }
+        checksum_errors += (step.status == I106_HEADER_CHKSUM_BAD) ? 1 : 0;
+    }
+    QCOMPARE(channels, (std::vector<uint16_t>{0, 1, 2, 3, 4}));
+    QCOMPARE(checksum_errors, 3);
+}
+
+void TestCh10PacketSource::truncatedBodyFails()
+{
+    const QByteArray whole = makePacket(1, I106CH10_DTYPE_IRIG_TIME, makeBody(8, 0));
+    const QByteArray cut = makePacket(2, I106CH10_DTYPE_PCM_FMT_1, makeBody(200, 1)).left(HEADER_SIZE + 50);
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, whole + cut));
+
+    const std::vector<Step> mapped = readAll(file.fileName(), Ch10PacketSource::Backend::Mapped);
+    QCOMPARE(mapped.size(), static_cast<size_t>(3));
+    QCOMPARE(mapped[2].status, I106_OK);
+    QCOMPARE(mapped[2].data_status, I106_EOF);
+    QVERIFY(mapped == readAll(file.fileName(), Ch10PacketSource::Backend::Library));
+    QVERIFY(mapped == readAll(file.fileName(), Ch10PacketSource::Backend::Prefetched, kSmallBlocks[0]));
+}
+
+void TestCh10PacketSource::prefetchedBodiesSpanBlocks()
+{
+    // Bodies several blocks long, with skipped bodies in between
+    const QByteArray first = makePacket(1, I106CH10_DTYPE_PCM_FMT_1, makeBody(1000, 3));
+    const QByteArray skipped = makePacket(2, I106CH10_DTYPE_PCM_FMT_1, makeBody(700, 4), 0, 0, true);
+    const QByteArray last = makePacket(1, I106CH10_DTYPE_PCM_FMT_1, makeBody(333, 5));
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, first + skipped + last));
+
+    const std::unique_ptr<Ch10PacketSource> source =
+        Ch10PacketSource::open(file.fileName(), Ch10PacketSource::Backend::Prefetched, kSmallBlocks[0]);
+    QVERIFY(source != nullptr);
+    QCOMPARE(source->backend(), Ch10PacketSource::Backend::Prefetched);
+
+    Ch10Packet packet;
+    std::vector<QByteArray> bodies;
+    while (source->next(packet) == I106_OK)
+    {
+        if (packet.header.uChID == 1)
+        {
+            QCOMPARE(source->readData(packet), I106_OK);
+            bodies.emplace_back(reinterpret_cast<const char*>(packet.data),
+                                static_cast<qsizetype>(packet.header.ulDataLen));
+        }
+    }
+    QCOMPARE(bodies, (std::vector<QByteArray>{makeBody(1000, 3), makeBody(333, 5)}));
+
+    // The skipped body is longer than the blocks in flight, so it was jumped over, not read
+    const Ch10ReadStats stats = source->readStats();
+    QVERIFY(stats.bytes > 0);
+    QVERIFY(stats.bytes < source->size());
+}
+
+void TestCh10PacketSource::setPositionSearchesForward()
+{
+    const QByteArray first = makePacket(1, I106CH10_DTYPE_PCM_FMT_1, makeBody(48, 0));
+    const QByteArray second = makePacket(2, I106CH10_DTYPE_PCM_FMT_1, makeBody(48, 1));
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, first + second));
+
+    for (const auto backend : {Ch10PacketSource::Backend::Mapped, Ch10PacketSource::Backend::Library,
+                               Ch10PacketSource::Backend::Prefetched})
+    {
+        const std::unique_ptr<Ch10PacketSource> source =
+            Ch10PacketSource::open(file.fileName(), backend, kSmallBlocks[0]);
+        QVERIFY(source != nullptr);
+        QCOMPARE(source->size(), static_cast<int64_t>(kTmatsSize + first.size() + second.size()));
+
+        Ch10Packet packet;
+        QVERIFY(source->setPosition(kTmatsSize + 5));
+        QCOMPARE(source->next(packet), I106_OK);
+        QCOMPARE(packet.header.uChID, static_cast<uint16_t>(2));
+        QCOMPARE(packet.offset, static_cast<int64_t>(kTmatsSize + first.size()));
+        QCOMPARE(source->position(), packet.dataOffset());
+        QCOMPARE(source->next(packet), I106_EOF);
+
+        // Back to the start, behind anything a prefetching source still holds
+        QVERIFY(source->setPosition(0));
+        QCOMPARE(source->next(packet), I106_OK);
+        QCOMPARE(packet.offset, static_cast<int64_t>(0));
+        QCOMPARE(packet.header.ubyDataType, static_cast<uint8_t>(I106CH10_DTYPE_TMATS));
+    }
+}
+
+void TestCh10PacketSource::previousFindsEarlierPacket()
+{
+    // The middle body is longer than the first search window, and the file ends with a truncated packet
+    const QByteArray first = makePacket(1, I106CH10_DTYPE_PCM_FMT_1, makeBody(48, 0));
+    const QByteArray large = makePacket(2, I106CH10_DTYPE_PCM_FMT_1, makeBody(100000, 1));
+    const QByteArray last = makePacket(3, I106CH10_DTYPE_PCM_FMT_1, makeBody(48, 2));
+    const QByteArray cut = makePacket(4, I106CH10_DTYPE_PCM_FMT_1, makeBody(48, 3)).left(HEADER_SIZE + 10);
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, first + large + last + cut));
+    const int64_t large_offset = kTmatsSize + first.size();
+    const int64_t last_offset = large_offset + large.size();
+
+    for (const auto backend : {Ch10PacketSource::Backend::Mapped, Ch10PacketSource::Backend::Library,
+                               Ch10PacketSource::Backend::Prefetched})
+    {
+        const std::unique_ptr<Ch10PacketSource> source =
+            Ch10PacketSource::open(file.fileName(), backend, kSmallBlocks[2]);
+        QVERIFY(source != nullptr);
+
+        Ch10Packet packet;
+        QCOMPARE(source->previous(source->size(), packet), I106_OK);
+        QCOMPARE(packet.offset, last_offset);
+        QCOMPARE(packet.header.uChID, static_cast<uint16_t>(3));
+        QCOMPARE(source->previous(last_offset, packet), I106_OK);
+        QCOMPARE(packet.offset, large_offset);
+
+        // A packet that does not end by the limit is passed over, even if the search has to widen
+        QCOMPARE(source->previous(last_offset - 1, packet), I106_OK);
+        QCOMPARE(packet.offset, static_cast<int64_t>(kTmatsSize));
+        QCOMPARE(source->previous(kTmatsSize - 1, packet), I106_BOF);
+
+        // A filter passes over packets it rejects
+        const auto channel_1 = [](uint16_t channel_id, uint8_t /*data_type*/) { return channel_id == 1; };
+        QCOMPARE(source->previous(source->size(), packet, channel_1), I106_OK);
+        QCOMPARE(packet.offset, static_cast<int64_t>(kTmatsSize));
+        const auto time = [](uint16_t /*channel_id*/, uint8_t data_type) {
+            return data_type == I106CH10_DTYPE_IRIG_TIME;
+        };
+        QCOMPARE(source->previous(source->size(), packet, time), I106_BOF);
+
+        // The body is read separately
+        QCOMPARE(source->previous(large_offset, packet), I106_OK);
+        QCOMPARE(source->readAt(packet.offset, packet), I106_OK);
+        QCOMPARE(QByteArray(reinterpret_cast<const char*>(packet.data), 48), makeBody(48, 0));
+    }
+}
+
+void TestCh10PacketSource::rejectsNonChapter10Files()
+{
+    QTemporaryFile empty;
+    QVERIFY(empty.open());
+    QTemporaryFile text;
+    QVERIFY(text.open() && text.write(QByteArray("not a recording")) > 0 && text.flush());
+
+    for (const auto backend : {Ch10PacketSource::Backend::Mapped, Ch10PacketSource::Backend::Library,
+                               Ch10PacketSource::Backend::Prefetched})
+    {
+        QVERIFY(Ch10PacketSource::open(empty.fileName(), backend) == nullptr);
+        QVERIFY(Ch10PacketSource::open(text.fileName(), backend) == nullptr);
+    }
+    QVERIFY(Ch10PacketSource::open("no_such_file.ch10") == nullptr);
+}
@@ -0,0 +1,25 @@
+/**
+ * @file tst_ch10packetsource.h
+ * @brief Unit tests for Ch10PacketSource — backend equivalence, resync, truncation and block edges.
+ */
+
+#ifndef TST_CH10PACKETSOURCE_H
+#define TST_CH10PACKETSOURCE_H
+
+#include <QObject>
+
+class TestCh10PacketSource : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readsPacketsInOrder();
+    void backendsAgreeOnCorruptInput();
+    void truncatedBodyFails();
+    void prefetchedBodiesSpanBlocks();
+    void setPositionSearchesForward();
+    void previousFindsEarlierPacket();
+    void rejectsNonChapter10Files();
+};
+
+#endif // TST_CH10PACKETSOURCE_H
@@ -0,0 +1,215 @@
+/**
+ * @file tst_ch10recordingindex.cpp
+ * @brief Implementation of Ch10RecordingIndex unit tests.
+ */
+
+#include "tst_ch10recordingindex.h"
+
+#include <utility>
+#include <vector>
+
+#include <QTemporaryFile>
+#include <QtTest>
+
+#include "ch10packetindex.h"
+#include "ch10recordingindex.h"
+#include "ch10testpackets.h"
+
+using namespace Irig106;
+
+namespace {
+    /// One packet listed by a node index packet.
+    struct Listed {
+        int64_t offset = 0;
+        int64_t rel_time = 0;
+        uint16_t channel = 0;
+        uint8_t data_type = 0;
+    };
+
+    /// Ways makeRecording() can spoil the index.
+    enum class Damage {
+        None,
+        EntryInsidePacket,   ///< Last entry points 4 bytes into its packet.
+        EntriesOutOfOrder,   ///< Second node lists its first two packets the wrong way round.
+        CountMismatch,       ///< Second node claims one entry more than it holds.
+        ForeignTimeStamps,   ///< Second node uses secondary header time stamps.
+        RootLinksForward,    ///< First root links to an offset after itself.
+        FileSizeTooLarge,    ///< Last root records a file larger than the file.
+        NoFinalRoot          ///< The file ends with a node, not a root.
+    };
+
+    /// @return The bytes of @p value.
+    template <typename T>
+    QByteArray bytesOf(T value)
+    {
+        return {reinterpret_cast<const char*>(&value), static_cast<qsizetype>(sizeof(value))};
+    }
+
+    /// @return A node index packet listing @p listed, claiming @p extra entries more.
+    QByteArray makeNode(const std::vector<Listed>& listed, uint32_t extra = 0, uint8_t flags = 0)
+    {
+        QByteArray body = bytesOf<uint32_t>(0x80000000U | static_cast<uint32_t>(listed.size() + extra));
+        for (const Listed& entry : listed)
+        {
+            body += bytesOf(entry.rel_time);  // RTC in the low 6 bytes
+            body += bytesOf<uint32_t>(entry.channel | (static_cast<uint32_t>(entry.data_type) << 16));
+            body += bytesOf(entry.offset);
+        }
+        return makePacket(0, I106CH10_DTYPE_RECORDING_INDEX, body, 0, flags);
+    }
+
+    /// @return A root index packet listing the node at @p node, linking to @p previous_root.
+    QByteArray makeRoot(int64_t node, int64_t previous_root, int64_t file_size)
+    {
+        QByteArray body = bytesOf<uint32_t>(0x40000000U | 2) + bytesOf(file_size);
+        body += bytesOf<int64_t>(0) + bytesOf(node);
+        body += bytesOf<int64_t>(0) + bytesOf(previous_root);
+        return makePacket(0, I106CH10_DTYPE_RECORDING_INDEX, body);
+    }
+
+    /**
+     * @brief Builds a recording of TMATS and 4 rounds of time (channel 1) and PCM (channel 3)
+     *        packets, with a node and a root index packet after the second and the fourth round.
+     * @param[out] listed  Packets the nodes list (before any damage).
+     * @param[in]  damage  Fault to build into the index.
+     */
+    QByteArray makeRecording(std::vector<Listed>& listed, Damage damage = Damage::None)
+    {
+        QByteArray bytes = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray("G\\DSI\\N:0;\r\n"));
+        listed.clear();
+        std::vector<Listed> node_entries;
+        int64_t first_root = 0;
+        for (int round = 0; round < 4; round++)
+        {
+            const int64_t time = 10000000LL * (round + 1);
+            node_entries.push_back({bytes.size(), time, 1, I106CH10_DTYPE_IRIG_TIME});
+            bytes += makePacket(1, I106CH10_DTYPE_IRIG_TIME, QByteArray(12, '\0'), time);
+            node_entries.push_back({bytes.size(), time + 100, 3, I106CH10_DTYPE_PCM_FMT_1});
+            bytes += makePacket(3, I106CH10_DTYPE_PCM_FMT_1, QByteArray(64, '\x55'), time + 100);
+            if (round % 2 == 0)
+            {
+                continue;
+            }
+
+            listed.insert(listed.end(), node_entries.begin(), node_entries.end());
+            const bool last = (round == 3);
+            uint32_t extra = 0;
+            uint8_t flags = 0;
+            if (last)
+            {
+                switch (damage)
+                {
+                case Damage::EntryInsidePacket:
+                    node_entries.back().offset += 4;
+                    break;
+                case Damage::EntriesOutOfOrder:
+                    std::swap(node_entries[0], node_entries[1]);
+                    break;
+                case Damage::CountMismatch:
+                    extra = 1;
+                    break;
+                case Damage::ForeignTimeStamps:
+                    flags = I106CH10_PFLAGS_IPTIMESRC;
+                    break;
+                default:
+                    break;
+                }
+            }
+            const auto node = static_cast<int64_t>(bytes.size());
+            bytes += makeNode(node_entries, extra, flags);
+            node_entries.clear();
+            if (last && damage == Damage::NoFinalRoot)
+            {
+                break;
+            }
+
+            const auto root = static_cast<int64_t>(bytes.size());
+            int64_t previous_root = last ? first_root : root;
+            if (!last && damage == Damage::RootLinksForward)
+            {
+                previous_root = root + 8;
+            }
+            first_root = last ? first_root : root;
+            int64_t file_size = root + makeRoot(node, previous_root, 0).size();
+            file_size += (last && damage == Damage::FileSizeTooLarge) ? 1 : 0;
+            bytes += makeRoot(node, previous_root, file_size);
+        }
+        return bytes;
+    }
+
+    /// Writes @p bytes to @p file.
+    bool writeFile(QTemporaryFile& file, const QByteArray& bytes)
+    {
+        return file.open() && file.write(bytes) == bytes.size() && file.flush();
+    }
+
+    /// Backends the index is read through.
+    const std::vector<Ch10PacketSource::Backend> kBackends = {
+        Ch10PacketSource::Backend::Mapped, Ch10PacketSource::Backend::Library,
+        Ch10PacketSource::Backend::Prefetched};
+}
+
+void TestCh10RecordingIndex::readListsIndexedPackets()
+{
+    std::vector<Listed> listed;
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, makeRecording(listed)));
+    QCOMPARE(listed.size(), static_cast<size_t>(8));
+
+    for (const auto backend : kBackends)
+    {
+        const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(file.fileName(), backend);
+        QVERIFY(source != nullptr);
+        Ch10PacketIndex index;
+        QVERIFY(Ch10RecordingIndex::read(*source, index));
+
+        // Both roots' nodes in file order, after the unlisted TMATS packet
+        QCOMPARE(index.size(), listed.size() + 1);
+        QCOMPARE(index.offsets()[0], static_cast<int64_t>(0));
+        QCOMPARE(index.dataTypes()[0], static_cast<uint8_t>(I106CH10_DTYPE_TMATS));
+        for (size_t i = 0; i < listed.size(); i++)
+        {
+            QCOMPARE(index.offsets()[i + 1], listed[i].offset);
+            QCOMPARE(index.relativeTimes()[i + 1], listed[i].rel_time);
+            QCOMPARE(index.channelIds()[i + 1], listed[i].channel);
+            QCOMPARE(index.dataTypes()[i + 1], listed[i].data_type);
+            QCOMPARE(index.packetLengths()[i + 1], static_cast<uint32_t>(0));
+        }
+    }
+}
+
+void TestCh10RecordingIndex::readRejectsFileWithoutIndex()
+{
+    std::vector<Listed> listed;
+    const QByteArray recording = makeRecording(listed);
+    QTemporaryFile file;
+    QVERIFY(writeFile(file, recording.left(static_cast<qsizetype>(listed[1].offset))));
+
+    const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(file.fileName());
+    QVERIFY(source != nullptr);
+    Ch10PacketIndex index;
+    QVERIFY(!Ch10RecordingIndex::read(*source, index));
+    QVERIFY(index.isEmpty());
+}
+
+void TestCh10RecordingIndex::readRejectsInconsistentIndex()
+{
+    for (const Damage damage : {Damage::EntryInsidePacket, Damage::EntriesOutOfOrder, Damage::CountMismatch,
+                                Damage::ForeignTimeStamps, Damage::RootLinksForward, Damage::FileSizeTooLarge,
+                                Damage::NoFinalRoot})
+    {
+        std::vector<Listed> listed;
+        QTemporaryFile file;
+        QVERIFY(writeFile(file, makeRecording(listed, damage)));
+
+        for (const auto backend : kBackends)
+        {
+            const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(file.fileName(), backend);
+            QVERIFY(source != nullptr);
+            Ch10PacketIndex index;
+            QVERIFY2(!Ch10RecordingIndex::read(*source, index),
+                     qPrintable(QString("damage %1 accepted").arg(static_cast<int>(damage))));
+            QVERIFY(index.isEmpty());
+        }
+    }
+}
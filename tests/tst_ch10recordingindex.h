@@ -0,0 +1,21 @@
+/**
+ * @file tst_ch10recordingindex.h
+ * @brief Unit tests for Ch10RecordingIndex — root/node decoding, root chains and rejection of bad indexes.
+ */
+
+#ifndef TST_CH10RECORDINGINDEX_H
+#define TST_CH10RECORDINGINDEX_H
+
+#include <QObject>
+
+class TestCh10RecordingIndex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void readListsIndexedPackets();
+    void readRejectsFileWithoutIndex();
+    void readRejectsInconsistentIndex();
+};
+
+#endif // TST_CH10RECORDINGINDEX_H
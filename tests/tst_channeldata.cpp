@@ -57,3 +57,13 @@ void TestChannelData::incrementChannelCountAccumulates()
     cd.incrementChannelCount();
     QCOMPARE(cd.channelCount(), 3);
 }
+
+void TestChannelData::setChannelCountReplacesCount()
+{
+    ChannelData cd(1);
+    cd.incrementChannelCount();
+    cd.setChannelCount(42);
+    QCOMPARE(cd.channelCount(), 42);
+    cd.incrementChannelCount();
+    QCOMPARE(cd.channelCount(), 43);
+}
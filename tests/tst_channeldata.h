@@ -16,6 +16,7 @@ private slots:
     void setChannelNameSetsName();
     void incrementChannelCountIncrementsOnce();
     void incrementChannelCountAccumulates();
+    void setChannelCountReplacesCount();
 };
 
 #endif // TST_CHANNELDATA_H
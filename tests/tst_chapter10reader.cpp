@@ -2,9 +2,15 @@
 
 #include <QtTest>
 
+#include <cstring>
+
 #include <QCoreApplication>
 #include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
 
+#include "ch10packetindex.h"
+#include "ch10testpackets.h"
 #include "chapter10reader.h"
 #include "constants.h"
 
@@ -17,6 +23,71 @@ static QString testDataPath(const QString& filename)
     return dir.filePath("data/" + filename);
 }
 
+/// @return TMATS, then 5 rounds of time (channel 1), PCM (channel 3) and PCM (channel 60000) packets.
+static QByteArray makeRecording(const QByteArray& junk = QByteArray())
+{
+    QByteArray bytes = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray("G\\DSI\\N:0;\r\n"));
+    for (int i = 0; i < 5; i++)
+    {
+        bytes += makePacket(1, I106CH10_DTYPE_IRIG_TIME, QByteArray(12, '\0'));
+        bytes += makePacket(3, I106CH10_DTYPE_PCM_FMT_1, QByteArray(200, '\x55'));
+        bytes += (i == 2) ? junk : QByteArray();
+        bytes += makePacket(60000, I106CH10_DTYPE_PCM_FMT_1, QByteArray(40, '\x66'));
+    }
+    return bytes;
+}
+
+/// Writes @p bytes to @p path.
+static bool writeBytes(const QString& path, const QByteArray& bytes)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(bytes) == bytes.size();
+}
+
+/// Writes makeRecording(@p junk) to @p path.
+static bool writeRecording(const QString& path, const QByteArray& junk = QByteArray())
+{
+    return writeBytes(path, makeRecording(junk));
+}
+
+/**
+ * @brief Appends a recording index to @p bytes: a node index packet listing the time and
+ *        channel 3 packets (not the TMATS or channel 60000 ones) and a root index packet.
+ * @param[in] node_shift Added to the node offset the root records (non-zero breaks the index).
+ */
+static QByteArray withRecordingIndex(const QByteArray& bytes, int64_t node_shift = 0)
+{
+    QByteArray entries;
+    uint32_t count = 0;
+    for (qsizetype offset = 0; offset < bytes.size();)
+    {
+        Irig106::SuI106Ch10Header header = {};
+        std::memcpy(&header, bytes.constData() + offset, HEADER_SIZE);
+        if (header.ubyDataType == I106CH10_DTYPE_IRIG_TIME || header.uChID == 3)
+        {
+            const uint32_t channel_and_type = header.uChID | (static_cast<uint32_t>(header.ubyDataType) << 16);
+            const auto packet_offset = static_cast<int64_t>(offset);
+            entries += QByteArray(8, '\0');  // relative time 0, as makePacket() stamps
+            entries += QByteArray(reinterpret_cast<const char*>(&channel_and_type), sizeof(channel_and_type));
+            entries += QByteArray(reinterpret_cast<const char*>(&packet_offset), sizeof(packet_offset));
+            count++;
+        }
+        offset += header.ulPacketLen;
+    }
+    const uint32_t node_csdw = 0x80000000U | count;
+    QByteArray result = bytes + makePacket(0, I106CH10_DTYPE_RECORDING_INDEX,
+                                           QByteArray(reinterpret_cast<const char*>(&node_csdw), 4) + entries);
+
+    // One node, then the link of the only root to itself
+    const uint32_t root_csdw = 2;
+    const int64_t node = bytes.size() + node_shift;
+    const auto root = static_cast<int64_t>(result.size());
+    QByteArray root_body(reinterpret_cast<const char*>(&root_csdw), 4);
+    root_body += QByteArray(8, '\0') + QByteArray(reinterpret_cast<const char*>(&node), sizeof(node));
+    root_body += QByteArray(8, '\0') + QByteArray(reinterpret_cast<const char*>(&root), sizeof(root));
+    return result + makePacket(0, I106CH10_DTYPE_RECORDING_INDEX, root_body);
+}
+
 void TestChapter10Reader::loadChannelsReturnsTrueForValidFile()
 {
     Chapter10Reader reader;
@@ -228,3 +299,129 @@ void TestChapter10Reader::dhmsToUInt64ComputesCorrectOffset()
     // Day 2, 01:30:15  →  86400 + 3600 + 1800 + 15 = 91815
     QCOMPARE(reader.dhmsToUInt64(2, 1, 30, 15), static_cast<uint64_t>(91815));
 }
+
+void TestChapter10Reader::loadChannelsCountsPacketsFromHeaders()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeRecording(path));
+
+    // The first load scans headers and writes the sidecar; the second uses it
+    for (int pass = 0; pass < 2; pass++)
+    {
+        Chapter10Reader reader;
+        QVERIFY(reader.loadChannels(path));
+        QVERIFY(QFile::exists(Ch10PacketIndex::sidecarPath(path)));
+
+        QCOMPARE(reader.getTimeChannelComboBoxList(), QStringList{"1 - Time"});
+        QCOMPARE(reader.getPCMChannelComboBoxList(), (QStringList{"3 - PCM", "60000 - PCM"}));
+        QCOMPARE(reader.m_channel_data.size(), 4);
+        QCOMPARE(reader.m_channel_data[0]->channelCount(), 1);
+        QCOMPARE(reader.m_channel_data[1]->channelCount(), 5);
+        QCOMPARE(reader.m_channel_data[3]->channelCount(), 5);
+        QCOMPARE(reader.m_channel_data[60000]->channelCount(), 5);
+    }
+}
+
+void TestChapter10Reader::loadChannelsSkipsSidecarAfterResync()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QByteArray corrupt = makePacket(7, I106CH10_DTYPE_PCM_FMT_1, QByteArray(16, '\0'));
+    corrupt[4] = static_cast<char>(corrupt[4] ^ 0x01);  // header checksum no longer matches
+    QVERIFY(writeRecording(path, QByteArray("junk") + corrupt));
+
+    // The scan resynchronizes past the corrupt header and still counts every packet
+    Chapter10Reader reader;
+    QVERIFY(reader.loadChannels(path));
+    QCOMPARE(reader.m_channel_data.size(), 4);
+    QCOMPARE(reader.m_channel_data[60000]->channelCount(), 5);
+    QVERIFY(!QFile::exists(Ch10PacketIndex::sidecarPath(path)));
+}
+
+void TestChapter10Reader::loadChannelsUsesRecordingIndex()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeBytes(path, withRecordingIndex(makeRecording())));
+
+    // The catalog is what the index lists: channel 60000 is left out and no sidecar is needed
+    Chapter10Reader reader;
+    QVERIFY(reader.loadChannels(path));
+    QCOMPARE(reader.getTimeChannelComboBoxList(), QStringList{"1 - Time"});
+    QCOMPARE(reader.getPCMChannelComboBoxList(), QStringList{"3 - PCM"});
+    QCOMPARE(reader.m_channel_data.size(), 3);
+    QCOMPARE(reader.m_channel_data[0]->channelCount(), 1);
+    QCOMPARE(reader.m_channel_data[1]->channelCount(), 5);
+    QCOMPARE(reader.m_channel_data[3]->channelCount(), 5);
+    QVERIFY(!QFile::exists(Ch10PacketIndex::sidecarPath(path)));
+}
+
+void TestChapter10Reader::loadChannelsFallsBackFromBadRecordingIndex()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("recording.ch10");
+    QVERIFY(writeBytes(path, withRecordingIndex(makeRecording(), 4)));
+
+    // The root points inside the node packet, so the file is scanned instead
+    Chapter10Reader reader;
+    QVERIFY(reader.loadChannels(path));
+    QCOMPARE(reader.getPCMChannelComboBoxList(), (QStringList{"3 - PCM", "60000 - PCM"}));
+    QCOMPARE(reader.m_channel_data.size(), 4);
+    QCOMPARE(reader.m_channel_data[0]->channelCount(), 3);
+    QCOMPARE(reader.m_channel_data[60000]->channelCount(), 5);
+    QVERIFY(QFile::exists(Ch10PacketIndex::sidecarPath(path)));
+}
+
+void TestChapter10Reader::loadTimeRangeReadsFileEnds()
+{
+    // Time packets 1 s apart; the last is followed by more than a backward search step of PCM
+    QByteArray bytes = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray("G\\DSI\\N:0;\r\n"));
+    for (int i = 0; i < 4; i++)
+    {
+        const int64_t rel_time = 10000000LL * (i + 1);
+        bytes += makePacket(1, I106CH10_DTYPE_IRIG_TIME, QByteArray(12, '\0'), rel_time);
+        bytes += makePacket(3, I106CH10_DTYPE_PCM_FMT_1, QByteArray(200, '\x55'), rel_time + 100);
+    }
+    bytes += makePacket(3, I106CH10_DTYPE_PCM_FMT_1, QByteArray(100000, '\x55'), 50000000LL);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("ends.ch10");
+    QVERIFY(writeBytes(path, bytes));
+
+    Chapter10Reader scanned;
+    QVERIFY(scanned.loadChannels(path));
+
+    Chapter10Reader reader;
+    QVERIFY(reader.loadTimeRange(path));
+    QCOMPARE(reader.m_relative_start_time, static_cast<int64_t>(10000000LL));
+    QCOMPARE(reader.m_relative_stop_time, static_cast<int64_t>(40000000LL));
+    QCOMPARE(reader.m_relative_start_time, scanned.m_relative_start_time);
+    QCOMPARE(reader.m_relative_stop_time, scanned.m_relative_stop_time);
+    QCOMPARE(reader.getStopSecond(), scanned.getStopSecond());
+    QVERIFY(reader.m_channel_data.isEmpty());
+
+    // The catalog moves over; the times stay
+    reader.takeChannels(scanned);
+    QCOMPARE(reader.m_channel_data.size(), 3);
+    QCOMPARE(reader.getCurrentPCMChannelID(), 3);
+    QVERIFY(scanned.m_channel_data.isEmpty());
+    QCOMPARE(scanned.getCurrentPCMChannelID(), -1);
+    QCOMPARE(reader.m_relative_stop_time, static_cast<int64_t>(40000000LL));
+}
+
+void TestChapter10Reader::loadTimeRangeReturnsFalseWithoutTimePacket()
+{
+    QByteArray bytes = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray("G\\DSI\\N:0;\r\n"));
+    bytes += makePacket(3, I106CH10_DTYPE_PCM_FMT_1, QByteArray(200, '\x55'));
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.filePath("no_time.ch10");
+    QVERIFY(writeBytes(path, bytes));
+
+    Chapter10Reader reader;
+    QVERIFY(!reader.loadTimeRange(path));
+    QVERIFY(!reader.loadTimeRange(dir.filePath("missing.ch10")));
+}
@@ -27,6 +27,18 @@ private slots:
 
     // v3.2 additions
     void dhmsToUInt64ComputesCorrectOffset();
+
+    // Header-only scan and packet index sidecar
+    void loadChannelsCountsPacketsFromHeaders();
+    void loadChannelsSkipsSidecarAfterResync();
+
+    // Recording index packets
+    void loadChannelsUsesRecordingIndex();
+    void loadChannelsFallsBackFromBadRecordingIndex();
+
+    // Time range from the file ends
+    void loadTimeRangeReadsFileEnds();
+    void loadTimeRangeReturnsFalseWithoutTimePacket();
 };
 
 #endif // TST_CHAPTER10READER_H
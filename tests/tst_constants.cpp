@@ -24,9 +24,10 @@ void TestConstants::pcmNumMinorFrames()
     QCOMPARE(PCMConstants::kNumMinorFrames, 1);
 }
 
-void TestConstants::pcmTimeRoundingOffset()
+void TestConstants::pcmTickConstants()
 {
-    QCOMPARE(PCMConstants::kTimeRoundingOffset, 0.0005);
+    QCOMPARE(PCMConstants::kTicksPerSecond, static_cast<int64_t>(10000000));
+    QCOMPARE(PCMConstants::kTimeRoundingTicks, static_cast<int64_t>(5000));
 }
 
 void TestConstants::pcmChannelTypeIdentifiers()
@@ -12,7 +12,7 @@ private slots:
     void pcmDefaultFrameSync();
     void pcmCommonWordLen();
     void pcmNumMinorFrames();
-    void pcmTimeRoundingOffset();
+    void pcmTickConstants();
     void pcmChannelTypeIdentifiers();
     void uiDefaultReceiverCount();
     void uiDefaultChannelsPerReceiver();
@@ -0,0 +1,127 @@
+/**
+ * @file tst_csvrowwriter.cpp
+ * @brief Implementation of CsvRowWriter unit tests.
+ */
+
+#include "tst_csvrowwriter.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <QBuffer>
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include "constants.h"
+#include "csvrowwriter.h"
+
+namespace {
+    /// Ticks of day @p yday (0-based) at @p hh:@p mm:@p ss.@p ms in 1970.
+    int64_t ticksAt(int yday, int hh, int mm, int ss, int ms)
+    {
+        const int64_t seconds = (yday * 86400LL) + (hh * 3600LL) + (mm * 60LL) + ss;
+        return (seconds * PCMConstants::kTicksPerSecond) + (ms * PCMConstants::kTicksPerMillisecond);
+    }
+}
+
+void TestCsvRowWriter::rowFormat()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        CsvRowWriter writer(buffer);
+        const double sums[] = { 42.0, -7.5, 1.0 / 3.0 };
+        writer.writeRow(ticksAt(44, 10, 30, 15, 250), sums, 3, 1);
+        writer.writeRow(ticksAt(0, 0, 0, 1, 7), sums, 1, 4);
+        QCOMPARE(writer.rowsWritten(), static_cast<uint64_t>(2));
+    }
+    QCOMPARE(buffer.data(), QByteArray("45,10:30:15.250,42,-7.5,0.333333\n"
+                                       "1,00:00:01.007,10.5\n"));
+}
+
+void TestCsvRowWriter::prefixFollowsRoundedSecond()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    CsvRowWriter writer(buffer);
+    const double sum = 1.0;
+
+    // 0.5 ms below the next second rounds up into it (and across midnight)
+    const int64_t last = ticksAt(364, 23, 59, 59, 999);
+    writer.writeRow(last, &sum, 1, 1);
+    writer.writeRow(last + PCMConstants::kTimeRoundingTicks - 1, &sum, 1, 1);
+    writer.writeRow(last + PCMConstants::kTimeRoundingTicks, &sum, 1, 1);
+    writer.writeRow(ticksAt(364, 23, 59, 58, 0), &sum, 1, 1);
+    QVERIFY(writer.flush());
+
+    QCOMPARE(buffer.data(), QByteArray("365,23:59:59.999,1\n"
+                                       "365,23:59:59.999,1\n"
+                                       "1,00:00:00.000,1\n"
+                                       "365,23:59:58.000,1\n"));
+}
+
+void TestCsvRowWriter::valuesMatchQStringNumber()
+{
+    std::vector<double> values = {
+        0.0, -0.0, 1e-300, 123456.5, 999999.5, 1e6, 0.0001, 0.00001, 1e21, -3.25,
+        std::numeric_limits<double>::quiet_NaN(),
+        std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(),
+        std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::max()
+    };
+    QRandomGenerator rng(13);
+    for (int i = 0; i < 2000; i++)
+    {
+        values.push_back(std::ldexp(static_cast<double>(static_cast<int32_t>(rng.generate())),
+                                    rng.bounded(-60, 40)));
+        const quint64 bits = rng.generate64();
+        double raw = 0;
+        std::memcpy(&raw, &bits, sizeof(raw));
+        values.push_back(raw);
+    }
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    CsvRowWriter writer(buffer);
+    QByteArray expected;
+    const int64_t time_ticks = ticksAt(100, 12, 0, 0, 0);
+    for (size_t v = 0; v < values.size(); v++)
+    {
+        const int n_samples = static_cast<int>(v % 5) + 1;
+        writer.writeRow(time_ticks, &values[v], 1, n_samples);
+        expected += "101,12:00:00.000," + QString::number(values[v] / n_samples).toUtf8() + '\n';
+    }
+    QVERIFY(writer.flush());
+    QCOMPARE(buffer.data(), expected);
+}
+
+void TestCsvRowWriter::writesInBlocks()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    const QByteArray row("1,00:00:00.000,2\n");
+    const double sum = 2.0;
+    CsvRowWriter writer(buffer, 4 * row.size());
+
+    // Rows stay buffered until the threshold is reached, then go out together
+    for (int i = 0; i < 3; i++)
+    {
+        writer.writeRow(0, &sum, 1, 1);
+    }
+    QVERIFY(buffer.data().isEmpty());
+    writer.writeRow(0, &sum, 1, 1);
+    QCOMPARE(buffer.data().size(), 4 * row.size());
+
+    writer.writeRow(0, &sum, 1, 1);
+    QCOMPARE(buffer.data().size(), 4 * row.size());
+    QVERIFY(writer.flush());
+    QCOMPARE(buffer.data(), row.repeated(5));
+    QCOMPARE(writer.rowsWritten(), static_cast<uint64_t>(5));
+
+    // Nothing buffered: flushing again writes nothing
+    QVERIFY(writer.flush());
+    QCOMPARE(buffer.data().size(), 5 * row.size());
+}
@@ -0,0 +1,22 @@
+/**
+ * @file tst_csvrowwriter.h
+ * @brief Unit tests for CsvRowWriter — row format, value formatting and block writes.
+ */
+
+#ifndef TST_CSVROWWRITER_H
+#define TST_CSVROWWRITER_H
+
+#include <QObject>
+
+class TestCsvRowWriter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void rowFormat();
+    void prefixFollowsRoundedSecond();
+    void valuesMatchQStringNumber();
+    void writesInBlocks();
+};
+
+#endif // TST_CSVROWWRITER_H
@@ -0,0 +1,118 @@
+/**
+ * @file tst_extractionplan.cpp
+ * @brief Implementation of ExtractionPlan unit tests.
+ */
+
+#include "tst_extractionplan.h"
+
+#include <vector>
+
+#include <QtTest>
+
+#include "extractionplan.h"
+
+namespace {
+    constexpr uint32_t kWordLen = 16;
+    constexpr uint32_t kWordsInFrame = 49;
+    constexpr uint64_t kWordMask = 0xFFFF;
+}
+
+void TestExtractionPlan::dataWordCountEdgeCases()
+{
+    QCOMPARE(ExtractionPlan::dataWordCount(kWordsInFrame, kWordLen), kWordsInFrame - 1);
+    QCOMPARE(ExtractionPlan::dataWordCount(2, kWordLen), 1U);
+    // A one-word frame only stores its slot when words are a single bit long
+    QCOMPARE(ExtractionPlan::dataWordCount(1, kWordLen), 0U);
+    QCOMPARE(ExtractionPlan::dataWordCount(1, 1), 1U);
+    QCOMPARE(ExtractionPlan::dataWordCount(1, 0), 1U);
+    QCOMPARE(ExtractionPlan::dataWordCount(0, kWordLen), 0U);
+}
+
+void TestExtractionPlan::compileComputesOffsetsAndMasks()
+{
+    const ExtractionPlan plan = ExtractionPlan::compile({ 0, 5, 47 }, kWordsInFrame, kWordLen, kWordMask);
+    QCOMPARE(plan.size(), static_cast<size_t>(3));
+
+    // Word k ends (k + 1) word lengths after the preceding sync bit
+    QCOMPARE(plan.field(0).end_bit, kWordLen);
+    QCOMPARE(plan.field(1).end_bit, 6 * kWordLen);
+    QCOMPARE(plan.field(2).end_bit, 48 * kWordLen);
+    QCOMPARE(plan.lastEndBit(), 48 * kWordLen);
+    for (size_t f = 0; f < plan.size(); f++)
+    {
+        QCOMPARE(plan.field(f).mask, kWordMask);
+        QCOMPARE(plan.field(f).column, static_cast<uint32_t>(f));
+    }
+
+    // Zero-length words advance one bit per word
+    const ExtractionPlan bits = ExtractionPlan::compile({ 3 }, 8, 0, 1);
+    QCOMPARE(bits.field(0).end_bit, 4U);
+}
+
+void TestExtractionPlan::compileSkipsOutOfRangeWords()
+{
+    const ExtractionPlan plan = ExtractionPlan::compile({ -1, 2, 49, 1000, 3 }, kWordsInFrame,
+                                                        kWordLen, kWordMask);
+    QCOMPARE(plan.size(), static_cast<size_t>(2));
+    QCOMPARE(plan.field(0).column, 1U);
+    QCOMPARE(plan.field(0).word, 2U);
+    QCOMPARE(plan.field(1).column, 4U);
+    QCOMPARE(plan.field(1).word, 3U);
+
+    QVERIFY(ExtractionPlan::compile({}, kWordsInFrame, kWordLen, kWordMask).isEmpty());
+    QCOMPARE(ExtractionPlan().lastEndBit(), 0U);
+}
+
+void TestExtractionPlan::compileSortsByOffset()
+{
+    // Columns listed out of frame order; duplicates keep column order
+    const ExtractionPlan plan = ExtractionPlan::compile({ 30, 4, 30, 0 }, kWordsInFrame,
+                                                        kWordLen, kWordMask);
+    QCOMPARE(plan.size(), static_cast<size_t>(4));
+    QCOMPARE(plan.field(0).column, 3U);
+    QCOMPARE(plan.field(1).column, 1U);
+    QCOMPARE(plan.field(2).column, 0U);
+    QCOMPARE(plan.field(3).column, 2U);
+    for (size_t f = 1; f < plan.size(); f++)
+    {
+        QVERIFY(plan.field(f - 1).end_bit <= plan.field(f).end_bit);
+    }
+}
+
+void TestExtractionPlan::syncSlotReadsZero()
+{
+    const ExtractionPlan plan = ExtractionPlan::compile({ 48, 10 }, kWordsInFrame, kWordLen, kWordMask);
+    QCOMPARE(plan.size(), static_cast<size_t>(2));
+    QCOMPARE(plan.field(0).word, 10U);
+    QCOMPARE(plan.field(1).word, 48U);
+    QCOMPARE(plan.field(1).mask, uint64_t{0});
+    // Ordered with the last data word so it is available once the frame is complete
+    QCOMPARE(plan.field(1).end_bit, (kWordsInFrame - 1) * kWordLen);
+}
+
+void TestExtractionPlan::allWordsFollowsFrameLayout()
+{
+    const ExtractionPlan plan = ExtractionPlan::allWords(kWordsInFrame, kWordLen, kWordMask);
+    QCOMPARE(plan.size(), static_cast<size_t>(kWordsInFrame));
+    for (uint32_t w = 0; w < kWordsInFrame; w++)
+    {
+        QCOMPARE(plan.field(w).word, w);
+        QCOMPARE(plan.field(w).column, w);
+    }
+    QCOMPARE(plan.field(kWordsInFrame - 1).mask, uint64_t{0});
+}
+
+void TestExtractionPlan::handlesHundredsOfColumns()
+{
+    // Sparse selection from a long frame: every third word of a 1024-word frame
+    std::vector<int> column_words;
+    for (int w = 1021; w >= 0; w -= 3)
+    {
+        column_words.push_back(w);
+    }
+    const ExtractionPlan plan = ExtractionPlan::compile(column_words, 1024, kWordLen, kWordMask);
+    QCOMPARE(plan.size(), column_words.size());
+    QCOMPARE(plan.field(0).word, 1U);
+    QCOMPARE(plan.field(plan.size() - 1).word, 1021U);
+    QCOMPARE(plan.field(plan.size() - 1).column, 0U);
+}
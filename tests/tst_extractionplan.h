@@ -0,0 +1,25 @@
+/**
+ * @file tst_extractionplan.h
+ * @brief Unit tests for ExtractionPlan — field offsets, masks, ordering and skipped words.
+ */
+
+#ifndef TST_EXTRACTIONPLAN_H
+#define TST_EXTRACTIONPLAN_H
+
+#include <QObject>
+
+class TestExtractionPlan : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void dataWordCountEdgeCases();
+    void compileComputesOffsetsAndMasks();
+    void compileSkipsOutOfRangeWords();
+    void compileSortsByOffset();
+    void syncSlotReadsZero();
+    void allWordsFollowsFrameLayout();
+    void handlesHundredsOfColumns();
+};
+
+#endif // TST_EXTRACTIONPLAN_H
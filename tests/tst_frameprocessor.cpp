@@ -15,10 +15,19 @@
 #include <QtTest>
 #include <QVector>
 
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "ch10packetindex.h"
+#include "ch10packetsource.h"
+#include "ch10testpackets.h"
 #include "chapter10reader.h"
 #include "constants.h"
 #include "frameprocessor.h"
 #include "framesetup.h"
+#include "i106_decode_time.h"
 
 /// Helper: resolves a path inside tests/data/ relative to the test executable.
 static QString testDataPath(const QString& filename)
@@ -28,6 +37,13 @@ static QString testDataPath(const QString& filename)
     return dir.filePath("data/" + filename);
 }
 
+/// Helper: returns the contents of @p path, or an empty array if it cannot be read.
+static QByteArray readAll(const QString& path)
+{
+    QFile f(path);
+    return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+}
+
 /// Helper: builds a ProcessingParams with common test defaults.
 static ProcessingParams makeTestParams(const QString& filename = {},
                                         int time_channel_id = -1,
@@ -63,6 +79,17 @@ static bool loadDefaultFrameSetup(FrameSetup& setup)
     return setup.tryLoadingFile(ini_path, 49);
 }
 
+/// Helper: @return An IRIG time packet on channel 1 carrying @p seconds.
+static QByteArray makeTimePacket(uint32_t seconds)
+{
+    Irig106::SuI106Ch10Header header = {};
+    Irig106::SuIrig106Time irig_time = {};
+    irig_time.ulSecs = seconds;
+    QByteArray body(64, '\0');
+    Irig106::enI106_Encode_TimeF1(&header, 0, 0, 0, &irig_time, body.data());
+    return makePacket(1, I106CH10_DTYPE_IRIG_TIME, body.left(static_cast<qsizetype>(header.ulDataLen)));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //                          CONSTRUCTOR / ABORT                               //
 ////////////////////////////////////////////////////////////////////////////////
@@ -182,13 +209,15 @@ void TestFrameProcessor::writeTimeSampleFormat()
     QFile output(out_path);
     QVERIFY(output.open(QIODevice::WriteOnly));
 
-    // writeTimeSample uses gmtime(): current_time_sample is a Unix epoch timestamp.
+    // writeTimeSample takes 100 ns ticks since the Unix epoch.
     // DOY 45 = Feb 14 (0-based tm_yday=44, +1 in output).
-    // Epoch for 1970 DOY 45, 10:30:15 = (44 * 86400) + 10*3600 + 30*60 + 15 = 3,839,415
-    double current_time_sample = (44 * 86400.0) + (10 * 3600.0) + (30 * 60.0) + 15.0;
+    // Epoch for 1970 DOY 45, 10:30:15.250 = (44 * 86400) + 10*3600 + 30*60 + 15 = 3,839,415 s + 250 ms;
+    // 0.4999 ms more still rounds down to .250
+    int64_t current_time_ticks = (((44 * 86400LL) + (10 * 3600LL) + (30 * 60LL) + 15LL) * PCMConstants::kTicksPerSecond)
+                                 + (250 * PCMConstants::kTicksPerMillisecond) + 4999;
     int n_samples = 1;
 
-    FrameProcessor::writeTimeSample(output, current_time_sample, n_samples, enabled_params);
+    FrameProcessor::writeTimeSample(output, current_time_ticks, n_samples, enabled_params);
     output.close();
 
     // Read the output and verify format
@@ -201,7 +230,7 @@ void TestFrameProcessor::writeTimeSampleFormat()
     QStringList parts = line.split(',');
     QVERIFY2(parts.size() == 3, qPrintable("Expected 3 CSV columns, got " + QString::number(parts.size())));
     QCOMPARE(parts[0], QString("45"));  // Day-of-year (tm_yday+1)
-    QVERIFY(parts[1].contains(":"));     // Time with colons
+    QCOMPARE(parts[1], QString("10:30:15.250"));
     QCOMPARE(parts[2].toDouble(), 42.0); // Averaged sample value
 }
 
@@ -225,10 +254,10 @@ void TestFrameProcessor::writeTimeSampleAveraging()
     QFile output(out_path);
     QVERIFY(output.open(QIODevice::WriteOnly));
 
-    double current_time_sample = (44 * 86400.0) + (10 * 3600.0) + (30 * 60.0) + 15.0;
+    int64_t current_time_ticks = ((44 * 86400LL) + (10 * 3600LL) + (30 * 60LL) + 15LL) * PCMConstants::kTicksPerSecond;
     int n_samples = 10;  // Average should be 100.0 / 10 = 10.0
 
-    FrameProcessor::writeTimeSample(output, current_time_sample, n_samples, enabled_params);
+    FrameProcessor::writeTimeSample(output, current_time_ticks, n_samples, enabled_params);
     output.close();
 
     QFile result_file(out_path);
@@ -383,6 +412,49 @@ void TestFrameProcessor::processInvalidPcmChannel()
     QCOMPARE(finished_spy.last().at(0).toBool(), false);
 }
 
+void TestFrameProcessor::processRejectsRateBelowMinimum()
+{
+    // Zero, negative and sub-millihertz rates would all bin into nothing
+    for (const double rate : {0.0, -1.0, 0.0004})
+    {
+        FrameProcessor fp;
+        QSignalSpy error_spy(&fp, &FrameProcessor::errorOccurred);
+        QSignalSpy finished_spy(&fp, &FrameProcessor::processingFinished);
+
+        FrameSetup setup;
+        ProcessingParams p = makeTestParams("dummy.ch10", 1, 1);
+        p.outfile = "output.csv";
+        p.start_seconds = 0;
+        p.stop_seconds = 100;
+        p.sample_rate = 1;
+        p.extra_rates.push_back({rate, "output_low.csv"});
+        bool result = fp.process(p, &setup);
+        QVERIFY(!result);
+        QCOMPARE(error_spy.size(), 1);
+        QVERIFY(error_spy.first().at(0).toString().startsWith("Sample rate must be at least"));
+        QVERIFY(!finished_spy.isEmpty());
+        QCOMPARE(finished_spy.last().at(0).toBool(), false);
+    }
+}
+
+void TestFrameProcessor::processRejectsUnorderedWindows()
+{
+    FrameProcessor fp;
+    QSignalSpy error_spy(&fp, &FrameProcessor::errorOccurred);
+    QSignalSpy finished_spy(&fp, &FrameProcessor::processingFinished);
+
+    FrameSetup setup;
+    ProcessingParams p = makeTestParams("dummy.ch10", 1, 1);
+    p.sample_rate = 1;
+    p.windows.push_back({50, 60, "window_0.csv"});
+    p.windows.push_back({10, 20, "window_1.csv"});
+    bool result = fp.process(p, &setup);
+    QVERIFY(!result);
+    QVERIFY(!error_spy.isEmpty());
+    QVERIFY(!finished_spy.isEmpty());
+    QCOMPARE(finished_spy.last().at(0).toBool(), false);
+}
+
 void TestFrameProcessor::processInvalidFile()
 {
     FrameProcessor fp;
@@ -591,8 +663,12 @@ static bool setupParams(FrameSetup& setup, double slope, double offset)
 }
 
 /// Helper: runs process() on the RNRZ-L test file and returns the output path,
-/// or empty string on failure or skip.
-static QString runProcess(FrameSetup& setup, const QString& out_path)
+/// or empty string on failure or skip. The run starts out serial, word-parallel,
+/// at 1 Hz over the whole file; @p adjust may change any parameter, and sees the
+/// file's bounds in start_seconds / stop_seconds. Extra channels left at
+/// pcm_channel_id -1 get the primary channel's layout.
+static QString runProcess(FrameSetup& setup, const QString& out_path,
+                          const std::function<void(ProcessingParams&)>& adjust = {})
 {
     QString filepath = testDataPath("rnrz-l_testfile.ch10");
     if (!QFileInfo::exists(filepath))
@@ -625,6 +701,25 @@ static QString runProcess(FrameSetup& setup, const QString& out_path)
     p.stop_seconds = stop_secs;
     p.sample_rate = 1;
     p.is_randomized = true;
+    p.sync_engine = SyncEngine::WordParallel;
+    p.decode_threads = 1;
+    if (adjust)
+    {
+        adjust(p);
+    }
+    for (auto& channel : p.extra_pcm_channels)
+    {
+        // Same layout as the primary channel unless the caller set one
+        if (channel.pcm_channel_id < 0)
+        {
+            channel.pcm_channel_id = pcm_id;
+            channel.frame_sync = p.frame_sync;
+            channel.sync_pattern_length = sync_len;
+            channel.words_in_minor_frame = words_in_frame;
+            channel.bits_in_minor_frame = bits_in_frame;
+            channel.is_randomized = true;
+        }
+    }
 
     FrameProcessor fp;
     bool ok = fp.process(p, &setup);
@@ -771,3 +866,337 @@ void TestFrameProcessor::processNegativeSlopeNegatesValues()
     QVERIFY2(qAbs(val_neg + val_pos) < 1e-6,
              qPrintable(QString("Expected val_neg (%1) = -val_pos (%2)").arg(val_neg).arg(val_pos)));
 }
+
+void TestFrameProcessor::processSyncEnginesMatch()
+{
+    // The word-parallel synchronizer must reproduce the bit-serial CSV exactly.
+    QString filepath = testDataPath("rnrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("RNRZ-L test file not available");
+
+    QTemporaryDir temp_dir;
+    QVERIFY(temp_dir.isValid());
+
+    FrameSetup setup_serial;
+    if (!setupParams(setup_serial, 1.0, 0.0))
+        QSKIP("Could not load default frame setup");
+    QString path_serial = runProcess(setup_serial, temp_dir.path() + "/serial.csv",
+                                     [](ProcessingParams& p) { p.sync_engine = SyncEngine::BitSerial; });
+    QVERIFY2(!path_serial.isEmpty(), "bit-serial run should succeed");
+
+    FrameSetup setup_parallel;
+    QVERIFY(setupParams(setup_parallel, 1.0, 0.0));
+    QString path_parallel = runProcess(setup_parallel, temp_dir.path() + "/parallel.csv");
+    QVERIFY2(!path_parallel.isEmpty(), "word-parallel run should succeed");
+
+    QCOMPARE(readAll(path_parallel), readAll(path_serial));
+}
+
+void TestFrameProcessor::processParallelDecodeMatchesSerial()
+{
+    // Small chunks force many packet-aligned edges through the ordered merge.
+    QString filepath = testDataPath("rnrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("RNRZ-L test file not available");
+
+    QTemporaryDir temp_dir;
+    QVERIFY(temp_dir.isValid());
+
+    FrameSetup setup_serial;
+    if (!setupParams(setup_serial, 1.0, 0.0))
+        QSKIP("Could not load default frame setup");
+    QString path_serial = runProcess(setup_serial, temp_dir.path() + "/serial.csv");
+    QVERIFY2(!path_serial.isEmpty(), "serial run should succeed");
+
+    constexpr uint64_t kSmallChunkBytes = 64 * 1024;
+    FrameSetup setup_chunked;
+    QVERIFY(setupParams(setup_chunked, 1.0, 0.0));
+    QString path_chunked = runProcess(setup_chunked, temp_dir.path() + "/chunked.csv", [](ProcessingParams& p) {
+        p.decode_threads = 4;
+        p.parallel_chunk_bytes = kSmallChunkBytes;
+    });
+    QVERIFY2(!path_chunked.isEmpty(), "parallel run should succeed");
+
+    QCOMPARE(readAll(path_chunked), readAll(path_serial));
+}
+
+void TestFrameProcessor::processPacketSourcesMatch()
+{
+    // Mapped views, prefetched blocks and irig106 reads must feed identical packets,
+    // whether or not the backend can take the parallel decode path
+    QString filepath = testDataPath("rnrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("RNRZ-L test file not available");
+
+    QTemporaryDir temp_dir;
+    QVERIFY(temp_dir.isValid());
+
+    QByteArray expected;
+    constexpr uint64_t kSmallChunkBytes = 64 * 1024;
+    for (const auto backend : {Ch10PacketSource::Backend::Mapped, Ch10PacketSource::Backend::Prefetched,
+                               Ch10PacketSource::Backend::Library})
+    {
+        for (const int threads : {1, 4})
+        {
+            FrameSetup setup;
+            if (!setupParams(setup, 1.0, 0.0))
+                QSKIP("Could not load default frame setup");
+            const QString name = Ch10PacketSource::backendName(backend) + QString(" on %1 thread(s)").arg(threads);
+            QString path = runProcess(setup, temp_dir.path() + "/" + QString::number(static_cast<int>(backend)) +
+                                          "_" + QString::number(threads) + ".csv",
+                                      [&](ProcessingParams& p) {
+                                          p.decode_threads = threads;
+                                          p.parallel_chunk_bytes = kSmallChunkBytes;
+                                          p.packet_source = backend;
+                                      });
+            QVERIFY2(!path.isEmpty(), qPrintable(name + " run should succeed"));
+
+            const QByteArray output = readAll(path);
+            if (expected.isEmpty())
+            {
+                expected = output;
+            }
+            QVERIFY2(output == expected, qPrintable(name + " output differs"));
+        }
+    }
+}
+
+void TestFrameProcessor::processMultiChannelMatchesSingleRuns()
+{
+    // The test file has one PCM channel; decoding it twice in one pass with
+    // different calibrations must reproduce both single-channel outputs.
+    QString filepath = testDataPath("rnrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("RNRZ-L test file not available");
+
+    QTemporaryDir temp_dir;
+    QVERIFY(temp_dir.isValid());
+
+    FrameSetup setup1;
+    if (!setupParams(setup1, 1.0, 0.0))
+        QSKIP("Could not load default frame setup");
+    FrameSetup setup2;
+    QVERIFY(setupParams(setup2, 2.0, 5.0));
+
+    QString single1 = runProcess(setup1, temp_dir.path() + "/single1.csv");
+    QString single2 = runProcess(setup2, temp_dir.path() + "/single2.csv");
+    QVERIFY2(!single1.isEmpty() && !single2.isEmpty(), "single-channel runs should succeed");
+
+    constexpr uint64_t kSmallChunkBytes = 64 * 1024;
+    for (int threads : {1, 4})
+    {
+        PcmChannelParams extra;
+        extra.frame_setup = &setup2;
+        extra.outfile = temp_dir.path() + QString("/multi2_%1.csv").arg(threads);
+        QString multi1 = runProcess(setup1, temp_dir.path() + QString("/multi1_%1.csv").arg(threads),
+                                    [&](ProcessingParams& p) {
+                                        p.decode_threads = threads;
+                                        p.parallel_chunk_bytes = kSmallChunkBytes;
+                                        p.extra_pcm_channels = {extra};
+                                    });
+        QVERIFY2(!multi1.isEmpty(), "multi-channel run should succeed");
+
+        QCOMPARE(readAll(multi1), readAll(single1));
+        QCOMPARE(readAll(extra.outfile), readAll(single2));
+    }
+}
+
+void TestFrameProcessor::processMultiRateMatchesSingleRuns()
+{
+    // One decode feeding 1 Hz, 10 Hz and 0.5 Hz outputs must reproduce the
+    // three single-rate runs byte for byte.
+    QString filepath = testDataPath("rnrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("RNRZ-L test file not available");
+
+    QTemporaryDir temp_dir;
+    QVERIFY(temp_dir.isValid());
+
+    FrameSetup setup;
+    if (!setupParams(setup, 1.0, 0.0))
+        QSKIP("Could not load default frame setup");
+
+    const QVector<double> rates = {1.0, 10.0, 0.5};
+    QVector<QString> singles;
+    for (double rate : rates)
+    {
+        singles.push_back(runProcess(setup, temp_dir.path() + QString("/single_%1.csv").arg(rate),
+                                     [rate](ProcessingParams& p) { p.sample_rate = rate; }));
+        QVERIFY2(!singles.back().isEmpty(), "single-rate run should succeed");
+    }
+
+    constexpr uint64_t kSmallChunkBytes = 64 * 1024;
+    for (int threads : {1, 4})
+    {
+        QVector<RateOutput> extra_rates;
+        for (int r = 1; r < rates.size(); r++)
+        {
+            extra_rates.push_back({rates[r], temp_dir.path() + QString("/multi_%1_%2.csv").arg(rates[r]).arg(threads)});
+        }
+        QString multi = runProcess(setup, temp_dir.path() + QString("/multi_1_%1.csv").arg(threads),
+                                   [&](ProcessingParams& p) {
+                                       p.decode_threads = threads;
+                                       p.parallel_chunk_bytes = kSmallChunkBytes;
+                                       p.sample_rate = rates[0];
+                                       p.extra_rates = extra_rates;
+                                   });
+        QVERIFY2(!multi.isEmpty(), "multi-rate run should succeed");
+
+        QCOMPARE(readAll(multi), readAll(singles[0]));
+        for (int r = 1; r < rates.size(); r++)
+        {
+            QCOMPARE(readAll(extra_rates[r - 1].outfile), readAll(singles[r]));
+        }
+    }
+}
+
+void TestFrameProcessor::processWindowMatchesFullRun()
+{
+    // A window read from its own start must reproduce the full run's rows for it
+    QString filepath = testDataPath("rnrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("RNRZ-L test file not available");
+
+    QTemporaryDir temp_dir;
+    QVERIFY(temp_dir.isValid());
+
+    FrameSetup setup;
+    if (!setupParams(setup, 1.0, 0.0))
+        QSKIP("Could not load default frame setup");
+    const QByteArray full = readAll(runProcess(setup, temp_dir.path() + "/full.csv"));
+    QVERIFY2(!full.isEmpty(), "full run should succeed");
+
+    for (int threads : {1, 4})
+    {
+        // Two seconds starting one second into the file
+        const QString window_path = runProcess(setup, temp_dir.path() + QString("/window_%1.csv").arg(threads),
+                                               [threads](ProcessingParams& p) {
+                                                   p.decode_threads = threads;
+                                                   p.parallel_chunk_bytes = 64 * 1024;
+                                                   p.start_seconds += 1;
+                                                   p.stop_seconds = std::min(p.start_seconds + 2, p.stop_seconds);
+                                               });
+        QVERIFY2(!window_path.isEmpty(), "windowed run should succeed");
+        const QByteArray window = readAll(window_path);
+        const QByteArray rows = window.mid(window.indexOf('\n') + 1);
+        QVERIFY(!rows.isEmpty());
+        QVERIFY2(full.contains(rows), "windowed rows should match the full run's rows");
+    }
+}
+
+void TestFrameProcessor::processWindowsMatchSingleRuns()
+{
+    // The first window of a pass is read like a run of its own; a window
+    // sharing the pass continues the full run's decode
+    QString filepath = testDataPath("rnrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("RNRZ-L test file not available");
+
+    QTemporaryDir temp_dir;
+    QVERIFY(temp_dir.isValid());
+
+    FrameSetup setup;
+    if (!setupParams(setup, 1.0, 0.0))
+        QSKIP("Could not load default frame setup");
+    const QByteArray full = readAll(runProcess(setup, temp_dir.path() + "/full.csv"));
+    QVERIFY2(!full.isEmpty(), "full run should succeed");
+    const QByteArray first = readAll(runProcess(setup, temp_dir.path() + "/first.csv", [](ProcessingParams& p) {
+        p.start_seconds += 1;
+        p.stop_seconds = std::min(p.start_seconds + 1, p.stop_seconds);
+    }));
+    QVERIFY2(!first.isEmpty(), "single-window run should succeed");
+
+    for (int threads : {1, 4})
+    {
+        const QString prefix = temp_dir.path() + QString("/window_%1_").arg(threads);
+        const QString path = runProcess(setup, temp_dir.path() + "/unused.csv", [&](ProcessingParams& p) {
+            p.decode_threads = threads;
+            p.parallel_chunk_bytes = 64 * 1024;
+            // Windows one and three seconds into the file
+            const uint64_t t0 = p.start_seconds;
+            p.windows = {{t0 + 1, t0 + 2, prefix + "0.csv"}, {t0 + 3, t0 + 4, prefix + "1.csv"}};
+        });
+        QVERIFY2(!path.isEmpty(), "multi-window run should succeed");
+        QCOMPARE(readAll(prefix + "0.csv"), first);
+
+        const QByteArray second = readAll(prefix + "1.csv");
+        const QByteArray rows = second.mid(second.indexOf('\n') + 1);
+        QVERIFY(!rows.isEmpty());
+        QVERIFY2(full.contains(rows), "a window sharing a pass should match the full run's rows");
+    }
+}
+
+void TestFrameProcessor::planWindowPassesMergesNearbyWindows()
+{
+    const uint64_t gap = PCMConstants::kWindowMergeGapSeconds;
+    const QVector<TimeWindow> windows{
+        {100, 110, "a.csv"},
+        {105, 108, "b.csv"},              // inside the first
+        {110 + gap, 130, "c.csv"},        // margins meet: same pass
+        {130 + gap + 1, 140, "d.csv"},    // just too far: new pass
+        {1000, 1000, "e.csv"},
+    };
+    const auto passes = FrameProcessor::planWindowPasses(windows);
+    QCOMPARE(passes.size(), static_cast<size_t>(3));
+    QCOMPARE(passes[0].start_seconds, static_cast<uint64_t>(100));
+    QCOMPARE(passes[0].stop_seconds, static_cast<uint64_t>(130));
+    QCOMPARE(passes[0].windows, 3);
+    QCOMPARE(passes[1].start_seconds, 130 + gap + 1);
+    QCOMPARE(passes[1].stop_seconds, static_cast<uint64_t>(140));
+    QCOMPARE(passes[2].windows, 1);
+    QVERIFY(FrameProcessor::planWindowPasses({}).empty());
+}
+
+void TestFrameProcessor::findTimePacketBisectsTimePackets()
+{
+    // 120 s of one time packet and three 12 KB PCM packets per second: several
+    // MB, so the unindexed search bisects before walking
+    constexpr int kSeconds = 120;
+    QByteArray bytes = makePacket(0, I106CH10_DTYPE_TMATS, QByteArray("G\\DSI\\N:0;\r\n"));
+    std::vector<int64_t> time_offsets;
+    for (int s = 0; s < kSeconds; s++)
+    {
+        time_offsets.push_back(bytes.size());
+        bytes += makeTimePacket(static_cast<uint32_t>((45 * 86400) + s));
+        for (int p = 0; p < 3; p++)
+        {
+            bytes += makePacket(3, I106CH10_DTYPE_PCM_FMT_1, QByteArray(12000, static_cast<char>(s)));
+        }
+    }
+    QTemporaryFile file;
+    QVERIFY(file.open() && file.write(bytes) == bytes.size() && file.flush());
+    QVERIFY(bytes.size() > 2 * PCMConstants::kWindowSearchBytes);
+
+    const std::unique_ptr<Ch10PacketSource> source = Ch10PacketSource::open(file.fileName());
+    QVERIFY(source != nullptr);
+    Ch10PacketIndex index;
+    Ch10Packet packet;
+    while (source->next(packet) == Irig106::I106_OK)
+    {
+        index.append(packet);
+    }
+    QCOMPARE(index.size(), static_cast<size_t>(1 + (4 * kSeconds)));
+
+    int64_t offset = 0;
+    uint64_t first_seconds = 0;
+    QVERIFY(FrameProcessor::probeTimePacket(*source, 1, 0, source->size(), offset, first_seconds));
+    QCOMPARE(offset, time_offsets[0]);
+
+    for (const Ch10PacketIndex& search_index : {Ch10PacketIndex(), index})
+    {
+        // The last time packet at or before each target, or none before the first
+        for (int target : {-1, 0, 1, 59, 60, 119, 500})
+        {
+            const int64_t expected = (target < 0) ? -1 : time_offsets[static_cast<size_t>(std::min(target, kSeconds - 1))];
+            QCOMPARE(FrameProcessor::findTimePacket(*source, search_index, 1, first_seconds + target, 0), expected);
+        }
+
+        // Packets before the starting offset and on other channels are ignored
+        QCOMPARE(FrameProcessor::findTimePacket(*source, search_index, 1, first_seconds + 10, time_offsets[20]),
+                 static_cast<int64_t>(-1));
+        QCOMPARE(FrameProcessor::findTimePacket(*source, search_index, 1, first_seconds + 30, time_offsets[20]),
+                 time_offsets[30]);
+        QCOMPARE(FrameProcessor::findTimePacket(*source, search_index, 2, first_seconds + 30, 0),
+                 static_cast<int64_t>(-1));
+    }
+}
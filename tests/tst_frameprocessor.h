@@ -28,12 +28,23 @@ private slots:
     void preScanWithRnrzlFile();
     void processInvalidTimeChannel();
     void processInvalidPcmChannel();
+    void processRejectsRateBelowMinimum();
+    void processRejectsUnorderedWindows();
     void processInvalidFile();
     void processWithTestFile();
     void processWithNrzlFile();
     void processOutputHasDataRows();
     void processSlopeAffectsOutput();
     void processNegativeSlopeNegatesValues();
+    void processSyncEnginesMatch();
+    void processParallelDecodeMatchesSerial();
+    void processPacketSourcesMatch();
+    void processMultiChannelMatchesSingleRuns();
+    void processMultiRateMatchesSingleRuns();
+    void processWindowMatchesFullRun();
+    void processWindowsMatchSingleRuns();
+    void planWindowPassesMergesNearbyWindows();
+    void findTimePacketBisectsTimePackets();
 };
 
 #endif // TST_FRAMEPROCESSOR_H
@@ -0,0 +1,92 @@
+/**
+ * @file tst_irigtime.cpp
+ * @brief Implementation of IrigTime unit tests.
+ */
+
+#include "tst_irigtime.h"
+
+#include <QDateTime>
+#include <QRandomGenerator>
+#include <QTimeZone>
+#include <QtTest>
+
+#include "irigtime.h"
+
+// Evaluated by the compiler: the conversion must stay usable in constant expressions
+static_assert(IrigTime::toTimeFields(0).ddd == 1);
+static_assert(IrigTime::daysFromCivil(2000, 3, 1) == 11017);
+static_assert(IrigTime::dayOfYear(IrigTime::daysFromCivil(2024, 12, 31)) == 366);
+
+void TestIrigTime::knownDates()
+{
+    // Time packets without a year decode to 1971; DOY 165 10:30:15
+    const TimeFields f = IrigTime::toTimeFields((365LL + 164) * 86400 + (10 * 3600) + (30 * 60) + 15);
+    QCOMPARE(f.ddd, 165);
+    QCOMPARE(f.hh, 10);
+    QCOMPARE(f.mm, 30);
+    QCOMPARE(f.ss, 15);
+
+    // Last second of a leap year, then the first of the next
+    const int64_t new_year_2025 = IrigTime::daysFromCivil(2025, 1, 1) * IrigTime::kSecondsPerDay;
+    const TimeFields last = IrigTime::toTimeFields(new_year_2025 - 1);
+    QCOMPARE(last.ddd, 366);
+    QCOMPARE(last.hh, 23);
+    QCOMPARE(last.ss, 59);
+    QCOMPARE(IrigTime::toTimeFields(new_year_2025).ddd, 1);
+
+    // Before the epoch
+    const TimeFields before = IrigTime::toTimeFields(-1);
+    QCOMPARE(before.ddd, 365);
+    QCOMPARE(before.hh, 23);
+    QCOMPARE(before.mm, 59);
+    QCOMPARE(before.ss, 59);
+}
+
+void TestIrigTime::civilRoundTrip()
+{
+    for (int64_t days = -800000; days <= 800000; days += 37)
+    {
+        const IrigTime::CivilDate date = IrigTime::civilFromDays(days);
+        QCOMPARE(IrigTime::daysFromCivil(date.year, date.month, date.day), days);
+    }
+}
+
+void TestIrigTime::matchesQDateTimeUtc()
+{
+    QRandomGenerator rng(14);
+    for (int i = 0; i < 20000; i++)
+    {
+        // 1900 .. 2100
+        const auto seconds = static_cast<int64_t>(rng.bounded(6311390400.0)) - 2208988800LL;
+        const QDateTime utc = QDateTime::fromSecsSinceEpoch(seconds, QTimeZone::UTC);
+        const TimeFields f = IrigTime::toTimeFields(seconds);
+        QCOMPARE(f.ddd, utc.date().dayOfYear());
+        QCOMPARE(f.hh, utc.time().hour());
+        QCOMPARE(f.mm, utc.time().minute());
+        QCOMPARE(f.ss, utc.time().second());
+
+        const IrigTime::CivilDate date = IrigTime::civilFromDays(IrigTime::floorDiv(seconds, IrigTime::kSecondsPerDay));
+        QCOMPARE(date.year, static_cast<int64_t>(utc.date().year()));
+        QCOMPARE(date.month, utc.date().month());
+        QCOMPARE(date.day, utc.date().day());
+    }
+}
+
+void TestIrigTime::dayCacheMatchesDirect()
+{
+    // Mostly forward steps across day and year edges, with occasional jumps back
+    IrigTime::DayCache cache;
+    QRandomGenerator rng(1400);
+    int64_t seconds = IrigTime::daysFromCivil(1971, 12, 30) * IrigTime::kSecondsPerDay;
+    for (int i = 0; i < 50000; i++)
+    {
+        seconds += (rng.bounded(10) == 0) ? -static_cast<int64_t>(rng.bounded(200000))
+                                          : static_cast<int64_t>(rng.bounded(400));
+        const TimeFields cached = cache.fields(seconds);
+        const TimeFields direct = IrigTime::toTimeFields(seconds);
+        QCOMPARE(cached.ddd, direct.ddd);
+        QCOMPARE(cached.hh, direct.hh);
+        QCOMPARE(cached.mm, direct.mm);
+        QCOMPARE(cached.ss, direct.ss);
+    }
+}
@@ -0,0 +1,22 @@
+/**
+ * @file tst_irigtime.h
+ * @brief Unit tests for IrigTime — civil-from-days conversion and the day cache.
+ */
+
+#ifndef TST_IRIGTIME_H
+#define TST_IRIGTIME_H
+
+#include <QObject>
+
+class TestIrigTime : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void knownDates();
+    void civilRoundTrip();
+    void matchesQDateTimeUtc();
+    void dayCacheMatchesDirect();
+};
+
+#endif // TST_IRIGTIME_H
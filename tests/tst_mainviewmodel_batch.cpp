@@ -1,10 +1,19 @@
 #include "tst_mainviewmodel_batch.h"
 
+#include <QDir>
 #include <QSignalSpy>
 #include <QtTest>
 
+#include "chapter10reader.h"
 #include "mainviewmodel.h"
 
+static QString mvmTestDataPath(const QString& filename)
+{
+    QDir dir(QCoreApplication::applicationDirPath());
+    dir.cdUp();
+    return dir.filePath("data/" + filename);
+}
+
 void TestMainViewModelBatch::batchModeDefaultFalse()
 {
     MainViewModel vm;
@@ -296,3 +305,86 @@ void TestMainViewModelBatch::retryFailedFilesEmitsBatchFilesChanged()
 
     QVERIFY(spy.size() >= 1);
 }
+
+// ---------------------------------------------------------------------------
+// Background intake
+// ---------------------------------------------------------------------------
+
+void TestMainViewModelBatch::openFilesLoadsInBackground()
+{
+    // openFiles() returns with every file listed but unread; each entry is
+    // filled in as the pool finishes it.
+    const QString filepath = mvmTestDataPath("nrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("nrz-l_testfile.ch10 not available");
+
+    MainViewModel vm;
+    QSignalSpy loaded_spy(&vm, &MainViewModel::batchFileLoaded);
+    vm.openFiles({filepath, filepath});
+
+    QCOMPARE(vm.batchMode(), true);
+    QCOMPARE(vm.batchFileCount(), 2);
+    QTRY_VERIFY_WITH_TIMEOUT(!vm.batchLoading(), 10000);
+
+    QCOMPARE(loaded_spy.size(), 2);
+    QCOMPARE(vm.fileLoaded(), true);
+    for (const BatchFileInfo& info : vm.batchFiles())
+    {
+        QVERIFY(info.loaded);
+        QVERIFY(!info.pcmChannelIds.isEmpty());
+        QCOMPARE(info.pcmChannelIds.size(), info.pcmChannelStrings.size());
+    }
+}
+
+void TestMainViewModelBatch::cancelDuringIntakeSkipsUnreadFiles()
+{
+    // Cancelling the intake keeps the list: files not read yet stay as skipped.
+    const QString filepath = mvmTestDataPath("nrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("nrz-l_testfile.ch10 not available");
+
+    MainViewModel vm;
+    vm.openFiles(QStringList(8, filepath));
+    vm.cancelProcessing();
+    QTRY_VERIFY_WITH_TIMEOUT(!vm.batchLoading(), 10000);
+
+    QCOMPARE(vm.batchFileCount(), 8);
+    for (const BatchFileInfo& info : vm.batchFiles())
+    {
+        QVERIFY(info.loaded || (info.skip && info.skipReason == "Loading cancelled"));
+    }
+}
+
+void TestMainViewModelBatch::intakeCatalogMatchesReader()
+{
+    // Processing runs from the catalog taken at intake, so it must hold the
+    // channel IDs and time range a fresh catalog of the file reports.
+    const QString filepath = mvmTestDataPath("nrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+        QSKIP("nrz-l_testfile.ch10 not available");
+
+    Chapter10Reader reader;
+    QVERIFY(reader.loadChannels(filepath));
+
+    MainViewModel vm;
+    vm.openFiles({filepath, filepath});
+    QTRY_VERIFY_WITH_TIMEOUT(!vm.batchLoading(), 10000);
+
+    const BatchFileInfo& info = vm.batchFiles().at(0);
+    QCOMPARE(info.timeChannelIds.size(), info.timeChannelStrings.size());
+    for (qsizetype i = 0; i < info.timeChannelIds.size(); i++)
+    {
+        reader.timeChannelChanged(static_cast<int>(i) + 1);
+        QCOMPARE(info.timeChannelIds.at(i), reader.getCurrentTimeChannelID());
+    }
+    for (qsizetype i = 0; i < info.pcmChannelIds.size(); i++)
+    {
+        reader.pcmChannelChanged(static_cast<int>(i) + 1);
+        QCOMPARE(info.pcmChannelIds.at(i), reader.getCurrentPCMChannelID());
+    }
+    QCOMPARE(info.startSeconds, static_cast<quint64>(reader.dhmsToUInt64(
+        reader.getStartDayOfYear(), reader.getStartHour(), reader.getStartMinute(), reader.getStartSecond())));
+    QCOMPARE(info.stopSeconds, static_cast<quint64>(reader.dhmsToUInt64(
+        reader.getStopDayOfYear(), reader.getStopHour(), reader.getStopMinute(), reader.getStopSecond())));
+    QVERIFY(info.startSeconds <= info.stopSeconds);
+}
@@ -38,6 +38,11 @@ private slots:
     // Retry state correctness
     void retryFailedFilesPreservesSuccessfulFile();
     void retryFailedFilesEmitsBatchFilesChanged();
+
+    // Background intake
+    void openFilesLoadsInBackground();
+    void cancelDuringIntakeSkipsUnreadFiles();
+    void intakeCatalogMatchesReader();
 };
 
 #endif // TST_MAINVIEWMODEL_BATCH_H
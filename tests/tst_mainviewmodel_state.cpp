@@ -514,6 +514,7 @@ void TestMainViewModelState::startProcessingErrorIfNoReceiversSelected()
 
     MainViewModel vm;
     vm.openFile(filepath);
+    QTRY_VERIFY_WITH_TIMEOUT(!vm.channelsLoading(), 10000);
     if (!vm.fileLoaded())
         QSKIP("Could not load nrz-l_testfile.ch10");
 
@@ -544,6 +545,7 @@ void TestMainViewModelState::startProcessingAbortedIfPreScanFails()
 
     MainViewModel vm;
     vm.openFile(filepath);
+    QTRY_VERIFY_WITH_TIMEOUT(!vm.channelsLoading(), 10000);
     if (!vm.fileLoaded())
         QSKIP("Could not load nrz-l_testfile.ch10");
 
@@ -0,0 +1,848 @@
+/**
+ * @file tst_pcmframesync.cpp
+ * @brief Implementation of PcmFrameSynchronizer unit tests.
+ */
+
+#include "tst_pcmframesync.h"
+
+#include <utility>
+#include <vector>
+
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include "pcmframesync.h"
+
+namespace {
+    constexpr uint64_t kSyncPattern = 0xFE6B2840;
+    constexpr uint32_t kSyncLen = 32;
+    constexpr uint32_t kWordLen = 16;
+    constexpr uint32_t kWordsInFrame = 49;
+    constexpr uint32_t kBitsInFrame = ((kWordsInFrame - 1) * kWordLen) + kSyncLen;
+
+    /// Appends bits MSB-first to a byte buffer.
+    class BitWriter
+    {
+    public:
+        void append(uint64_t value, uint32_t num_bits)
+        {
+            for (uint32_t i = num_bits; i > 0; i--)
+            {
+                if (m_bit_count % 8 == 0)
+                {
+                    m_bytes.push_back(0);
+                }
+                if (((value >> (i - 1)) & 1) != 0)
+                {
+                    m_bytes.back() |= static_cast<uint8_t>(0x80 >> (m_bit_count % 8));
+                }
+                m_bit_count++;
+            }
+        }
+
+        const std::vector<uint8_t>& bytes() const { return m_bytes; }
+
+    private:
+        std::vector<uint8_t> m_bytes;
+        uint64_t m_bit_count = 0;
+    };
+
+    /// Frame layout used by the default 16-receiver setup.
+    PcmFrameSyncConfig defaultConfig()
+    {
+        PcmFrameSyncConfig config;
+        config.sync_pat = kSyncPattern;
+        config.sync_mask = 0xFFFFFFFFULL;
+        config.sync_pat_len = kSyncLen;
+        config.bits_in_frame = kBitsInFrame;
+        config.words_in_frame = kWordsInFrame;
+        config.word_len = kWordLen;
+        config.word_mask = 0xFFFF;
+        config.min_syncs = 0;
+        return config;
+    }
+
+    /// Writes one minor frame (sync + data words where word i = base + i).
+    void appendFrame(BitWriter& writer, uint64_t base, uint64_t sync = kSyncPattern)
+    {
+        writer.append(sync, kSyncLen);
+        for (uint32_t w = 0; w < kWordsInFrame - 1; w++)
+        {
+            writer.append((base + w) & 0xFFFF, kWordLen);
+        }
+    }
+
+    /// Captured output of one synchronizer run.
+    struct SyncResult
+    {
+        std::vector<uint64_t> end_bits;
+        std::vector<uint64_t> words;
+        uint64_t total_syncs = 0;
+        uint64_t lock_count = 0;
+        uint64_t unlock_count = 0;
+        uint64_t missed_syncs = 0;
+    };
+
+    /// Feeds @p bytes in the given packet sizes (cycled) and collects every frame.
+    SyncResult runSync(const PcmFrameSyncConfig& config, SyncEngine engine,
+                       const std::vector<uint8_t>& bytes, const std::vector<size_t>& splits,
+                       const ExtractionPlan* plan = nullptr)
+    {
+        PcmFrameSynchronizer sync(config, engine);
+        if (plan != nullptr)
+        {
+            sync.setExtractionPlan(*plan);
+        }
+        SyncResult result;
+        size_t pos = 0;
+        size_t split_idx = 0;
+        while (pos < bytes.size())
+        {
+            size_t len = splits.empty() ? bytes.size() : splits[split_idx++ % splits.size()];
+            len = qMin(len, bytes.size() - pos);
+            sync.processPacket(bytes.data() + pos, len);
+            pos += len;
+            for (size_t f = 0; f < sync.frameCount(); f++)
+            {
+                result.end_bits.push_back(sync.frameEndBit(f));
+                const uint64_t* words = sync.frameWords(f);
+                result.words.insert(result.words.end(), words, words + sync.frameWidth());
+            }
+        }
+        result.total_syncs = sync.totalSyncs();
+        result.lock_count = sync.lockCount();
+        result.unlock_count = sync.unlockCount();
+        result.missed_syncs = sync.missedSyncs();
+        return result;
+    }
+
+    /// Config for a frame of @p words_in_frame words of @p word_len bits after a @p sync_len-bit sync.
+    PcmFrameSyncConfig geometryConfig(uint32_t sync_len, uint32_t word_len, uint32_t words_in_frame)
+    {
+        PcmFrameSyncConfig config;
+        config.sync_pat_len = sync_len;
+        config.sync_mask = (1ULL << sync_len) - 1;
+        config.sync_pat = kSyncPattern & config.sync_mask;
+        config.word_len = word_len;
+        config.word_mask = (1ULL << word_len) - 1;
+        config.words_in_frame = words_in_frame;
+        config.bits_in_frame = sync_len + ((words_in_frame - 1) * word_len);
+        config.lock_misses = 3;
+        return config;
+    }
+
+    /// Clean stream of @p num_frames frames with random data words (plus a closing sync).
+    std::vector<uint8_t> cleanStream(const PcmFrameSyncConfig& config, int num_frames, QRandomGenerator& rng)
+    {
+        BitWriter writer;
+        for (int f = 0; f < num_frames; f++)
+        {
+            writer.append(config.sync_pat, config.sync_pat_len);
+            for (uint32_t w = 0; w + 1 < config.words_in_frame; w++)
+            {
+                writer.append(rng.generate64(), config.word_len);
+            }
+        }
+        writer.append(config.sync_pat, config.sync_pat_len);
+        return writer.bytes();
+    }
+
+    /// Inverse of RNRZ-L descrambling: out[t] = in[t] ^ out[t-14] ^ out[t-15].
+    std::vector<uint8_t> scramble(const std::vector<uint8_t>& bytes)
+    {
+        std::vector<uint8_t> out(bytes.size(), 0);
+        uint32_t history = 0;
+        for (size_t t = 0; t < bytes.size() * 8; t++)
+        {
+            const uint32_t in = (bytes[t / 8] >> (7 - (t % 8))) & 1;
+            const uint32_t bit = in ^ ((history >> 13) & 1) ^ ((history >> 14) & 1);
+            history = ((history << 1) | bit) & 0x7FFF;
+            if (bit != 0)
+            {
+                out[t / 8] |= static_cast<uint8_t>(0x80 >> (t % 8));
+            }
+        }
+        return out;
+    }
+
+    /// Swaps byte pairs of every even-length packet, as the recorder does.
+    void swapPairs(std::vector<uint8_t>& bytes, const std::vector<size_t>& splits)
+    {
+        size_t pos = 0;
+        size_t split_idx = 0;
+        while (pos < bytes.size())
+        {
+            const size_t len = qMin(splits[split_idx++ % splits.size()], bytes.size() - pos);
+            if (len % 2 == 0)
+            {
+                for (size_t i = 0; i < len; i += 2)
+                {
+                    std::swap(bytes[pos + i], bytes[pos + i + 1]);
+                }
+            }
+            pos += len;
+        }
+    }
+}
+
+void TestPcmFrameSync::engineNames()
+{
+    QCOMPARE(QString(PcmFrameSynchronizer::engineName(SyncEngine::BitSerial)), QString("bit-serial"));
+    QCOMPARE(QString(PcmFrameSynchronizer::engineName(SyncEngine::WordParallel)), QString("word-parallel"));
+}
+
+void TestPcmFrameSync::extractsFramesAtExactSpacing()
+{
+    BitWriter writer;
+    const int num_frames = 10;
+    for (int f = 0; f < num_frames; f++)
+    {
+        appendFrame(writer, static_cast<uint64_t>(f) * 100);
+    }
+    // Trailing sync closes the last frame
+    writer.append(kSyncPattern, kSyncLen);
+
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        SyncResult r = runSync(defaultConfig(), engine, writer.bytes(), {});
+        QCOMPARE(r.total_syncs, static_cast<uint64_t>(num_frames + 1));
+        // The first sync only opens a frame; every later one closes one
+        QCOMPARE(r.end_bits.size(), static_cast<size_t>(num_frames));
+        for (int f = 0; f < num_frames; f++)
+        {
+            QCOMPARE(r.end_bits[f], static_cast<uint64_t>(((f + 1) * kBitsInFrame) + kSyncLen - 1));
+            QCOMPARE(r.words[(f * kWordsInFrame)], static_cast<uint64_t>(f) * 100);
+            QCOMPARE(r.words[(f * kWordsInFrame) + kWordsInFrame - 2],
+                     (static_cast<uint64_t>(f) * 100) + kWordsInFrame - 2);
+            // The sync slot at the end of the word array is never written
+            QCOMPARE(r.words[(f * kWordsInFrame) + kWordsInFrame - 1], uint64_t{0});
+        }
+    }
+}
+
+void TestPcmFrameSync::minSyncsDelaysFirstFrame()
+{
+    BitWriter writer;
+    for (int f = 0; f < 6; f++)
+    {
+        appendFrame(writer, 0);
+    }
+    writer.append(kSyncPattern, kSyncLen);
+
+    PcmFrameSyncConfig config = defaultConfig();
+    config.min_syncs = 3;
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        SyncResult r = runSync(config, engine, writer.bytes(), {});
+        // Spaced syncs are counted from zero, so frames 0..2 are held back
+        QCOMPARE(r.end_bits.size(), static_cast<size_t>(3));
+    }
+}
+
+void TestPcmFrameSync::misplacedSyncDropsFrame()
+{
+    BitWriter writer;
+    appendFrame(writer, 0);
+    appendFrame(writer, 0);
+    writer.append(0x5, 3);  // slip the stream by three bits
+    appendFrame(writer, 0);
+    appendFrame(writer, 0);
+    writer.append(kSyncPattern, kSyncLen);
+
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        SyncResult r = runSync(defaultConfig(), engine, writer.bytes(), {});
+        QCOMPARE(r.total_syncs, uint64_t{5});
+        QCOMPARE(r.end_bits.size(), static_cast<size_t>(3));
+    }
+}
+
+void TestPcmFrameSync::syncSpanningPacketBoundary()
+{
+    BitWriter writer;
+    writer.append(0, 13);  // misalign the first sync relative to byte boundaries
+    for (int f = 0; f < 4; f++)
+    {
+        appendFrame(writer, static_cast<uint64_t>(f) * 7);
+    }
+    writer.append(kSyncPattern, kSyncLen);
+    const SyncResult expected = runSync(defaultConfig(), SyncEngine::BitSerial, writer.bytes(), {});
+    QCOMPARE(expected.end_bits.size(), static_cast<size_t>(4));
+
+    for (size_t split = 1; split <= 17; split++)
+    {
+        SyncResult r = runSync(defaultConfig(), SyncEngine::WordParallel, writer.bytes(), { split });
+        QCOMPARE(r.total_syncs, expected.total_syncs);
+        QVERIFY(r.end_bits == expected.end_bits);
+        QVERIFY(r.words == expected.words);
+    }
+}
+
+void TestPcmFrameSync::patternOutsideMaskNeverMatches()
+{
+    BitWriter writer;
+    for (int f = 0; f < 3; f++)
+    {
+        appendFrame(writer, 0);
+    }
+
+    PcmFrameSyncConfig config = defaultConfig();
+    config.sync_pat = kSyncPattern | (1ULL << 40);
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        SyncResult r = runSync(config, engine, writer.bytes(), {});
+        QCOMPARE(r.total_syncs, uint64_t{0});
+        QVERIFY(r.end_bits.empty());
+    }
+}
+
+void TestPcmFrameSync::resetClearsStreamState()
+{
+    BitWriter writer;
+    appendFrame(writer, 0);
+    appendFrame(writer, 0);
+
+    PcmFrameSynchronizer sync(defaultConfig(), SyncEngine::WordParallel);
+    sync.processPacket(writer.bytes().data(), writer.bytes().size());
+    QCOMPARE(sync.totalSyncs(), uint64_t{2});
+    QVERIFY(sync.bitsProcessed() > 0);
+
+    sync.reset();
+    QCOMPARE(sync.totalSyncs(), uint64_t{0});
+    QCOMPARE(sync.bitsProcessed(), uint64_t{0});
+    QCOMPARE(sync.frameCount(), static_cast<size_t>(0));
+}
+
+void TestPcmFrameSync::enginesMatchOnRandomStreams()
+{
+    // Random frame layouts, noise bursts, bit slips and packet splits; the
+    // word-parallel engine must agree with the bit-serial reference exactly.
+    QRandomGenerator rng(1234);
+    for (int iter = 0; iter < 200; iter++)
+    {
+        PcmFrameSyncConfig config;
+        const uint32_t sync_len = (iter % 3 == 0) ? kSyncLen : 1 + rng.bounded(40U);
+        config.sync_pat_len = sync_len;
+        config.sync_mask = (1ULL << sync_len) - 1;
+        config.sync_pat = rng.generate64() & config.sync_mask;
+        config.word_len = (iter % 5 == 0) ? rng.bounded(20U) : kWordLen;
+        config.word_mask = ((1ULL << config.word_len) - 1) & config.sync_mask;
+        config.words_in_frame = (iter % 2 == 0) ? rng.bounded(8U) : kWordsInFrame;
+        const uint32_t data_words = (config.words_in_frame > 0) ? config.words_in_frame - 1 : 0;
+        config.bits_in_frame = sync_len + (data_words * qMax(config.word_len, 1U)) + rng.bounded(3U);
+        config.min_syncs = rng.bounded(3U);
+
+        BitWriter writer;
+        const uint32_t total_bits = 2000 + rng.bounded(20000U);
+        uint32_t written = 0;
+        while (written < total_bits)
+        {
+            if (rng.bounded(4U) != 0)
+            {
+                writer.append(config.sync_pat, sync_len);
+                uint32_t fill = config.bits_in_frame - sync_len;
+                if (rng.bounded(10U) == 0)
+                {
+                    fill += rng.bounded(5U);
+                }
+                for (uint32_t b = 0; b < fill; b++)
+                {
+                    writer.append(rng.bounded(2U), 1);
+                }
+                written += sync_len + fill;
+            }
+            else
+            {
+                const uint32_t noise = rng.bounded(200U);
+                for (uint32_t b = 0; b < noise; b++)
+                {
+                    writer.append(rng.bounded(2U), 1);
+                }
+                written += noise;
+            }
+        }
+
+        std::vector<size_t> splits;
+        for (int i = 0; i < 16; i++)
+        {
+            splits.push_back(1 + rng.bounded((iter % 4 == 0) ? 9U : 3000U));
+        }
+
+        const SyncResult expected = runSync(config, SyncEngine::BitSerial, writer.bytes(), splits);
+        const SyncResult actual = runSync(config, SyncEngine::WordParallel, writer.bytes(), splits);
+        QCOMPARE(actual.total_syncs, expected.total_syncs);
+        QVERIFY(actual.end_bits == expected.end_bits);
+        QVERIFY(actual.words == expected.words);
+    }
+}
+
+void TestPcmFrameSync::conditionsRawPayload()
+{
+    BitWriter writer;
+    writer.append(0, 5);
+    for (int f = 0; f < 8; f++)
+    {
+        appendFrame(writer, static_cast<uint64_t>(f) * 3);
+    }
+    writer.append(kSyncPattern, kSyncLen);
+    const SyncResult expected = runSync(defaultConfig(), SyncEngine::BitSerial, writer.bytes(), {});
+    QCOMPARE(expected.end_bits.size(), static_cast<size_t>(8));
+
+    const std::vector<size_t> splits = { 6, 1, 3, 250, 4 };
+    for (int format = 0; format < 4; format++)
+    {
+        PcmFrameSyncConfig config = defaultConfig();
+        config.swap_bytes = (format & 1) != 0;
+        config.randomized = (format & 2) != 0;
+
+        std::vector<uint8_t> raw = config.randomized ? scramble(writer.bytes()) : writer.bytes();
+        if (config.swap_bytes)
+        {
+            swapPairs(raw, splits);
+        }
+
+        for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+        {
+            SyncResult r = runSync(config, engine, raw, splits);
+            QCOMPARE(r.total_syncs, expected.total_syncs);
+            QVERIFY(r.end_bits == expected.end_bits);
+            QVERIFY(r.words == expected.words);
+        }
+    }
+}
+
+void TestPcmFrameSync::fusedConditioningMatchesBitSerial()
+{
+    // The word-parallel engine swaps and descrambles inside its packing pass;
+    // odd packet sizes and packets larger than one cache chunk are included.
+    QRandomGenerator rng(99);
+    for (int iter = 0; iter < 16; iter++)
+    {
+        BitWriter writer;
+        const int num_frames = 100 + static_cast<int>(rng.bounded(400U));
+        for (int f = 0; f < num_frames; f++)
+        {
+            appendFrame(writer, rng.generate64());
+            if (rng.bounded(8U) == 0)
+            {
+                writer.append(rng.generate64(), rng.bounded(64U));
+            }
+        }
+
+        PcmFrameSyncConfig config = defaultConfig();
+        config.swap_bytes = (iter & 1) != 0;
+        config.randomized = (iter & 2) != 0;
+
+        std::vector<size_t> splits;
+        for (int i = 0; i < 8; i++)
+        {
+            splits.push_back(1 + rng.bounded((iter % 4 == 3) ? 70000U : 5000U));
+        }
+
+        std::vector<uint8_t> raw = config.randomized ? scramble(writer.bytes()) : writer.bytes();
+        if (config.swap_bytes)
+        {
+            swapPairs(raw, splits);
+        }
+
+        const SyncResult expected = runSync(config, SyncEngine::BitSerial, raw, splits);
+        const SyncResult actual = runSync(config, SyncEngine::WordParallel, raw, splits);
+        QVERIFY(!expected.end_bits.empty());
+        QCOMPARE(actual.total_syncs, expected.total_syncs);
+        QVERIFY(actual.end_bits == expected.end_bits);
+        QVERIFY(actual.words == expected.words);
+    }
+}
+
+void TestPcmFrameSync::lockStateNames()
+{
+    QCOMPARE(QString(PcmFrameSynchronizer::lockStateName(FrameLockState::Search)), QString("search"));
+    QCOMPARE(QString(PcmFrameSynchronizer::lockStateName(FrameLockState::Check)), QString("check"));
+    QCOMPARE(QString(PcmFrameSynchronizer::lockStateName(FrameLockState::Lock)), QString("lock"));
+}
+
+void TestPcmFrameSync::lockIgnoresSyncInsideFrame()
+{
+    BitWriter writer;
+    for (int f = 0; f < 8; f++)
+    {
+        if (f == 3)
+        {
+            // Data words 10 and 11 spell the sync pattern
+            writer.append(kSyncPattern, kSyncLen);
+            for (uint32_t w = 0; w < kWordsInFrame - 1; w++)
+            {
+                writer.append((w == 10) ? 0xFE6B : ((w == 11) ? 0x2840 : 0), kWordLen);
+            }
+            continue;
+        }
+        appendFrame(writer, static_cast<uint64_t>(f) * 100);
+    }
+    writer.append(kSyncPattern, kSyncLen);
+
+    PcmFrameSyncConfig locked = defaultConfig();
+    locked.lock_misses = 3;
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        // Searching every bit, the false sync splits frame 3 and drops it
+        SyncResult search = runSync(defaultConfig(), engine, writer.bytes(), { 100 });
+        QCOMPARE(search.total_syncs, uint64_t{10});
+        QCOMPARE(search.end_bits.size(), static_cast<size_t>(7));
+        QCOMPARE(search.lock_count, uint64_t{0});
+
+        SyncResult lock = runSync(locked, engine, writer.bytes(), { 100 });
+        QCOMPARE(lock.total_syncs, uint64_t{9});
+        QCOMPARE(lock.end_bits.size(), static_cast<size_t>(8));
+        QCOMPARE(lock.words[(3 * kWordsInFrame) + 10], uint64_t{0xFE6B});
+        QCOMPARE(lock.lock_count, uint64_t{1});
+        QCOMPARE(lock.unlock_count, uint64_t{0});
+        QCOMPARE(lock.missed_syncs, uint64_t{0});
+    }
+}
+
+void TestPcmFrameSync::lockFlywheelsOverMissedSync()
+{
+    BitWriter writer;
+    for (int f = 0; f < 8; f++)
+    {
+        appendFrame(writer, static_cast<uint64_t>(f) * 100, (f == 4) ? (kSyncPattern ^ 1) : kSyncPattern);
+    }
+    writer.append(kSyncPattern, kSyncLen);
+
+    PcmFrameSyncConfig config = defaultConfig();
+    config.lock_misses = 3;
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        SyncResult search = runSync(defaultConfig(), engine, writer.bytes(), {});
+        QCOMPARE(search.end_bits.size(), static_cast<size_t>(6));
+
+        // The frame closed by the corrupted sync is dropped, the next one is kept
+        PcmFrameSynchronizer sync(config, engine);
+        sync.processPacket(writer.bytes().data(), writer.bytes().size());
+        QCOMPARE(sync.frameCount(), static_cast<size_t>(7));
+        QCOMPARE(sync.frameWords(3)[0], uint64_t{400});
+        QCOMPARE(sync.totalSyncs(), uint64_t{8});
+        QCOMPARE(sync.missedSyncs(), uint64_t{1});
+        QCOMPARE(sync.unlockCount(), uint64_t{0});
+        QVERIFY(sync.lockState() == FrameLockState::Lock);
+    }
+}
+
+void TestPcmFrameSync::lockDropsToSearchAfterMisses()
+{
+    BitWriter writer;
+    for (int f = 0; f < 8; f++)
+    {
+        if (f == 4)
+        {
+            writer.append(0x5, 3);  // slip the stream by three bits
+        }
+        appendFrame(writer, static_cast<uint64_t>(f) * 100);
+    }
+    writer.append(kSyncPattern, kSyncLen);
+
+    PcmFrameSyncConfig config = defaultConfig();
+    config.lock_misses = 2;
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        SyncResult r = runSync(config, engine, writer.bytes(), { 64 });
+        QCOMPARE(r.total_syncs, uint64_t{8});
+        QCOMPARE(r.end_bits.size(), static_cast<size_t>(6));
+        QCOMPARE(r.missed_syncs, uint64_t{2});
+        QCOMPARE(r.unlock_count, uint64_t{1});
+        QCOMPARE(r.lock_count, uint64_t{2});
+    }
+}
+
+void TestPcmFrameSync::enginesMatchInLockMode()
+{
+    QRandomGenerator rng(4321);
+    for (int iter = 0; iter < 100; iter++)
+    {
+        PcmFrameSyncConfig config = defaultConfig();
+        config.lock_misses = 1 + rng.bounded(4U);
+        config.min_syncs = rng.bounded(3U);
+
+        BitWriter writer;
+        const int num_frames = 50 + static_cast<int>(rng.bounded(200U));
+        for (int f = 0; f < num_frames; f++)
+        {
+            const uint32_t event = rng.bounded(16U);
+            if (event == 0)
+            {
+                writer.append(rng.generate64(), 1 + rng.bounded(63U));  // slip
+            }
+            appendFrame(writer, rng.generate64(), (event == 1) ? rng.generate64() : kSyncPattern);
+        }
+        writer.append(kSyncPattern, kSyncLen);
+
+        std::vector<size_t> splits;
+        for (int i = 0; i < 8; i++)
+        {
+            splits.push_back(1 + rng.bounded(3000U));
+        }
+
+        const SyncResult expected = runSync(config, SyncEngine::BitSerial, writer.bytes(), splits);
+        const SyncResult actual = runSync(config, SyncEngine::WordParallel, writer.bytes(), splits);
+        QVERIFY(expected.lock_count > 0);
+        QCOMPARE(actual.total_syncs, expected.total_syncs);
+        QCOMPARE(actual.lock_count, expected.lock_count);
+        QCOMPARE(actual.unlock_count, expected.unlock_count);
+        QCOMPARE(actual.missed_syncs, expected.missed_syncs);
+        QVERIFY(actual.end_bits == expected.end_bits);
+        QVERIFY(actual.words == expected.words);
+    }
+}
+
+void TestPcmFrameSync::planLimitsOutputToSelectedWords()
+{
+    BitWriter writer;
+    writer.append(0, 9);
+    for (int f = 0; f < 6; f++)
+    {
+        appendFrame(writer, static_cast<uint64_t>(f) * 1000);
+    }
+    writer.append(kSyncPattern, kSyncLen);
+
+    // Out-of-order, duplicate, sync-slot and out-of-range columns
+    const std::vector<int> column_words = { 40, 2, -1, 48, 2, 0, 60 };
+    const ExtractionPlan plan = ExtractionPlan::compile(column_words, kWordsInFrame, kWordLen, 0xFFFF);
+    QCOMPARE(plan.size(), static_cast<size_t>(5));
+
+    for (SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        const SyncResult all = runSync(defaultConfig(), engine, writer.bytes(), { 37 });
+        const SyncResult planned = runSync(defaultConfig(), engine, writer.bytes(), { 37 }, &plan);
+        QCOMPARE(planned.end_bits.size(), static_cast<size_t>(6));
+        QVERIFY(planned.end_bits == all.end_bits);
+        QCOMPARE(planned.words.size(), planned.end_bits.size() * plan.size());
+        for (size_t f = 0; f < planned.end_bits.size(); f++)
+        {
+            for (size_t k = 0; k < plan.size(); k++)
+            {
+                QCOMPARE(planned.words[(f * plan.size()) + k],
+                         all.words[(f * kWordsInFrame) + plan.field(k).word]);
+            }
+            QCOMPARE(planned.words[f * plan.size()], static_cast<uint64_t>(f) * 1000);
+        }
+    }
+
+    // Random plans over random streams: both engines agree
+    QRandomGenerator rng(77);
+    for (int iter = 0; iter < 50; iter++)
+    {
+        BitWriter noisy;
+        for (int f = 0; f < 40; f++)
+        {
+            appendFrame(noisy, rng.generate64());
+            if (rng.bounded(6U) == 0)
+            {
+                noisy.append(rng.generate64(), 1 + rng.bounded(40U));
+            }
+        }
+        std::vector<int> words;
+        for (uint32_t c = rng.bounded(64U); c > 0; c--)
+        {
+            words.push_back(static_cast<int>(rng.bounded(kWordsInFrame + 2)) - 1);
+        }
+        const ExtractionPlan random_plan = ExtractionPlan::compile(words, kWordsInFrame, kWordLen, 0xFFFF);
+        PcmFrameSyncConfig config = defaultConfig();
+        config.lock_misses = rng.bounded(3U);
+
+        const std::vector<size_t> splits = { 1 + rng.bounded(500U), 1 + rng.bounded(500U) };
+        const SyncResult expected = runSync(config, SyncEngine::BitSerial, noisy.bytes(), splits, &random_plan);
+        const SyncResult actual = runSync(config, SyncEngine::WordParallel, noisy.bytes(), splits, &random_plan);
+        QVERIFY(actual.end_bits == expected.end_bits);
+        QVERIFY(actual.words == expected.words);
+    }
+}
+
+void TestPcmFrameSync::extractorSelection()
+{
+    struct Case { uint32_t sync_len; uint32_t word_len; const char* name; };
+    const Case cases[] = {
+        { 16, 16, "16-bit words, 16-bit sync" },
+        { 24, 16, "16-bit words, 24-bit sync" },
+        { 32, 16, "16-bit words, 32-bit sync" },
+        { 20, 16, "generic" },
+        { 32, 8, "8-bit words" },
+        { 24, 10, "10-bit words" },
+        { 16, 12, "12-bit words" },
+        { 32, 14, "generic" },
+    };
+    for (const Case& c : cases)
+    {
+        PcmFrameSynchronizer sync(geometryConfig(c.sync_len, c.word_len, 33));
+        QCOMPARE(QString(sync.extractorName()), QString(c.name));
+        sync.setSpecializedExtraction(false);
+        QCOMPARE(QString(sync.extractorName()), QString("generic"));
+    }
+
+    // A word mask wider than the word length keeps the generic extractor
+    PcmFrameSyncConfig wide = geometryConfig(32, 16, 33);
+    wide.word_mask = 0xFFFFF;
+    QCOMPARE(QString(PcmFrameSynchronizer(wide).extractorName()), QString("generic"));
+}
+
+void TestPcmFrameSync::specializedExtractorsMatchGeneric()
+{
+    const uint32_t geometries[][2] = { { 16, 16 }, { 24, 16 }, { 32, 16 }, { 32, 8 }, { 24, 10 }, { 16, 12 } };
+    QRandomGenerator rng(2024);
+    for (int iter = 0; iter < 60; iter++)
+    {
+        const uint32_t* geometry = geometries[iter % 6];
+        PcmFrameSyncConfig config = geometryConfig(geometry[0], geometry[1], 8 + rng.bounded(50U));
+        config.lock_misses = 1 + rng.bounded(3U);
+
+        // Clean frames with occasional slips and corrupted syncs
+        BitWriter writer;
+        for (int f = 0; f < 200; f++)
+        {
+            if (rng.bounded(25U) == 0)
+            {
+                writer.append(rng.generate64(), 1 + rng.bounded(40U));
+            }
+            writer.append((rng.bounded(20U) == 0) ? rng.generate64() : config.sync_pat, config.sync_pat_len);
+            for (uint32_t w = 0; w + 1 < config.words_in_frame; w++)
+            {
+                writer.append(rng.generate64(), config.word_len);
+            }
+        }
+
+        // Sparse and dense plans
+        std::vector<int> words;
+        const uint32_t columns = (iter % 2 == 0) ? 3 : config.words_in_frame;
+        for (uint32_t c = 0; c < columns; c++)
+        {
+            words.push_back(static_cast<int>(rng.bounded(config.words_in_frame + 1)) - 1);
+        }
+        const ExtractionPlan plan = ExtractionPlan::compile(words, config.words_in_frame,
+                                                           config.word_len, config.word_mask);
+
+        const std::vector<size_t> splits = { 1 + rng.bounded(4000U), 1 + rng.bounded(40U) };
+        const SyncResult expected = runSync(config, SyncEngine::BitSerial, writer.bytes(), splits, &plan);
+        const SyncResult specialized = runSync(config, SyncEngine::WordParallel, writer.bytes(), splits, &plan);
+        QVERIFY(!expected.end_bits.empty());
+        QCOMPARE(specialized.lock_count, expected.lock_count);
+        QCOMPARE(specialized.missed_syncs, expected.missed_syncs);
+        QVERIFY(specialized.end_bits == expected.end_bits);
+        QVERIFY(specialized.words == expected.words);
+    }
+}
+
+void TestPcmFrameSync::extractorThroughput_data()
+{
+    QTest::addColumn<uint32_t>("sync_len");
+    QTest::addColumn<uint32_t>("word_len");
+    QTest::addColumn<bool>("specialized");
+
+    const uint32_t geometries[][2] = { { 16, 16 }, { 24, 16 }, { 32, 16 }, { 32, 8 }, { 24, 10 }, { 24, 12 } };
+    for (const auto& geometry : geometries)
+    {
+        for (bool specialized : { true, false })
+        {
+            const QString name = QString("sync%1/word%2/%3").arg(geometry[0]).arg(geometry[1])
+                                     .arg(specialized ? "specialized" : "generic");
+            QTest::newRow(qPrintable(name)) << geometry[0] << geometry[1] << specialized;
+        }
+    }
+}
+
+void TestPcmFrameSync::extractorThroughput()
+{
+    // Lock-mode throughput on a clean 49-word stream reading every word.
+    // Run with -iterations N (or -tickcounter) for stable figures.
+    QFETCH(uint32_t, sync_len);
+    QFETCH(uint32_t, word_len);
+    QFETCH(bool, specialized);
+
+    const PcmFrameSyncConfig config = geometryConfig(sync_len, word_len, kWordsInFrame);
+    QRandomGenerator rng(7);
+    const std::vector<uint8_t> stream = cleanStream(config, 20000, rng);
+    constexpr size_t kPacketBytes = 4096;
+
+    PcmFrameSynchronizer sync(config);
+    sync.setSpecializedExtraction(specialized);
+    uint64_t frames = 0;
+    QBENCHMARK
+    {
+        sync.reset();
+        frames = 0;
+        for (size_t pos = 0; pos < stream.size(); pos += kPacketBytes)
+        {
+            sync.processPacket(stream.data() + pos, qMin(kPacketBytes, stream.size() - pos));
+            frames += sync.frameCount();
+        }
+    }
+    QCOMPARE(frames, uint64_t{20000});
+    QCOMPARE(sync.lockCount(), uint64_t{1});
+}
+
+void TestPcmFrameSync::midStreamStartConverges()
+{
+    // Started at a packet's global bit offset, a synchronizer reaches the
+    // continuous run's state within a few frames and then emits the same frames
+    QRandomGenerator rng(11);
+    constexpr size_t kPacketBytes = 250;
+    constexpr size_t kStartPacket = 12;
+    constexpr size_t kEdgePacket = 16;
+    for (const SyncEngine engine : { SyncEngine::BitSerial, SyncEngine::WordParallel })
+    {
+        for (bool randomized : { false, true })
+        {
+            PcmFrameSyncConfig config = geometryConfig(kSyncLen, kWordLen, kWordsInFrame);
+            config.min_syncs = 1;
+            config.randomized = randomized;
+            std::vector<uint8_t> stream = cleanStream(config, 200, rng);
+            if (randomized)
+            {
+                stream = scramble(stream);
+            }
+
+            PcmFrameSynchronizer continuous(config, engine);
+            PcmFrameSynchronizer chunk(config, engine);
+            chunk.reset(kStartPacket * kPacketBytes * 8);
+            SyncResult expected;
+            SyncResult actual;
+            for (size_t p = 0; p * kPacketBytes < stream.size(); p++)
+            {
+                const size_t len = qMin(kPacketBytes, stream.size() - (p * kPacketBytes));
+                const uint8_t* data = stream.data() + (p * kPacketBytes);
+                if (p == kStartPacket)
+                {
+                    QVERIFY(chunk.streamState() != continuous.streamState());
+                }
+                if (p == kEdgePacket)
+                {
+                    QVERIFY(chunk.streamState() == continuous.streamState());
+                }
+
+                continuous.processPacket(data, len);
+                if (p < kStartPacket)
+                {
+                    continue;
+                }
+                chunk.processPacket(data, len);
+                if (p < kEdgePacket)
+                {
+                    continue;
+                }
+                for (size_t f = 0; f < continuous.frameCount(); f++)
+                {
+                    expected.end_bits.push_back(continuous.frameEndBit(f));
+                    expected.words.insert(expected.words.end(), continuous.frameWords(f),
+                                          continuous.frameWords(f) + continuous.frameWidth());
+                }
+                for (size_t f = 0; f < chunk.frameCount(); f++)
+                {
+                    actual.end_bits.push_back(chunk.frameEndBit(f));
+                    actual.words.insert(actual.words.end(), chunk.frameWords(f),
+                                        chunk.frameWords(f) + chunk.frameWidth());
+                }
+            }
+            QVERIFY(!expected.end_bits.empty());
+            QCOMPARE(actual.end_bits, expected.end_bits);
+            QCOMPARE(actual.words, expected.words);
+        }
+    }
+}
@@ -0,0 +1,39 @@
+/**
+ * @file tst_pcmframesync.h
+ * @brief Unit tests for PcmFrameSynchronizer — bit-serial and word-parallel engines.
+ */
+
+#ifndef TST_PCMFRAMESYNC_H
+#define TST_PCMFRAMESYNC_H
+
+#include <QObject>
+
+class TestPcmFrameSync : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void engineNames();
+    void extractsFramesAtExactSpacing();
+    void minSyncsDelaysFirstFrame();
+    void misplacedSyncDropsFrame();
+    void syncSpanningPacketBoundary();
+    void patternOutsideMaskNeverMatches();
+    void resetClearsStreamState();
+    void enginesMatchOnRandomStreams();
+    void conditionsRawPayload();
+    void fusedConditioningMatchesBitSerial();
+    void lockStateNames();
+    void lockIgnoresSyncInsideFrame();
+    void lockFlywheelsOverMissedSync();
+    void lockDropsToSearchAfterMisses();
+    void enginesMatchInLockMode();
+    void planLimitsOutputToSelectedWords();
+    void extractorSelection();
+    void specializedExtractorsMatchGeneric();
+    void extractorThroughput_data();
+    void extractorThroughput();
+    void midStreamStartConverges();
+};
+
+#endif // TST_PCMFRAMESYNC_H
@@ -0,0 +1,113 @@
+/**
+ * @file tst_pcmpackettable.cpp
+ * @brief Implementation of PcmPacketTable unit tests.
+ */
+
+#include "tst_pcmpackettable.h"
+
+#include <vector>
+
+#include <QtTest>
+
+#include "pcmpackettable.h"
+
+namespace {
+    /// Body length of a packet carrying @p payload PCM bytes.
+    constexpr uint32_t bodyLen(uint32_t payload) { return payload + 4; }
+
+    /// Table of @p count packets of 1000 payload bytes, 1 KB apart in the file.
+    PcmPacketTable makeTable(size_t count)
+    {
+        PcmPacketTable table;
+        table.addTimeReference(Irig106::SuTimeRef{});
+        for (size_t i = 0; i < count; i++)
+        {
+            table.addPacket(static_cast<int64_t>(i) * 1024, bodyLen(1000), static_cast<int64_t>(i) * 100);
+        }
+        return table;
+    }
+}
+
+void TestPcmPacketTable::packetsAccumulateStreamBits()
+{
+    PcmPacketTable table;
+    table.addPacket(100, bodyLen(10), 0);
+    table.addPacket(200, bodyLen(3), 0);
+    table.addPacket(300, bodyLen(7), 0);
+    QCOMPARE(table.size(), static_cast<size_t>(3));
+    QCOMPARE(table.packet(0).start_bit, static_cast<uint64_t>(0));
+    QCOMPARE(table.packet(1).start_bit, static_cast<uint64_t>(80));
+    QCOMPARE(table.packet(2).start_bit, static_cast<uint64_t>(104));
+    QCOMPARE(table.packet(2).data_offset, static_cast<int64_t>(300));
+    QCOMPARE(table.payloadBytes(), static_cast<uint64_t>(20));
+
+    table.clear();
+    QVERIFY(table.isEmpty());
+    QCOMPARE(table.payloadBytes(), static_cast<uint64_t>(0));
+}
+
+void TestPcmPacketTable::packetsUseLatestTimeReference()
+{
+    PcmPacketTable table;
+    Irig106::SuTimeRef ref = {};
+    table.addTimeReference(ref);
+    table.addPacket(0, bodyLen(8), 0);
+    ref.uRelTime = 5;
+    table.addTimeReference(ref);
+    ref.uRelTime = 9;
+    table.addTimeReference(ref);
+    table.addPacket(64, bodyLen(8), 10);
+
+    QCOMPARE(table.timeReferenceCount(), static_cast<size_t>(3));
+    QCOMPARE(table.packet(0).time_ref, 0U);
+    QCOMPARE(table.packet(1).time_ref, 2U);
+    QCOMPARE(table.timeReference(table.packet(1).time_ref).uRelTime, static_cast<int64_t>(9));
+}
+
+void TestPcmPacketTable::chunksCoverAllPackets()
+{
+    const PcmPacketTable table = makeTable(95);
+    const std::vector<PcmDecodeChunk> chunks = table.planChunks(10000, 0);
+
+    // 1000-byte packets: ten per 10 KB chunk, the remainder in the last one
+    QCOMPARE(chunks.size(), static_cast<size_t>(10));
+    size_t expected_first = 0;
+    for (const PcmDecodeChunk& chunk : chunks)
+    {
+        QCOMPARE(chunk.first, expected_first);
+        QVERIFY(chunk.end > chunk.first);
+        expected_first = chunk.end;
+    }
+    QCOMPARE(expected_first, table.size());
+    QCOMPARE(chunks.back().end - chunks.back().first, static_cast<size_t>(5));
+
+    QVERIFY(PcmPacketTable().planChunks(10000, 0).empty());
+}
+
+void TestPcmPacketTable::chunksCarryLeadIn()
+{
+    const PcmPacketTable table = makeTable(40);
+
+    // The first chunk starts the stream; later ones reach back at least the lead-in
+    const std::vector<PcmDecodeChunk> chunks = table.planChunks(10000, 2500 * 8);
+    QCOMPARE(chunks.front().lead_in, static_cast<size_t>(0));
+    for (size_t c = 1; c < chunks.size(); c++)
+    {
+        const uint64_t lead_bits = table.packet(chunks[c].first).start_bit -
+                                   table.packet(chunks[c].lead_in).start_bit;
+        QVERIFY(lead_bits >= 2500 * 8);
+        QCOMPARE(chunks[c].lead_in, chunks[c].first - 3);
+    }
+
+    // Even without a lead-in budget, one packet primes the packet timing
+    for (const PcmDecodeChunk& chunk : table.planChunks(10000, 0))
+    {
+        if (chunk.first > 0)
+        {
+            QCOMPARE(chunk.lead_in, chunk.first - 1);
+        }
+    }
+
+    // A lead-in longer than the stream so far starts at the first packet
+    QCOMPARE(table.planChunks(10000, 1ULL << 40)[1].lead_in, static_cast<size_t>(0));
+}
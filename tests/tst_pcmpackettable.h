@@ -0,0 +1,22 @@
+/**
+ * @file tst_pcmpackettable.h
+ * @brief Unit tests for PcmPacketTable — stream bit offsets and chunk planning.
+ */
+
+#ifndef TST_PCMPACKETTABLE_H
+#define TST_PCMPACKETTABLE_H
+
+#include <QObject>
+
+class TestPcmPacketTable : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void packetsAccumulateStreamBits();
+    void packetsUseLatestTimeReference();
+    void chunksCoverAllPackets();
+    void chunksCarryLeadIn();
+};
+
+#endif // TST_PCMPACKETTABLE_H
@@ -1,5 +1,6 @@
 #include "tst_processingcoordinator.h"
 
+#include <QDir>
 #include <QSignalSpy>
 #include <QVector>
 #include <QtTest>
@@ -14,6 +15,13 @@
 // Helpers
 // ---------------------------------------------------------------------------
 
+static QString testDataPath(const QString& filename)
+{
+    QDir dir(QCoreApplication::applicationDirPath());
+    dir.cdUp();
+    return dir.filePath("data/" + filename);
+}
+
 /// Builds a minimal 1-parameter FrameSetup via a temp INI file.
 static FrameSetup* makeFrameSetup(QObject* parent = nullptr)
 {
@@ -39,6 +47,22 @@ static QVector<QVector<bool>> singleReceiverStates()
     return states;
 }
 
+/// Returns a cataloged batch file on PCM channel 3 / time channel 1 with no pre-scan yet.
+static BatchFileInfo unscannedBatchFile(const QString& name)
+{
+    BatchFileInfo info;
+    info.filepath           = name;
+    info.filename           = name;
+    info.pcmChannelStrings  = { "3 - PCM" };
+    info.timeChannelStrings = { "1 - IRIG-B" };
+    info.pcmChannelIds      = { 3 };
+    info.timeChannelIds     = { 1 };
+    info.resolvedPcmIndex   = 0;
+    info.resolvedTimeIndex  = 0;
+    info.loaded             = true;
+    return info;
+}
+
 // ---------------------------------------------------------------------------
 // Tests
 // ---------------------------------------------------------------------------
@@ -46,10 +70,9 @@ static QVector<QVector<bool>> singleReceiverStates()
 void TestProcessingCoordinator::constructorDefaults()
 {
     QVector<BatchFileInfo> batch_files;
-    Chapter10Reader reader;
     FrameSetup fs(nullptr);
 
-    ProcessingCoordinator coord(&batch_files, &fs, &reader);
+    ProcessingCoordinator coord(&batch_files, &fs);
 
     QCOMPARE(coord.processing(), false);
     QCOMPARE(coord.progressPercent(), 0);
@@ -59,10 +82,9 @@ void TestProcessingCoordinator::constructorDefaults()
 void TestProcessingCoordinator::resetClearsBatchState()
 {
     QVector<BatchFileInfo> batch_files;
-    Chapter10Reader reader;
     FrameSetup fs(nullptr);
 
-    ProcessingCoordinator coord(&batch_files, &fs, &reader);
+    ProcessingCoordinator coord(&batch_files, &fs);
 
     // reset() should be callable at any time and leave state clean
     coord.reset();
@@ -75,10 +97,9 @@ void TestProcessingCoordinator::resetClearsBatchState()
 void TestProcessingCoordinator::cancelProcessingNoRunNoOp()
 {
     QVector<BatchFileInfo> batch_files;
-    Chapter10Reader reader;
     FrameSetup fs(nullptr);
 
-    ProcessingCoordinator coord(&batch_files, &fs, &reader);
+    ProcessingCoordinator coord(&batch_files, &fs);
 
     // Should not crash when no thread is running
     coord.cancelProcessing();
@@ -89,10 +110,9 @@ void TestProcessingCoordinator::cancelProcessingNoRunNoOp()
 void TestProcessingCoordinator::runPreScanInvalidChannelReturnsFalse()
 {
     QVector<BatchFileInfo> batch_files;
-    Chapter10Reader reader;
     FrameSetup* fs = makeFrameSetup();
 
-    ProcessingCoordinator coord(&batch_files, fs, &reader);
+    ProcessingCoordinator coord(&batch_files, fs);
 
     bool result = coord.runPreScan(-1, "any_file.ch10", "FE6B2840");
 
@@ -104,10 +124,9 @@ void TestProcessingCoordinator::runPreScanInvalidChannelReturnsFalse()
 void TestProcessingCoordinator::runPreScanInvalidFileReturnsFalse()
 {
     QVector<BatchFileInfo> batch_files;
-    Chapter10Reader reader;
     FrameSetup* fs = makeFrameSetup();
 
-    ProcessingCoordinator coord(&batch_files, fs, &reader);
+    ProcessingCoordinator coord(&batch_files, fs);
 
     // Channel ID 0 is valid but the file does not exist → preScan fails
     bool result = coord.runPreScan(0, "nonexistent_file_xyz.ch10", "FE6B2840");
@@ -120,10 +139,9 @@ void TestProcessingCoordinator::runPreScanInvalidFileReturnsFalse()
 void TestProcessingCoordinator::startSingleProcessingNoReceiversReturnsFalse()
 {
     QVector<BatchFileInfo> batch_files;
-    Chapter10Reader reader;
     FrameSetup* fs = makeFrameSetup();
 
-    ProcessingCoordinator coord(&batch_files, fs, &reader);
+    ProcessingCoordinator coord(&batch_files, fs);
 
     QSignalSpy error_spy(&coord, &ProcessingCoordinator::errorOccurred);
 
@@ -146,10 +164,9 @@ void TestProcessingCoordinator::startSingleProcessingNoReceiversReturnsFalse()
 void TestProcessingCoordinator::startSingleProcessingEmitsProcessingState()
 {
     QVector<BatchFileInfo> batch_files;
-    Chapter10Reader reader;
     FrameSetup* fs = makeFrameSetup();
 
-    ProcessingCoordinator coord(&batch_files, fs, &reader);
+    ProcessingCoordinator coord(&batch_files, fs);
 
     QSignalSpy state_spy(&coord, &ProcessingCoordinator::processingStateChanged);
 
@@ -189,10 +206,9 @@ void TestProcessingCoordinator::batchFilesUpdatedAfterPreScan()
     info.resolvedPcmIndex = -1;
     batch_files.append(info);
 
-    Chapter10Reader reader;
     FrameSetup* fs = makeFrameSetup();
 
-    ProcessingCoordinator coord(&batch_files, fs, &reader);
+    ProcessingCoordinator coord(&batch_files, fs);
     QSignalSpy updated_spy(&coord, &ProcessingCoordinator::batchFilesUpdated);
 
     coord.startBatchProcessing("output_dir", 0,
@@ -207,3 +223,232 @@ void TestProcessingCoordinator::batchFilesUpdatedAfterPreScan()
 
     delete fs;
 }
+
+void TestProcessingCoordinator::batchSettlesFilesWithoutRuns()
+{
+    // Skipped and failed-pre-scan files are settled before any worker starts,
+    // so the batch completes synchronously with the usual counts.
+    QVector<BatchFileInfo> batch_files;
+    BatchFileInfo skipped;
+    skipped.filepath   = "skipped.ch10";
+    skipped.filename   = "skipped.ch10";
+    skipped.skip       = true;
+    skipped.skipReason = "No PCM channels";
+    batch_files.append(skipped);
+
+    BatchFileInfo unsynced;
+    unsynced.filepath         = "nonexistent.ch10";
+    unsynced.filename         = "nonexistent.ch10";
+    unsynced.resolvedPcmIndex = -1;
+    batch_files.append(unsynced);
+
+    FrameSetup* fs = makeFrameSetup();
+
+    ProcessingCoordinator coord(&batch_files, fs);
+    coord.setBatchConcurrency(4, 1);
+    QSignalSpy finished_spy(&coord, &ProcessingCoordinator::processingFinished);
+
+    coord.startBatchProcessing("output_dir", 0,
+                               "FE6B2840", 0, 0, "1.0",
+                               singleReceiverStates());
+
+    QCOMPARE(finished_spy.count(), 1);
+    QCOMPARE(finished_spy.at(0).at(0).toBool(), false);
+    QCOMPARE(coord.processing(), false);
+    QCOMPARE(coord.progressPercent(), 100);
+    QVERIFY(batch_files[1].processed);
+    QVERIFY(!batch_files[1].processedOk);
+
+    delete fs;
+}
+
+void TestProcessingCoordinator::batchPreScanParamsRequiresLayout()
+{
+    ProcessingParams params;
+    QVERIFY(!ProcessingCoordinator::batchPreScanParams("XYZ", 48, params));
+    QVERIFY(!ProcessingCoordinator::batchPreScanParams("FE6B2840", 0, params));
+
+    QVERIFY(ProcessingCoordinator::batchPreScanParams("FE6B2840", 48, params));
+    QCOMPARE(params.frame_sync, static_cast<uint64_t>(0xFE6B2840));
+    QCOMPARE(params.sync_pattern_length, 32);
+    QCOMPARE(params.words_in_minor_frame, 49);
+    QCOMPARE(params.bits_in_minor_frame, 800);
+}
+
+void TestProcessingCoordinator::preScanBatchFileRecordsScanKey()
+{
+    // The pre-scan records the channel and frame layout it ran with, so a
+    // batch started with the same settings does not scan the file again.
+    const QString filepath = testDataPath("nrz-l_testfile.ch10");
+    if (!QFileInfo::exists(filepath))
+    {
+        QSKIP("NRZ-L test file not available");
+    }
+
+    Chapter10Reader reader;
+    QVERIFY(reader.loadChannels(filepath));
+    const QStringList pcm_list = reader.getPCMChannelComboBoxList();
+    if (pcm_list.isEmpty())
+    {
+        QSKIP("No PCM channels in NRZ-L test file");
+    }
+
+    BatchFileInfo info;
+    info.filepath = filepath;
+    for (const QString& s : pcm_list)
+    {
+        info.pcmChannelIds.append(s.split(" - ").first().toInt());
+    }
+    info.resolvedPcmIndex = static_cast<int>(info.pcmChannelIds.size()) - 1;
+
+    ProcessingParams params;
+    QVERIFY(ProcessingCoordinator::batchPreScanParams("FE6B2840", 48, params));
+    QStringList log;
+    ProcessingCoordinator::preScanBatchFile(info, params, log);
+
+    QVERIFY(info.preScanOk);
+    QVERIFY(!log.isEmpty());
+    QCOMPARE(info.preScanPcmChannelId, info.pcmChannelIds.last());
+    QCOMPARE(info.preScanFrameSync, static_cast<quint64>(0xFE6B2840));
+    QCOMPARE(info.preScanSyncBits, 32);
+    QCOMPARE(info.preScanFrameWords, 49);
+
+    // Without a resolved channel the key is cleared
+    info.resolvedPcmIndex = -1;
+    ProcessingCoordinator::preScanBatchFile(info, params, log);
+    QVERIFY(!info.preScanOk);
+    QCOMPARE(info.preScanPcmChannelId, -1);
+}
+
+void TestProcessingCoordinator::batchRunsFromIntakeCatalog()
+{
+    // A file is not cataloged again before its run: a file with a complete
+    // catalog starts even though it cannot be read (the run itself fails),
+    // and one without its time channel IDs fails before any run starts.
+    FrameSetup* fs = makeFrameSetup();
+    const auto cataloged = [](const QString& name) {
+        BatchFileInfo info;
+        info.filepath            = name;
+        info.filename            = name;
+        info.pcmChannelStrings   = { "3 - PCM" };
+        info.timeChannelStrings  = { "1 - IRIG-B" };
+        info.pcmChannelIds       = { 3 };
+        info.timeChannelIds      = { 1 };
+        info.resolvedPcmIndex    = 0;
+        info.resolvedTimeIndex   = 0;
+        info.loaded              = true;
+        info.preScanOk           = true;
+        info.preScanPcmChannelId = 3;
+        info.preScanFrameSync    = 0xFE6B2840;
+        info.preScanSyncBits     = 32;
+        info.preScanFrameWords   = 2;
+        return info;
+    };
+
+    QVector<BatchFileInfo> batch_files;
+    batch_files.append(cataloged("nonexistent.ch10"));
+    batch_files.append(cataloged("no_time_ids.ch10"));
+    batch_files[1].timeChannelIds.clear();
+
+    ProcessingCoordinator coord(&batch_files, fs);
+    coord.setBatchConcurrency(1, 0);
+    QSignalSpy log_spy(&coord, &ProcessingCoordinator::logMessageReceived);
+    QSignalSpy processing_spy(&coord, &ProcessingCoordinator::batchFileProcessing);
+    QSignalSpy finished_spy(&coord, &ProcessingCoordinator::processingFinished);
+
+    coord.startBatchProcessing("output_dir", 0,
+                               "FE6B2840", 0, 0, "1.0",
+                               singleReceiverStates());
+    QTRY_COMPARE_WITH_TIMEOUT(finished_spy.count(), 1, 10000);
+
+    QCOMPARE(processing_spy.count(), 2);
+    QStringList log;
+    for (const QList<QVariant>& args : std::as_const(log_spy))
+    {
+        log.append(args.at(0).toString());
+    }
+    QVERIFY(log.filter("Could not load").isEmpty());
+    QVERIFY(log.filter("Pre-scan").isEmpty());
+    QCOMPARE(log.filter("Channel not selected for no_time_ids.ch10").size(), 1);
+    QVERIFY(batch_files[0].processed);
+    QVERIFY(!batch_files[0].processedOk);
+    QVERIFY(batch_files[1].processed);
+    QVERIFY(!batch_files[1].processedOk);
+
+    delete fs;
+}
+
+void TestProcessingCoordinator::batchPreScansOffGuiThread()
+{
+    // Files the intake did not scan are scanned on the pool; the batch starts
+    // only when every scan has reported back
+    FrameSetup* fs = makeFrameSetup();
+    QVector<BatchFileInfo> batch_files;
+    batch_files.append(unscannedBatchFile("nonexistent_a.ch10"));
+    batch_files.append(unscannedBatchFile("nonexistent_b.ch10"));
+
+    ProcessingCoordinator coord(&batch_files, fs);
+    coord.setBatchConcurrency(1, 0);
+    QSignalSpy progress_spy(&coord, &ProcessingCoordinator::batchPreScanProgress);
+    QSignalSpy log_spy(&coord, &ProcessingCoordinator::logMessageReceived);
+    QSignalSpy finished_spy(&coord, &ProcessingCoordinator::processingFinished);
+
+    coord.startBatchProcessing("output_dir", 0,
+                               "FE6B2840", 0, 0, "1.0",
+                               singleReceiverStates());
+    QVERIFY(coord.processing());
+    QCOMPARE(finished_spy.count(), 0);
+    QTRY_COMPARE_WITH_TIMEOUT(finished_spy.count(), 1, 10000);
+
+    QCOMPARE(progress_spy.first().at(0).toInt(), 0);
+    QCOMPARE(progress_spy.last().at(0).toInt(), 2);
+    QCOMPARE(progress_spy.last().at(1).toInt(), 2);
+    QStringList log;
+    for (const QList<QVariant>& args : std::as_const(log_spy))
+    {
+        log.append(args.at(0).toString());
+    }
+    QCOMPARE(log.filter("ERROR: Pre-scan failed").size(), 2);
+    for (const BatchFileInfo& info : std::as_const(batch_files))
+    {
+        QCOMPARE(info.preScanPcmChannelId, 3);
+        QVERIFY(info.processed);
+        QVERIFY(!info.processedOk);
+    }
+
+    delete fs;
+}
+
+void TestProcessingCoordinator::batchPreScanCancelEndsBatch()
+{
+    // Cancelling while files are pre-scanned ends the batch before any file runs
+    FrameSetup* fs = makeFrameSetup();
+    QVector<BatchFileInfo> batch_files;
+    batch_files.append(unscannedBatchFile("nonexistent_a.ch10"));
+    batch_files.append(unscannedBatchFile("nonexistent_b.ch10"));
+
+    ProcessingCoordinator coord(&batch_files, fs);
+    QSignalSpy log_spy(&coord, &ProcessingCoordinator::logMessageReceived);
+    QSignalSpy processing_spy(&coord, &ProcessingCoordinator::batchFileProcessing);
+    QSignalSpy finished_spy(&coord, &ProcessingCoordinator::processingFinished);
+
+    coord.startBatchProcessing("output_dir", 0,
+                               "FE6B2840", 0, 0, "1.0",
+                               singleReceiverStates());
+    coord.cancelProcessing();
+    QTRY_COMPARE_WITH_TIMEOUT(finished_spy.count(), 1, 10000);
+
+    QCOMPARE(finished_spy.at(0).at(0).toBool(), false);
+    QCOMPARE(coord.processing(), false);
+    QCOMPARE(processing_spy.count(), 0);
+    bool cancelled_logged = false;
+    for (const QList<QVariant>& args : std::as_const(log_spy))
+    {
+        cancelled_logged = cancelled_logged || args.at(0).toString().startsWith("Batch cancelled by user");
+    }
+    QVERIFY(cancelled_logged);
+    QVERIFY(!batch_files[0].processed);
+    QVERIFY(!batch_files[1].processed);
+
+    delete fs;
+}
@@ -16,6 +16,12 @@ private slots:
     void startSingleProcessingNoReceiversReturnsFalse();
     void startSingleProcessingEmitsProcessingState();
     void batchFilesUpdatedAfterPreScan();
+    void batchSettlesFilesWithoutRuns();
+    void batchPreScanParamsRequiresLayout();
+    void preScanBatchFileRecordsScanKey();
+    void batchRunsFromIntakeCatalog();
+    void batchPreScansOffGuiThread();
+    void batchPreScanCancelEndsBatch();
 };
 
 #endif // TST_PROCESSINGCOORDINATOR_H
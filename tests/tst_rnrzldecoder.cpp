@@ -0,0 +1,120 @@
+/**
+ * @file tst_rnrzldecoder.cpp
+ * @brief Implementation of RnrzlDecoder unit tests.
+ */
+
+#include "tst_rnrzldecoder.h"
+
+#include <QByteArray>
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include "rnrzldecoder.h"
+
+namespace {
+    QByteArray randomBytes(QRandomGenerator& rng, int size)
+    {
+        QByteArray bytes(size, '\0');
+        for (char& b : bytes)
+        {
+            b = static_cast<char>(rng.bounded(256U));
+        }
+        return bytes;
+    }
+
+    uint8_t* bytePtr(QByteArray& bytes)
+    {
+        return reinterpret_cast<uint8_t*>(bytes.data());
+    }
+}
+
+void TestRnrzlDecoder::zeroBitsLeavesState()
+{
+    QByteArray data(4, '\x5A');
+    const QByteArray original = data;
+    uint16_t lfsr = 0x1234;
+
+    RnrzlDecoder::derandomize(bytePtr(data), 0, lfsr);
+    QCOMPARE(data, original);
+    QCOMPARE(lfsr, static_cast<uint16_t>(0x1234));
+}
+
+void TestRnrzlDecoder::matchesBitSerialEveryLength()
+{
+    // Every whole-byte length up to several 64-bit blocks, random LFSR seeds
+    QRandomGenerator rng(2024);
+    for (int len = 0; len <= 600; len++)
+    {
+        for (int rep = 0; rep < 4; rep++)
+        {
+            QByteArray fast = randomBytes(rng, len);
+            QByteArray reference = fast;
+            uint16_t fast_lfsr = static_cast<uint16_t>(rng.bounded(0x8000U));
+            uint16_t reference_lfsr = fast_lfsr;
+            const uint64_t bits = static_cast<uint64_t>(len) * 8;
+
+            RnrzlDecoder::derandomize(bytePtr(fast), bits, fast_lfsr);
+            RnrzlDecoder::derandomizeBitSerial(bytePtr(reference), bits, reference_lfsr);
+
+            QVERIFY2(fast == reference, qPrintable(QString("length %1 bytes").arg(len)));
+            QCOMPARE(fast_lfsr, reference_lfsr);
+        }
+    }
+}
+
+void TestRnrzlDecoder::matchesBitSerialPartialBytes()
+{
+    // Bit counts that end mid-byte, including fewer bits than the LFSR holds
+    QRandomGenerator rng(99);
+    for (uint64_t bits = 1; bits <= 200; bits++)
+    {
+        QByteArray fast = randomBytes(rng, 32);
+        QByteArray reference = fast;
+        uint16_t fast_lfsr = static_cast<uint16_t>(rng.bounded(0x8000U));
+        uint16_t reference_lfsr = fast_lfsr;
+
+        RnrzlDecoder::derandomize(bytePtr(fast), bits, fast_lfsr);
+        RnrzlDecoder::derandomizeBitSerial(bytePtr(reference), bits, reference_lfsr);
+
+        QVERIFY2(fast == reference, qPrintable(QString("%1 bits").arg(bits)));
+        QCOMPARE(fast_lfsr, reference_lfsr);
+    }
+}
+
+void TestRnrzlDecoder::carriesLfsrAcrossPackets()
+{
+    // Splitting a stream into packets must give the same result as one pass
+    QRandomGenerator rng(7);
+    const QByteArray stream = randomBytes(rng, 4096);
+
+    QByteArray whole = stream;
+    uint16_t whole_lfsr = 0;
+    RnrzlDecoder::derandomizeBitSerial(bytePtr(whole), static_cast<uint64_t>(whole.size()) * 8, whole_lfsr);
+
+    QByteArray split = stream;
+    uint16_t split_lfsr = 0;
+    int pos = 0;
+    while (pos < split.size())
+    {
+        const int len = qMin(1 + static_cast<int>(rng.bounded(300U)), static_cast<int>(split.size()) - pos);
+        RnrzlDecoder::derandomize(bytePtr(split) + pos, static_cast<uint64_t>(len) * 8, split_lfsr);
+        pos += len;
+    }
+
+    QCOMPARE(split, whole);
+    QCOMPARE(split_lfsr, whole_lfsr);
+}
+
+void TestRnrzlDecoder::preservesBitsPastEnd()
+{
+    QByteArray data(16, '\xFF');
+    uint16_t lfsr = 0x7FFF;
+    RnrzlDecoder::derandomize(bytePtr(data), 70, lfsr);
+
+    // Bits 70..127 are outside the range and must be untouched
+    QCOMPARE(static_cast<uint8_t>(data[8]) & 0x03, 0x03);
+    for (int i = 9; i < data.size(); i++)
+    {
+        QCOMPARE(static_cast<uint8_t>(data[i]), static_cast<uint8_t>(0xFF));
+    }
+}
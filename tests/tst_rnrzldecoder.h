@@ -0,0 +1,23 @@
+/**
+ * @file tst_rnrzldecoder.h
+ * @brief Unit tests for RnrzlDecoder — bit-exactness against the per-bit descrambler.
+ */
+
+#ifndef TST_RNRZLDECODER_H
+#define TST_RNRZLDECODER_H
+
+#include <QObject>
+
+class TestRnrzlDecoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void zeroBitsLeavesState();
+    void matchesBitSerialEveryLength();
+    void matchesBitSerialPartialBytes();
+    void carriesLfsrAcrossPackets();
+    void preservesBitsPastEnd();
+};
+
+#endif // TST_RNRZLDECODER_H
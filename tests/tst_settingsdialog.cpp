@@ -342,14 +342,14 @@ void TestSettingsDialog::okButtonDisabledForInvalidReceivers()
     dlg.setReceiverCount(UIConstants::kDefaultReceiverCount);
     QVERIFY(ok_btn->isEnabled());
 
-    // Total parameters exceed kMaxTotalParameters (48):
-    // 16 receivers × 4 channels = 64 > 48
+    // Total parameters exceed kMaxTotalParameters (512):
+    // 16 receivers × 48 channels = 768 > 512
     dlg.setReceiverCount(UIConstants::kMaxReceiverCount);
-    dlg.setChannelsPerReceiver(4);
+    dlg.setChannelsPerReceiver(UIConstants::kMaxChannelsPerReceiver);
     QVERIFY2(!ok_btn->isEnabled(),
              "OK must be disabled when receivers x channels exceeds kMaxTotalParameters");
 
-    // Reduce channels to bring total back to 48 (16 × 3 = 48)
+    // Reduce channels to bring total back within the limit (16 × 3 = 48)
     dlg.setChannelsPerReceiver(UIConstants::kDefaultChannelsPerReceiver);
     QVERIFY2(ok_btn->isEnabled(), "OK must re-enable when total parameters are within limit");
 }
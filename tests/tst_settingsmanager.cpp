@@ -225,12 +225,12 @@ void TestSettingsManager::loadFilePolarityInvalid()
 
 void TestSettingsManager::loadFileExceedsTotalParameters()
 {
-    // Count=16 x ChannelsPerReceiver=4 = 64, exceeds kMaxTotalParameters (48)
+    // Count=16 x ChannelsPerReceiver=48 = 768, exceeds kMaxTotalParameters (512)
     QString path = writeTemporaryIni(
         "[Frame]\nFrameSync=FE6B2840\n\n"
         "[Parameters]\nPolarity=1\nSlope=2\nScale=100\n\n"
         "[Time]\nExtractAllTime=true\nSampleRate=0\n\n"
-        "[Receivers]\nCount=16\nChannelsPerReceiver=4\n");
+        "[Receivers]\nCount=16\nChannelsPerReceiver=48\n");
     QVERIFY(!path.isEmpty());
 
     MainViewModel vm;
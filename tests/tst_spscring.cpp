@@ -0,0 +1,108 @@
+/**
+ * @file tst_spscring.cpp
+ * @brief Implementation of SpscRing unit tests.
+ */
+
+#include "tst_spscring.h"
+
+#include <memory>
+#include <thread>
+
+#include <QtTest>
+
+#include "spscring.h"
+
+void TestSpscRing::capacityRoundsUpToPowerOfTwo()
+{
+    QCOMPARE(SpscRing<int>(1).capacity(), static_cast<size_t>(1));
+    QCOMPARE(SpscRing<int>(5).capacity(), static_cast<size_t>(8));
+    QCOMPARE(SpscRing<int>(64).capacity(), static_cast<size_t>(64));
+}
+
+void TestSpscRing::tryPushFailsWhenFull()
+{
+    SpscRing<int> ring(4);
+    for (int i = 0; i < 4; i++)
+    {
+        int value = i;
+        QVERIFY(ring.tryPush(value));
+    }
+    int extra = 99;
+    QVERIFY(!ring.tryPush(extra));
+    QCOMPARE(ring.size(), static_cast<size_t>(4));
+
+    // Slots are reused once popped, in FIFO order
+    int value = -1;
+    QVERIFY(ring.tryPop(value));
+    QCOMPARE(value, 0);
+    QVERIFY(ring.tryPush(extra));
+    for (int expected : { 1, 2, 3, 99 })
+    {
+        QVERIFY(ring.tryPop(value));
+        QCOMPARE(value, expected);
+    }
+    QVERIFY(!ring.tryPop(value));
+}
+
+void TestSpscRing::closeDrainsRemainingItems()
+{
+    SpscRing<std::unique_ptr<int>> ring(4);
+    QVERIFY(ring.push(std::make_unique<int>(7)));
+    ring.close();
+    QVERIFY(ring.isClosed());
+
+    std::unique_ptr<int> item;
+    QVERIFY(ring.pop(item));
+    QCOMPARE(*item, 7);
+    QVERIFY(!ring.pop(item));
+}
+
+void TestSpscRing::occupancyCounters()
+{
+    SpscRing<int> ring(8);
+    for (int i = 0; i < 3; i++)
+    {
+        QVERIFY(ring.push(i));
+    }
+    QCOMPARE(ring.pushCount(), static_cast<uint64_t>(3));
+    QCOMPARE(ring.peakSize(), static_cast<size_t>(3));
+    QCOMPARE(ring.meanFill(), 2.0);
+    QCOMPARE(ring.fullWaits(), static_cast<uint64_t>(0));
+
+    int value = 0;
+    while (ring.tryPop(value))
+    {
+    }
+    QVERIFY(ring.push(5));
+    QCOMPARE(ring.peakSize(), static_cast<size_t>(3));
+    QCOMPARE(ring.emptyWaits(), static_cast<uint64_t>(0));
+}
+
+void TestSpscRing::threadedTransferKeepsOrder()
+{
+    // A tiny ring forces both sides to wait on each other
+    constexpr int kItems = 200000;
+    SpscRing<int> ring(4);
+    std::thread producer([&ring]() {
+        for (int i = 0; i < kItems; i++)
+        {
+            ring.push(i);
+        }
+        ring.close();
+    });
+
+    int expected = 0;
+    bool in_order = true;
+    int value = 0;
+    while (ring.pop(value))
+    {
+        in_order = in_order && (value == expected);
+        expected++;
+    }
+    producer.join();
+
+    QVERIFY(in_order);
+    QCOMPARE(expected, kItems);
+    QVERIFY(ring.peakSize() <= ring.capacity());
+    QVERIFY(ring.fullWaits() + ring.emptyWaits() > 0);
+}
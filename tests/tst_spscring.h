@@ -0,0 +1,23 @@
+/**
+ * @file tst_spscring.h
+ * @brief Unit tests for SpscRing — ordering, bounds, close semantics and counters.
+ */
+
+#ifndef TST_SPSCRING_H
+#define TST_SPSCRING_H
+
+#include <QObject>
+
+class TestSpscRing : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void capacityRoundsUpToPowerOfTwo();
+    void tryPushFailsWhenFull();
+    void closeDrainsRemainingItems();
+    void occupancyCounters();
+    void threadedTransferKeepsOrder();
+};
+
+#endif // TST_SPSCRING_H
@@ -0,0 +1,232 @@
+/**
+ * @file tst_synccorrelator.cpp
+ * @brief Implementation of SyncCorrelator unit tests.
+ */
+
+#include "tst_synccorrelator.h"
+
+#include <vector>
+
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include "synccorrelator.h"
+
+namespace {
+    constexpr uint64_t kSyncPattern = 0xFE6B2840;
+    constexpr uint64_t kSyncMask = 0xFFFFFFFF;
+
+    const std::vector<SyncCorrelator::Kernel>& allKernels()
+    {
+        static const std::vector<SyncCorrelator::Kernel> kernels = {
+            SyncCorrelator::Kernel::Scalar, SyncCorrelator::Kernel::Sse42,
+            SyncCorrelator::Kernel::Avx2, SyncCorrelator::Kernel::Avx512 };
+        return kernels;
+    }
+
+    /// Reference: shifts the stream in one bit at a time like the frame state machine.
+    std::vector<uint64_t> referenceHits(const std::vector<uint64_t>& blocks,
+                                        uint64_t sync_pat, uint64_t sync_mask)
+    {
+        std::vector<uint64_t> hits(blocks.size() - 1, 0);
+        uint64_t test_word = blocks[0];
+        for (size_t k = 1; k < blocks.size(); k++)
+        {
+            for (int i = 0; i < 64; i++)
+            {
+                test_word = (test_word << 1) | ((blocks[k] >> (63 - i)) & 1);
+                if ((test_word & sync_mask) == sync_pat)
+                {
+                    hits[k - 1] |= 1ULL << (63 - i);
+                }
+            }
+        }
+        return hits;
+    }
+
+    /// Writes @p len bits of @p value so the last one lands on stream bit @p end_bit.
+    void placePattern(std::vector<uint64_t>& blocks, uint64_t value, int len, size_t end_bit)
+    {
+        for (int b = 0; b < len; b++)
+        {
+            const size_t pos = end_bit - b;  // stream bit, block 0 included
+            const uint64_t bit = 1ULL << (63 - (pos % 64));
+            if (((value >> b) & 1) != 0)
+            {
+                blocks[pos / 64] |= bit;
+            }
+            else
+            {
+                blocks[pos / 64] &= ~bit;
+            }
+        }
+    }
+
+    std::vector<uint64_t> runKernel(SyncCorrelator::Kernel kernel, const std::vector<uint64_t>& blocks,
+                                    uint64_t sync_pat, uint64_t sync_mask)
+    {
+        SyncCorrelator correlator(sync_pat, sync_mask, kernel);
+        std::vector<uint64_t> hits(blocks.size() - 1, 0xDEADBEEF);
+        correlator.findHits(blocks.data(), blocks.size() - 1, hits.data());
+        return hits;
+    }
+}
+
+void TestSyncCorrelator::kernelNames()
+{
+    QCOMPARE(QString(SyncCorrelator::kernelName(SyncCorrelator::Kernel::Scalar)), QString("scalar"));
+    QCOMPARE(QString(SyncCorrelator::kernelName(SyncCorrelator::Kernel::Sse42)), QString("SSE4.2"));
+    QCOMPARE(QString(SyncCorrelator::kernelName(SyncCorrelator::Kernel::Avx2)), QString("AVX2"));
+    QCOMPARE(QString(SyncCorrelator::kernelName(SyncCorrelator::Kernel::Avx512)), QString("AVX-512"));
+}
+
+void TestSyncCorrelator::bestKernelIsSupported()
+{
+    QVERIFY(SyncCorrelator::isSupported(SyncCorrelator::Kernel::Scalar));
+    QVERIFY(SyncCorrelator::isSupported(SyncCorrelator::bestKernel()));
+
+    SyncCorrelator correlator(kSyncPattern, kSyncMask);
+    QCOMPARE(correlator.kernel(), SyncCorrelator::bestKernel());
+}
+
+void TestSyncCorrelator::packBlocksPadsTail()
+{
+    const uint8_t bytes[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0xFE, 0x6B, 0x28 };
+    std::vector<uint64_t> blocks;
+    const size_t num_blocks = SyncCorrelator::packBlocks(bytes, sizeof(bytes), 0x42, blocks);
+
+    QCOMPARE(num_blocks, static_cast<size_t>(2));
+    QCOMPARE(blocks.size(), static_cast<size_t>(3));
+    QCOMPARE(blocks[0], uint64_t{0x42});
+    QCOMPARE(blocks[1], uint64_t{0x0123456789ABCDEF});
+    QCOMPARE(blocks[2], uint64_t{0xFE6B280000000000});
+}
+
+void TestSyncCorrelator::everyBitAlignment()
+{
+    // Place each pattern so it ends on every bit of several blocks, including
+    // patterns straddling the history block and block boundaries.
+    struct Pattern { uint64_t value; int len; };
+    const Pattern patterns[] = {
+        { kSyncPattern, 32 },
+        { 0xFAF320, 24 },
+        { 0xEB90, 16 },
+        { 0x1ACFFC1D0000FFFFULL, 64 },
+        { 0x1, 1 },
+    };
+    constexpr size_t kNumBlocks = 11;
+
+    for (const Pattern& pattern : patterns)
+    {
+        const uint64_t mask = (pattern.len == 64) ? ~0ULL : ((1ULL << pattern.len) - 1);
+        for (size_t end_bit = static_cast<size_t>(pattern.len) - 1; end_bit < (kNumBlocks + 1) * 64; end_bit++)
+        {
+            std::vector<uint64_t> blocks(kNumBlocks + 1, 0);
+            placePattern(blocks, pattern.value, pattern.len, end_bit);
+            const std::vector<uint64_t> expected = referenceHits(blocks, pattern.value, mask);
+            if (end_bit >= 64)
+            {
+                QVERIFY(expected[(end_bit / 64) - 1] & (1ULL << (63 - (end_bit % 64))));
+            }
+
+            for (SyncCorrelator::Kernel kernel : allKernels())
+            {
+                if (!SyncCorrelator::isSupported(kernel))
+                {
+                    continue;
+                }
+                const std::vector<uint64_t> actual = runKernel(kernel, blocks, pattern.value, mask);
+                QVERIFY2(actual == expected,
+                         qPrintable(QString("%1 kernel, %2-bit pattern ending at bit %3")
+                                        .arg(SyncCorrelator::kernelName(kernel))
+                                        .arg(pattern.len).arg(end_bit)));
+            }
+        }
+    }
+}
+
+void TestSyncCorrelator::randomStreamsMatchReference()
+{
+    // Low-entropy streams so short patterns hit often; block counts cover
+    // every vector-width remainder.
+    QRandomGenerator rng(42);
+    for (int iter = 0; iter < 300; iter++)
+    {
+        const int len = 1 + static_cast<int>(rng.bounded(64U));
+        const uint64_t mask = (len == 64) ? ~0ULL : ((1ULL << len) - 1);
+        const uint64_t pattern = rng.generate64() & mask & ((iter % 2 == 0) ? 0x0F0F0F0F0F0F0F0FULL : ~0ULL);
+        const size_t num_blocks = 1 + rng.bounded(40U);
+
+        std::vector<uint64_t> blocks(num_blocks + 1);
+        for (uint64_t& block : blocks)
+        {
+            block = rng.generate64() & rng.generate64() & 0x0F0F0F0F0F0F0F0FULL;
+        }
+        const std::vector<uint64_t> expected = referenceHits(blocks, pattern, mask);
+
+        for (SyncCorrelator::Kernel kernel : allKernels())
+        {
+            if (!SyncCorrelator::isSupported(kernel))
+            {
+                continue;
+            }
+            QVERIFY2(runKernel(kernel, blocks, pattern, mask) == expected,
+                     SyncCorrelator::kernelName(kernel));
+        }
+    }
+}
+
+void TestSyncCorrelator::patternOutsideMaskNeverMatches()
+{
+    std::vector<uint64_t> blocks(9, ~0ULL);
+    for (SyncCorrelator::Kernel kernel : allKernels())
+    {
+        if (!SyncCorrelator::isSupported(kernel))
+        {
+            continue;
+        }
+        const std::vector<uint64_t> hits = runKernel(kernel, blocks, 0x1FFFF, 0xFFFF);
+        for (uint64_t h : hits)
+        {
+            QCOMPARE(h, uint64_t{0});
+        }
+    }
+}
+
+void TestSyncCorrelator::containsPatternHonorsLengthGuard()
+{
+    // An all-zero pattern matches the zero history immediately; it must not be
+    // reported until a full pattern length of real bits was shifted in.
+    const uint8_t zeros[2] = { 0x00, 0x00 };
+    SyncCorrelator correlator(0, 0xFFFF);
+    QVERIFY(!correlator.containsPattern(zeros, 15, 16));
+    QVERIFY(correlator.containsPattern(zeros, 16, 16));
+
+    const uint8_t sync[4] = { 0xFE, 0x6B, 0x28, 0x40 };
+    SyncCorrelator sync_correlator(kSyncPattern, kSyncMask);
+    QVERIFY(sync_correlator.containsPattern(sync, 32, 32));
+    QVERIFY(!sync_correlator.containsPattern(sync, 31, 32));
+}
+
+void TestSyncCorrelator::containsPatternAcrossChunks()
+{
+    // The convenience search works in fixed-size chunks; place the sync across
+    // every byte boundary of a buffer several chunks long.
+    QRandomGenerator rng(7);
+    std::vector<uint8_t> buffer(2000);
+    for (size_t offset = 0; offset + 4 <= buffer.size(); offset += 61)
+    {
+        for (uint8_t& b : buffer)
+        {
+            b = static_cast<uint8_t>(rng.bounded(2U));  // 0x00/0x01 never contain 0xFE6B2840
+        }
+        buffer[offset] = 0xFE;
+        buffer[offset + 1] = 0x6B;
+        buffer[offset + 2] = 0x28;
+        buffer[offset + 3] = 0x40;
+
+        SyncCorrelator correlator(kSyncPattern, kSyncMask);
+        QVERIFY(correlator.containsPattern(buffer.data(), buffer.size() * 8, 32));
+        QVERIFY(!correlator.containsPattern(buffer.data(), (offset + 4) * 8 - 1, 32));
+    }
+}
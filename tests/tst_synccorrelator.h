@@ -0,0 +1,26 @@
+/**
+ * @file tst_synccorrelator.h
+ * @brief Unit tests for SyncCorrelator — kernel dispatch and bit-alignment coverage.
+ */
+
+#ifndef TST_SYNCCORRELATOR_H
+#define TST_SYNCCORRELATOR_H
+
+#include <QObject>
+
+class TestSyncCorrelator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void kernelNames();
+    void bestKernelIsSupported();
+    void packBlocksPadsTail();
+    void everyBitAlignment();
+    void randomStreamsMatchReference();
+    void patternOutsideMaskNeverMatches();
+    void containsPatternHonorsLengthGuard();
+    void containsPatternAcrossChunks();
+};
+
+#endif // TST_SYNCCORRELATOR_H
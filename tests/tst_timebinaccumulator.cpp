@@ -0,0 +1,228 @@
+/**
+ * @file tst_timebinaccumulator.cpp
+ * @brief Implementation of TimeBinAccumulator unit tests.
+ */
+
+#include "tst_timebinaccumulator.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <QRandomGenerator>
+#include <QtTest>
+
+#include "timebinaccumulator.h"
+
+namespace {
+    constexpr uint64_t kStart = 1000;
+    constexpr uint64_t kStop = 1010;
+
+    /// @return @p seconds in 100 ns ticks.
+    int64_t ticks(double seconds)
+    {
+        return std::llround(seconds * 1.0e7);
+    }
+
+    /// Two values per frame, written to columns 1 and 0.
+    TimeBinAccumulator makeBins(double sample_rate)
+    {
+        return TimeBinAccumulator(kStart, kStop, sample_rate, { 1, 0 }, 2);
+    }
+
+    /// Closed bins drained from an accumulator.
+    struct Rows
+    {
+        std::vector<int64_t> times;
+        std::vector<int> samples;
+        std::vector<double> sums;
+    };
+
+    void drain(TimeBinAccumulator& bins, Rows& rows)
+    {
+        for (size_t b = 0; b < bins.closedBins(); b++)
+        {
+            rows.times.push_back(bins.binTime(b));
+            rows.samples.push_back(bins.binSamples(b));
+            rows.sums.insert(rows.sums.end(), bins.binSums(b), bins.binSums(b) + bins.columnCount());
+        }
+        bins.clearClosedBins();
+    }
+
+    /// Bitwise comparison, so summation order differences are caught.
+    bool sameBits(const std::vector<double>& a, const std::vector<double>& b)
+    {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+    }
+}
+
+void TestTimeBinAccumulator::binsFollowSamplePeriod()
+{
+    TimeBinAccumulator bins = makeBins(4);
+    const double a[] = { 1.0, 10.0 };
+    const double b[] = { 3.0, 30.0 };
+    QVERIFY(bins.addFrame(ticks(1000.10), a));
+    QVERIFY(bins.addFrame(ticks(1000.20), b));
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(0));
+
+    // Skipping two empty periods closes the first bin only
+    QVERIFY(bins.addFrame(ticks(1000.80), a));
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(1));
+    QCOMPARE(bins.binTime(0), ticks(1000.0));
+    QCOMPARE(bins.binSamples(0), 2);
+    QCOMPARE(bins.binSums(0)[0], 40.0);
+    QCOMPARE(bins.binSums(0)[1], 4.0);
+
+    bins.flush();
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(2));
+    QCOMPARE(bins.binTime(1), ticks(1000.75));
+    QCOMPARE(bins.binSamples(1), 1);
+
+    bins.clearClosedBins();
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(0));
+}
+
+void TestTimeBinAccumulator::fractionalRateBins()
+{
+    // 0.25 Hz: one row per four seconds
+    TimeBinAccumulator bins = makeBins(0.25);
+    const double v[] = { 1.0, 2.0 };
+    QVERIFY(bins.addFrame(ticks(1000.5), v));
+    QVERIFY(bins.addFrame(ticks(1003.9), v));
+    QVERIFY(bins.addFrame(ticks(1004.5), v));
+    QVERIFY(bins.addFrame(ticks(1009.0), v));
+    bins.flush();
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(3));
+    QCOMPARE(bins.binTime(0), ticks(1000.0));
+    QCOMPARE(bins.binSamples(0), 2);
+    QCOMPARE(bins.binTime(1), ticks(1004.0));
+    QCOMPARE(bins.binSamples(1), 1);
+    QCOMPARE(bins.binTime(2), ticks(1008.0));
+}
+
+void TestTimeBinAccumulator::binEdgesAreExact()
+{
+    // 3 Hz does not divide a second into whole ticks; edges must not drift
+    constexpr uint64_t kYear = 365ULL * 86400;
+    TimeBinAccumulator bins(0, 2 * kYear, 3.0, { 0 }, 1);
+    const double v[] = { 1.0 };
+
+    // A frame exactly on an edge stays in the earlier bin
+    QVERIFY(bins.addFrame(ticks(1.0), v));
+    QVERIFY(bins.addFrame(ticks(1.0) + 1, v));
+
+    // A year later is one division away, and lands on an exact second
+    QVERIFY(bins.addFrame(ticks(static_cast<double>(kYear)) + 1, v));
+    bins.flush();
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(3));
+    QCOMPARE(bins.binTime(0), ticks(2.0 / 3.0));
+    QCOMPARE(bins.binTime(1), ticks(1.0));
+    QCOMPARE(bins.binTime(2), ticks(static_cast<double>(kYear)));
+}
+
+void TestTimeBinAccumulator::framesOutsideWindowIgnored()
+{
+    TimeBinAccumulator bins = makeBins(1);
+    const double v[] = { 1.0, 1.0 };
+    QVERIFY(!bins.addFrame(ticks(999.5), v));
+    QVERIFY(!bins.addFrame(ticks(1010.5), v));
+    QVERIFY(!bins.addFrame(std::numeric_limits<int64_t>::min(), v));
+    QVERIFY(bins.addFrame(ticks(1010.0), v));
+    bins.flush();
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(1));
+    QCOMPARE(bins.binSamples(0), 1);
+}
+
+void TestTimeBinAccumulator::backwardsFrameJoinsCurrentBin()
+{
+    // Like the original sampler, a frame earlier than the current bin is
+    // averaged into that bin rather than reopening an older one
+    TimeBinAccumulator bins = makeBins(1);
+    const double v[] = { 2.0, 4.0 };
+    QVERIFY(bins.addFrame(ticks(1003.5), v));
+    QVERIFY(bins.addFrame(ticks(1001.5), v));
+    bins.flush();
+    QCOMPARE(bins.closedBins(), static_cast<size_t>(1));
+    QCOMPARE(bins.binTime(0), ticks(1003.0));
+    QCOMPARE(bins.binSamples(0), 2);
+}
+
+void TestTimeBinAccumulator::chunkMergeMatchesSerial()
+{
+    QRandomGenerator rng(42);
+    for (int iter = 0; iter < 50; iter++)
+    {
+        const int sample_rate = 1 + static_cast<int>(rng.bounded(50U));
+        std::vector<int64_t> times;
+        std::vector<double> values;
+        double t = 999.5;
+        while (t < 1010.5)
+        {
+            times.push_back(ticks(t));
+            values.push_back(rng.generateDouble() * 100.0);
+            values.push_back(-rng.generateDouble());
+            // Mostly forward, with occasional small steps back in time
+            t += (rng.bounded(20U) == 0) ? -0.05 : rng.generateDouble() * 0.02;
+        }
+
+        TimeBinAccumulator serial = makeBins(sample_rate);
+        Rows expected;
+        for (size_t i = 0; i < times.size(); i++)
+        {
+            serial.addFrame(times[i], &values[i * 2]);
+            drain(serial, expected);
+        }
+        serial.flush();
+        drain(serial, expected);
+
+        // Random chunk edges; rejected chunks are continued serially
+        TimeBinAccumulator merged = makeBins(sample_rate);
+        Rows actual;
+        size_t first = 0;
+        while (first < times.size())
+        {
+            const size_t end = qMin(times.size(), first + 1 + rng.bounded(400U));
+            TimeBinAccumulator chunk = makeBins(sample_rate);
+            chunk.setRecordFirstBin(true);
+            for (size_t i = first; i < end; i++)
+            {
+                chunk.addFrame(times[i], &values[i * 2]);
+            }
+            if (!merged.appendChunk(chunk))
+            {
+                for (size_t i = first; i < end; i++)
+                {
+                    merged.addFrame(times[i], &values[i * 2]);
+                }
+            }
+            drain(merged, actual);
+            first = end;
+        }
+        merged.flush();
+        drain(merged, actual);
+
+        QCOMPARE(actual.times, expected.times);
+        QCOMPARE(actual.samples, expected.samples);
+        QVERIFY(sameBits(actual.sums, expected.sums));
+    }
+}
+
+void TestTimeBinAccumulator::appendChunkRejectsFoldedBins()
+{
+    const double v[] = { 1.0, 1.0 };
+    TimeBinAccumulator merged = makeBins(1);
+    QVERIFY(merged.addFrame(ticks(1005.5), v));
+
+    // Serially, both bins of this chunk would fold into bin 5
+    TimeBinAccumulator chunk = makeBins(1);
+    chunk.setRecordFirstBin(true);
+    QVERIFY(chunk.addFrame(ticks(1002.5), v));
+    QVERIFY(chunk.addFrame(ticks(1003.5), v));
+    QVERIFY(!merged.canAppendChunk(chunk));
+    QVERIFY(!merged.appendChunk(chunk));
+
+    merged.flush();
+    QCOMPARE(merged.closedBins(), static_cast<size_t>(1));
+    QCOMPARE(merged.binSamples(0), 1);
+}
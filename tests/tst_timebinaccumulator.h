@@ -0,0 +1,25 @@
+/**
+ * @file tst_timebinaccumulator.h
+ * @brief Unit tests for TimeBinAccumulator — CSV sampling and ordered chunk merging.
+ */
+
+#ifndef TST_TIMEBINACCUMULATOR_H
+#define TST_TIMEBINACCUMULATOR_H
+
+#include <QObject>
+
+class TestTimeBinAccumulator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void binsFollowSamplePeriod();
+    void fractionalRateBins();
+    void binEdgesAreExact();
+    void framesOutsideWindowIgnored();
+    void backwardsFrameJoinsCurrentBin();
+    void chunkMergeMatchesSerial();
+    void appendChunkRejectsFoldedBins();
+};
+
+#endif // TST_TIMEBINACCUMULATOR_H